@@ -28,7 +28,9 @@ class ATTR_ROW final
 public:
     using const_iterator = typename AttrRowIterator;
 
-    ATTR_ROW(const UINT cchRowWidth, const TextAttribute attr);
+    ATTR_ROW(const UINT cchRowWidth,
+             const TextAttribute attr,
+             std::pmr::memory_resource* const pRunPool = std::pmr::get_default_resource());
 
     void Reset(const TextAttribute attr);
 
@@ -66,7 +68,9 @@ public:
 
 private:
 
-    std::vector<TextAttributeRun> _list;
+    // Runs come out of the owning text buffer's pool so that the one-run
+    // rows (the normal case) don't each cost a separate heap block.
+    std::pmr::vector<TextAttributeRun> _list;
     size_t _cchRowWidth;
 
 #ifdef UNIT_TESTING
@@ -10,17 +10,20 @@
 // Routine Description:
 // - constructor
 // Arguments:
+// - pCells - the cells backing this row. Owned by the text buffer, must hold at least rowWidth cells.
 // - rowWidth - the size (in wchar_t) of the char and attribute rows
 // - pParent - the parent ROW
 // Return Value:
 // - instantiated object
-// Note: will through if unable to allocate char/attribute buffers
-CharRow::CharRow(size_t rowWidth, ROW* const pParent) :
+CharRow::CharRow(value_type* const pCells, const size_t rowWidth, ROW* const pParent) :
     _wrapForced{ false },
     _doubleBytePadded{ false },
-    _data(rowWidth, value_type()),
+    _data{ pCells },
+    _rowWidth{ rowWidth },
+    _unicodeStorage{},
     _pParent{ FAIL_FAST_IF_NULL(pParent) }
 {
+    std::fill_n(_data, _rowWidth, value_type());
 }
 
 // Routine Description:
@@ -75,7 +78,7 @@ bool CharRow::WasDoubleBytePadded() const noexcept
 // - the size of the row
 size_t CharRow::size() const noexcept
 {
-    return _data.size();
+    return _rowWidth;
 }
 
 // Routine Description:
@@ -86,10 +89,8 @@ size_t CharRow::size() const noexcept
 // - <none>
 void CharRow::Reset()
 {
-    for (auto& cell : _data)
-    {
-        cell.Reset();
-    }
+    std::for_each(begin(), end(), [](value_type& cell) { cell.Reset(); });
+    _unicodeStorage.Clear();
 
     _wrapForced = false;
     _doubleBytePadded = false;
@@ -97,41 +98,47 @@ void CharRow::Reset()
 
 // Routine Description:
 // - resizes the width of the CharRowBase
+// - The row doesn't own its cells, so the caller hands it the new location
+//   (a slice of the resized text buffer slab). Existing cells are copied over
+//   and any new columns are filled with blank cells. Glyphs stored for columns that
+//   were cut off are dropped.
 // Arguments:
+// - pNewCells - the new backing cells for this row, at least newSize long
 // - newSize - the new width of the character and attributes rows
 // Return Value:
 // - S_OK on success, otherwise relevant error code
 [[nodiscard]]
-HRESULT CharRow::Resize(const size_t newSize) noexcept
+HRESULT CharRow::Resize(value_type* const pNewCells, const size_t newSize) noexcept
 {
-    try
-    {
-        const value_type insertVals;
-        _data.resize(newSize, insertVals);
-    }
-    CATCH_RETURN();
+    const auto preserved = std::min(_rowWidth, newSize);
+    std::copy_n(_data, preserved, pNewCells);
+    std::fill_n(pNewCells + preserved, newSize - preserved, value_type());
+
+    _data = pNewCells;
+    _rowWidth = newSize;
+    _unicodeStorage.EraseFrom(newSize);
 
     return S_OK;
 }
 
 typename CharRow::iterator CharRow::begin() noexcept
 {
-    return _data.begin();
+    return _data;
 }
 
 typename CharRow::const_iterator CharRow::cbegin() const noexcept
 {
-    return _data.cbegin();
+    return _data;
 }
 
 typename CharRow::iterator CharRow::end() noexcept
 {
-    return _data.end();
+    return _data + _rowWidth;
 }
 
 typename CharRow::const_iterator CharRow::cend() const noexcept
 {
-    return _data.cend();
+    return _data + _rowWidth;
 }
 
 // Routine Description:
@@ -142,12 +149,12 @@ typename CharRow::const_iterator CharRow::cend() const noexcept
 // - The calculated left boundary of the internal string.
 size_t CharRow::MeasureLeft() const
 {
-    std::vector<value_type>::const_iterator it = _data.cbegin();
-    while (it != _data.cend() && it->IsSpace())
+    const_iterator it = cbegin();
+    while (it != cend() && it->IsSpace())
     {
         ++it;
     }
-    return it - _data.cbegin();
+    return it - cbegin();
 }
 
 // Routine Description:
@@ -158,17 +165,18 @@ size_t CharRow::MeasureLeft() const
 // - The calculated right boundary of the internal string.
 size_t CharRow::MeasureRight() const noexcept
 {
-    std::vector<value_type>::const_reverse_iterator it = _data.crbegin();
-    while (it != _data.crend() && it->IsSpace())
+    const_iterator it = cend();
+    while (it != cbegin() && (it - 1)->IsSpace())
     {
-        ++it;
+        --it;
     }
-    return _data.crend() - it;
+    return it - cbegin();
 }
 
 void CharRow::ClearCell(const size_t column)
 {
-    _data.at(column).Reset();
+    _CellAt(column).Reset();
+    _unicodeStorage.Erase(column);
 }
 
 // Routine Description:
@@ -179,14 +187,7 @@ void CharRow::ClearCell(const size_t column)
 // - True if there is valid text in this row. False otherwise.
 bool CharRow::ContainsText() const noexcept
 {
-    for (const value_type& cell : _data)
-    {
-        if (!cell.IsSpace())
-        {
-            return true;
-        }
-    }
-    return false;
+    return std::any_of(cbegin(), cend(), [](const value_type& cell) { return !cell.IsSpace(); });
 }
 
 // Routine Description:
@@ -198,7 +199,7 @@ bool CharRow::ContainsText() const noexcept
 // Note: will throw exception if column is out of bounds
 const DbcsAttribute& CharRow::DbcsAttrAt(const size_t column) const
 {
-    return _data.at(column).DbcsAttr();
+    return _CellAt(column).DbcsAttr();
 }
 
 // Routine Description:
@@ -222,7 +223,8 @@ DbcsAttribute& CharRow::DbcsAttrAt(const size_t column)
 // Note: will throw exception if column is out of bounds
 void CharRow::ClearGlyph(const size_t column)
 {
-    _data.at(column).EraseChars();
+    _CellAt(column).EraseChars();
+    _unicodeStorage.Erase(column);
 }
 
 // Routine Description:
@@ -234,7 +236,7 @@ void CharRow::ClearGlyph(const size_t column)
 // - Note: will throw exception if column is out of bounds
 const CharRow::reference CharRow::GlyphAt(const size_t column) const
 {
-    THROW_HR_IF(E_INVALIDARG, column >= _data.size());
+    THROW_HR_IF(E_INVALIDARG, column >= _rowWidth);
     return { const_cast<CharRow&>(*this), column };
 }
 
@@ -247,7 +249,7 @@ const CharRow::reference CharRow::GlyphAt(const size_t column) const
 // - Note: will throw exception if column is out of bounds
 CharRow::reference CharRow::GlyphAt(const size_t column)
 {
-    THROW_HR_IF(E_INVALIDARG, column >= _data.size());
+    THROW_HR_IF(E_INVALIDARG, column >= _rowWidth);
     return { *this, column };
 }
 
@@ -262,8 +264,8 @@ CharRow::reference CharRow::GlyphAt(const size_t column)
 std::wstring CharRow::GetTextRaw() const
 {
     std::wstring wstr;
-    wstr.reserve(_data.size());
-    for (size_t i = 0;  i < _data.size(); ++i)
+    wstr.reserve(_rowWidth);
+    for (size_t i = 0;  i < _rowWidth; ++i)
     {
         auto glyph = GlyphAt(i);
         for (auto it = glyph.begin(); it != glyph.end(); ++it)
@@ -277,9 +279,9 @@ std::wstring CharRow::GetTextRaw() const
 std::wstring CharRow::GetText() const
 {
     std::wstring wstr;
-    wstr.reserve(_data.size());
+    wstr.reserve(_rowWidth);
 
-    for (size_t i = 0;  i < _data.size(); ++i)
+    for (size_t i = 0;  i < _rowWidth; ++i)
     {
         auto glyph = GlyphAt(i);
         if (!DbcsAttrAt(i).IsTrailing())
@@ -293,32 +295,48 @@ std::wstring CharRow::GetText() const
     return wstr;
 }
 
-UnicodeStorage& CharRow::GetUnicodeStorage()
+// Routine Description:
+// - the storage for glyphs of this row that don't fit in a single cell. It is keyed by column.
+UnicodeStorage& CharRow::GetUnicodeStorage() noexcept
 {
-    return _pParent->GetUnicodeStorage();
+    return _unicodeStorage;
 }
 
-const UnicodeStorage& CharRow::GetUnicodeStorage() const
+const UnicodeStorage& CharRow::GetUnicodeStorage() const noexcept
 {
-    return _pParent->GetUnicodeStorage();
+    return _unicodeStorage;
 }
 
 // Routine Description:
-// - calculates the key used by the given column of the char row to store glyph data in UnicodeStorage
+// - Updates the pointer to the parent row (which might change if we shuffle the rows around)
 // Arguments:
-// - column - the column to generate the key for
+// - pParent - Pointer to the parent row
+void CharRow::UpdateParent(ROW* const pParent) noexcept
+{
+    _pParent = FAIL_FAST_IF_NULL(pParent);
+}
+
+// Routine Description:
+// - bounds checked access to the cell at column
+// Arguments:
+// - column - the column of the cell to retrieve
 // Return Value:
-// - the COORD key for data access from UnicodeStorage for the column
-COORD CharRow::GetStorageKey(const size_t column) const
+// - the cell
+// Note: will throw exception if column is out of bounds
+const CharRow::value_type& CharRow::_CellAt(const size_t column) const
 {
-    return { gsl::narrow<SHORT>(column), _pParent->GetId() };
+    THROW_HR_IF(E_INVALIDARG, column >= _rowWidth);
+    return _data[column];
 }
 
 // Routine Description:
-// - Updates the pointer to the parent row (which might change if we shuffle the rows around)
+// - bounds checked access to the cell at column
 // Arguments:
-// - pParent - Pointer to the parent row
-void CharRow::UpdateParent(ROW* const pParent) noexcept
+// - column - the column of the cell to retrieve
+// Return Value:
+// - the cell
+// Note: will throw exception if column is out of bounds
+CharRow::value_type& CharRow::_CellAt(const size_t column)
 {
-    _pParent = FAIL_FAST_IF_NULL(pParent);
+    return const_cast<value_type&>(static_cast<const CharRow* const>(this)->_CellAt(column));
 }
@@ -42,11 +42,17 @@ class CharRow final
 public:
     using glyph_type = typename wchar_t;
     using value_type = typename CharRowCell;
-    using iterator = typename std::vector<value_type>::iterator;
-    using const_iterator = typename std::vector<value_type>::const_iterator;
+    using iterator = value_type*;
+    using const_iterator = const value_type*;
     using reference = typename CharRowCellReference;
 
-    CharRow(size_t rowWidth, ROW* const pParent);
+    CharRow(value_type* const pCells, const size_t rowWidth, ROW* const pParent);
+
+    // The cells belong to the text buffer, so a copy would alias them. Rows can only be moved.
+    CharRow(const CharRow&) = delete;
+    CharRow& operator=(const CharRow&) = delete;
+    CharRow(CharRow&&) = default;
+    CharRow& operator=(CharRow&&) = default;
 
     void SetWrapForced(const bool wrap) noexcept;
     bool WasWrapForced() const noexcept;
@@ -55,7 +61,7 @@ public:
     size_t size() const noexcept;
     void Reset();
     [[nodiscard]]
-    HRESULT Resize(const size_t newSize) noexcept;
+    HRESULT Resize(value_type* const pNewCells, const size_t newSize) noexcept;
     size_t MeasureLeft() const;
     size_t MeasureRight() const noexcept;
     void ClearCell(const size_t column);
@@ -79,14 +85,13 @@ public:
     iterator end() noexcept;
     const_iterator cend() const noexcept;
 
-    UnicodeStorage& GetUnicodeStorage();
-    const UnicodeStorage& GetUnicodeStorage() const;
-    COORD GetStorageKey(const size_t column) const;
+    UnicodeStorage& GetUnicodeStorage() noexcept;
+    const UnicodeStorage& GetUnicodeStorage() const noexcept;
 
     void UpdateParent(ROW* const pParent) noexcept;
 
     friend CharRowCellReference;
-    friend constexpr bool operator==(const CharRow& a, const CharRow& b) noexcept;
+    friend bool operator==(const CharRow& a, const CharRow& b) noexcept;
 
 protected:
     // Occurs when the user runs out of text in a given row and we're forced to wrap the cursor to the next line
@@ -95,18 +100,27 @@ protected:
     // Occurs when the user runs out of text to support a double byte character and we're forced to the next line
     bool _doubleBytePadded;
 
-    // storage for glyph data and dbcs attributes
-    std::vector<value_type> _data;
+    const value_type& _CellAt(const size_t column) const;
+    value_type& _CellAt(const size_t column);
+
+    // storage for glyph data and dbcs attributes. this is this row's slice of
+    // the cell slab owned by the TextBuffer, not an allocation of its own.
+    value_type* _data;
+    size_t _rowWidth;
+
+    // storage for the glyphs of this row that don't fit in a single cell
+    UnicodeStorage _unicodeStorage;
 
     // ROW that this CharRow belongs to
     ROW* _pParent;
 };
 
-constexpr bool operator==(const CharRow& a, const CharRow& b) noexcept
+inline bool operator==(const CharRow& a, const CharRow& b) noexcept
 {
     return (a._wrapForced == b._wrapForced &&
             a._doubleBytePadded == b._doubleBytePadded &&
-            a._data == b._data);
+            a._rowWidth == b._rowWidth &&
+            std::equal(a._data, a._data + a._rowWidth, b._data));
 }
 
 template<typename InputIt1, typename InputIt2>
@@ -15,14 +15,20 @@ void CharRowCellReference::operator=(const std::wstring_view chars)
     THROW_HR_IF(E_INVALIDARG, chars.empty());
     if (chars.size() == 1)
     {
-        _cellData().Char() = chars.front();
+        // Look the column up in the storage instead of trusting the stored
+        //      flag. Writers like ROW::WriteCells assign the cell's DbcsAttr
+        //      before its glyph, which has already cleared the flag.
+        auto& storage = _parent.GetUnicodeStorage();
+        if (!storage.empty())
+        {
+            storage.Erase(_index);
+        }
         _cellData().DbcsAttr().SetGlyphStored(false);
+        _cellData().Char() = chars.front();
     }
     else
     {
-        auto& storage = _parent.GetUnicodeStorage();
-        const auto key = _parent.GetStorageKey(_index);
-        storage.StoreGlyph(key, { chars.cbegin(), chars.cend() });
+        _parent.GetUnicodeStorage().StoreGlyph(_index, chars);
         _cellData().DbcsAttr().SetGlyphStored(true);
     }
 }
@@ -42,7 +48,7 @@ CharRowCellReference::operator std::wstring_view() const
 // - ref to the CharRowCell
 CharRowCell& CharRowCellReference::_cellData()
 {
-    return _parent._data.at(_index);
+    return _parent._CellAt(_index);
 }
 
 // Routine Description:
@@ -51,7 +57,7 @@ CharRowCell& CharRowCellReference::_cellData()
 // - ref to the CharRowCell
 const CharRowCell& CharRowCellReference::_cellData() const
 {
-    return _parent._data.at(_index);
+    return _parent._CellAt(_index);
 }
 
 // Routine Description:
@@ -62,9 +68,7 @@ std::wstring_view CharRowCellReference::_glyphData() const
 {
     if (_cellData().DbcsAttr().IsGlyphStored())
     {
-        const auto& text = _parent.GetUnicodeStorage().GetText(_parent.GetStorageKey(_index));
-
-        return { text.data(), text.size() };
+        return _parent.GetUnicodeStorage().GetText(_index);
     }
     else
     {
@@ -80,7 +84,7 @@ CharRowCellReference::const_iterator CharRowCellReference::begin() const
 {
     if (_cellData().DbcsAttr().IsGlyphStored())
     {
-        return _parent.GetUnicodeStorage().GetText(_parent.GetStorageKey(_index)).data();
+        return _parent.GetUnicodeStorage().GetText(_index).data();
     }
     else
     {
@@ -96,8 +100,7 @@ CharRowCellReference::const_iterator CharRowCellReference::end() const
 {
     if (_cellData().DbcsAttr().IsGlyphStored())
     {
-
-        const auto& chars = _parent.GetUnicodeStorage().GetText(_parent.GetStorageKey(_index));
+        const auto chars = _parent.GetUnicodeStorage().GetText(_index);
         return chars.data() + chars.size();
     }
     else
@@ -123,8 +126,8 @@ bool operator==(const CharRowCellReference& ref, const std::vector<wchar_t>& gly
     }
     else
     {
-        const auto& chars = ref._parent.GetUnicodeStorage().GetText(ref._parent.GetStorageKey(ref._index));
-        return chars == glyph;
+        const auto chars = ref._parent.GetUnicodeStorage().GetText(ref._index);
+        return std::equal(chars.cbegin(), chars.cend(), glyph.cbegin(), glyph.cend());
     }
 }
 
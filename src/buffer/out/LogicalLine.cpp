@@ -0,0 +1,129 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "LogicalLine.hpp"
+
+// Routine Description:
+// - Reads the logical line that the given row is part of.
+// - Rows are joined for as long as the one above was wrapped onto the next,
+//   within the bounds of the buffer. The trailing cells of wide glyphs are
+//   left out, as is the blank space after the end of the text.
+// Arguments:
+// - buffer - The text buffer to read from
+// - row - Any row of the logical line
+// Return Value:
+// - <none>
+void LogicalLine::Read(const TextBuffer& buffer, const SHORT row)
+{
+    const auto size = buffer.GetSize();
+    THROW_HR_IF(E_INVALIDARG, row < size.Top() || row > size.BottomInclusive());
+
+    _top = row;
+    while (_top > size.Top() && buffer.GetRowByOffset(_top - 1).GetCharRow().WasWrapForced())
+    {
+        _top--;
+    }
+
+    _bottom = row;
+    while (_bottom < size.BottomInclusive() && buffer.GetRowByOffset(_bottom).GetCharRow().WasWrapForced())
+    {
+        _bottom++;
+    }
+
+    _text.clear();
+    _cells.clear();
+
+    for (SHORT y = _top; y <= _bottom; y++)
+    {
+        const auto& charRow = buffer.GetRowByOffset(y).GetCharRow();
+        const auto pCells = charRow.cbegin();
+        const SHORT width = gsl::narrow<SHORT>(charRow.size());
+
+        // Most cells are one character, so make room for the whole row up front
+        //      and only grow further for the glyphs that are longer.
+        size_t length = _text.size();
+        _text.resize(length + width);
+        _cells.resize(length + width);
+
+        for (SHORT x = 0; x < width; x++)
+        {
+            const auto& dbcsAttr = pCells[x].DbcsAttr();
+            if (dbcsAttr.IsTrailing())
+            {
+                continue;
+            }
+
+            const GlyphCells cells{ { x, y }, dbcsAttr.IsLeading() && x + 1 < width ? gsl::narrow_cast<SHORT>(x + 1) : x };
+
+            if (dbcsAttr.IsGlyphStored())
+            {
+                const std::wstring_view glyph = charRow.GlyphAt(x);
+                if (glyph.size() > 1)
+                {
+                    _text.resize(_text.size() + glyph.size() - 1);
+                    _cells.resize(_cells.size() + glyph.size() - 1);
+                }
+                std::copy(glyph.cbegin(), glyph.cend(), _text.begin() + length);
+                std::fill_n(_cells.begin() + length, glyph.size(), cells);
+                length += glyph.size();
+            }
+            else
+            {
+                _text[length] = pCells[x].Char();
+                _cells[length] = cells;
+                length++;
+            }
+        }
+
+        _text.resize(length);
+        _cells.resize(length);
+    }
+
+    const auto end = _text.find_last_not_of(UNICODE_SPACE);
+    const auto length = end == std::wstring::npos ? 0 : end + 1;
+    _text.resize(length);
+    _cells.resize(length);
+}
+
+// Routine Description:
+// - Gets the first row of the line that was read.
+// Return Value:
+// - The row, in buffer coordinates.
+SHORT LogicalLine::GetTop() const noexcept
+{
+    return _top;
+}
+
+// Routine Description:
+// - Gets the last row of the line that was read.
+// Return Value:
+// - The row, in buffer coordinates.
+SHORT LogicalLine::GetBottom() const noexcept
+{
+    return _bottom;
+}
+
+// Routine Description:
+// - Gets the text of the line that was read.
+// Return Value:
+// - The text. Only valid until the next Read.
+std::wstring_view LogicalLine::GetText() const noexcept
+{
+    return _text;
+}
+
+// Routine Description:
+// - Maps a span of the line's text back onto the cells it came from.
+// Arguments:
+// - offset - The index of the first character of the span
+// - length - The number of characters in the span. Can't be zero.
+// Return Value:
+// - The first cell of the span's first glyph and the last cell of its last glyph.
+std::pair<COORD, COORD> LogicalLine::GetCellSpan(const size_t offset, const size_t length) const
+{
+    THROW_HR_IF(E_INVALIDARG, length == 0);
+    const auto& last = _cells.at(offset + length - 1);
+    return { _cells.at(offset).first, { last.lastColumn, last.first.Y } };
+}
@@ -0,0 +1,47 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- LogicalLine.hpp
+
+Abstract:
+- Reads a logical line out of a text buffer: a row together with the rows its
+  text was wrapped onto, joined into one string.
+- Keeps the cell each character came from, so positions in the string can be
+  mapped back onto the buffer.
+- One instance is meant to be reused line after line, so walking through the
+  whole scrollback never holds more than one line's worth of text.
+--*/
+
+#pragma once
+
+#include "textBuffer.hpp"
+
+class LogicalLine final
+{
+public:
+    LogicalLine() = default;
+
+    void Read(const TextBuffer& buffer, const SHORT row);
+
+    SHORT GetTop() const noexcept;
+    SHORT GetBottom() const noexcept;
+    std::wstring_view GetText() const noexcept;
+
+    std::pair<COORD, COORD> GetCellSpan(const size_t offset, const size_t length) const;
+
+private:
+    SHORT _top = 0;
+    SHORT _bottom = 0;
+    std::wstring _text;
+
+    // The cells of the glyph each character of _text belongs to. A glyph is never
+    // split across rows, so its last cell is only a column.
+    struct GlyphCells
+    {
+        COORD first;
+        SHORT lastColumn;
+    };
+    std::vector<GlyphCells> _cells;
+};
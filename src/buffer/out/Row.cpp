@@ -14,13 +14,20 @@
 // - rowWidth - the width of the row, cell elements
 // - fillAttribute - the default text attribute
 // - pParent - the text buffer that this row belongs to
+// - pCells - the slice of the text buffer's cell slab that holds this row's characters
+// - pAttrRunPool - the text buffer's pool that this row's attribute runs are allocated from
 // Return Value:
 // - constructed object
-ROW::ROW(const SHORT rowId, const short rowWidth, const TextAttribute fillAttribute, TextBuffer* const pParent) :
+ROW::ROW(const SHORT rowId,
+         const short rowWidth,
+         const TextAttribute fillAttribute,
+         TextBuffer* const pParent,
+         CharRow::value_type* const pCells,
+         std::pmr::memory_resource* const pAttrRunPool) :
     _id{ rowId },
     _rowWidth{ gsl::narrow<size_t>(rowWidth) },
-    _charRow{ gsl::narrow<size_t>(rowWidth), this },
-    _attrRow{ gsl::narrow<UINT>(rowWidth), fillAttribute },
+    _charRow{ pCells, gsl::narrow<size_t>(rowWidth), this },
+    _attrRow{ gsl::narrow<UINT>(rowWidth), fillAttribute, pAttrRunPool },
     _pParent{ pParent }
 {
 }
@@ -84,18 +91,19 @@ bool ROW::Reset(const TextAttribute Attr)
 // Routine Description:
 // - resizes ROW to new width
 // Arguments:
+// - pNewCells - the new slice of the text buffer's cell slab for this row's characters
 // - width - the new width, in cells
 // Return Value:
 // - S_OK if successful, otherwise relevant error
 [[nodiscard]]
-HRESULT ROW::Resize(const size_t width)
+HRESULT ROW::Resize(CharRow::value_type* const pNewCells, const size_t width)
 {
-    RETURN_IF_FAILED(_charRow.Resize(width));
     try
     {
         _attrRow.Resize(width);
     }
     CATCH_RETURN();
+    RETURN_IF_FAILED(_charRow.Resize(pNewCells, width));
 
     _rowWidth = width;
 
@@ -133,14 +141,14 @@ RowCellIterator ROW::AsCellIter(const size_t startIndex, const size_t count) con
     return RowCellIterator(*this, startIndex, count);
 }
 
-UnicodeStorage& ROW::GetUnicodeStorage()
+UnicodeStorage& ROW::GetUnicodeStorage() noexcept
 {
-    return _pParent->GetUnicodeStorage();
+    return _charRow.GetUnicodeStorage();
 }
 
-const UnicodeStorage& ROW::GetUnicodeStorage() const
+const UnicodeStorage& ROW::GetUnicodeStorage() const noexcept
 {
-    return _pParent->GetUnicodeStorage();
+    return _charRow.GetUnicodeStorage();
 }
 
 // Routine Description:
@@ -161,16 +169,52 @@ OutputCellIterator ROW::WriteCells(OutputCellIterator it, const size_t index, co
     // If we're given a right-side column limit, use it. Otherwise, the write limit is the final column index available in the char row.
     const auto finalColumnInRow = limitRight.value_or(_charRow.size() - 1);
 
+    // The colors of the cells are gathered into runs as we go and laid over the row's
+    // attributes all at once, instead of one cell at a time. The runs for a typical
+    // row fit in the space on the stack, so gathering them doesn't allocate either.
+    // The vector is reserved to all of that space up front. Left to grow on its own,
+    // it would give up the buffer and go to the heap at half of it.
+    constexpr size_t cAttrRunsOnStack = 64;
+    alignas(TextAttributeRun) std::array<std::byte, cAttrRunsOnStack * sizeof(TextAttributeRun)> attrRunSpace;
+    std::pmr::monotonic_buffer_resource attrRunPool{ attrRunSpace.data(), attrRunSpace.size() };
+    std::pmr::vector<TextAttributeRun> attrRuns{ &attrRunPool };
+    attrRuns.reserve(cAttrRunsOnStack);
+    size_t attrRunsStart = currentIndex;
+
+    const auto applyAttrRuns = [&]() {
+        if (!attrRuns.empty())
+        {
+            LOG_IF_FAILED(_attrRow.InsertAttrRuns({ attrRuns.data(), attrRuns.size() },
+                                                  attrRunsStart,
+                                                  currentIndex - 1,
+                                                  _charRow.size()));
+            attrRuns.clear();
+        }
+    };
+
     while (it && currentIndex <= finalColumnInRow)
     {
         // Fill the color if the behavior isn't set to keeping the current color.
         if (it->TextAttrBehavior() != TextAttributeBehavior::Current)
         {
-            const TextAttributeRun attrRun{ 1, it->TextAttr() };
-            LOG_IF_FAILED(_attrRow.InsertAttrRuns({ &attrRun, 1 },
-                                                  currentIndex,
-                                                  currentIndex,
-                                                  _charRow.size()));
+            if (attrRuns.empty())
+            {
+                attrRunsStart = currentIndex;
+            }
+
+            if (!attrRuns.empty() && attrRuns.back().GetAttributes() == it->TextAttr())
+            {
+                attrRuns.back().IncrementLength();
+            }
+            else
+            {
+                attrRuns.emplace_back(1, it->TextAttr());
+            }
+        }
+        else
+        {
+            // Cells that keep their current color split the runs, so lay down what we have so far.
+            applyAttrRuns();
         }
 
         // Fill the text if the behavior isn't set to saying there's only a color stored in this iterator.
@@ -218,5 +262,100 @@ OutputCellIterator ROW::WriteCells(OutputCellIterator it, const size_t index, co
         ++currentIndex;
     }
 
+    applyAttrRuns();
+
     return it;
 }
+
+// Routine Description:
+// - Moves the cells of a span of the row over by count, in place, and blanks
+//   the cells they uncover. Cells moved past the end of the span are dropped.
+// - A wide glyph that the move would split, at either end of the span or where
+//   the dropped cells are cut off, is blanked first, both halves of it.
+// - The colors move along with the cells. They're laid over the row as one
+//   batch of runs, gathered on the stack like WriteCells does.
+// Arguments:
+// - left - The first column of the span
+// - right - The last column of the span
+// - count - How far to move the cells
+// - insert - True to move the cells right and blank the start of the span,
+//   false to move them left and blank the end of it.
+// - fillAttribute - The color of the blank cells
+void ROW::ShiftCells(const size_t left, const size_t right, const size_t count, const bool insert, const TextAttribute fillAttribute)
+{
+    THROW_HR_IF(E_INVALIDARG, left > right || right >= _charRow.size());
+
+    const size_t width = right - left + 1;
+    const size_t cBlank = std::min(count, width);
+    const size_t cKept = width - cBlank;
+    if (cBlank == 0)
+    {
+        return;
+    }
+
+    const auto blankSplitGlyph = [this](const size_t column) {
+        if (column + 1 < _charRow.size() &&
+            _charRow.DbcsAttrAt(column).IsLeading() &&
+            _charRow.DbcsAttrAt(column + 1).IsTrailing())
+        {
+            _charRow.ClearCell(column);
+            _charRow.ClearCell(column + 1);
+        }
+    };
+    if (left > 0)
+    {
+        blankSplitGlyph(left - 1);
+    }
+    blankSplitGlyph(right);
+    if (cKept > 0)
+    {
+        blankSplitGlyph(insert ? right - cBlank : left + cBlank - 1);
+    }
+
+    const size_t keptFrom = insert ? left : left + cBlank;
+    const size_t keptTo = insert ? left + cBlank : left;
+    const size_t blankFrom = insert ? left : right - cBlank + 1;
+    const size_t droppedFrom = insert ? right - cBlank + 1 : left;
+
+    // The runs are gathered on the stack, reserved up front as in WriteCells.
+    constexpr size_t cAttrRunsOnStack = 16;
+    alignas(TextAttributeRun) std::array<std::byte, cAttrRunsOnStack * sizeof(TextAttributeRun)> attrRunSpace;
+    std::pmr::monotonic_buffer_resource attrRunPool{ attrRunSpace.data(), attrRunSpace.size() };
+    std::pmr::vector<TextAttributeRun> attrRuns{ &attrRunPool };
+    attrRuns.reserve(cAttrRunsOnStack);
+    if (insert)
+    {
+        attrRuns.emplace_back(cBlank, fillAttribute);
+    }
+    for (size_t column = keptFrom; column < keptFrom + cKept;)
+    {
+        size_t applies = 0;
+        const auto attr = _attrRow.GetAttrByColumn(column, &applies);
+        const size_t length = std::min(applies, keptFrom + cKept - column);
+        attrRuns.emplace_back(length, attr);
+        column += length;
+    }
+    if (!insert)
+    {
+        attrRuns.emplace_back(cBlank, fillAttribute);
+    }
+
+    // The colors go first, since that's the only step that can fail. Once they're
+    //      down, moving the text can't fail halfway.
+    THROW_IF_FAILED(_attrRow.InsertAttrRuns({ attrRuns.data(), attrRuns.size() }, left, right, _charRow.size()));
+
+    auto& storage = _charRow.GetUnicodeStorage();
+    storage.EraseRange(droppedFrom, droppedFrom + cBlank);
+    storage.ShiftRange(keptFrom, keptFrom + cKept, static_cast<ptrdiff_t>(keptTo) - static_cast<ptrdiff_t>(keptFrom));
+
+    const auto pCells = _charRow.begin();
+    if (insert)
+    {
+        std::copy_backward(pCells + keptFrom, pCells + keptFrom + cKept, pCells + keptTo + cKept);
+    }
+    else
+    {
+        std::copy(pCells + keptFrom, pCells + keptFrom + cKept, pCells + keptTo);
+    }
+    std::fill_n(pCells + blankFrom, cBlank, CharRow::value_type());
+}
@@ -32,7 +32,12 @@ class TextBuffer;
 class ROW final
 {
 public:
-    ROW(const SHORT rowId, const short rowWidth, const TextAttribute fillAttribute, TextBuffer* const pParent);
+    ROW(const SHORT rowId,
+        const short rowWidth,
+        const TextAttribute fillAttribute,
+        TextBuffer* const pParent,
+        CharRow::value_type* const pCells,
+        std::pmr::memory_resource* const pAttrRunPool);
 
     size_t size() const noexcept;
 
@@ -47,7 +52,7 @@ public:
 
     bool Reset(const TextAttribute Attr);
     [[nodiscard]]
-    HRESULT Resize(const size_t width);
+    HRESULT Resize(CharRow::value_type* const pNewCells, const size_t width);
 
     void ClearColumn(const size_t column);
     std::wstring GetText() const;
@@ -55,11 +60,13 @@ public:
     RowCellIterator AsCellIter(const size_t startIndex) const;
     RowCellIterator AsCellIter(const size_t startIndex, const size_t count) const;
 
-    UnicodeStorage& GetUnicodeStorage();
-    const UnicodeStorage& GetUnicodeStorage() const;
+    UnicodeStorage& GetUnicodeStorage() noexcept;
+    const UnicodeStorage& GetUnicodeStorage() const noexcept;
 
     OutputCellIterator WriteCells(OutputCellIterator it, const size_t index, const bool setWrap, std::optional<size_t> limitRight = std::nullopt);
 
+    void ShiftCells(const size_t left, const size_t right, const size_t count, const bool insert, const TextAttribute fillAttribute);
+
     friend bool operator==(const ROW& a, const ROW& b) noexcept;
 
 #ifdef UNIT_TESTING
@@ -4,95 +4,130 @@
 #include "precomp.h"
 #include "UnicodeStorage.hpp"
 
-UnicodeStorage::UnicodeStorage() :
-    _map{}
+UnicodeStorage::UnicodeStorage() noexcept :
+    _glyphs{}
 {
 }
 
 // Routine Description:
 // - fetches the text associated with key
 // Arguments:
-// - key - the key into the storage
+// - key - the column of the glyph
 // Return Value:
-// - the glyph data associated with key
+// - the glyph data associated with key. Only valid until the storage is next modified.
 // Note: will throw exception if key is not stored yet
-const UnicodeStorage::mapped_type& UnicodeStorage::GetText(const key_type key) const
+std::wstring_view UnicodeStorage::GetText(const key_type key) const
 {
-    return _map.at(key);
+    const auto it = _LowerBound(key);
+    THROW_HR_IF(E_INVALIDARG, it == _glyphs.cend() || it->column != key);
+    return it->text;
 }
 
 // Routine Description:
-// - stores glyph data associated with key.
+// - stores glyph data associated with key, replacing anything already stored there.
 // Arguments:
-// - key - the key into the storage
+// - key - the column of the glyph
 // - glyph - the glyph data to store
-void UnicodeStorage::StoreGlyph(const key_type key, const mapped_type& glyph)
+void UnicodeStorage::StoreGlyph(const key_type key, const std::wstring_view glyph)
 {
-    _map.insert_or_assign(key, glyph);
+    // Text is almost always written left to right, so check the end first
+    // to make appending a new column a plain push_back.
+    if (_glyphs.empty() || _glyphs.back().column < key)
+    {
+        _glyphs.push_back({ key, mapped_type{ glyph } });
+        return;
+    }
+
+    const auto it = _glyphs.begin() + (_LowerBound(key) - _glyphs.cbegin());
+    if (it->column == key)
+    {
+        it->text.assign(glyph);
+    }
+    else
+    {
+        _glyphs.insert(it, { key, mapped_type{ glyph } });
+    }
 }
 
 // Routine Description:
 // - erases key and it's associated data from the storage
 // Arguments:
-// - key - the key to remove
+// - key - the column to remove
 void UnicodeStorage::Erase(const key_type key) noexcept
 {
-    _map.erase(key);
+    const auto it = _LowerBound(key);
+    if (it != _glyphs.cend() && it->column == key)
+    {
+        _glyphs.erase(it);
+    }
 }
 
 // Routine Description:
-// - Remaps all of the stored items to new coordinate positions
-//   based on a bulk rearrangement of row IDs and potential row width resize.
+// - erases key and every key after it. Used when the row is made narrower.
 // Arguments:
-// - rowMap - A map of the old row IDs to the new row IDs.
-// - width - The width of the new row. Remove any items that are beyond the row width.
-//         - Use nullopt if we're not resizing the width of the row, just renumbering the rows.
-void UnicodeStorage::Remap(const std::map<SHORT, SHORT>& rowMap, const std::optional<SHORT> width)
+// - key - the first column to remove
+void UnicodeStorage::EraseFrom(const key_type key) noexcept
 {
-    // Make a temporary map to hold all the new row positioning
-    std::unordered_map<key_type, mapped_type> newMap;
-
-    // Walk through every stored item.
-    for (const auto& pair : _map)
-    {
-        // Extract the old coordinate position
-        const auto oldCoord = pair.first;
-
-        // Only try to short-circuit based on width if we were told it changed
-        // by being given a new width value.
-        if (width.has_value())
-        {
-            // Get the column ID
-            const auto oldColId = oldCoord.X;
-
-            // If the column index is at/beyond the row width, don't bother copying it to the new map.
-            if (oldColId >= width.value())
-            {
-                continue;
-            }
-        }
-
-        // Get the row ID from the position as that's what we need to remap
-        const auto oldRowId = oldCoord.Y;
+    _glyphs.erase(_LowerBound(key), _glyphs.cend());
+}
 
-        // Use the mapping given to convert the old row ID to the new row ID
-        const auto mapIter = rowMap.find(oldRowId);
+// Routine Description:
+// - erases every key from first up to, but not including, end.
+// Arguments:
+// - first - the first column to remove
+// - end - the column after the last one to remove
+void UnicodeStorage::EraseRange(const key_type first, const key_type end) noexcept
+{
+    _glyphs.erase(_LowerBound(first), _LowerBound(end));
+}
 
-        // If there's no mapping to a new row, don't bother copying it to the new map. The row is gone.
-        if (mapIter == rowMap.end())
-        {
-            continue;
-        }
+// Routine Description:
+// - moves every key from first up to, but not including, end over by distance.
+//   Used when a row's cells are shifted in place. Nothing may be stored between
+//   the moved keys and where they land, so that the keys stay in order.
+// Arguments:
+// - first - the first column to move
+// - end - the column after the last one to move
+// - distance - how far to move them, negative to move them left
+void UnicodeStorage::ShiftRange(const key_type first, const key_type end, const ptrdiff_t distance) noexcept
+{
+    for (auto it = _glyphs.begin() + (_LowerBound(first) - _glyphs.cbegin()); it != _glyphs.end() && it->column < end; ++it)
+    {
+        it->column = static_cast<key_type>(static_cast<ptrdiff_t>(it->column) + distance);
+    }
+}
 
-        const auto newRowId = mapIter->second;
+// Routine Description:
+// - erases everything from the storage. The capacity is kept for the row's next use.
+void UnicodeStorage::Clear() noexcept
+{
+    _glyphs.clear();
+}
 
-        // Generate a new coordinate with the same X as the old one, but a new Y value.
-        const auto newCoord = COORD{ oldCoord.X, newRowId };
+// Routine Description:
+// - the number of glyphs stored
+size_t UnicodeStorage::size() const noexcept
+{
+    return _glyphs.size();
+}
 
-        // Put the adjusted coordinate into the map with the original value.
-        newMap.emplace(newCoord, pair.second);
-    }
+// Routine Description:
+// - whether no glyphs are stored
+bool UnicodeStorage::empty() const noexcept
+{
+    return _glyphs.empty();
+}
 
-    // Swap into the stored map, free the temporary when we exit.
-    _map.swap(newMap);
+// Routine Description:
+// - finds the first stored glyph at or after key
+// Arguments:
+// - key - the column to search for
+// Return Value:
+// - iterator to the glyph, or the end of the storage if there is none
+std::vector<UnicodeStorage::Glyph>::const_iterator UnicodeStorage::_LowerBound(const key_type key) const noexcept
+{
+    return std::lower_bound(_glyphs.cbegin(),
+                            _glyphs.cend(),
+                            key,
+                            [](const Glyph& glyph, const key_type column) { return glyph.column < column; });
 }
@@ -7,6 +7,9 @@ Module Name:
 
 Abstract:
 - dynamic storage location for glyphs that can't normally fit in the output buffer
+- Each CharRow owns one of these for its own columns. The glyphs are kept in a flat
+  vector sorted by column, so they move with the row when rows are rotated or resized
+  and never have to be re-keyed.
 
 Author(s):
 - Austin Diviness (AustDi) 02-May-2018
@@ -15,54 +18,48 @@ Author(s):
 #pragma once
 
 #include <vector>
-#include <unordered_map>
-#include <climits>
-
-// std::unordered_map needs help to know how to hash a COORD
-namespace std
-{
-    template <>
-    struct hash<COORD>
-    {
-
-        // Routine Description:
-        // - hashes a coord. coord will be hashed by storing the x and y values consecutively in the lower
-        // bits of a size_t.
-        // Arguments:
-        // - coord - the coord to hash
-        // Return Value:
-        // - the hashed coord
-        constexpr size_t operator()(const COORD& coord) const noexcept
-        {
-            size_t retVal = coord.Y;
-            const size_t xCoord = coord.X;
-            retVal |= xCoord << (sizeof(coord.Y) * CHAR_BIT);
-            return retVal;
-        }
-    };
-}
+#include <string>
+#include <string_view>
 
 class UnicodeStorage final
 {
 public:
-    using key_type = typename COORD;
-    using mapped_type = typename std::vector<wchar_t>;
+    using key_type = size_t;
+    using mapped_type = std::wstring;
 
-    UnicodeStorage();
+    UnicodeStorage() noexcept;
 
-    const mapped_type& GetText(const key_type key) const;
+    std::wstring_view GetText(const key_type key) const;
 
-    void StoreGlyph(const key_type key, const mapped_type& glyph);
+    void StoreGlyph(const key_type key, const std::wstring_view glyph);
 
     void Erase(const key_type key) noexcept;
 
-    void Remap(const std::map<SHORT, SHORT>& rowMap, const std::optional<SHORT> width);
+    void EraseFrom(const key_type key) noexcept;
+
+    void EraseRange(const key_type first, const key_type end) noexcept;
+
+    void ShiftRange(const key_type first, const key_type end, const ptrdiff_t distance) noexcept;
+
+    void Clear() noexcept;
+
+    size_t size() const noexcept;
+    bool empty() const noexcept;
 
 private:
-    std::unordered_map<key_type, mapped_type> _map;
+    // A surrogate pair or short combining sequence fits in the string's
+    // small buffer, so storing one costs no allocation beyond the vector slot.
+    struct Glyph
+    {
+        key_type column;
+        mapped_type text;
+    };
+
+    std::vector<Glyph> _glyphs;
+
+    std::vector<Glyph>::const_iterator _LowerBound(const key_type key) const noexcept;
 
 #ifdef UNIT_TESTING
     friend class UnicodeStorageTests;
-    friend class TextBufferTests;
 #endif
 };
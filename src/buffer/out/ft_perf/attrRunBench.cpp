@@ -0,0 +1,175 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "attrRunBench.hpp"
+#include "..\textBuffer.hpp"
+#include "..\..\..\renderer\inc\DummyRenderTarget.hpp"
+
+using namespace Microsoft::Console::Buffer::Perf;
+
+namespace
+{
+    // How many different lines of each kind are made up. The rows of the buffer cycle through them.
+    constexpr size_t s_cLines = 64;
+
+    const TextAttribute s_attrDefault{ FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE };
+    const TextAttribute s_attrDim{ FOREGROUND_INTENSITY };
+    const TextAttribute s_attrRead{ FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_INTENSITY };
+    const TextAttribute s_attrWrite{ FOREGROUND_RED | FOREGROUND_INTENSITY };
+    const TextAttribute s_attrExecute{ FOREGROUND_GREEN | FOREGROUND_INTENSITY };
+    const TextAttribute s_attrDirectory{ FOREGROUND_BLUE | FOREGROUND_INTENSITY };
+    const TextAttribute s_attrLink{ FOREGROUND_GREEN | FOREGROUND_BLUE | FOREGROUND_INTENSITY };
+    const TextAttribute s_attrBold{ FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE | FOREGROUND_INTENSITY };
+    const TextAttribute s_attrError{ FOREGROUND_RED | FOREGROUND_INTENSITY };
+    const TextAttribute s_attrWarning{ FOREGROUND_RED | FOREGROUND_GREEN };
+
+    void _Append(std::vector<OutputCell>& cells, const std::wstring_view text, const TextAttribute attr)
+    {
+        for (const auto& wch : text)
+        {
+            cells.emplace_back(std::wstring_view{ &wch, 1 }, DbcsAttribute{}, attr);
+        }
+    }
+
+    // Routine Description:
+    // - Makes up a row of `ls -la` output, colored the way the fancier listing
+    //      tools do it: every permission bit in its own color, dimmed sizes and
+    //      dates, and the name colored by what kind of file it is.
+    std::vector<OutputCell> _GetListingRow(const size_t index)
+    {
+        std::vector<OutputCell> cells;
+        const bool directory = index % 5 == 0;
+        const bool link = index % 11 == 0;
+        const bool executable = index % 3 == 0;
+
+        _Append(cells, directory ? L"d" : (link ? L"l" : L"-"), directory ? s_attrDirectory : (link ? s_attrLink : s_attrDim));
+        for (size_t i = 0; i < 9; ++i)
+        {
+            const auto bit = index * 7 + i * 13;
+            switch (i % 3)
+            {
+            case 0:
+                _Append(cells, bit % 4 ? L"r" : L"-", bit % 4 ? s_attrRead : s_attrDim);
+                break;
+            case 1:
+                _Append(cells, i == 1 || bit % 3 == 0 ? L"w" : L"-", i == 1 || bit % 3 == 0 ? s_attrWrite : s_attrDim);
+                break;
+            default:
+                _Append(cells, directory || executable ? L"x" : L"-", directory || executable ? s_attrExecute : s_attrDim);
+                break;
+            }
+        }
+
+        _Append(cells, L"  1 ", s_attrDefault);
+        _Append(cells, L"user", s_attrBold);
+        _Append(cells, L" ", s_attrDefault);
+        _Append(cells, L"users", s_attrBold);
+        _Append(cells, L" ", s_attrDefault);
+
+        auto size = std::to_wstring(index * 7919 % 100000);
+        size.insert(0, 8 - size.size(), L' ');
+        _Append(cells, size, s_attrExecute);
+        _Append(cells, L" ", s_attrDefault);
+        _Append(cells, L"Oct " + std::to_wstring(1 + index % 28) + L" 12:" + std::to_wstring(10 + index % 50), s_attrDirectory);
+        _Append(cells, L" ", s_attrDefault);
+
+        const auto name = L"file" + std::to_wstring(index) + (directory ? L"" : L".cpp");
+        _Append(cells, name, directory ? s_attrDirectory : (link ? s_attrLink : (executable ? s_attrExecute : s_attrDefault)));
+        if (link)
+        {
+            _Append(cells, L" -> ", s_attrDefault);
+            _Append(cells, L"..\\shared\\" + name, s_attrDefault);
+        }
+        return cells;
+    }
+
+    // Routine Description:
+    // - Makes up a row of a compiler's output: the location in bold, the kind of
+    //      diagnostic in its color, and the identifiers in the message in bold.
+    std::vector<OutputCell> _GetCompilerRow(const size_t index)
+    {
+        std::vector<OutputCell> cells;
+        const bool error = index % 4 == 0;
+
+        _Append(cells, L"src\\host\\file" + std::to_wstring(index % 97) + L".cpp(" + std::to_wstring(index % 1000) + L",17): ", s_attrBold);
+        _Append(cells, error ? L"error" : L"warning", error ? s_attrError : s_attrWarning);
+        _Append(cells, L" C" + std::to_wstring(error ? 2000 + index % 500 : 4000 + index % 500) + L": ", s_attrDefault);
+        _Append(cells, L"'", s_attrDefault);
+        _Append(cells, L"identifier" + std::to_wstring(index), s_attrBold);
+        _Append(cells, error ? L"': undeclared identifier, did you mean '" : L"': unreferenced formal parameter in '", s_attrDefault);
+        _Append(cells, L"Function" + std::to_wstring(index % 13), s_attrBold);
+        _Append(cells, L"'?", s_attrDefault);
+        return cells;
+    }
+
+    // Routine Description:
+    // - Times writing the given lines over every row of the buffer, both a cell at
+    //      a time and a row at a time. Each row is reset first, the way a scrolled-in
+    //      row is blank before it's written.
+    void _Run(TextBuffer& buffer,
+              const std::wstring_view operation,
+              const std::vector<std::vector<OutputCell>>& lines,
+              const std::chrono::milliseconds durationTarget,
+              std::vector<Measurement>& results)
+    {
+        const auto size = buffer.GetSize();
+        const auto width = gsl::narrow<size_t>(size.Width());
+
+        auto perCell = [&]() {
+            for (SHORT y = 0; y < size.Height(); ++y)
+            {
+                auto& row = buffer.GetRowByOffset(y);
+                const auto& line = lines.at(y % lines.size());
+                THROW_HR_IF(E_UNEXPECTED, !row.Reset(s_attrDefault));
+                for (size_t x = 0; x < std::min(line.size(), width); ++x)
+                {
+                    row.WriteCells(OutputCellIterator({ &line.at(x), 1 }), x, false);
+                }
+            }
+            return gsl::narrow<size_t>(size.Height());
+        };
+        results.push_back(Measure(operation, L"cells", durationTarget, perCell));
+
+        auto perRow = [&]() {
+            for (SHORT y = 0; y < size.Height(); ++y)
+            {
+                auto& row = buffer.GetRowByOffset(y);
+                const auto& line = lines.at(y % lines.size());
+                THROW_HR_IF(E_UNEXPECTED, !row.Reset(s_attrDefault));
+                row.WriteCells(OutputCellIterator({ line.data(), std::min(line.size(), width) }), 0, false);
+            }
+            return gsl::narrow<size_t>(size.Height());
+        };
+        results.push_back(Measure(operation, L"row", durationTarget, perRow));
+    }
+}
+
+// Routine Description:
+// - Times writing colorized directory listings and compiler diagnostics over every
+//   row of a buffer of the given size, one cell at a time and a whole row at a time.
+// Arguments:
+// - bufferSize - the size of the text buffer
+// - durationTarget - minimum time to spend on each measurement
+// Return Value:
+// - a measurement per kind of output and way of writing it, per row
+std::vector<Measurement> Microsoft::Console::Buffer::Perf::RunAttrRunBenchmarks(const COORD bufferSize,
+                                                                                const std::chrono::milliseconds durationTarget)
+{
+    DummyRenderTarget renderTarget;
+    TextBuffer buffer{ bufferSize, s_attrDefault, CURSOR_SMALL_SIZE, renderTarget };
+
+    std::vector<std::vector<OutputCell>> listing;
+    std::vector<std::vector<OutputCell>> compiler;
+    for (size_t i = 0; i < s_cLines; ++i)
+    {
+        listing.push_back(_GetListingRow(i));
+        compiler.push_back(_GetCompilerRow(i));
+    }
+
+    std::vector<Measurement> results;
+    _Run(buffer, L"ls -la", listing, durationTarget, results);
+    _Run(buffer, L"compiler", compiler, durationTarget, results);
+    return results;
+}
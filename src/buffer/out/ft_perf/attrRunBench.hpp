@@ -0,0 +1,22 @@
+/*++
+Copyright (c) Microsoft Corporation.
+Licensed under the MIT license.
+
+Module Name:
+- attrRunBench.hpp
+
+Abstract:
+- Times writing colorized rows, like a directory listing or a compiler's
+  diagnostics, into the text buffer one cell at a time against a whole row
+  at a time.
+--*/
+
+#pragma once
+
+#include "measure.hpp"
+
+namespace Microsoft::Console::Buffer::Perf
+{
+    std::vector<Measurement> RunAttrRunBenchmarks(const COORD bufferSize,
+                                                  const std::chrono::milliseconds durationTarget);
+}
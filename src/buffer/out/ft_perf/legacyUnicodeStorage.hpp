@@ -0,0 +1,88 @@
+/*++
+Copyright (c) Microsoft Corporation.
+Licensed under the MIT license.
+
+Module Name:
+- legacyUnicodeStorage.hpp
+
+Abstract:
+- The buffer-wide glyph storage that UnicodeStorage used to be, kept here
+  only as the baseline for the perf harness. Every glyph is a hash node
+  keyed by its COORD, holding its own vector, and moving rows means
+  re-keying every stored glyph through a row map.
+--*/
+
+#pragma once
+
+#include <climits>
+
+namespace std
+{
+    template<>
+    struct hash<COORD>
+    {
+        constexpr size_t operator()(const COORD& coord) const noexcept
+        {
+            size_t retVal = coord.Y;
+            const size_t xCoord = coord.X;
+            retVal |= xCoord << (sizeof(coord.Y) * CHAR_BIT);
+            return retVal;
+        }
+    };
+}
+
+namespace Microsoft::Console::Buffer::Perf
+{
+    class LegacyUnicodeStorage final
+    {
+    public:
+        using key_type = COORD;
+        using mapped_type = std::vector<wchar_t>;
+
+        const mapped_type& GetText(const key_type key) const
+        {
+            return _map.at(key);
+        }
+
+        void StoreGlyph(const key_type key, const mapped_type& glyph)
+        {
+            _map.insert_or_assign(key, glyph);
+        }
+
+        void Clear() noexcept
+        {
+            _map.clear();
+        }
+
+        size_t size() const noexcept
+        {
+            return _map.size();
+        }
+
+        void Remap(const std::map<SHORT, SHORT>& rowMap, const std::optional<SHORT> width)
+        {
+            std::unordered_map<key_type, mapped_type> newMap;
+            for (const auto& pair : _map)
+            {
+                const auto oldCoord = pair.first;
+                if (width.has_value() && oldCoord.X >= width.value())
+                {
+                    continue;
+                }
+
+                const auto mapIter = rowMap.find(oldCoord.Y);
+                if (mapIter == rowMap.end() && width.has_value())
+                {
+                    continue;
+                }
+
+                const auto newRowId = mapIter == rowMap.end() ? oldCoord.Y : mapIter->second;
+                newMap.emplace(COORD{ oldCoord.X, newRowId }, pair.second);
+            }
+            _map.swap(newMap);
+        }
+
+    private:
+        std::unordered_map<key_type, mapped_type> _map;
+    };
+}
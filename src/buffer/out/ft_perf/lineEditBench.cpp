@@ -0,0 +1,182 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "lineEditBench.hpp"
+#include "..\textBuffer.hpp"
+#include "..\..\..\renderer\inc\DummyRenderTarget.hpp"
+
+using namespace Microsoft::Console::Buffer::Perf;
+using namespace Microsoft::Console::Types;
+
+namespace
+{
+    // How many different lines are made up. The rows of the buffer cycle through them.
+    constexpr size_t s_cLines = 64;
+
+    const TextAttribute s_attrDefault{ FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE };
+    const TextAttribute s_attrFill{ FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE | BACKGROUND_BLUE };
+    const std::array<TextAttribute, 4> s_attrWords{
+        TextAttribute{ FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE },
+        TextAttribute{ FOREGROUND_GREEN | FOREGROUND_INTENSITY },
+        TextAttribute{ FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_INTENSITY },
+        TextAttribute{ FOREGROUND_BLUE | FOREGROUND_INTENSITY }
+    };
+
+    // Routine Description:
+    // - Makes up a row of source code the width of the buffer, the way an editor
+    //      shows it: words of a few letters, each in its syntax color.
+    std::vector<OutputCell> _GetLine(const size_t index, const size_t width)
+    {
+        std::vector<OutputCell> cells;
+        for (size_t word = 0; cells.size() < width; ++word)
+        {
+            const auto attr = s_attrWords.at((index + word) % s_attrWords.size());
+            const auto cch = 2 + (index * 7 + word * 3) % 6;
+            for (size_t i = 0; i < cch && cells.size() < width; ++i)
+            {
+                const wchar_t wch = gsl::narrow_cast<wchar_t>(L'a' + (index + word + i) % 26);
+                cells.emplace_back(std::wstring_view{ &wch, 1 }, DbcsAttribute{}, attr);
+            }
+            if (cells.size() < width)
+            {
+                cells.emplace_back(std::wstring_view{ &UNICODE_SPACE, 1 }, DbcsAttribute{}, s_attrDefault);
+            }
+        }
+        return cells;
+    }
+
+    // Routine Description:
+    // - Picks where on the given row the edit goes and how many cells it covers.
+    //      It always leaves some of the row after it, so that ICH and DCH move
+    //      cells instead of just erasing the rest of the row.
+    std::pair<COORD, size_t> _GetEdit(const SHORT y, const size_t width)
+    {
+        const size_t count = 1 + y % 8;
+        const auto x = gsl::narrow_cast<SHORT>((y * 37) % (width - 2 * count));
+        return { COORD{ x, y }, count };
+    }
+
+    // Routine Description:
+    // - Inserts cells the way ScrollConsoleScreenBuffer did it for ICH: copy each
+    //      cell of the span to its new place a cell at a time, walking from the
+    //      right so nothing is overwritten before it's read, then fill the gap.
+    void _CopyInsert(TextBuffer& buffer, const COORD target, const size_t count, const size_t right)
+    {
+        const size_t left = target.X;
+        for (auto x = right; x >= left + count; --x)
+        {
+            const auto cell = OutputCell(*buffer.GetCellDataAt({ gsl::narrow_cast<SHORT>(x - count), target.Y }));
+            buffer.WriteLine(OutputCellIterator({ &cell, 1 }), { gsl::narrow_cast<SHORT>(x), target.Y });
+        }
+        buffer.WriteLine(OutputCellIterator(UNICODE_SPACE, s_attrFill), target, false, left + count - 1);
+    }
+
+    // Routine Description:
+    // - Deletes cells the way ScrollConsoleScreenBuffer did it for DCH: copy each
+    //      cell after the deleted ones to its new place a cell at a time, walking
+    //      from the left, then fill what they uncovered at the end of the span.
+    void _CopyDelete(TextBuffer& buffer, const COORD target, const size_t count, const size_t right)
+    {
+        const size_t left = target.X;
+        for (auto x = left; x + count <= right; ++x)
+        {
+            const auto cell = OutputCell(*buffer.GetCellDataAt({ gsl::narrow_cast<SHORT>(x + count), target.Y }));
+            buffer.WriteLine(OutputCellIterator({ &cell, 1 }), { gsl::narrow_cast<SHORT>(x), target.Y });
+        }
+        const COORD fill{ gsl::narrow_cast<SHORT>(right - count + 1), target.Y };
+        buffer.WriteLine(OutputCellIterator(UNICODE_SPACE, s_attrFill), fill, false, right);
+    }
+
+    // Routine Description:
+    // - Erases cells the way ECH did it, with FillConsoleOutputCharacter and then
+    //      FillConsoleOutputAttribute over the same cells.
+    void _FillErase(TextBuffer& buffer, const COORD target, const size_t count)
+    {
+        buffer.Write(OutputCellIterator(UNICODE_SPACE, count), target);
+        buffer.Write(OutputCellIterator(s_attrFill, count), target);
+    }
+
+    // Routine Description:
+    // - Times rewriting every row of the buffer and then making one edit to it.
+    //      Rewriting the row first keeps every pass the same amount of work, and
+    //      is timed on its own as the "rewrite" measurement to subtract.
+    // Arguments:
+    // - edit - makes the edit, given the target cell and the count
+    template<typename TEdit>
+    Measurement _Measure(TextBuffer& buffer,
+                         const std::wstring_view operation,
+                         const std::wstring_view store,
+                         const std::vector<std::vector<OutputCell>>& lines,
+                         const std::chrono::milliseconds durationTarget,
+                         TEdit&& edit)
+    {
+        const auto size = buffer.GetSize();
+        const auto width = gsl::narrow<size_t>(size.Width());
+
+        auto pass = [&]() {
+            for (SHORT y = 0; y < size.Height(); ++y)
+            {
+                auto& row = buffer.GetRowByOffset(y);
+                const auto& line = lines.at(y % lines.size());
+                THROW_HR_IF(E_UNEXPECTED, !row.Reset(s_attrDefault));
+                row.WriteCells(OutputCellIterator({ line.data(), line.size() }), 0, false);
+
+                const auto [target, count] = _GetEdit(y, width);
+                edit(target, count);
+            }
+            return gsl::narrow<size_t>(size.Height());
+        };
+        return Measure(operation, store, durationTarget, pass);
+    }
+}
+
+// Routine Description:
+// - Times ICH, DCH and ECH on every row of a buffer of the given size filled with
+//   syntax colored text, with the text buffer's InsertCells, DeleteCells and
+//   EraseCells, and with the cell-by-cell copy and fills they replaced.
+// Arguments:
+// - bufferSize - the size of the text buffer
+// - durationTarget - minimum time to spend on each measurement
+// Return Value:
+// - a measurement per operation and way of doing it, per row
+std::vector<Measurement> Microsoft::Console::Buffer::Perf::RunLineEditBenchmarks(const COORD bufferSize,
+                                                                                 const std::chrono::milliseconds durationTarget)
+{
+    DummyRenderTarget renderTarget;
+    TextBuffer buffer{ bufferSize, s_attrDefault, CURSOR_SMALL_SIZE, renderTarget };
+
+    const auto width = gsl::narrow<size_t>(bufferSize.X);
+    const auto right = width - 1;
+    std::vector<std::vector<OutputCell>> lines;
+    for (size_t i = 0; i < s_cLines; ++i)
+    {
+        lines.push_back(_GetLine(i, width));
+    }
+
+    std::vector<Measurement> results;
+    results.push_back(_Measure(buffer, L"none", L"rewrite", lines, durationTarget, [](const COORD, const size_t) {}));
+
+    results.push_back(_Measure(buffer, L"ICH", L"shift", lines, durationTarget, [&](const COORD target, const size_t count) {
+        buffer.InsertCells(target, count, right, s_attrFill);
+    }));
+    results.push_back(_Measure(buffer, L"ICH", L"copy", lines, durationTarget, [&](const COORD target, const size_t count) {
+        _CopyInsert(buffer, target, count, right);
+    }));
+
+    results.push_back(_Measure(buffer, L"DCH", L"shift", lines, durationTarget, [&](const COORD target, const size_t count) {
+        buffer.DeleteCells(target, count, right, s_attrFill);
+    }));
+    results.push_back(_Measure(buffer, L"DCH", L"copy", lines, durationTarget, [&](const COORD target, const size_t count) {
+        _CopyDelete(buffer, target, count, right);
+    }));
+
+    results.push_back(_Measure(buffer, L"ECH", L"erase", lines, durationTarget, [&](const COORD target, const size_t count) {
+        buffer.EraseCells(Viewport::FromDimensions(target, gsl::narrow<SHORT>(count), 1), s_attrFill);
+    }));
+    results.push_back(_Measure(buffer, L"ECH", L"fill", lines, durationTarget, [&](const COORD target, const size_t count) {
+        _FillErase(buffer, target, count);
+    }));
+    return results;
+}
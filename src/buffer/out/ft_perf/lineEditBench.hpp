@@ -0,0 +1,23 @@
+/*++
+Copyright (c) Microsoft Corporation.
+Licensed under the MIT license.
+
+Module Name:
+- lineEditBench.hpp
+
+Abstract:
+- Times inserting, deleting and erasing cells in the rows of the text buffer
+  (ICH, DCH and ECH) with the buffer's own InsertCells, DeleteCells and
+  EraseCells, against the cell-by-cell copy and separate fills the adapter
+  used to get through ScrollConsoleScreenBuffer and FillConsoleOutput*.
+--*/
+
+#pragma once
+
+#include "measure.hpp"
+
+namespace Microsoft::Console::Buffer::Perf
+{
+    std::vector<Measurement> RunLineEditBenchmarks(const COORD bufferSize,
+                                                   const std::chrono::milliseconds durationTarget);
+}
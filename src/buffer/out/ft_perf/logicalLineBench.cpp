@@ -0,0 +1,160 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "logicalLineBench.hpp"
+#include "..\LogicalLine.hpp"
+#include "..\textBuffer.hpp"
+#include "..\..\..\renderer\inc\DummyRenderTarget.hpp"
+
+using namespace Microsoft::Console::Buffer::Perf;
+
+namespace
+{
+    // Something a build log would be searched for. About one line in forty has a hit.
+    constexpr std::wstring_view s_pattern{ L"error C\\d+: \\w+" };
+
+    // Keeps the reads from being optimized away.
+    volatile size_t s_cSink = 0;
+
+    // Routine Description:
+    // - Makes up a line of a build log. Most fit in a row of a default window, but
+    //      every so often one is long enough to wrap onto a few more.
+    std::wstring _GetLogLine(const size_t index)
+    {
+        std::wstring line = L"  src\\host\\file" + std::to_wstring(index % 97) + L".cpp";
+        if (index % 41 == 0)
+        {
+            line += L"(" + std::to_wstring(index % 1000) + L"): error C" + std::to_wstring(2000 + index % 500) + L": undeclared identifier";
+        }
+
+        const auto cWords = index % 13 == 0 ? 60 : index % 9;
+        for (size_t i = 0; i < cWords; ++i)
+        {
+            line += L" /I" + std::to_wstring(index * 31 + i) + L"\\include";
+        }
+        return line;
+    }
+
+    // Routine Description:
+    // - Writes enough log lines to scroll the buffer past its full height, so the
+    //      rows start partway into the storage the way they do in a busy console.
+    void _FillBuffer(TextBuffer& buffer)
+    {
+        const auto size = buffer.GetSize();
+        const TextAttribute attr{};
+        auto& cursor = buffer.GetCursor();
+
+        const size_t cLines = size.Height() + size.Height() / 4;
+        for (size_t i = 0; i < cLines; ++i)
+        {
+            buffer.WriteStream(_GetLogLine(i), attr);
+
+            auto position = cursor.GetPosition();
+            position.X = 0;
+            if (position.Y == size.BottomInclusive())
+            {
+                THROW_HR_IF(E_OUTOFMEMORY, !buffer.IncrementCircularBuffer());
+            }
+            else
+            {
+                position.Y++;
+            }
+            cursor.SetPosition(position);
+        }
+    }
+
+    // Routine Description:
+    // - Counts the non-empty matches of the expression in the text, the way a search
+    //      walks them, reusing the given match results.
+    size_t _CountMatches(const wchar_t* const begin,
+                         const wchar_t* const end,
+                         const std::wregex& regex,
+                         std::wcmatch& match)
+    {
+        size_t cMatches = 0;
+        auto flags = std::regex_constants::match_not_null;
+        for (auto pos = begin; std::regex_search(pos, end, match, regex, flags); pos = match[0].second)
+        {
+            cMatches++;
+            flags |= std::regex_constants::match_prev_avail;
+        }
+        return cMatches;
+    }
+
+    // Routine Description:
+    // - Reads every logical line of the buffer, reusing one LogicalLine, and hands
+    //      each to the given function.
+    // Return Value:
+    // - the number of rows read
+    template<typename TFunc>
+    size_t _ForEachLine(const TextBuffer& buffer, LogicalLine& line, TFunc&& func)
+    {
+        const auto size = buffer.GetSize();
+        for (SHORT row = 0; row < size.Height(); row = line.GetBottom() + 1)
+        {
+            line.Read(buffer, row);
+            func(line.GetText());
+        }
+        return size.Height();
+    }
+}
+
+// Routine Description:
+// - Fills a buffer of the given size with a build log that has some soft-wrapped
+//   lines, then times reading it a logical line at a time, running a regular
+//   expression over it that way, and running the same expression over the whole
+//   buffer joined into one string.
+// Arguments:
+// - bufferSize - the size of the text buffer
+// - durationTarget - minimum time to spend on each measurement
+// Return Value:
+// - a measurement per operation and way of reading the buffer, per row
+std::vector<Measurement> Microsoft::Console::Buffer::Perf::RunLogicalLineBenchmarks(const COORD bufferSize,
+                                                                                    const std::chrono::milliseconds durationTarget)
+{
+    DummyRenderTarget renderTarget;
+    TextBuffer buffer{ bufferSize, TextAttribute{}, CURSOR_SMALL_SIZE, renderTarget };
+    _FillBuffer(buffer);
+
+    const std::wregex regex{ s_pattern.data(), s_pattern.size(), std::regex_constants::ECMAScript | std::regex_constants::optimize };
+    LogicalLine line;
+    std::wcmatch match;
+    std::vector<Measurement> results;
+
+    auto read = [&]() {
+        size_t cch = 0;
+        const auto cRows = _ForEachLine(buffer, line, [&](const std::wstring_view text) {
+            cch += text.size();
+        });
+        s_cSink = cch;
+        return cRows;
+    };
+    results.push_back(Measure(L"read", L"lines", durationTarget, read));
+
+    auto regexLines = [&]() {
+        size_t cMatches = 0;
+        const auto cRows = _ForEachLine(buffer, line, [&](const std::wstring_view text) {
+            cMatches += _CountMatches(text.data(), text.data() + text.size(), regex, match);
+        });
+        s_cSink = cMatches;
+        return cRows;
+    };
+    results.push_back(Measure(L"regex", L"lines", durationTarget, regexLines));
+
+    // The straightforward way: one string for the whole buffer, a line feed after
+    //      every logical line, and a single pass of the expression over all of it.
+    auto regexJoined = [&]() {
+        std::wstring text;
+        const auto cRows = _ForEachLine(buffer, line, [&](const std::wstring_view lineText) {
+            text.append(lineText);
+            text.push_back(UNICODE_LINEFEED);
+        });
+        s_cSink = _CountMatches(text.data(), text.data() + text.size(), regex, match);
+        return cRows;
+    };
+    results.push_back(Measure(L"regex", L"joined", durationTarget, regexJoined));
+
+    return results;
+}
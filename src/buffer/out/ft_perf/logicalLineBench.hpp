@@ -0,0 +1,22 @@
+/*++
+Copyright (c) Microsoft Corporation.
+Licensed under the MIT license.
+
+Module Name:
+- logicalLineBench.hpp
+
+Abstract:
+- Times reading a full scrollback one logical line at a time, and running a
+  regular expression over it that way, against joining the whole buffer into
+  one string first.
+--*/
+
+#pragma once
+
+#include "measure.hpp"
+
+namespace Microsoft::Console::Buffer::Perf
+{
+    std::vector<Measurement> RunLogicalLineBenchmarks(const COORD bufferSize,
+                                                      const std::chrono::milliseconds durationTarget);
+}
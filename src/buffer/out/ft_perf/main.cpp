@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "unicodeStorageBench.hpp"
+#include "logicalLineBench.hpp"
+#include "attrRunBench.hpp"
+#include "lineEditBench.hpp"
+
+using namespace Microsoft::Console::Buffer::Perf;
+
+namespace
+{
+    constexpr size_t s_cDefaultGlyphsPerRow = 30;
+    constexpr unsigned int s_msDefaultTarget = 1000;
+
+    // The same size as a default conhost window, with the default scrollback.
+    constexpr COORD s_coordBufferSize{ 120, 9001 };
+
+    void _PrintUsage()
+    {
+        wprintf(L"Usage: conbufferout.perf.exe [-t <milliseconds>] [-g <glyphs per row>]\r\n");
+        wprintf(L"Times the text buffer's storage for glyphs that don't fit in a cell, against the old buffer-wide map,\r\n");
+        wprintf(L"reading the buffer a logical line at a time for search, writing colorized rows,\r\n");
+        wprintf(L"and inserting, deleting and erasing cells in a row.\r\n");
+        wprintf(L"Defaults: -t %u -g %zu\r\n", s_msDefaultTarget, s_cDefaultGlyphsPerRow);
+    }
+
+    void _Report(const Measurement& measurement, const std::wstring_view unit)
+    {
+        const auto cOperations = static_cast<double>(measurement.cOperations);
+        const std::wstring unitString{ unit };
+        wprintf(L"%-8s %-8s %10.2f ns/%s %10.3f allocs/%s\r\n",
+                std::wstring{ measurement.operation }.c_str(),
+                std::wstring{ measurement.store }.c_str(),
+                cOperations > 0 ? measurement.seconds * 1e9 / cOperations : 0.0,
+                unitString.c_str(),
+                cOperations > 0 ? measurement.cAllocations / cOperations : 0.0,
+                unitString.c_str());
+    }
+}
+
+int __cdecl wmain(int argc, wchar_t* argv[])
+{
+    unsigned int msTarget = s_msDefaultTarget;
+    size_t cGlyphsPerRow = s_cDefaultGlyphsPerRow;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::wstring_view arg{ argv[i] };
+        if ((arg == L"-t" || arg == L"-g") && i + 1 < argc)
+        {
+            const auto value = _wtoi(argv[++i]);
+            if (value <= 0)
+            {
+                _PrintUsage();
+                return E_INVALIDARG;
+            }
+            if (arg == L"-t")
+            {
+                msTarget = value;
+            }
+            else
+            {
+                cGlyphsPerRow = value;
+            }
+        }
+        else
+        {
+            _PrintUsage();
+            return E_INVALIDARG;
+        }
+    }
+
+    try
+    {
+        wprintf(L"Buffer: %dx%d, %zu glyphs per row, at least %u ms per run\r\n",
+                s_coordBufferSize.X,
+                s_coordBufferSize.Y,
+                std::min<size_t>(cGlyphsPerRow, s_coordBufferSize.X),
+                msTarget);
+        for (const auto& measurement : RunUnicodeStorageBenchmarks(s_coordBufferSize, cGlyphsPerRow, std::chrono::milliseconds(msTarget)))
+        {
+            _Report(measurement, L"glyph");
+        }
+
+        wprintf(L"Logical lines of a build log, regex \"error C\\d+: \\w+\"\r\n");
+        for (const auto& measurement : RunLogicalLineBenchmarks(s_coordBufferSize, std::chrono::milliseconds(msTarget)))
+        {
+            _Report(measurement, L"row");
+        }
+
+        wprintf(L"Colorized rows, written a cell at a time and a row at a time\r\n");
+        for (const auto& measurement : RunAttrRunBenchmarks(s_coordBufferSize, std::chrono::milliseconds(msTarget)))
+        {
+            _Report(measurement, L"row");
+        }
+
+        wprintf(L"ICH, DCH and ECH on a rewritten row, by the text buffer and by copying and filling cells\r\n");
+        for (const auto& measurement : RunLineEditBenchmarks(s_coordBufferSize, std::chrono::milliseconds(msTarget)))
+        {
+            _Report(measurement, L"row");
+        }
+    }
+    CATCH_RETURN();
+
+    return S_OK;
+}
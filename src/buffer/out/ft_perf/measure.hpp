@@ -0,0 +1,58 @@
+/*++
+Copyright (c) Microsoft Corporation.
+Licensed under the MIT license.
+
+Module Name:
+- measure.hpp
+
+Abstract:
+- The measurement every benchmark in the harness reports, and the timing loop
+  that takes it.
+--*/
+
+#pragma once
+
+#include "../../../terminal/parser/ft_perf/allocationCounter.hpp"
+
+namespace Microsoft::Console::Buffer::Perf
+{
+    struct Measurement
+    {
+        std::wstring_view operation;
+        std::wstring_view store;
+        size_t cOperations;
+        double seconds;
+        size_t cAllocations;
+    };
+
+    // Routine Description:
+    // - Runs pass repeatedly for at least durationTarget, after one untimed warm up.
+    // Arguments:
+    // - operation, store - labels for the report
+    // - durationTarget - minimum time to spend running passes
+    // - pass - runs the operation once and returns how many units of work it did
+    // Return Value:
+    // - the totals over all of the timed passes
+    template<typename TPass>
+    Measurement Measure(const std::wstring_view operation,
+                        const std::wstring_view store,
+                        const std::chrono::milliseconds durationTarget,
+                        TPass&& pass)
+    {
+        pass();
+
+        Measurement measurement{ operation, store, 0, 0.0, 0 };
+        const auto cAllocationsBefore = Microsoft::Console::Perf::GetAllocationCount();
+        const auto start = std::chrono::steady_clock::now();
+        auto elapsed = std::chrono::steady_clock::duration::zero();
+        do
+        {
+            measurement.cOperations += pass();
+            elapsed = std::chrono::steady_clock::now() - start;
+        } while (elapsed < durationTarget);
+
+        measurement.seconds = std::chrono::duration<double>(elapsed).count();
+        measurement.cAllocations = Microsoft::Console::Perf::GetAllocationCount() - cAllocationsBefore;
+        return measurement;
+    }
+}
@@ -0,0 +1,160 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "legacyUnicodeStorage.hpp"
+#include "unicodeStorageBench.hpp"
+#include "..\UnicodeStorage.hpp"
+
+using namespace Microsoft::Console::Buffer::Perf;
+
+namespace
+{
+    // Every glyph written is an emoji from the Miscellaneous Symbols and
+    //      Pictographs block, so every one of them is a surrogate pair.
+    constexpr wchar_t s_wchHighSurrogate = 0xD83C;
+    constexpr wchar_t s_wchLowSurrogateFirst = 0xDF00;
+    constexpr size_t s_cLowSurrogates = 0x100;
+
+    // Keeps the reads from being optimized away.
+    volatile size_t s_cchSink = 0;
+
+    // Routine Description:
+    // - Spreads the glyphs of a row evenly across its width.
+    std::vector<SHORT> _GetGlyphColumns(const SHORT width, const size_t cGlyphsPerRow)
+    {
+        std::vector<SHORT> columns;
+        const auto cGlyphs = std::min<size_t>(cGlyphsPerRow, width);
+        for (size_t i = 0; i < cGlyphs; ++i)
+        {
+            columns.push_back(gsl::narrow<SHORT>(i * width / cGlyphs));
+        }
+        return columns;
+    }
+
+    std::array<wchar_t, 2> _GetGlyph(const SHORT x, const SHORT y) noexcept
+    {
+        return { s_wchHighSurrogate, static_cast<wchar_t>(s_wchLowSurrogateFirst + (x + y) % s_cLowSurrogates) };
+    }
+
+    void _RunLegacy(const COORD bufferSize,
+                    const std::vector<SHORT>& columns,
+                    const std::chrono::milliseconds durationTarget,
+                    std::vector<Measurement>& results)
+    {
+        LegacyUnicodeStorage storage;
+
+        auto write = [&]() {
+            storage.Clear();
+            for (SHORT y = 0; y < bufferSize.Y; ++y)
+            {
+                for (const auto x : columns)
+                {
+                    const auto glyph = _GetGlyph(x, y);
+                    storage.StoreGlyph({ x, y }, { glyph.cbegin(), glyph.cend() });
+                }
+            }
+            return storage.size();
+        };
+        results.push_back(Measure(L"write", L"legacy", durationTarget, write));
+
+        auto read = [&]() {
+            size_t cch = 0;
+            for (SHORT y = 0; y < bufferSize.Y; ++y)
+            {
+                for (const auto x : columns)
+                {
+                    cch += storage.GetText({ x, y }).size();
+                }
+            }
+            s_cchSink = cch;
+            return storage.size();
+        };
+        results.push_back(Measure(L"read", L"legacy", durationTarget, read));
+
+        // Scrolling the whole buffer up by one row moves every row, so every
+        //      stored glyph has to be re-keyed.
+        auto remap = [&]() {
+            std::map<SHORT, SHORT> rowMap;
+            for (SHORT y = 0; y < bufferSize.Y; ++y)
+            {
+                rowMap.emplace(y, gsl::narrow<SHORT>((y + bufferSize.Y - 1) % bufferSize.Y));
+            }
+            storage.Remap(rowMap, std::nullopt);
+            return storage.size();
+        };
+        results.push_back(Measure(L"remap", L"legacy", durationTarget, remap));
+    }
+
+    void _RunPerRow(const COORD bufferSize,
+                    const std::vector<SHORT>& columns,
+                    const std::chrono::milliseconds durationTarget,
+                    std::vector<Measurement>& results)
+    {
+        // One storage per row, the same as the text buffer holds them.
+        std::vector<UnicodeStorage> rows(bufferSize.Y);
+
+        auto write = [&]() {
+            size_t cGlyphs = 0;
+            for (SHORT y = 0; y < bufferSize.Y; ++y)
+            {
+                auto& storage = rows.at(y);
+                storage.Clear();
+                for (const auto x : columns)
+                {
+                    const auto glyph = _GetGlyph(x, y);
+                    storage.StoreGlyph(x, { glyph.data(), glyph.size() });
+                }
+                cGlyphs += storage.size();
+            }
+            return cGlyphs;
+        };
+        results.push_back(Measure(L"write", L"row", durationTarget, write));
+
+        auto read = [&]() {
+            size_t cch = 0;
+            for (SHORT y = 0; y < bufferSize.Y; ++y)
+            {
+                const auto& storage = rows.at(y);
+                for (const auto x : columns)
+                {
+                    cch += storage.GetText(x).size();
+                }
+            }
+            s_cchSink = cch;
+            return bufferSize.Y * columns.size();
+        };
+        results.push_back(Measure(L"read", L"row", durationTarget, read));
+
+        // The text buffer moves the rows themselves when it scrolls, and each
+        //      row's glyphs are keyed by column alone, so they just go along.
+        auto remap = [&]() {
+            std::rotate(rows.begin(), rows.begin() + 1, rows.end());
+            return bufferSize.Y * columns.size();
+        };
+        results.push_back(Measure(L"remap", L"row", durationTarget, remap));
+    }
+}
+
+// Routine Description:
+// - Fills a buffer of the given size with glyphs that need out-of-band storage,
+//   then times writing, reading and remapping (scrolling by one row) them with
+//   both the old buffer-wide map and the per-row storage.
+// Arguments:
+// - bufferSize - the size of the simulated text buffer
+// - cGlyphsPerRow - how many cells of each row hold a stored glyph
+// - durationTarget - minimum time to spend on each measurement
+// Return Value:
+// - a measurement per operation and store
+std::vector<Measurement> Microsoft::Console::Buffer::Perf::RunUnicodeStorageBenchmarks(const COORD bufferSize,
+                                                                                       const size_t cGlyphsPerRow,
+                                                                                       const std::chrono::milliseconds durationTarget)
+{
+    const auto columns = _GetGlyphColumns(bufferSize.X, cGlyphsPerRow);
+
+    std::vector<Measurement> results;
+    _RunLegacy(bufferSize, columns, durationTarget, results);
+    _RunPerRow(bufferSize, columns, durationTarget, results);
+    return results;
+}
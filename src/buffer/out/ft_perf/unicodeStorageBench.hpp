@@ -0,0 +1,22 @@
+/*++
+Copyright (c) Microsoft Corporation.
+Licensed under the MIT license.
+
+Module Name:
+- unicodeStorageBench.hpp
+
+Abstract:
+- Times writing, reading and remapping out-of-band glyphs with the per-row
+  UnicodeStorage against the old buffer-wide map.
+--*/
+
+#pragma once
+
+#include "measure.hpp"
+
+namespace Microsoft::Console::Buffer::Perf
+{
+    std::vector<Measurement> RunUnicodeStorageBenchmarks(const COORD bufferSize,
+                                                         const size_t cGlyphsPerRow,
+                                                         const std::chrono::milliseconds durationTarget);
+}
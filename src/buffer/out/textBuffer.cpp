@@ -29,14 +29,21 @@ TextBuffer::TextBuffer(const COORD screenBufferSize,
     _firstRow{ 0 },
     _currentAttributes{ defaultAttributes },
     _cursor{ cursorSize, *this },
+    _cells(static_cast<size_t>(screenBufferSize.X) * static_cast<size_t>(screenBufferSize.Y)),
+    _attrRunPool{},
     _storage{},
-    _unicodeStorage{},
     _renderTarget{ renderTarget }
 {
-    // initialize ROWs
+    // initialize ROWs. Reserve up front so the rows never move (their char rows point back at them).
+    _storage.reserve(screenBufferSize.Y);
     for (size_t i = 0; i < static_cast<size_t>(screenBufferSize.Y); ++i)
     {
-        _storage.emplace_back(static_cast<SHORT>(i), screenBufferSize.X, _currentAttributes, this);
+        _storage.emplace_back(static_cast<SHORT>(i),
+                              screenBufferSize.X,
+                              _currentAttributes,
+                              this,
+                              _cells.data() + i * screenBufferSize.X,
+                              &_attrRunPool);
     }
 }
 
@@ -372,6 +379,195 @@ OutputCellIterator TextBuffer::WriteLine(const OutputCellIterator givenIt,
     return newIt;
 }
 
+// Routine Description:
+// - Inserts blank cells into a row, the way ICH does. The cells from the
+//   target to the right limit move right by count and the ones pushed past
+//   the limit are lost.
+// Arguments:
+// - target - Where to insert the blank cells
+// - count - How many blank cells to insert
+// - limitRight - The last column the cells can move into
+// - fillAttributes - The attributes of the blank cells
+void TextBuffer::InsertCells(const COORD target,
+                             const size_t count,
+                             const size_t limitRight,
+                             const TextAttribute fillAttributes)
+{
+    _ShiftCells(target, count, limitRight, fillAttributes, true);
+}
+
+// Routine Description:
+// - Deletes cells from a row, the way DCH does. The cells after the deleted
+//   ones, up to the right limit, move left by count and blank cells fill in
+//   at the limit.
+// Arguments:
+// - target - The first cell to delete
+// - count - How many cells to delete
+// - limitRight - The last column the blank cells fill in up to
+// - fillAttributes - The attributes of the blank cells
+void TextBuffer::DeleteCells(const COORD target,
+                             const size_t count,
+                             const size_t limitRight,
+                             const TextAttribute fillAttributes)
+{
+    _ShiftCells(target, count, limitRight, fillAttributes, false);
+}
+
+// Routine Description:
+// - Blanks every cell in a region, writing each row once and invalidating the
+//   region once for all of them.
+// Arguments:
+// - region - The cells to blank. It's clipped to the buffer.
+// - fillAttributes - The attributes of the blank cells
+void TextBuffer::EraseCells(const Viewport region,
+                            const TextAttribute fillAttributes)
+{
+    const auto erase = Viewport::Intersect(GetSize(), region);
+    if (!erase.IsValid())
+    {
+        return;
+    }
+
+    const OutputCellIterator fill(UNICODE_SPACE, fillAttributes);
+    for (auto y = erase.Top(); y < erase.BottomExclusive(); y++)
+    {
+        GetRowByOffset(y).WriteCells(fill, erase.Left(), false, erase.RightInclusive());
+    }
+    _NotifyPaint(erase);
+}
+
+// Routine Description:
+// - Moves the cells of a row between the target and the right limit over by
+//   count and blanks the cells they uncover.
+// - The row shifts its cells in place, see ROW::ShiftCells, and the renderer
+//   hears about it once. That includes the cell on either side of the span,
+//   in case a wide glyph there was split and blanked.
+// Arguments:
+// - target - The first cell of the span
+// - count - How far to move the cells
+// - limitRight - The last cell of the span. It's clipped to the buffer.
+// - fillAttributes - The attributes of the blank cells
+// - insert - True to move the cells right and blank the start of the span,
+//   false to move them left and blank the end of it.
+void TextBuffer::_ShiftCells(const COORD target,
+                             const size_t count,
+                             const size_t limitRight,
+                             const TextAttribute fillAttributes,
+                             const bool insert)
+{
+    const auto size = GetSize();
+    if (!size.IsInBounds(target) || count == 0)
+    {
+        return;
+    }
+
+    const size_t left = target.X;
+    const size_t right = std::min(limitRight, gsl::narrow_cast<size_t>(size.RightInclusive()));
+    if (right < left)
+    {
+        return;
+    }
+
+    GetRowByOffset(target.Y).ShiftCells(left, right, count, insert, fillAttributes);
+
+    const SMALL_RECT changed{ std::max(gsl::narrow_cast<SHORT>(target.X - 1), size.Left()),
+                              target.Y,
+                              std::min(gsl::narrow_cast<SHORT>(right + 1), size.RightInclusive()),
+                              target.Y };
+    _NotifyPaint(Viewport::FromInclusive(changed));
+}
+
+// Routine Description:
+// - Writes a run of printable text at the cursor, the way a terminal does:
+//   each row segment is written in one go, text that reaches the right edge
+//   wraps onto the next row, and running off the bottom of the buffer cycles
+//   it. The cursor is left just past the last cell written.
+// - A run that fills the row to the last column leaves the cursor on the last
+//   column with a delayed EOL wrap. The wrap happens when (and only if) the
+//   next write continues at that position. Anything that moves the cursor
+//   (CR, LF, BS, cursor positioning) clears the delay, so a LF after a full
+//   row goes down one row, not two.
+// - Surrogate pairs and wide glyphs are handled by the OutputCellIterator and
+//   ROW::WriteCells. A wide glyph that doesn't fit at the end of a row pads
+//   that row and moves to the next.
+// Arguments:
+// - text - The text to write. It shouldn't contain control characters, the
+//   caller is responsible for handling those.
+// - attr - The attributes to write the text with
+// Return Value:
+// - The number of times the buffer was cycled. Callers can use this to send
+//   one scroll notification for the whole run.
+size_t TextBuffer::WriteStream(const std::wstring_view text,
+                               const TextAttribute attr)
+{
+    auto& cursor = GetCursor();
+    const auto size = GetSize();
+    size_t cCycled = 0;
+
+    auto target = cursor.GetPosition();
+    bool fWrap = cursor.IsDelayedEOLWrap() && cursor.GetDelayedAtPosition() == target;
+
+    OutputCellIterator it{ text, attr };
+    while (it)
+    {
+        // The previous write filled its row, so this one goes on the next.
+        if (fWrap)
+        {
+            GetRowByOffset(target.Y).GetCharRow().SetWrapForced(true);
+            fWrap = false;
+
+            target.X = 0;
+            target.Y++;
+            if (target.Y > size.BottomInclusive())
+            {
+                THROW_HR_IF(E_OUTOFMEMORY, !IncrementCircularBuffer());
+                target.Y = size.BottomInclusive();
+                cCycled++;
+            }
+        }
+
+        auto newIt = WriteLine(it, target, true);
+
+        // A wide glyph can't fit in a one column buffer. Skip it, rather
+        //      than padding row after row forever.
+        if (target.X == 0 && newIt && newIt.GetInputDistance(it) == 0)
+        {
+            ++newIt;
+        }
+
+        // WriteCells only stops short of the end of the text when it runs
+        //      out of row. It may have padded the last cell without advancing
+        //      the iterator (for a wide glyph), so don't rely on the distance.
+        if (newIt)
+        {
+            target.X = size.RightInclusive();
+            fWrap = true;
+        }
+        else
+        {
+            target.X += gsl::narrow<SHORT>(newIt.GetCellDistance(it));
+            if (target.X > size.RightInclusive())
+            {
+                // The text ended exactly at the right edge. The row only
+                //      wraps if more text follows, see above.
+                GetRowByOffset(target.Y).GetCharRow().SetWrapForced(false);
+                target.X = size.RightInclusive();
+                fWrap = true;
+            }
+        }
+
+        cursor.SetPosition(target);
+        it = newIt;
+    }
+
+    if (fWrap)
+    {
+        cursor.DelayEOLWrap(target);
+    }
+
+    return cCycled;
+}
+
 //Routine Description:
 // - Inserts one codepoint into the buffer at the current cursor position and advances the cursor as appropriate.
 //Arguments:
@@ -637,6 +833,17 @@ void TextBuffer::_SetFirstRowIndex(const SHORT FirstRowIndex)
     _firstRow = FirstRowIndex;
 }
 
+// Routine Description:
+// - Moves a run of whole rows up or down within the buffer by rotating the
+//   rows themselves instead of copying their contents.
+// - Rows are addressed by their offset from the first row, so this only
+//   touches the rows being moved and the rows they move over. It costs the
+//   same no matter how large the buffer is or where the circular buffer
+//   currently starts.
+// Arguments:
+// - firstRow - offset of the first row to move
+// - size - number of rows to move
+// - delta - how far to move them. Negative is up, positive is down.
 void TextBuffer::ScrollRows(const SHORT firstRow, const SHORT size, const SHORT delta)
 {
     // If we don't have to move anything, leave early.
@@ -645,19 +852,12 @@ void TextBuffer::ScrollRows(const SHORT firstRow, const SHORT size, const SHORT
         return;
     }
 
-    // OK. We're about to play games by moving rows around within the deque to
-    // scroll a massive region in a faster way than copying things.
-    // To make this easier, first correct the circular buffer to have the first row be 0 again.
-    if (_firstRow != 0)
-    {
-        // Rotate the buffer to put the first row at the front.
-        std::rotate(_storage.begin(), _storage.begin() + _firstRow, _storage.end());
-
-        // The first row is now at the top.
-        _firstRow = 0;
-    }
-
-    // Rotate just the subsection specified
+    // Rotate just the subsection specified.
+    // The rotation is done as three reversals of offset ranges:
+    // reverse [first, middle), reverse [middle, last), then reverse [first, last).
+    size_t first;
+    size_t middle;
+    size_t last;
     if (delta < 0)
     {
         // The layout is like this:
@@ -693,7 +893,9 @@ void TextBuffer::ScrollRows(const SHORT firstRow, const SHORT size, const SHORT
         // | 10
         // | 11
         // - end
-        std::rotate(_storage.begin() + firstRow + delta, _storage.begin() + firstRow, _storage.begin() + firstRow + size);
+        first = firstRow + delta;
+        middle = firstRow;
+        last = firstRow + size;
     }
     else
     {
@@ -730,12 +932,41 @@ void TextBuffer::ScrollRows(const SHORT firstRow, const SHORT size, const SHORT
         // | 10
         // | 11
         // - end
-        std::rotate(_storage.begin() + firstRow, _storage.begin() + firstRow + size, _storage.begin() + firstRow + size + delta);
+        first = firstRow;
+        middle = firstRow + size;
+        last = firstRow + size + delta;
+    }
+
+    _ReverseRows(first, middle);
+    _ReverseRows(middle, last);
+    _ReverseRows(first, last);
+
+    // Row IDs are the position within the storage, so the rows we just shuffled need renumbering.
+    // Their char rows also need to be pointed at their new parents. Stored unicode sequences
+    // are keyed by column within their own row, so they moved along with it.
+    for (auto offset = first; offset < last; ++offset)
+    {
+        auto& row = GetRowByOffset(offset);
+        row.SetId(gsl::narrow<SHORT>((_firstRow + offset) % TotalRowCount()));
+        row.GetCharRow().UpdateParent(&row);
     }
+}
 
-    // Renumber the IDs now that we've rearranged where the rows sit within the buffer.
-    // Refreshing should also delegate to the UnicodeStorage to re-key all the stored unicode sequences (where applicable).
-    _RefreshRowIDs(std::nullopt);
+// Routine Description:
+// - Reverses the order of the rows in the given range of offsets from the first row.
+// - Only the rows are swapped (which just swaps their cell slab pointers, run lists and stored glyphs),
+//   their IDs and parent pointers are left for the caller to fix up.
+// Arguments:
+// - firstOffset - offset of the first row in the range
+// - lastOffset - offset one past the last row in the range
+void TextBuffer::_ReverseRows(size_t firstOffset, size_t lastOffset)
+{
+    while (firstOffset + 1 < lastOffset)
+    {
+        --lastOffset;
+        std::swap(GetRowByOffset(firstOffset), GetRowByOffset(lastOffset));
+        ++firstOffset;
+    }
 }
 
 Cursor& TextBuffer::GetCursor()
@@ -782,7 +1013,7 @@ void TextBuffer::Reset()
 [[nodiscard]]
 NTSTATUS TextBuffer::ResizeTraditional(const COORD newSize) noexcept
 {
-    RETURN_HR_IF(E_INVALIDARG, newSize.X < 0 || newSize.Y < 0);
+    RETURN_HR_IF(E_INVALIDARG, newSize.X <= 0 || newSize.Y <= 0);
 
     const auto currentSize = GetSize().Dimensions();
     const auto attributes = GetCurrentAttributes();
@@ -794,87 +1025,62 @@ NTSTATUS TextBuffer::ResizeTraditional(const COORD newSize) noexcept
     }
     const SHORT TopRowIndex = (GetFirstRowIndex() + TopRow) % currentSize.Y;
 
-    // rotate rows until the top row is at index 0
     try
     {
-        const ROW& newTopRow = _storage[TopRowIndex];
-        while (&newTopRow != &_storage.front())
-        {
-            _storage.push_back(std::move(_storage.front()));
-            _storage.pop_front();
-        }
+        const size_t newWidth = newSize.X;
+        const size_t newHeight = newSize.Y;
 
-        _SetFirstRowIndex(0);
+        const size_t keptRows = std::min(newHeight, _storage.size());
+
+        // Everything that can fail happens first, while _storage is still untouched:
+        // the new slab, room for the new row list, and the blank rows added when growing.
+        std::vector<CharRow::value_type> newCells(newWidth * newHeight);
+        std::vector<ROW> newStorage;
+        newStorage.reserve(newHeight);
 
-        // realloc in the Y direction
-        // remove rows if we're shrinking
-        while (_storage.size() > static_cast<size_t>(newSize.Y))
+        std::vector<ROW> addedRows;
+        addedRows.reserve(newHeight - keptRows);
+        for (size_t i = keptRows; i < newHeight; ++i)
         {
-            _storage.pop_back();
+            addedRows.emplace_back(gsl::narrow<SHORT>(i),
+                                   newSize.X,
+                                   attributes,
+                                   this,
+                                   newCells.data() + i * newWidth,
+                                   &_attrRunPool);
         }
-        // add rows if we're growing
-        while (_storage.size() < static_cast<size_t>(newSize.Y))
+
+        // Nothing below can fail. ROW::Resize only fails for a zero width, which was
+        // rejected above, and the rows are moved into space that was already reserved.
+        // Keep as many of the old rows as fit, starting from the new top row.
+        // Each one is resized into its slice of the new slab and then moved, so the
+        // old rows' cells, run lists and stored glyphs are reused rather than reallocated.
+        // Rows that were trimmed off are destroyed along with their stored glyphs.
+        for (size_t i = 0; i < keptRows; ++i)
         {
-            _storage.emplace_back(static_cast<short>(_storage.size()), newSize.X, attributes, this);
+            auto& row = _storage[(TopRowIndex + i) % _storage.size()];
+            FAIL_FAST_IF_FAILED(row.Resize(newCells.data() + i * newWidth, newWidth));
+
+            auto& newRow = newStorage.emplace_back(std::move(row));
+            newRow.SetId(gsl::narrow_cast<SHORT>(i));
+            newRow.GetCharRow().UpdateParent(&newRow);
         }
 
-        // Now that we've tampered with the row placement, refresh all the row IDs.
-        // Also take advantage of the row ID refresh loop to resize the rows in the X dimension
-        // and cleanup the UnicodeStorage characters that might fall outside the resized buffer.
-        _RefreshRowIDs(newSize.X);
+        for (auto& row : addedRows)
+        {
+            auto& newRow = newStorage.emplace_back(std::move(row));
+            newRow.GetCharRow().UpdateParent(&newRow);
+        }
 
+        _cells.swap(newCells);
+        _storage.swap(newStorage);
+        _SetFirstRowIndex(0);
     }
     CATCH_RETURN();
 
     return S_OK;
 }
 
-const UnicodeStorage& TextBuffer::GetUnicodeStorage() const
-{
-    return _unicodeStorage;
-}
-
-UnicodeStorage& TextBuffer::GetUnicodeStorage()
-{
-    return _unicodeStorage;
-}
-
-// Routine Description:
-// - Method to help refresh all the Row IDs after manipulating the row
-//   by shuffling pointers around.
-// - This will also update parent pointers that are stored in depth within the buffer
-//   (e.g. it will update CharRow parents pointing at Rows that might have been moved around)
-// - Optionally takes a new row width if we're resizing to perform a resize operation and cleanup
-//   any high unicode (UnicodeStorage) runs while we're already looping through the rows.
-// Arguments:
-// - newRowWidth - Optional new value for the row width.
-void TextBuffer::_RefreshRowIDs(std::optional<SHORT> newRowWidth)
-{
-    std::map<SHORT, SHORT> rowMap;
-    SHORT i = 0;
-    for (auto& it : _storage)
-    {
-        // Build a map so we can update Unicode Storage
-        rowMap.emplace(it.GetId(), i);
-
-        // Update the IDs
-        it.SetId(i++);
-
-        // Also update the char row parent pointers as they can get shuffled up in the rotates.
-        it.GetCharRow().UpdateParent(&it);
-
-        // Resize the rows in the X dimension if we have a new width
-        if (newRowWidth.has_value())
-        {
-            // Realloc in the X direction
-            THROW_IF_FAILED(it.Resize(newRowWidth.value()));
-        }
-    }
-
-    // Give the new mapping to Unicode Storage
-    _unicodeStorage.Remap(rowMap, newRowWidth);
-}
-
 void TextBuffer::_NotifyPaint(const Viewport& viewport) const
 {
     _renderTarget.TriggerRedraw(viewport);
@@ -96,6 +96,22 @@ public:
                                  const bool setWrap = false,
                                  const std::optional<size_t> limitRight = std::nullopt);
 
+    size_t WriteStream(const std::wstring_view text,
+                       const TextAttribute attr);
+
+    void InsertCells(const COORD target,
+                     const size_t count,
+                     const size_t limitRight,
+                     const TextAttribute fillAttributes);
+
+    void DeleteCells(const COORD target,
+                     const size_t count,
+                     const size_t limitRight,
+                     const TextAttribute fillAttributes);
+
+    void EraseCells(const Microsoft::Console::Types::Viewport region,
+                    const TextAttribute fillAttributes);
+
     bool InsertCharacter(const wchar_t wch, const DbcsAttribute dbcsAttribute, const TextAttribute attr);
     bool InsertCharacter(const std::wstring_view chars, const DbcsAttribute dbcsAttribute, const TextAttribute attr);
     bool IncrementCursor();
@@ -127,9 +143,6 @@ public:
     [[nodiscard]]
     HRESULT ResizeTraditional(const COORD newSize) noexcept;
 
-    const UnicodeStorage& GetUnicodeStorage() const;
-    UnicodeStorage& GetUnicodeStorage();
-
     Microsoft::Console::Render::IRenderTarget& GetRenderTarget();
 
     class TextAndColor
@@ -148,17 +161,20 @@ public:
 
 private:
 
-    std::deque<ROW> _storage;
+    // Every row's characters live in slices of this one slab and every row's
+    // attribute runs come out of this one pool, so the rows themselves own no
+    // heap blocks. Both must outlive _storage.
+    std::vector<CharRow::value_type> _cells;
+    std::pmr::unsynchronized_pool_resource _attrRunPool;
+
+    std::vector<ROW> _storage;
     Cursor _cursor;
 
     SHORT _firstRow; // indexes top row (not necessarily 0)
 
     TextAttribute _currentAttributes;
 
-    // storage location for glyphs that can't fit into the buffer normally
-    UnicodeStorage _unicodeStorage;
-
-    void _RefreshRowIDs(std::optional<SHORT> newRowWidth);
+    void _ReverseRows(size_t firstOffset, size_t lastOffset);
 
     Microsoft::Console::Render::IRenderTarget& _renderTarget;
 
@@ -171,6 +187,12 @@ private:
 
     void _NotifyPaint(const Microsoft::Console::Types::Viewport& viewport) const;
 
+    void _ShiftCells(const COORD target,
+                     const size_t count,
+                     const size_t limitRight,
+                     const TextAttribute fillAttributes,
+                     const bool insert);
+
     // Assist with maintaining proper buffer state for Double Byte character sequences
     bool _PrepareForDoubleByteSequence(const DbcsAttribute dbcsAttribute);
     bool _AssertValidDoubleByteSequence(const DbcsAttribute dbcsAttribute);
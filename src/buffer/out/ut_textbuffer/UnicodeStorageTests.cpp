@@ -19,34 +19,98 @@ class UnicodeStorageTests
     TEST_METHOD(CanOverwriteEmoji)
     {
         UnicodeStorage storage;
-        const COORD coord{ 1, 3 };
-        const std::vector<wchar_t> newMoon{ 0xD83C, 0xDF11 };
-        const std::vector<wchar_t> fullMoon{ 0xD83C, 0xDF15 };
+        const size_t column = 1;
+        const std::wstring_view newMoon{ L"\xD83C\xDF11" };
+        const std::wstring_view fullMoon{ L"\xD83C\xDF15" };
 
         // store initial glyph
-        storage.StoreGlyph(coord, newMoon);
+        storage.StoreGlyph(column, newMoon);
 
         // verify it was stored
-        auto findIt = storage._map.find(coord);
-        VERIFY_ARE_NOT_EQUAL(findIt, storage._map.end());
-        const std::vector<wchar_t>& newMoonGlyph = findIt->second;
-        VERIFY_ARE_EQUAL(newMoonGlyph.size(), newMoon.size());
-        for (size_t i = 0; i < newMoon.size(); ++i)
-        {
-            VERIFY_ARE_EQUAL(newMoonGlyph.at(i), newMoon.at(i));
-        }
+        VERIFY_ARE_EQUAL(1u, storage.size());
+        VERIFY_IS_TRUE(storage.GetText(column) == newMoon);
 
         // overwrite it
-        storage.StoreGlyph(coord, fullMoon);
+        storage.StoreGlyph(column, fullMoon);
 
         // verify the glyph was overwritten
-        findIt = storage._map.find(coord);
-        VERIFY_ARE_NOT_EQUAL(findIt, storage._map.end());
-        const std::vector<wchar_t>& fullMoonGlyph = findIt->second;
-        VERIFY_ARE_EQUAL(fullMoonGlyph.size(), fullMoon.size());
-        for (size_t i = 0; i < fullMoon.size(); ++i)
+        VERIFY_ARE_EQUAL(1u, storage.size());
+        VERIFY_IS_TRUE(storage.GetText(column) == fullMoon);
+    }
+
+    TEST_METHOD(KeepsGlyphsInColumnOrder)
+    {
+        UnicodeStorage storage;
+        const std::wstring_view glyphs[]{ L"\xD83C\xDF11", L"\xD83C\xDF12", L"\xD83C\xDF13", L"\xD83C\xDF14" };
+
+        // store them out of order, so some have to be inserted in the middle
+        storage.StoreGlyph(6, glyphs[3]);
+        storage.StoreGlyph(0, glyphs[0]);
+        storage.StoreGlyph(4, glyphs[2]);
+        storage.StoreGlyph(2, glyphs[1]);
+
+        VERIFY_ARE_EQUAL(4u, storage.size());
+        for (size_t i = 0; i < storage._glyphs.size(); ++i)
         {
-            VERIFY_ARE_EQUAL(fullMoonGlyph.at(i), fullMoon.at(i));
+            VERIFY_ARE_EQUAL(i * 2, storage._glyphs.at(i).column);
+            VERIFY_IS_TRUE(storage.GetText(i * 2) == glyphs[i]);
         }
+
+        VERIFY_THROWS_SPECIFIC(storage.GetText(1),
+                               wil::ResultException,
+                               [](wil::ResultException& e) { return e.GetErrorCode() == E_INVALIDARG; });
+    }
+
+    TEST_METHOD(CanEraseGlyphs)
+    {
+        UnicodeStorage storage;
+        for (size_t column = 0; column < 8; ++column)
+        {
+            storage.StoreGlyph(column, L"\xD83C\xDF46");
+        }
+
+        // erasing a column that was never stored is fine
+        storage.Erase(10);
+        VERIFY_ARE_EQUAL(8u, storage.size());
+
+        storage.Erase(3);
+        VERIFY_ARE_EQUAL(7u, storage.size());
+        VERIFY_THROWS_SPECIFIC(storage.GetText(3),
+                               wil::ResultException,
+                               [](wil::ResultException& e) { return e.GetErrorCode() == E_INVALIDARG; });
+
+        // trim off everything from column 5 onward, as a resize would
+        storage.EraseFrom(5);
+        VERIFY_ARE_EQUAL(4u, storage.size());
+        VERIFY_IS_TRUE(storage.GetText(4) == L"\xD83C\xDF46");
+
+        storage.Clear();
+        VERIFY_IS_TRUE(storage.empty());
+    }
+
+    TEST_METHOD(CanShiftGlyphs)
+    {
+        UnicodeStorage storage;
+        const std::wstring_view glyphs[]{ L"\xD83C\xDF11", L"\xD83C\xDF12", L"\xD83C\xDF13", L"\xD83C\xDF14" };
+        for (size_t i = 0; i < 4; ++i)
+        {
+            storage.StoreGlyph(i * 2, glyphs[i]);
+        }
+
+        // drop the ones in columns 4 through 7, then move columns 1 through 3 to where they were,
+        //      the way inserting four cells at column 1 of an 8 column row would
+        storage.EraseRange(4, 8);
+        VERIFY_ARE_EQUAL(2u, storage.size());
+        storage.ShiftRange(1, 4, 4);
+        VERIFY_ARE_EQUAL(2u, storage.size());
+        VERIFY_IS_TRUE(storage.GetText(0) == glyphs[0]);
+        VERIFY_IS_TRUE(storage.GetText(6) == glyphs[1]);
+
+        // and back again, the way deleting them would
+        storage.EraseRange(1, 5);
+        storage.ShiftRange(5, 8, -4);
+        VERIFY_ARE_EQUAL(2u, storage.size());
+        VERIFY_IS_TRUE(storage.GetText(0) == glyphs[0]);
+        VERIFY_IS_TRUE(storage.GetText(2) == glyphs[1]);
     }
 };
@@ -163,13 +163,14 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 
             }
             if (dwRead == 0) continue;
-            // Convert buffer to hstring
-            char* pchStr = (char*)(buffer);
-            std::string str{pchStr, dwRead};
-            auto hstr = winrt::to_hstring(str);
+
+            // Decode into the decoder's own (reused) buffer. This will be
+            //      empty if all we got was the start of a multi-byte sequence.
+            const auto decoded = _outputDecoder.Decode({ reinterpret_cast<const char*>(buffer), dwRead });
+            if (decoded.empty()) continue;
 
             // Pass the output to our registered event handlers
-            _outputHandlers(hstr);
+            _outputHandlers(hstring{ decoded.data(), static_cast<hstring::size_type>(decoded.size()) });
         }
     }
 }
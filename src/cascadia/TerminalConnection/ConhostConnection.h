@@ -4,6 +4,7 @@
 #pragma once
 
 #include "ConhostConnection.g.h"
+#include "../../types/inc/Utf8Decoder.hpp"
 
 namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 {
@@ -39,6 +40,11 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         PROCESS_INFORMATION _piConhost;
         bool _closing;
 
+        // Output arrives in arbitrary chunks, which can split a UTF-8
+        //      sequence. The decoder holds on to the partial sequence until
+        //      the rest of it arrives.
+        Utf8Decoder _outputDecoder;
+
         static DWORD StaticOutputThreadProc(LPVOID lpParameter);
         DWORD _OutputThread();
     };
@@ -820,6 +820,21 @@ namespace winrt::Microsoft::Terminal::TerminalControl::implementation
         //      actually fail. We need a way to gracefully fallback.
         _renderer->TriggerFontChange(newDpi, _desiredFont, _actualFont);
 
+        // The widths the renderer gave for ambiguous glyphs were for the old font.
+        NotifyGlyphWidthFontChanged();
+
+        // Ask the new font about the glyphs on screen now, while we hold the
+        //      lock anyway, rather than one glyph at a time in the next frame.
+        //      The first call comes before the terminal has a buffer.
+        if (_initializedTerminal)
+        {
+            const auto viewport = _terminal->GetViewport();
+            const auto& buffer = _terminal->GetTextBuffer();
+            for (auto row = viewport.Top(); row < viewport.BottomExclusive(); ++row)
+            {
+                WarmGlyphWidthCache(buffer.GetRowByOffset(row).GetText());
+            }
+        }
     }
 
     // Method Description:
@@ -9,6 +9,7 @@
 #include "../../inc/DefaultSettings.h"
 #include "../../inc/argb.h"
 #include "../../types/inc/utils.hpp"
+#include "../../renderer/inc/InvalidationBatch.hpp"
 
 #include "winrt/Microsoft.Terminal.Settings.h"
 
@@ -300,33 +301,42 @@ Viewport Terminal::_GetVisibleViewport() const noexcept
 //      in accordance with the written text.
 // This method is our proverbial `WriteCharsLegacy`, and great care should be made to
 //      keep it minimal and orderly, lest it become WriteCharsLegacy2ElectricBoogaloo
-// TODO: MSFT 21006766
-//       This needs to become stream logic on the buffer itself sooner rather than later
-//       because it's otherwise impossible to avoid the Electric Boogaloo-ness here.
-//       I had to make a bunch of hacks to get Japanese and emoji to work-ish.
+// Each run of printable text is handed to the buffer's stream writer in one
+//      go, which takes care of wrapping, wide glyphs and surrogate pairs. We
+//      only step through the control characters ourselves.
+// However many rows the string scrolls, we repaint and notify listeners of the
+//      scroll once, at the end. Likewise the cells and cursor positions it
+//      invalidates are handed to the renderer together once it's done.
 void Terminal::_WriteBuffer(const std::wstring_view& stringView)
 {
+    Microsoft::Console::Render::InvalidationBatch invalidationBatch{ &_buffer->GetRenderTarget() };
     auto& cursor = _buffer->GetCursor();
     const Viewport bufferSize = _buffer->GetSize();
+    bool notifyScroll = false;
 
-    for (size_t i = 0; i < stringView.size(); i++)
+    const auto isControl = [](const wchar_t wch) noexcept {
+        return wch == UNICODE_LINEFEED || wch == UNICODE_CARRIAGERETURN || wch == UNICODE_BACKSPACE;
+    };
+
+    size_t i = 0;
+    while (i < stringView.size())
     {
-        wchar_t wch = stringView[i];
-        const COORD cursorPosBefore = cursor.GetPosition();
-        COORD proposedCursorPosition = cursorPosBefore;
-        bool notifyScroll = false;
+        const wchar_t wch = stringView[i];
 
-        if (wch == UNICODE_LINEFEED)
-        {
-            proposedCursorPosition.Y++;
-        }
-        else if (wch == UNICODE_CARRIAGERETURN)
+        if (isControl(wch))
         {
-            proposedCursorPosition.X = 0;
-        }
-        else if (wch == UNICODE_BACKSPACE)
-        {
-            if (cursorPosBefore.X == 0)
+            const COORD cursorPosBefore = cursor.GetPosition();
+            COORD proposedCursorPosition = cursorPosBefore;
+
+            if (wch == UNICODE_LINEFEED)
+            {
+                proposedCursorPosition.Y++;
+            }
+            else if (wch == UNICODE_CARRIAGERETURN)
+            {
+                proposedCursorPosition.X = 0;
+            }
+            else if (cursorPosBefore.X == 0)
             {
                 proposedCursorPosition.X = bufferSize.Width() - 1;
                 proposedCursorPosition.Y--;
@@ -335,44 +345,40 @@ void Terminal::_WriteBuffer(const std::wstring_view& stringView)
             {
                 proposedCursorPosition.X--;
             }
+
+            // If we're about to scroll past the bottom of the buffer, instead cycle the buffer.
+            const auto newRows = proposedCursorPosition.Y - bufferSize.Height() + 1;
+            if (newRows > 0)
+            {
+                for (auto dy = 0; dy < newRows; dy++)
+                {
+                    _buffer->IncrementCircularBuffer();
+                    proposedCursorPosition.Y--;
+                }
+                notifyScroll = true;
+            }
+
+            // This section is essentially equivalent to `AdjustCursorPosition`
+            // Update Cursor Position
+            cursor.SetPosition(proposedCursorPosition);
+            i++;
         }
         else
         {
-            // TODO: MSFT 21006766
-            // This is not great but I need it demoable. Fix by making a buffer stream writer.
-            if (wch >= 0xD800 && wch <= 0xDFFF)
-            {
-                OutputCellIterator it{ stringView.substr(i, 2) , _buffer->GetCurrentAttributes() };
-                const auto end = _buffer->Write(it);
-                const auto cellDistance = end.GetCellDistance(it);
-                i += cellDistance - 1;
-                proposedCursorPosition.X += gsl::narrow<SHORT>(cellDistance);
-            }
-            else
+            const auto runStart = i;
+            while (i < stringView.size() && !isControl(stringView[i]))
             {
-                OutputCellIterator it{ stringView.substr(i, 1) , _buffer->GetCurrentAttributes() };
-                const auto end = _buffer->Write(it);
-                const auto cellDistance = end.GetCellDistance(it);
-                proposedCursorPosition.X += gsl::narrow<SHORT>(cellDistance);
+                i++;
             }
-        }
 
-        // If we're about to scroll past the bottom of the buffer, instead cycle the buffer.
-        const auto newRows = proposedCursorPosition.Y - bufferSize.Height() + 1;
-        if (newRows > 0)
-        {
-            for(auto dy = 0; dy < newRows; dy++)
+            const auto cRowsCycled = _buffer->WriteStream(stringView.substr(runStart, i - runStart),
+                                                          _buffer->GetCurrentAttributes());
+            if (cRowsCycled > 0)
             {
-                _buffer->IncrementCircularBuffer();
-                proposedCursorPosition.Y--;
+                notifyScroll = true;
             }
-            notifyScroll = true;
         }
 
-        // This section is essentially equivalent to `AdjustCursorPosition`
-        // Update Cursor Position
-        cursor.SetPosition(proposedCursorPosition);
-
         const COORD cursorPosAfter = cursor.GetPosition();
 
         // Move the viewport down if the cursor moved below the viewport.
@@ -385,12 +391,12 @@ void Terminal::_WriteBuffer(const std::wstring_view& stringView)
                 notifyScroll = true;
             }
         }
+    }
 
-        if (notifyScroll)
-        {
-            _buffer->GetRenderTarget().TriggerRedrawAll();
-            _NotifyScrollEvent();
-        }
+    if (notifyScroll)
+    {
+        _buffer->GetRenderTarget().TriggerRedrawAll();
+        _NotifyScrollEvent();
     }
 }
 
@@ -117,6 +117,11 @@ std::vector<Microsoft::Console::Types::Viewport> Terminal::GetSelectionRects() n
     return result;
 }
 
+std::vector<Microsoft::Console::Types::Viewport> Terminal::GetSearchHighlightRects() noexcept
+{
+    return {};
+}
+
 const std::wstring Terminal::GetConsoleTitle() const noexcept
 {
     return _title;
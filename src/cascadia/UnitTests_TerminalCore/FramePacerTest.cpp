@@ -0,0 +1,132 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include <WexTestClass.h>
+
+#include "../renderer/base/FramePacer.hpp"
+#include "consoletaeftemplates.hpp"
+
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Console::Render;
+using namespace std::chrono_literals;
+
+namespace TerminalCoreUnitTests
+{
+    class FramePacerTest
+    {
+        TEST_CLASS(FramePacerTest);
+
+        TEST_METHOD(PaintsRightAwayAfterIdle)
+        {
+            FramePacer pacer{ 8ms, 33ms };
+            const FramePacer::clock::time_point start{};
+
+            VERIFY_IS_TRUE(pacer.GetDelay(start) == 0ms, L"Nothing is pending, so there's nothing to wait for.");
+
+            Log::Comment(L"Paint one frame, then stay quiet for a while.");
+            pacer.NotifyPaint(start);
+            pacer.FrameStarting(start);
+            pacer.FrameCompleted(start + 1ms, true);
+
+            Log::Comment(L"A keystroke long after the last frame is painted without waiting.");
+            const auto keystroke = start + 500ms;
+            pacer.NotifyPaint(keystroke);
+            VERIFY_IS_TRUE(pacer.GetDelay(keystroke) == 0ms);
+
+            pacer.FrameStarting(keystroke);
+            VERIFY_IS_TRUE(pacer.GetDelay(keystroke) == 0ms, L"Starting the frame consumes the pending change.");
+        }
+
+        TEST_METHOD(WaitsOutBudgetWhenChangeFollowsFrame)
+        {
+            FramePacer pacer{ 8ms, 33ms };
+            const FramePacer::clock::time_point start{};
+
+            pacer.NotifyPaint(start);
+            pacer.FrameStarting(start);
+            pacer.FrameCompleted(start, true);
+
+            Log::Comment(L"A change that comes in after the interval is painted right away...");
+            pacer.NotifyPaint(start + 10ms);
+            VERIFY_IS_TRUE(pacer.GetDelay(start + 10ms) == 0ms);
+            pacer.FrameStarting(start + 10ms);
+            pacer.FrameCompleted(start + 12ms, true);
+
+            Log::Comment(L"...but one that comes in right at the end of it is streaming output, and waits out the budget.");
+            pacer.NotifyPaint(start + 15ms);
+            VERIFY_IS_TRUE(pacer.GetDelay(start + 15ms) == 33ms);
+            VERIFY_IS_TRUE(pacer.GetDelay(start + 40ms) == 8ms);
+            VERIFY_IS_TRUE(pacer.GetDelay(start + 60ms) == 0ms, L"Past the budget, never a negative delay.");
+        }
+
+        TEST_METHOD(CoalescesSustainedOutput)
+        {
+            FramePacer pacer{ 8ms, 33ms };
+            const FramePacer::clock::time_point start{};
+
+            pacer.NotifyPaint(start);
+            pacer.FrameStarting(start);
+            pacer.FrameCompleted(start + 2ms, true);
+
+            Log::Comment(L"Output keeps arriving every millisecond while the previous frame is still fresh.");
+            for (auto t = 3ms; t < 30ms; t += 1ms)
+            {
+                pacer.NotifyPaint(start + t);
+            }
+
+            Log::Comment(L"The whole burst is painted as one frame, no later than the budget after the first change.");
+            VERIFY_IS_TRUE(pacer.GetDelay(start + 29ms) == 7ms);
+
+            pacer.FrameStarting(start + 36ms);
+            pacer.FrameCompleted(start + 38ms, true);
+
+            const auto stats = pacer.GetStatistics();
+            VERIFY_ARE_EQUAL(2u, stats.cFramesPainted);
+            VERIFY_ARE_EQUAL(0u, stats.cFramesSkipped);
+            VERIFY_ARE_EQUAL(26u, stats.cNotificationsCoalesced);
+            VERIFY_IS_TRUE(stats.lastLatency == 33ms);
+            VERIFY_IS_TRUE(stats.maxLatency == 33ms);
+            VERIFY_IS_TRUE(stats.totalLatency == 33ms);
+        }
+
+        TEST_METHOD(SkippedFramesDontCountTowardsInterval)
+        {
+            FramePacer pacer{ 8ms, 33ms };
+            const FramePacer::clock::time_point start{};
+
+            pacer.NotifyPaint(start);
+            pacer.FrameStarting(start);
+            pacer.FrameCompleted(start, true);
+
+            Log::Comment(L"A frame that turned out to have nothing dirty isn't counted as painted.");
+            pacer.NotifyPaint(start + 1ms);
+            pacer.FrameStarting(start + 1ms);
+            pacer.FrameCompleted(start + 2ms, false);
+
+            Log::Comment(L"So the next change is measured against the last painted frame, which is long enough ago.");
+            pacer.NotifyPaint(start + 9ms);
+            VERIFY_IS_TRUE(pacer.GetDelay(start + 9ms) == 0ms);
+
+            const auto stats = pacer.GetStatistics();
+            VERIFY_ARE_EQUAL(1u, stats.cFramesPainted);
+            VERIFY_ARE_EQUAL(1u, stats.cFramesSkipped);
+        }
+
+        TEST_METHOD(LatencyBudgetCanBeChanged)
+        {
+            FramePacer pacer{ 8ms, 33ms };
+            const FramePacer::clock::time_point start{};
+
+            pacer.NotifyPaint(start);
+            pacer.FrameStarting(start);
+            pacer.FrameCompleted(start, true);
+
+            pacer.SetLatencyBudget(16ms);
+            pacer.NotifyPaint(start + 4ms);
+            VERIFY_IS_TRUE(pacer.GetDelay(start + 4ms) == 16ms);
+        }
+    };
+}
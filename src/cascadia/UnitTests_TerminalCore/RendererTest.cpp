@@ -0,0 +1,151 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include <WexTestClass.h>
+
+#include "../cascadia/TerminalCore/Terminal.hpp"
+#include "../renderer/base/renderer.hpp"
+#include "../renderer/inc/DummyRenderTarget.hpp"
+#include "consoletaeftemplates.hpp"
+
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Terminal::Core;
+using namespace Microsoft::Console::Render;
+
+namespace
+{
+    // Counts the heap allocations made on this thread, so a test can check
+    //      that a piece of code doesn't make any.
+    thread_local size_t t_cAllocations = 0;
+}
+
+// The array and nothrow forms of new and delete all route through these, so
+//      replacing them is enough to see every allocation in this module.
+void* __cdecl operator new(size_t cb)
+{
+    t_cAllocations++;
+
+    void* const pv = malloc(cb == 0 ? 1 : cb);
+    if (pv == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return pv;
+}
+
+void __cdecl operator delete(void* pv) noexcept
+{
+    free(pv);
+}
+
+void __cdecl operator delete(void* pv, size_t /*cb*/) noexcept
+{
+    free(pv);
+}
+
+namespace TerminalCoreUnitTests
+{
+    // A render engine that considers the whole screen dirty on every frame
+    //      and only counts what it's asked to paint.
+    class CountingRenderEngine final : public IRenderEngine
+    {
+    public:
+        CountingRenderEngine(const COORD size) noexcept :
+            dirty{ 0, 0, size.X - 1, size.Y - 1 }
+        {
+        }
+
+        HRESULT StartPaint() noexcept override { return S_OK; }
+        HRESULT EndPaint() noexcept override { return S_OK; }
+        HRESULT Present() noexcept override { return S_OK; }
+        HRESULT PrepareForTeardown(_Out_ bool* const pForcePaint) noexcept override { *pForcePaint = false; return S_OK; }
+        HRESULT ScrollFrame() noexcept override { return S_OK; }
+        HRESULT Invalidate(const SMALL_RECT* const /*psrRegion*/) noexcept override { return S_OK; }
+        HRESULT InvalidateCursor(const COORD* const /*pcoordCursor*/) noexcept override { return S_OK; }
+        HRESULT InvalidateSystem(const RECT* const /*prcDirtyClient*/) noexcept override { return S_OK; }
+        HRESULT InvalidateSelection(const std::vector<SMALL_RECT>& /*rectangles*/) noexcept override { return S_OK; }
+        HRESULT InvalidateScroll(const COORD* const /*pcoordDelta*/) noexcept override { return S_OK; }
+        HRESULT InvalidateScrollRegion(const SMALL_RECT* const /*psrRegion*/, const COORD* const /*pcoordDelta*/) noexcept override { return S_OK; }
+        HRESULT InvalidateAll() noexcept override { return S_OK; }
+        HRESULT InvalidateCircling(_Out_ bool* const pForcePaint) noexcept override { *pForcePaint = false; return S_OK; }
+        HRESULT InvalidateTitle(const std::wstring& /*proposedTitle*/) noexcept override { return S_OK; }
+        HRESULT PaintBackground() noexcept override { return S_OK; }
+
+        HRESULT PaintBufferLine(std::basic_string_view<Cluster> const clusters,
+                                const COORD /*coord*/,
+                                const bool /*fTrimLeft*/) noexcept override
+        {
+            cRuns++;
+            for (const auto& cluster : clusters)
+            {
+                cColumns += cluster.GetColumns();
+            }
+            return S_OK;
+        }
+
+        HRESULT PaintBufferGridLines(const GridLines /*lines*/, const COLORREF /*color*/, const size_t /*cchLine*/, const COORD /*coordTarget*/) noexcept override { return S_OK; }
+        HRESULT PaintSelection(const SMALL_RECT /*rect*/) noexcept override { return S_OK; }
+        HRESULT PaintCursor(const CursorOptions& /*options*/) noexcept override { return S_OK; }
+        HRESULT UpdateDrawingBrushes(const COLORREF /*colorForeground*/, const COLORREF /*colorBackground*/, const WORD /*legacyColorAttribute*/, const bool /*isBold*/, const bool /*isSettingDefaultBrushes*/) noexcept override { return S_OK; }
+        HRESULT UpdateFont(const FontInfoDesired& /*FontInfoDesired*/, _Out_ FontInfo& /*FontInfo*/) noexcept override { return S_OK; }
+        HRESULT UpdateDpi(const int /*iDpi*/) noexcept override { return S_OK; }
+        HRESULT UpdateViewport(const SMALL_RECT /*srNewViewport*/) noexcept override { return S_OK; }
+        HRESULT GetProposedFont(const FontInfoDesired& /*FontInfoDesired*/, _Out_ FontInfo& /*FontInfo*/, const int /*iDpi*/) noexcept override { return S_OK; }
+        SMALL_RECT GetDirtyRectInChars() override { return dirty; }
+        std::basic_string_view<SMALL_RECT> GetDirtyArea() override { return { &dirty, 1 }; }
+        HRESULT GetFontSize(_Out_ COORD* const pFontSize) noexcept override { *pFontSize = { 1, 1 }; return S_OK; }
+        HRESULT IsGlyphWideByFont(const std::wstring_view /*glyph*/, _Out_ bool* const pResult) noexcept override { *pResult = false; return S_OK; }
+        HRESULT UpdateTitle(const std::wstring& /*newTitle*/) noexcept override { return S_OK; }
+
+        SMALL_RECT dirty;
+        size_t cRuns = 0;
+        size_t cColumns = 0;
+    };
+
+    class RendererTest
+    {
+        TEST_CLASS(RendererTest);
+
+        TEST_METHOD(PaintingFullFrameDoesNotAllocate)
+        {
+            const COORD size{ 200, 60 };
+
+            Terminal term;
+            DummyRenderTarget emptyRT;
+            term.Create(size, 0, emptyRT);
+
+            Log::Comment(L"Fill every row, changing color every 8 columns so that each row is painted as many runs.");
+            Log::Comment(L"The last 8 columns are left blank so that filling the bottom row doesn't scroll.");
+            std::wstring text;
+            for (SHORT row = 0; row < size.Y; row++)
+            {
+                text += L"\x1b[" + std::to_wstring(row + 1) + L";1H";
+                for (SHORT col = 0; col < size.X - 8; col += 8)
+                {
+                    text += L"\x1b[3" + std::to_wstring((row + col / 8) % 8) + L"mabcdefgh";
+                }
+            }
+            term.Write(text);
+
+            CountingRenderEngine engine{ size };
+            IRenderEngine* engines[]{ &engine };
+            Renderer renderer{ &term, engines, ARRAYSIZE(engines), nullptr };
+
+            Log::Comment(L"The first frame is allowed to set up whatever the renderer reuses.");
+            VERIFY_SUCCEEDED(renderer.PaintFrame());
+
+            engine.cRuns = 0;
+            engine.cColumns = 0;
+            const auto cAllocationsBefore = t_cAllocations;
+            VERIFY_SUCCEEDED(renderer.PaintFrame());
+            const auto cAllocations = t_cAllocations - cAllocationsBefore;
+
+            VERIFY_ARE_EQUAL(static_cast<size_t>(size.X * size.Y), engine.cColumns);
+            VERIFY_ARE_EQUAL(static_cast<size_t>(size.Y * (size.X / 8)), engine.cRuns, L"24 colored runs and one blank run per row");
+            VERIFY_ARE_EQUAL(0u, cAllocations, L"Painting a full frame of text shouldn't allocate.");
+        }
+    };
+}
@@ -0,0 +1,89 @@
+﻿// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include <WexTestClass.h>
+
+#include "../cascadia/TerminalCore/Terminal.hpp"
+#include "../renderer/inc/DummyRenderTarget.hpp"
+#include "consoletaeftemplates.hpp"
+
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Terminal::Core;
+using namespace Microsoft::Console::Render;
+
+namespace TerminalCoreUnitTests
+{
+    class TerminalApiTest
+    {
+        TEST_CLASS(TerminalApiTest);
+
+        TEST_METHOD(PrintStringWrapsLongLines)
+        {
+            Terminal term;
+            DummyRenderTarget emptyRT;
+            term.Create({ 10, 5 }, 0, emptyRT);
+
+            term.PrintString(L"0123456789abc");
+
+            const auto& buffer = term.GetTextBuffer();
+            VERIFY_ARE_EQUAL(COORD({ 3, 1 }), buffer.GetCursor().GetPosition());
+            VERIFY_IS_TRUE(buffer.GetRowByOffset(0).GetCharRow().WasWrapForced());
+            VERIFY_IS_TRUE(std::wstring_view{ buffer.GetRowByOffset(1).GetCharRow().GlyphAt(0) } == L"a");
+        }
+
+        TEST_METHOD(PrintStringFullRowThenLinefeed)
+        {
+            Terminal term;
+            DummyRenderTarget emptyRT;
+            term.Create({ 10, 5 }, 0, emptyRT);
+
+            Log::Comment(L"A row filled to the edge keeps the cursor on the last column, so a LF moves down just one row.");
+            term.PrintString(L"0123456789\n");
+
+            const auto& buffer = term.GetTextBuffer();
+            VERIFY_ARE_EQUAL(COORD({ 9, 1 }), buffer.GetCursor().GetPosition());
+            VERIFY_IS_FALSE(buffer.GetRowByOffset(0).GetCharRow().WasWrapForced());
+
+            term.PrintString(L"\rabc");
+
+            VERIFY_ARE_EQUAL(COORD({ 3, 1 }), buffer.GetCursor().GetPosition());
+            VERIFY_IS_TRUE(std::wstring_view{ buffer.GetRowByOffset(1).GetCharRow().GlyphAt(0) } == L"a");
+            VERIFY_IS_TRUE(std::wstring_view{ buffer.GetRowByOffset(2).GetCharRow().GlyphAt(0) } == L" ");
+
+            Log::Comment(L"Without the LF, the text written next continues on the next row.");
+            term.PrintString(L"\r0123456789");
+            term.PrintString(L"xyz");
+
+            VERIFY_ARE_EQUAL(COORD({ 3, 2 }), buffer.GetCursor().GetPosition());
+            VERIFY_IS_TRUE(buffer.GetRowByOffset(1).GetCharRow().WasWrapForced());
+            VERIFY_IS_TRUE(std::wstring_view{ buffer.GetRowByOffset(2).GetCharRow().GlyphAt(0) } == L"x");
+        }
+
+        TEST_METHOD(PrintStringNotifiesScrollOnce)
+        {
+            Terminal term;
+            DummyRenderTarget emptyRT;
+            term.Create({ 10, 5 }, 100, emptyRT);
+
+            size_t cNotifications = 0;
+            term.SetScrollPositionChangedCallback([&](const int, const int, const int) {
+                cNotifications++;
+            });
+
+            Log::Comment(L"Print enough lines to scroll the viewport many times over.");
+            std::wstring text;
+            for (size_t i = 0; i < 50; i++)
+            {
+                text += L"line\r\n";
+            }
+            term.PrintString(text);
+
+            VERIFY_ARE_EQUAL(1u, cNotifications);
+            VERIFY_ARE_EQUAL(COORD({ 0, 50 }), term.GetTextBuffer().GetCursor().GetPosition());
+            VERIFY_ARE_EQUAL(46, term.GetViewport().Top());
+        }
+    };
+}
@@ -10,8 +10,13 @@ ScreenBufferRenderTarget::ScreenBufferRenderTarget(SCREEN_INFORMATION& owner) :
 {
 }
 
+// Method Description:
+// - Text is written through here, so the buffer's search highlight is told which
+//      rows changed before they're drawn, whether or not the buffer is shown.
 void ScreenBufferRenderTarget::TriggerRedraw(const Microsoft::Console::Types::Viewport& region)
 {
+    _UpdateSearchHighlight(region);
+
     auto* pRenderer = ServiceLocator::LocateGlobals().pRender;
     const auto* pActive = &ServiceLocator::LocateGlobals().getConsoleInformation().GetActiveOutputBuffer().GetActiveBuffer();
     if (pRenderer != nullptr && pActive == &_owner)
@@ -22,6 +27,8 @@ void ScreenBufferRenderTarget::TriggerRedraw(const Microsoft::Console::Types::Vi
 
 void ScreenBufferRenderTarget::TriggerRedraw(const COORD* const pcoord)
 {
+    _UpdateSearchHighlight(Microsoft::Console::Types::Viewport::FromCoord(*pcoord));
+
     auto* pRenderer = ServiceLocator::LocateGlobals().pRender;
     const auto* pActive = &ServiceLocator::LocateGlobals().getConsoleInformation().GetActiveOutputBuffer().GetActiveBuffer();
     if (pRenderer != nullptr && pActive == &_owner)
@@ -90,6 +97,21 @@ void ScreenBufferRenderTarget::TriggerScroll(const COORD* const pcoordDelta)
     }
 }
 
+void ScreenBufferRenderTarget::TriggerScrollRegion(const Microsoft::Console::Types::Viewport& region, const COORD* const pcoordDelta)
+{
+    _UpdateSearchHighlight(region);
+
+    auto* pRenderer = ServiceLocator::LocateGlobals().pRender;
+    const auto* pActive = &ServiceLocator::LocateGlobals().getConsoleInformation().GetActiveOutputBuffer().GetActiveBuffer();
+    if (pRenderer != nullptr && pActive == &_owner)
+    {
+        pRenderer->TriggerScrollRegion(region, pcoordDelta);
+    }
+}
+
+// Method Description:
+// - The renderer may paint the buffer as it is before it circles, so the search
+//      highlight is only told about it after that.
 void ScreenBufferRenderTarget::TriggerCircling()
 {
     auto* pRenderer = ServiceLocator::LocateGlobals().pRender;
@@ -98,6 +120,8 @@ void ScreenBufferRenderTarget::TriggerCircling()
     {
         pRenderer->TriggerCircling();
     }
+
+    _owner.CircleSearchHighlight();
 }
 
 void ScreenBufferRenderTarget::TriggerTitleChange()
@@ -109,3 +133,36 @@ void ScreenBufferRenderTarget::TriggerTitleChange()
         pRenderer->TriggerTitleChange();
     }
 }
+
+// Method Description:
+// - Batches are forwarded whether or not this buffer is the active one. The
+//      active buffer can change while a batch is open, and the renderer has
+//      to see every end for the begins it saw.
+void ScreenBufferRenderTarget::BeginInvalidationBatch()
+{
+    auto* pRenderer = ServiceLocator::LocateGlobals().pRender;
+    if (pRenderer != nullptr)
+    {
+        pRenderer->BeginInvalidationBatch();
+    }
+}
+
+void ScreenBufferRenderTarget::EndInvalidationBatch()
+{
+    auto* pRenderer = ServiceLocator::LocateGlobals().pRender;
+    if (pRenderer != nullptr)
+    {
+        pRenderer->EndInvalidationBatch();
+    }
+}
+
+// Method Description:
+// - Finds the highlighted matches in the changed rows again, and repaints the
+//      highlight if there is one.
+void ScreenBufferRenderTarget::_UpdateSearchHighlight(const Microsoft::Console::Types::Viewport& region)
+{
+    if (_owner.UpdateSearchHighlight(region))
+    {
+        TriggerSelection();
+    }
+}
@@ -37,10 +37,15 @@ public:
     void TriggerSelection() override;
     void TriggerScroll() override;
     void TriggerScroll(const COORD* const pcoordDelta) override;
+    void TriggerScrollRegion(const Microsoft::Console::Types::Viewport& region, const COORD* const pcoordDelta) override;
     void TriggerCircling() override;
     void TriggerTitleChange() override;
+    void BeginInvalidationBatch() override;
+    void EndInvalidationBatch() override;
 
 private:
     SCREEN_INFORMATION& _owner;
 
+    void _UpdateSearchHighlight(const Microsoft::Console::Types::Viewport& region);
+
 };
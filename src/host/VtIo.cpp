@@ -156,20 +156,29 @@ HRESULT VtIo::CreateIoHandlers() noexcept
             switch (_IoMode)
             {
             case VtIoMode::XTERM_256:
-                _pVtRenderEngine = std::make_unique<Xterm256Engine>(std::move(_hOutput),
-                                                                    gci,
-                                                                    initialViewport,
-                                                                    gci.GetColorTable(),
-                                                                    static_cast<WORD>(gci.GetColorTableSize()));
+            {
+                auto xterm256Engine = std::make_unique<Xterm256Engine>(std::move(_hOutput),
+                                                                       gci,
+                                                                       initialViewport,
+                                                                       gci.GetColorTable(),
+                                                                       static_cast<WORD>(gci.GetColorTableSize()));
+                // Only write the cells that changed since the last frame.
+                RETURN_IF_FAILED(xterm256Engine->SetShadowBufferEnabled(true));
+                _pVtRenderEngine = std::move(xterm256Engine);
                 break;
+            }
             case VtIoMode::XTERM:
-                _pVtRenderEngine = std::make_unique<XtermEngine>(std::move(_hOutput),
+            {
+                auto xtermEngine = std::make_unique<XtermEngine>(std::move(_hOutput),
                                                                  gci,
                                                                  initialViewport,
                                                                  gci.GetColorTable(),
                                                                  static_cast<WORD>(gci.GetColorTableSize()),
                                                                  false);
+                RETURN_IF_FAILED(xtermEngine->SetShadowBufferEnabled(true));
+                _pVtRenderEngine = std::move(xtermEngine);
                 break;
+            }
             case VtIoMode::XTERM_ASCII:
                 _pVtRenderEngine = std::make_unique<XtermEngine>(std::move(_hOutput),
                                                                  gci,
@@ -19,6 +19,7 @@
 #include "../types/inc/convert.hpp"
 #include "../types/inc/GlyphWidth.hpp"
 #include "../types/inc/Viewport.hpp"
+#include "../renderer/inc/InvalidationBatch.hpp"
 
 #include "..\interactivity\inc\ServiceLocator.hpp"
 
@@ -320,6 +321,12 @@ NTSTATUS WriteCharsLegacy(SCREEN_INFORMATION& screenInfo,
     size_t TempNumSpaces = 0;
     const bool fUnprocessed = WI_IsFlagClear(screenInfo.OutputMode, ENABLE_PROCESSED_OUTPUT);
 
+    // Every cell written and every step of the cursor asks for a redraw. Hold
+    //      them until the whole string is written so the renderer sees one.
+    //      This goes to the renderer rather than the buffer's render target
+    //      because an alternate buffer can be torn down partway through a write.
+    Microsoft::Console::Render::InvalidationBatch invalidationBatch{ ServiceLocator::LocateGlobals().pRender };
+
     // Must not adjust cursor here. It has to stay on for many write scenarios. Consumers should call for the
     // cursor to be turned off if they want that.
 
@@ -981,6 +988,8 @@ NTSTATUS WriteChars(SCREEN_INFORMATION& screenInfo,
                 StateMachine& machine = screenInfo.GetStateMachine();
                 size_t const cch = BufferSize / sizeof(WCHAR);
 
+                // Hold the redraws across the whole string, not just each run of printable text in it.
+                Microsoft::Console::Render::InvalidationBatch invalidationBatch{ ServiceLocator::LocateGlobals().pRender };
                 machine.ProcessString(pwchRealUnicode, cch);
                 *pcb += BufferSize;
             }
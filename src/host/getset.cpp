@@ -1281,6 +1281,26 @@ NTSTATUS DoSrvPrivateSetKeypadMode(_In_ bool fApplicationMode)
     return STATUS_SUCCESS;
 }
 
+// Routine Description:
+// - A private API call for turning bracketed paste mode on or off. While it's
+//     on, text pasted into a client in VT input mode is wrapped in ESC[200~ and
+//     ESC[201~.
+// Parameters:
+// - fEnable - set to true to enable bracketed paste mode, false to disable.
+// Return value:
+// - True if handled successfully. False otherwise.
+[[nodiscard]]
+NTSTATUS DoSrvPrivateEnableBracketedPasteMode(const bool fEnable)
+{
+    CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    if (gci.pInputBuffer == nullptr)
+    {
+        return STATUS_UNSUCCESSFUL;
+    }
+    gci.pInputBuffer->GetTerminalInput().EnableBracketedPasteMode(fEnable);
+    return STATUS_SUCCESS;
+}
+
 // Routine Description:
 // - A private API call for making the cursor visible or not. Does not modify
 //      blinking state.
@@ -2124,6 +2144,139 @@ void DoSrvPrivateInsertLines(const unsigned int count)
     DoSrvPrivateModifyLinesImpl(count, true);
 }
 
+// Routine Description:
+// - A private API call to get only the cursor position and the viewport of the screen buffer.
+// - This is used by the VT adapter for cursor movement and erasing, instead of
+//   GetConsoleScreenBufferInfoEx, which also copies out the color table and works out
+//   the largest window that would fit on the screen.
+// Parameters:
+// - screenInfo - The screen buffer to retrieve the cursor and viewport of
+// - pCursorPosition - Receives the cursor position, relative to the whole buffer
+// - psrViewport - Receives the viewport. Like srWindow from GetConsoleScreenBufferInfoEx,
+//      its right and bottom are one past the last visible column and row.
+void DoSrvPrivateGetCursorAndViewport(const SCREEN_INFORMATION& screenInfo,
+                                      _Out_ COORD* const pCursorPosition,
+                                      _Out_ SMALL_RECT* const psrViewport)
+{
+    const auto& buffer = screenInfo.GetActiveBuffer();
+    *pCursorPosition = buffer.GetTextBuffer().GetCursor().GetPosition();
+    *psrViewport = buffer.GetViewport().ToExclusive();
+}
+
+// Routine Description:
+// - Inserts or deletes characters at the cursor, moving the rest of the
+//      cursor's row up to the right edge of the viewport directly in the text
+//      buffer. The uncovered cells are filled with the current attributes.
+// - This keeps the behavior ICH and DCH had when they went through
+//      ScrollConsoleScreenBuffer: the row doesn't move when scroll margins
+//      are set and the cursor is outside of them, but a count that reaches
+//      the edge of the viewport blanks the rest of the row regardless.
+// Parameters:
+// - screenInfo - The screen buffer to modify
+// - count - The number of characters to insert or delete
+// - insert - True to insert, false to delete
+// Return Value:
+// - S_OK, or a failure code from a thrown exception.
+[[nodiscard]]
+HRESULT DoSrvPrivateModifyCharactersImpl(SCREEN_INFORMATION& screenInfo, const unsigned int count, const bool insert)
+{
+    try
+    {
+        auto& buffer = screenInfo.GetActiveBuffer();
+        auto& textBuffer = buffer.GetTextBuffer();
+        const auto cursorPosition = textBuffer.GetCursor().GetPosition();
+        const auto viewport = buffer.GetViewport();
+
+        const auto remaining = viewport.RightExclusive() - cursorPosition.X;
+        if (remaining <= 0)
+        {
+            return S_OK;
+        }
+
+        const bool eraseRest = count >= gsl::narrow_cast<unsigned int>(remaining);
+        if (!eraseRest && !buffer.GetScrollingRegion().IsInBounds(cursorPosition))
+        {
+            return S_OK;
+        }
+
+        const auto fillAttributes = buffer.GetAttributes();
+        const size_t limitRight = viewport.RightInclusive();
+        if (eraseRest)
+        {
+            const auto rest = Viewport::FromInclusive({ cursorPosition.X, cursorPosition.Y, viewport.RightInclusive(), cursorPosition.Y });
+            textBuffer.EraseCells(rest, fillAttributes);
+        }
+        else if (insert)
+        {
+            textBuffer.InsertCells(cursorPosition, count, limitRight, fillAttributes);
+        }
+        else
+        {
+            textBuffer.DeleteCells(cursorPosition, count, limitRight, fillAttributes);
+        }
+
+        buffer.NotifyAccessibilityEventing(cursorPosition.X, cursorPosition.Y, viewport.RightInclusive(), cursorPosition.Y);
+    }
+    CATCH_RETURN();
+
+    return S_OK;
+}
+
+// Routine Description:
+// - A private API call for inserting blank characters at the cursor (ICH).
+// Parameters:
+// - screenInfo - The screen buffer to insert the characters into
+// - count - the number of characters to insert
+// Return Value:
+// - S_OK, or a failure code from a thrown exception.
+[[nodiscard]]
+HRESULT DoSrvPrivateInsertCharacters(SCREEN_INFORMATION& screenInfo, const unsigned int count)
+{
+    return DoSrvPrivateModifyCharactersImpl(screenInfo, count, true);
+}
+
+// Routine Description:
+// - A private API call for deleting the characters at the cursor (DCH).
+// Parameters:
+// - screenInfo - The screen buffer to delete the characters from
+// - count - the number of characters to delete
+// Return Value:
+// - S_OK, or a failure code from a thrown exception.
+[[nodiscard]]
+HRESULT DoSrvPrivateDeleteCharacters(SCREEN_INFORMATION& screenInfo, const unsigned int count)
+{
+    return DoSrvPrivateModifyCharactersImpl(screenInfo, count, false);
+}
+
+// Routine Description:
+// - A private API call for blanking a region of the screen buffer with the
+//      current attributes, for ED, EL and ECH.
+// - Each row of the region is written once, with both the spaces and their
+//      attributes. Going through FillConsoleOutputCharacter and
+//      FillConsoleOutputAttribute takes two passes over every row instead.
+// Parameters:
+// - screenInfo - The screen buffer to erase from
+// - psrRegion - The cells to erase, inclusive
+// Return Value:
+// - S_OK, or a failure code from a thrown exception.
+[[nodiscard]]
+HRESULT DoSrvPrivateEraseCells(SCREEN_INFORMATION& screenInfo, const SMALL_RECT* const psrRegion)
+{
+    try
+    {
+        auto& buffer = screenInfo.GetActiveBuffer();
+        const auto region = Viewport::Intersect(buffer.GetBufferSize(), Viewport::FromInclusive(*psrRegion));
+        if (region.IsValid())
+        {
+            buffer.GetTextBuffer().EraseCells(region, buffer.GetAttributes());
+            buffer.NotifyAccessibilityEventing(region.Left(), region.Top(), region.RightInclusive(), region.BottomInclusive());
+        }
+    }
+    CATCH_RETURN();
+
+    return S_OK;
+}
+
 // Method Description:
 // - Snaps the screen buffer's viewport to the "virtual bottom", the last place
 //the viewport was before the user scrolled it (with the mouse or scrollbar)
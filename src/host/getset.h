@@ -31,6 +31,8 @@ void DoSrvPrivateSetDefaultAttributes(SCREEN_INFORMATION& screenInfo, const bool
 NTSTATUS DoSrvPrivateSetCursorKeysMode(_In_ bool fApplicationMode);
 [[nodiscard]]
 NTSTATUS DoSrvPrivateSetKeypadMode(_In_ bool fApplicationMode);
+[[nodiscard]]
+NTSTATUS DoSrvPrivateEnableBracketedPasteMode(const bool fEnable);
 
 void DoSrvPrivateShowCursor(SCREEN_INFORMATION& screenInfo, const bool show) noexcept;
 void DoSrvPrivateAllowCursorBlinking(SCREEN_INFORMATION& screenInfo, const bool fEnable);
@@ -95,6 +97,17 @@ void DoSrvPrivateSetDefaultTabStops();
 void DoSrvPrivateDeleteLines(const unsigned int count);
 void DoSrvPrivateInsertLines(const unsigned int count);
 
+void DoSrvPrivateGetCursorAndViewport(const SCREEN_INFORMATION& screenInfo,
+                                      _Out_ COORD* const pCursorPosition,
+                                      _Out_ SMALL_RECT* const psrViewport);
+
+[[nodiscard]]
+HRESULT DoSrvPrivateInsertCharacters(SCREEN_INFORMATION& screenInfo, const unsigned int count);
+[[nodiscard]]
+HRESULT DoSrvPrivateDeleteCharacters(SCREEN_INFORMATION& screenInfo, const unsigned int count);
+[[nodiscard]]
+HRESULT DoSrvPrivateEraseCells(SCREEN_INFORMATION& screenInfo, const SMALL_RECT* const psrRegion);
+
 void DoSrvPrivateMoveToBottom(SCREEN_INFORMATION& screenInfo);
 
 [[nodiscard]]
@@ -6,6 +6,7 @@
 #include "dbcs.h"
 #include "stream.h"
 #include "../types/inc/GlyphWidth.hpp"
+#include "../types/inc/convert.hpp"
 
 #include <functional>
 
@@ -209,11 +210,16 @@ void InputBuffer::Flush()
 // - The console lock must be held when calling this routine.
 void InputBuffer::FlushAllButKeys()
 {
-    auto newEnd = std::remove_if(_storage.begin(), _storage.end(), [](const std::unique_ptr<IInputEvent>& event)
+    size_t keyCount = 0;
+    for (size_t i = 0; i < _storage.size(); ++i)
     {
-        return event->EventType() != InputEventType::KeyEvent;
-    });
-    _storage.erase(newEnd, _storage.end());
+        if (_storage[i].EventType == KEY_EVENT)
+        {
+            _storage[keyCount] = _storage[i];
+            ++keyCount;
+        }
+    }
+    _storage.erase_back(_storage.size() - keyCount);
 }
 
 // Routine Description:
@@ -240,6 +246,54 @@ NTSTATUS InputBuffer::Read(_Out_ std::deque<std::unique_ptr<IInputEvent>>& OutEv
                            const bool WaitForData,
                            const bool Unicode,
                            const bool Stream)
+{
+    try
+    {
+        std::vector<INPUT_RECORD> records;
+        const NTSTATUS Status = Read(records,
+                                     AmountToRead,
+                                     Peek,
+                                     WaitForData,
+                                     Unicode,
+                                     Stream);
+
+        // copy events to outEvents
+        for (const auto& record : records)
+        {
+            OutEvents.push_back(IInputEvent::Create(record));
+        }
+        return Status;
+    }
+    catch (...)
+    {
+        return NTSTATUS_FROM_HRESULT(wil::ResultFromCaughtException());
+    }
+}
+
+// Routine Description:
+// - This routine reads from the input buffer into a flat array of records, without creating an IInputEvent
+//   for each of them.
+// - It behaves like the IInputEvent version of Read otherwise.
+// Note:
+// - The console lock must be held when calling this routine.
+// Arguments:
+// - outRecords - the read records are appended to this
+// - AmountToRead - the amount of events to try to read
+// - Peek - If true, copy events to outRecords but don't remove them from the input buffer.
+// - WaitForData - if true, wait until an event is input (if there aren't enough to fill client buffer). if false, return immediately
+// - Unicode - true if the data in key events should be treated as unicode. false if they should be converted by the current input CP.
+// - Stream - true if read should unpack KeyEvents that have a >1 repeat count. AmountToRead must be 1 if Stream is true.
+// Return Value:
+// - STATUS_SUCCESS if records were read into the client buffer and everything is OK.
+// - CONSOLE_STATUS_WAIT if there weren't enough records to satisfy the request (and waits are allowed)
+// - otherwise a suitable memory/math/string error in NTSTATUS form.
+[[nodiscard]]
+NTSTATUS InputBuffer::Read(_Inout_ std::vector<INPUT_RECORD>& outRecords,
+                           const size_t AmountToRead,
+                           const bool Peek,
+                           const bool WaitForData,
+                           const bool Unicode,
+                           const bool Stream)
 {
     try
     {
@@ -253,10 +307,9 @@ NTSTATUS InputBuffer::Read(_Out_ std::deque<std::unique_ptr<IInputEvent>>& OutEv
         }
 
         // read from buffer
-        std::deque<std::unique_ptr<IInputEvent>> events;
         size_t eventsRead;
         bool resetWaitEvent;
-        _ReadBuffer(events,
+        _ReadBuffer(outRecords,
                     AmountToRead,
                     eventsRead,
                     Peek,
@@ -264,13 +317,6 @@ NTSTATUS InputBuffer::Read(_Out_ std::deque<std::unique_ptr<IInputEvent>>& OutEv
                     Unicode,
                     Stream);
 
-        // copy events to outEvents
-        while (!events.empty())
-        {
-            OutEvents.push_back(std::move(events.front()));
-            events.pop_front();
-        }
-
         if (resetWaitEvent)
         {
             ServiceLocator::LocateGlobals().hInputEvent.ResetEvent();
@@ -309,16 +355,16 @@ NTSTATUS InputBuffer::Read(_Out_ std::unique_ptr<IInputEvent>& outEvent,
     NTSTATUS Status;
     try
     {
-        std::deque<std::unique_ptr<IInputEvent>> outEvents;
-        Status = Read(outEvents,
+        std::vector<INPUT_RECORD> records;
+        Status = Read(records,
                       1,
                       Peek,
                       WaitForData,
                       Unicode,
                       Stream);
-        if (!outEvents.empty())
+        if (!records.empty())
         {
-            outEvent.swap(outEvents.front());
+            outEvent = IInputEvent::Create(records.front());
         }
     }
     catch (...)
@@ -332,7 +378,7 @@ NTSTATUS InputBuffer::Read(_Out_ std::unique_ptr<IInputEvent>& outEvent,
 // Routine Description:
 // - This routine reads from a buffer. It does the buffer manipulation.
 // Arguments:
-// - outEvents - where read events are placed
+// - outRecords - where read records are appended
 // - readCount - amount of events to read
 // - eventsRead - where to store number of events read
 // - peek - if true , don't remove data from buffer, just copy it.
@@ -343,7 +389,7 @@ NTSTATUS InputBuffer::Read(_Out_ std::unique_ptr<IInputEvent>& outEvent,
 // - <none>
 // Note:
 // - The console lock must be held when calling this routine.
-void InputBuffer::_ReadBuffer(_Out_ std::deque<std::unique_ptr<IInputEvent>>& outEvents,
+void InputBuffer::_ReadBuffer(_Inout_ std::vector<INPUT_RECORD>& outRecords,
                               const size_t readCount,
                               _Out_ size_t& eventsRead,
                               const bool peek,
@@ -356,94 +402,66 @@ void InputBuffer::_ReadBuffer(_Out_ std::deque<std::unique_ptr<IInputEvent>>& ou
     FAIL_FAST_IF(streamRead && readCount != 1);
 
     resetWaitEvent = false;
+    eventsRead = 0;
 
-    std::deque<std::unique_ptr<IInputEvent>> readEvents;
-    // we need another var to keep track of how many we've read
-    // because dbcs records count for two when we aren't doing a
-    // unicode read but the eventsRead count should return the number
-    // of events actually put into outRecords.
-    size_t virtualReadCount = 0;
+    // the number of records at the front of storage that were read out whole
+    // and need to be removed unless we're peeking.
+    size_t recordsConsumed = 0;
 
-    while (!_storage.empty() && virtualReadCount < readCount)
+    if (unicode && !streamRead)
     {
-        bool performNormalRead = true;
-        // for stream reads we need to split any key events that have been coalesced
-        if (streamRead)
-        {
-            if (_storage.front()->EventType() == InputEventType::KeyEvent)
-            {
-                KeyEvent* const pKeyEvent = static_cast<KeyEvent* const>(_storage.front().get());
-                if (pKeyEvent->GetRepeatCount() > 1)
-                {
-                    // split the key event
-                    std::unique_ptr<KeyEvent> streamKeyEvent = std::make_unique<KeyEvent>(*pKeyEvent);
-                    streamKeyEvent->SetRepeatCount(1);
-                    readEvents.push_back(std::move(streamKeyEvent));
-                    pKeyEvent->SetRepeatCount(pKeyEvent->GetRepeatCount() - 1);
-                    performNormalRead = false;
-                }
-            }
-        }
-
-        if (performNormalRead)
-        {
-            readEvents.push_back(std::move(_storage.front()));
-            _storage.pop_front();
-        }
+        // every record counts as one and none of them get split,
+        // so they can be copied out all at once.
+        recordsConsumed = std::min(readCount, _storage.size());
+        _storage.copy_to(0, recordsConsumed, outRecords);
+        eventsRead = recordsConsumed;
+    }
+    else
+    {
+        // we need another var to keep track of how many we've read
+        // because dbcs records count for two when we aren't doing a
+        // unicode read but the eventsRead count should return the number
+        // of events actually put into outRecords.
+        size_t virtualReadCount = 0;
 
-        ++virtualReadCount;
-        if (!unicode)
+        while (recordsConsumed < _storage.size() && virtualReadCount < readCount)
         {
-            if (readEvents.back()->EventType() == InputEventType::KeyEvent)
+            INPUT_RECORD& record = _storage[recordsConsumed];
+            outRecords.push_back(record);
+            ++eventsRead;
+
+            // for stream reads we need to split any key events that have been coalesced.
+            // the stored event keeps the rest of the repeat count, unless we're only peeking.
+            if (streamRead &&
+                record.EventType == KEY_EVENT &&
+                record.Event.KeyEvent.wRepeatCount > 1)
             {
-                const KeyEvent* const pKeyEvent = static_cast<const KeyEvent* const>(readEvents.back().get());
-                if (IsGlyphFullWidth(pKeyEvent->GetCharData()))
+                outRecords.back().Event.KeyEvent.wRepeatCount = 1;
+                if (!peek)
                 {
-                    ++virtualReadCount;
+                    record.Event.KeyEvent.wRepeatCount--;
                 }
             }
-        }
-    }
-
-    // the amount of events that were actually read
-    eventsRead = readEvents.size();
-
-    // copy the events back if we were supposed to peek
-    if (peek)
-    {
-        if (streamRead)
-        {
-            // we need to check and see if the event was split from a coalesced key event
-            // or if it was unrelated to the current front event in storage
-            if (!readEvents.empty() &&
-                !_storage.empty() &&
-                readEvents.back()->EventType() == InputEventType::KeyEvent &&
-                _storage.front()->EventType() == InputEventType::KeyEvent &&
-                _CanCoalesce(static_cast<const KeyEvent&>(*readEvents.back()),
-                                static_cast<const KeyEvent&>(*_storage.front())))
-            {
-                KeyEvent& keyEvent = static_cast<KeyEvent&>(*_storage.front());
-                keyEvent.SetRepeatCount(keyEvent.GetRepeatCount() + 1);
-            }
             else
             {
-                _storage.push_front(IInputEvent::Create(readEvents.back()->ToInputRecord()));
+                ++recordsConsumed;
             }
-        }
-        else
-        {
-            for (auto it = readEvents.crbegin(); it != readEvents.crend(); ++it)
+
+            ++virtualReadCount;
+            if (!unicode)
             {
-                _storage.push_front(IInputEvent::Create((*it)->ToInputRecord()));
+                if (record.EventType == KEY_EVENT &&
+                    IsGlyphFullWidth(record.Event.KeyEvent.uChar.UnicodeChar))
+                {
+                    ++virtualReadCount;
+                }
             }
         }
     }
 
-    // move events read to proper deque
-    while (!readEvents.empty())
+    if (!peek)
     {
-        outEvents.push_back(std::move(readEvents.front()));
-        readEvents.pop_front();
+        _storage.erase_front(recordsConsumed);
     }
 
     // signal if we emptied the buffer
@@ -466,8 +484,12 @@ size_t InputBuffer::Prepend(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& in
 {
     try
     {
-        _HandleConsoleSuspensionEvents(inEvents);
-        if (inEvents.empty())
+        const auto inRecords = IInputEvent::ToInputRecords(inEvents);
+        inEvents.clear();
+
+        std::vector<INPUT_RECORD> keptRecords;
+        const auto records = _HandleConsoleSuspensionEvents(inRecords, keptRecords);
+        if (records.empty())
         {
             return STATUS_SUCCESS;
         }
@@ -476,33 +498,34 @@ size_t InputBuffer::Prepend(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& in
         // this way to handle any coalescing that might occur.
 
         // get all of the existing records, "emptying" the buffer
-        std::deque<std::unique_ptr<IInputEvent>> existingStorage;
-        existingStorage.swap(_storage);
+        std::vector<INPUT_RECORD> existingRecords;
+        _storage.copy_to(0, _storage.size(), existingRecords);
+        _storage.clear();
 
         // We will need this variable to pass to _WriteBuffer so it can attempt to determine wait status.
-        // However, because we swapped the storage out from under it with an empty deque, it will always
-        // return true after the first one (as it is filling the newly emptied backing deque.)
+        // However, because we emptied the storage, it will always
+        // return true after the first one (as it is filling the newly emptied storage.)
         // Then after the second one, because we've inserted some input, it will always say false.
         bool unusedWaitStatus = false;
 
         // write the prepend records
         size_t prependEventsWritten;
-        _WriteBuffer(inEvents, prependEventsWritten, unusedWaitStatus);
+        _WriteBuffer(records, prependEventsWritten, unusedWaitStatus);
         FAIL_FAST_IF(!(unusedWaitStatus));
 
         // write all previously existing records
         size_t existingEventsWritten;
-        _WriteBuffer(existingStorage, existingEventsWritten, unusedWaitStatus);
+        _WriteBuffer(existingRecords, existingEventsWritten, unusedWaitStatus);
         FAIL_FAST_IF(!(!unusedWaitStatus));
 
         // We need to set the wait event if there were 0 events in the
         // input queue when we started.
         // Because we did interesting manipulation of the wait queue
         // in order to prepend, we can't trust what _WriteBuffer said
-        // and instead need to set the event if the original backing
-        // buffer (the one we swapped out at the top) was empty
+        // and instead need to set the event if the original storage
+        // (the one we emptied at the top) was empty
         // when this whole thing started.
-        if (existingStorage.empty())
+        if (existingRecords.empty())
         {
             ServiceLocator::LocateGlobals().hInputEvent.SetEvent();
         }
@@ -532,9 +555,9 @@ size_t InputBuffer::Write(_Inout_ std::unique_ptr<IInputEvent> inEvent)
 {
     try
     {
-        std::deque<std::unique_ptr<IInputEvent>> inEvents;
-        inEvents.push_back(std::move(inEvent));
-        return Write(inEvents);
+        const INPUT_RECORD record = inEvent->ToInputRecord();
+        inEvent.reset();
+        return Write(gsl::make_span(&record, 1));
     }
     catch (...)
     {
@@ -556,31 +579,167 @@ size_t InputBuffer::Write(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEv
 {
     try
     {
-        _HandleConsoleSuspensionEvents(inEvents);
-        if (inEvents.empty())
-        {
-            return 0;
-        }
+        const auto inRecords = IInputEvent::ToInputRecords(inEvents);
+        inEvents.clear();
+        return Write(inRecords);
+    }
+    catch (...)
+    {
+        LOG_HR(wil::ResultFromCaughtException());
+        return 0;
+    }
+}
+
+// Routine Description:
+// - Writes records to the input buffer as they are, without creating an
+// IInputEvent for each of them. Wakes up any readers that are waiting for
+// additional input events.
+// Arguments:
+// - inRecords - input records to store in the buffer.
+// Return Value:
+// - The number of events that were written to input buffer.
+// Note:
+// - The console lock must be held when calling this routine.
+// - will throw on failure. Throws E_INVALIDARG, without writing anything,
+// if any of the records has an unknown event type.
+size_t InputBuffer::Write(const gsl::span<const INPUT_RECORD> inRecords)
+{
+    const bool allValid = std::all_of(inRecords.begin(), inRecords.end(), [](const INPUT_RECORD& record) noexcept {
+        return record.EventType == KEY_EVENT ||
+               record.EventType == MOUSE_EVENT ||
+               record.EventType == WINDOW_BUFFER_SIZE_EVENT ||
+               record.EventType == MENU_EVENT ||
+               record.EventType == FOCUS_EVENT;
+    });
+    THROW_HR_IF(E_INVALIDARG, !allValid);
+
+    std::vector<INPUT_RECORD> keptRecords;
+    const auto records = _HandleConsoleSuspensionEvents(inRecords, keptRecords);
+    if (records.empty())
+    {
+        return 0;
+    }
+
+    // Write to buffer.
+    size_t EventsWritten;
+    bool SetWaitEvent;
+    _WriteBuffer(records, EventsWritten, SetWaitEvent);
+
+    if (SetWaitEvent)
+    {
+        ServiceLocator::LocateGlobals().hInputEvent.SetEvent();
+    }
+
+    // Alert any writers waiting for space.
+    WakeUpReadersWaitingForData();
+    return EventsWritten;
+}
+
+// Routine Description:
+// - Writes pasted text to the input buffer as one key down record per
+// character, leaving out the modifier keys and key ups that typing it would
+// add. Clients in VT input mode and cooked reads only look at the key downs.
+// In VT input mode the records carry just the character, the same as the vt
+// input module makes of a typed key, and the text is wrapped in ESC[200~ and
+// ESC[201~ if the client turned on bracketed paste mode, with any ESC in the
+// text itself left out so that it can't end the paste early. Otherwise they carry
+// the key and modifiers that type the character on the current keyboard
+// layout, for readers that go by the key. Wakes up any readers that are
+// waiting for additional input events.
+// Arguments:
+// - text - The text to paste, already filtered for pasting.
+// Return Value:
+// - The number of events that were written to input buffer.
+// Note:
+// - The console lock must be held when calling this routine.
+// - will throw on failure
+size_t InputBuffer::WritePaste(const std::wstring_view text)
+{
+    static constexpr std::wstring_view pasteStart{ L"\x1b[200~" };
+    static constexpr std::wstring_view pasteEnd{ L"\x1b[201~" };
 
-        // Write to buffer.
-        size_t EventsWritten;
-        bool SetWaitEvent;
-        _WriteBuffer(inEvents, EventsWritten, SetWaitEvent);
+    if (text.empty())
+    {
+        return 0;
+    }
 
-        if (SetWaitEvent)
+    const bool vtInputMode = IsInVirtualTerminalInputMode();
+    const bool bracketed = vtInputMode && _termInput.IsBracketedPasteModeEnabled();
+
+    std::vector<INPUT_RECORD> records;
+    records.reserve(text.size() + (bracketed ? pasteStart.size() + pasteEnd.size() : 0));
+
+    // Looking up the key for a character asks the keyboard layout, so the
+    // answers for ASCII, which most pastes are made of, are kept for the rest
+    // of the paste.
+    std::array<INPUT_RECORD, 128> asciiRecords{};
+    const auto appendChars = [&](const std::wstring_view chars) {
+        for (const auto wch : chars)
         {
-            ServiceLocator::LocateGlobals().hInputEvent.SetEvent();
+            if (vtInputMode)
+            {
+                INPUT_RECORD record{};
+                record.EventType = KEY_EVENT;
+                record.Event.KeyEvent.bKeyDown = TRUE;
+                record.Event.KeyEvent.wRepeatCount = 1;
+                record.Event.KeyEvent.uChar.UnicodeChar = wch;
+                records.push_back(record);
+            }
+            else if (wch < asciiRecords.size())
+            {
+                INPUT_RECORD& record = asciiRecords[wch];
+                if (record.EventType != KEY_EVENT)
+                {
+                    record = CharToKeyDownRecord(wch);
+                }
+                records.push_back(record);
+            }
+            else
+            {
+                records.push_back(CharToKeyDownRecord(wch));
+            }
         }
+    };
 
-        // Alert any writers waiting for space.
-        WakeUpReadersWaitingForData();
-        return EventsWritten;
+    if (bracketed)
+    {
+        // A pasted ESC[201~ would close the brackets and have the rest of the
+        // paste taken for typed keys, so no ESC of the text goes in between them.
+        std::wstring unescaped;
+        unescaped.reserve(text.size());
+        std::copy_if(text.cbegin(), text.cend(), std::back_inserter(unescaped), [](const wchar_t wch) noexcept {
+            return wch != L'\x1b';
+        });
+
+        appendChars(pasteStart);
+        appendChars(unescaped);
+        appendChars(pasteEnd);
     }
-    catch (...)
+    else
+    {
+        appendChars(text);
+    }
+
+    std::vector<INPUT_RECORD> keptRecords;
+    const auto kept = _HandleConsoleSuspensionEvents(records, keptRecords);
+    if (kept.empty())
     {
-        LOG_HR(wil::ResultFromCaughtException());
         return 0;
     }
+
+    // In VT input mode these are already the records the vt input module
+    // would have made out of typed keys, and pasted records are never
+    // coalesced, so they skip _WriteBuffer and go in as one piece.
+    const bool wasEmpty = _storage.empty();
+    _storage.append(kept);
+
+    if (wasEmpty)
+    {
+        ServiceLocator::LocateGlobals().hInputEvent.SetEvent();
+    }
+
+    WakeUpReadersWaitingForData();
+    return gsl::narrow<size_t>(kept.size());
 }
 
 // Routine Description:
@@ -595,76 +754,61 @@ size_t InputBuffer::Write(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEv
 // Note:
 // - The console lock must be held when calling this routine.
 // - will throw on failure
-void InputBuffer::_WriteBuffer(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
+void InputBuffer::_WriteBuffer(const gsl::span<const INPUT_RECORD> inRecords,
                                _Out_ size_t& eventsWritten,
                                _Out_ bool& setWaitEvent)
 {
     eventsWritten = 0;
     setWaitEvent = false;
     const bool initiallyEmptyQueue = _storage.empty();
-    const size_t initialInEventsSize = inEvents.size();
     const bool vtInputMode = IsInVirtualTerminalInputMode();
 
-    while(!inEvents.empty())
+    if (!vtInputMode && inRecords.size() > 1)
     {
-        // Pop the next event.
-        // If we're in vt mode, try and handle it with the vt input module.
-        // If it was handled, do nothing else for it.
-        // If there was one event passed in, try coalescing it with the previous event currently in the buffer.
-        // If it's not coalesced, append it to the buffer.
-        std::unique_ptr<IInputEvent> inEvent = std::move(inEvents.front());
-        inEvents.pop_front();
-        if (vtInputMode)
+        // Nothing needs to look at these records one at a time. They aren't
+        // translated by the vt input module, and records are never coalesced
+        // when more than one is written at once. Store them in one piece.
+        _storage.append(inRecords);
+        eventsWritten = gsl::narrow<size_t>(inRecords.size());
+    }
+    else
+    {
+        for (const auto& inRecord : inRecords)
         {
-            const bool handled = _termInput.HandleKey(inEvent.get());
-            if (handled)
+            // If we're in vt mode, try and handle it with the vt input module.
+            // If it was handled, do nothing else for it.
+            // If there was one event passed in, try coalescing it with the previous event currently in the buffer.
+            // If it's not coalesced, append it to the buffer.
+            if (vtInputMode && inRecord.EventType == KEY_EVENT)
             {
-                eventsWritten++;
-                continue;
+                const KeyEvent keyEvent{ inRecord.Event.KeyEvent };
+                const bool handled = _termInput.HandleKey(&keyEvent);
+                if (handled)
+                {
+                    eventsWritten++;
+                    continue;
+                }
             }
-        }
 
-        // we only check for possible coalescing when storing one
-        // record at a time because this is the original behavior of
-        // the input buffer. Changing this behavior may break stuff
-        // that was depending on it.
-        if (initialInEventsSize == 1 && !_storage.empty())
-        {
-            // coalescing requires a deque of events, so push it back onto the front.
-            inEvents.push_front(std::move(inEvent));
-
-            bool coalesced = false;
-            // this looks kinda weird but we don't want to coalesce a
-            // mouse event and then try to coalesce a key event right after.
-            //
-            // we also pass the whole deque to the coalescing methods
-            // even though they only want one event because it should
-            // be their responsibility to maintain the correct state
-            // of the deque if they process any records in it.
-            if (_CoalesceMouseMovedEvents(inEvents))
-            {
-                coalesced = true;
-            }
-            else if (_CoalesceRepeatedKeyPressEvents(inEvents))
-            {
-                coalesced = true;
-            }
-            if (coalesced)
-            {
-                eventsWritten = 1;
-                return;
-            }
-            else
+            // we only check for possible coalescing when storing one
+            // record at a time because this is the original behavior of
+            // the input buffer. Changing this behavior may break stuff
+            // that was depending on it.
+            if (inRecords.size() == 1 && !_storage.empty())
             {
-                // We didn't coalesce the event. pull it from the queue again,
-                //  to keep the state consistent with the start of this block.
-                inEvent = std::move(inEvents.front());
-                inEvents.pop_front();
+                // this looks kinda weird but we don't want to coalesce a
+                // mouse event and then try to coalesce a key event right after.
+                if (_CoalesceMouseMovedEvents(inRecord) ||
+                    _CoalesceRepeatedKeyPressEvents(inRecord))
+                {
+                    eventsWritten = 1;
+                    return;
+                }
             }
+            // At this point, the event was neither coalesced, nor processed by VT.
+            _storage.push_back(inRecord);
+            ++eventsWritten;
         }
-        // At this point, the event was neither coalesced, nor processed by VT.
-        _storage.push_back(std::move(inEvent));
-        ++eventsWritten;
     }
     if (initiallyEmptyQueue && !_storage.empty())
     {
@@ -673,42 +817,34 @@ void InputBuffer::_WriteBuffer(_Inout_ std::deque<std::unique_ptr<IInputEvent>>&
 }
 
 // Routine Description:
-// - Checks if the last saved event and the first event of inRecords are
+// - Checks if the last saved event and the incoming record are
 // both MOUSE_MOVED events. If they are, the last saved event is
-// updated with the new mouse position and the first event of inRecords is
+// updated with the new mouse position and the incoming record is
 // dropped.
 // Arguments:
-// - inRecords - The incoming records to process.
+// - inRecord - The incoming record to process.
 // Return Value:
 // true if events were coalesced, false if they were not.
 // Note:
-// - The size of inRecords must be 1.
 // - Coalescing here means updating a record that already exists in
 // the buffer with updated values from an incoming event, instead of
 // storing the incoming event (which would make the original one
 // redundant/out of date with the most current state).
-bool InputBuffer::_CoalesceMouseMovedEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
+bool InputBuffer::_CoalesceMouseMovedEvents(const INPUT_RECORD& inRecord)
 {
-    FAIL_FAST_IF(!(inEvents.size() == 1));
     FAIL_FAST_IF(_storage.empty());
-    const IInputEvent* const pFirstInEvent = inEvents.front().get();
-    const IInputEvent* const pLastStoredEvent = _storage.back().get();
-    if (pFirstInEvent->EventType() == InputEventType::MouseEvent &&
-        pLastStoredEvent->EventType() == InputEventType::MouseEvent)
+    INPUT_RECORD& lastRecord = _storage.back();
+    if (inRecord.EventType == MOUSE_EVENT &&
+        lastRecord.EventType == MOUSE_EVENT)
     {
-        const MouseEvent* const pInMouseEvent = static_cast<const MouseEvent* const>(pFirstInEvent);
-        const MouseEvent* const pLastMouseEvent = static_cast<const MouseEvent* const>(pLastStoredEvent);
+        const MouseEvent inMouseEvent{ inRecord.Event.MouseEvent };
+        const MouseEvent lastMouseEvent{ lastRecord.Event.MouseEvent };
 
-        if (pInMouseEvent->IsMouseMoveEvent() &&
-            pLastMouseEvent->IsMouseMoveEvent())
+        if (inMouseEvent.IsMouseMoveEvent() &&
+            lastMouseEvent.IsMouseMoveEvent())
         {
             // update mouse moved position
-            MouseEvent* const pMouseEvent = static_cast<MouseEvent* const>(_storage.back().release());
-            pMouseEvent->SetPosition(pInMouseEvent->GetPosition());
-            std::unique_ptr<IInputEvent> tempPtr(pMouseEvent);
-            tempPtr.swap(_storage.back());
-
-            inEvents.pop_front();
+            lastRecord.Event.MouseEvent.dwMousePosition = inMouseEvent.GetPosition();
             return true;
         }
     }
@@ -741,44 +877,36 @@ bool InputBuffer::_CanCoalesce(const KeyEvent& a, const KeyEvent& b) const noexc
 }
 
 // Routine Description::
-// - If the last input event saved and the first input event in inRecords
-// are both a keypress down event for the same key, update the repeat
-// count of the saved event and drop the first from inRecords.
+// - If the last input event saved and the incoming record are both a
+// keypress down event for the same key, update the repeat count of the
+// saved event and drop the incoming record.
 // Arguments:
-// - inRecords - The incoming records to process.
+// - inRecord - The incoming record to process.
 // Return Value:
 // true if events were coalesced, false if they were not.
 // Note:
-// - The size of inRecords must be 1.
 // - Coalescing here means updating a record that already exists in
 // the buffer with updated values from an incoming event, instead of
 // storing the incoming event (which would make the original one
 // redundant/out of date with the most current state).
-bool InputBuffer::_CoalesceRepeatedKeyPressEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
+bool InputBuffer::_CoalesceRepeatedKeyPressEvents(const INPUT_RECORD& inRecord)
 {
-    FAIL_FAST_IF(!(inEvents.size() == 1));
     FAIL_FAST_IF(_storage.empty());
-    const IInputEvent* const pFirstInEvent = inEvents.front().get();
-    const IInputEvent* const pLastStoredEvent = _storage.back().get();
-    if (pFirstInEvent->EventType() == InputEventType::KeyEvent &&
-        pLastStoredEvent->EventType() == InputEventType::KeyEvent)
-    {
-        const KeyEvent* const pInKeyEvent = static_cast<const KeyEvent* const>(pFirstInEvent);
-        const KeyEvent* const pLastKeyEvent = static_cast<const KeyEvent* const>(pLastStoredEvent);
-
-        if (pInKeyEvent->IsKeyDown() &&
-            pLastKeyEvent->IsKeyDown() &&
-            !IsGlyphFullWidth(pInKeyEvent->GetCharData()) &&
-            _CanCoalesce(*pInKeyEvent, *pLastKeyEvent))
+    INPUT_RECORD& lastRecord = _storage.back();
+    if (inRecord.EventType == KEY_EVENT &&
+        lastRecord.EventType == KEY_EVENT)
+    {
+        const KeyEvent inKeyEvent{ inRecord.Event.KeyEvent };
+        const KeyEvent lastKeyEvent{ lastRecord.Event.KeyEvent };
+
+        if (inKeyEvent.IsKeyDown() &&
+            lastKeyEvent.IsKeyDown() &&
+            !IsGlyphFullWidth(inKeyEvent.GetCharData()) &&
+            _CanCoalesce(inKeyEvent, lastKeyEvent))
         {
             // increment repeat count
-            KeyEvent* const pKeyEvent = static_cast<KeyEvent* const>(_storage.back().release());
-            WORD repeatCount = pKeyEvent->GetRepeatCount() + pInKeyEvent->GetRepeatCount();
-            pKeyEvent->SetRepeatCount(repeatCount);
-            std::unique_ptr<IInputEvent> tempPtr(pKeyEvent);
-            tempPtr.swap(_storage.back());
-
-            inEvents.pop_front();
+            WORD repeatCount = lastKeyEvent.GetRepeatCount() + inKeyEvent.GetRepeatCount();
+            lastRecord.Event.KeyEvent.wRepeatCount = repeatCount;
             return true;
         }
     }
@@ -788,42 +916,60 @@ bool InputBuffer::_CoalesceRepeatedKeyPressEvents(_Inout_ std::deque<std::unique
 // Routine Description:
 // - Handles records that suspend/resume the console.
 // Arguments:
-// - records - records to check for pause/unpause events
+// - inRecords - records to check for pause/unpause events
+// - keptRecords - if any records are dropped, the rest are copied into this
 // Return Value:
-// - None
+// - The records that remain to be written. This is inRecords itself unless
+// one of them was dropped.
 // Note:
 // - The console lock must be held when calling this routine.
 // - will throw exception on error
-void InputBuffer::_HandleConsoleSuspensionEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
+gsl::span<const INPUT_RECORD> InputBuffer::_HandleConsoleSuspensionEvents(const gsl::span<const INPUT_RECORD> inRecords,
+                                                                          _Inout_ std::vector<INPUT_RECORD>& keptRecords)
 {
     CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
 
-    std::deque<std::unique_ptr<IInputEvent>> outEvents;
-    while (!inEvents.empty())
+    // most writes don't drop anything, so the records are
+    // only copied once the first one to drop is found.
+    bool dropped = false;
+    for (auto it = inRecords.begin(); it != inRecords.end(); ++it)
     {
-        std::unique_ptr<IInputEvent> currEvent = std::move(inEvents.front());
-        inEvents.pop_front();
-        if (currEvent->EventType() == InputEventType::KeyEvent)
+        bool drop = false;
+        if (it->EventType == KEY_EVENT)
         {
-            const KeyEvent* const pKeyEvent = static_cast<const KeyEvent* const>(currEvent.get());
-            if (pKeyEvent->IsKeyDown())
+            const KeyEvent keyEvent{ it->Event.KeyEvent };
+            if (keyEvent.IsKeyDown())
             {
                 if (WI_IsFlagSet(gci.Flags, CONSOLE_SUSPENDED) &&
-                    !IsSystemKey(pKeyEvent->GetVirtualKeyCode()))
+                    !IsSystemKey(keyEvent.GetVirtualKeyCode()))
                 {
                     UnblockWriteConsole(CONSOLE_OUTPUT_SUSPENDED);
-                    continue;
+                    drop = true;
                 }
-                else if (WI_IsFlagSet(InputMode, ENABLE_LINE_INPUT) && pKeyEvent->IsPauseKey())
+                else if (WI_IsFlagSet(InputMode, ENABLE_LINE_INPUT) && keyEvent.IsPauseKey())
                 {
                     WI_SetFlag(gci.Flags, CONSOLE_SUSPENDED);
-                    continue;
+                    drop = true;
                 }
             }
         }
-        outEvents.push_back(std::move(currEvent));
+
+        if (drop && !dropped)
+        {
+            keptRecords.assign(inRecords.begin(), it);
+            dropped = true;
+        }
+        else if (!drop && dropped)
+        {
+            keptRecords.push_back(*it);
+        }
+    }
+
+    if (dropped)
+    {
+        return keptRecords;
     }
-    inEvents.swap(outEvents);
+    return inRecords;
 }
 
 // Routine Description:
@@ -850,12 +996,11 @@ void InputBuffer::_HandleTerminalInputCallback(std::deque<std::unique_ptr<IInput
     try
     {
         // add all input events to the storage queue
-        while (!inEvents.empty())
+        for (const auto& inEvent : inEvents)
         {
-            std::unique_ptr<IInputEvent> inEvent = std::move(inEvents.front());
-            inEvents.pop_front();
-            _storage.push_back(std::move(inEvent));
+            _storage.push_back(inEvent->ToInputRecord());
         }
+        inEvents.clear();
     }
     catch (...)
     {
@@ -7,6 +7,8 @@ Module Name:
 
 Abstract:
 - storage area for incoming input events.
+- Events are stored by value as INPUT_RECORDs in a ring, so queueing one
+  doesn't allocate. IInputEvents are only created for callers that use them.
 
 Author:
 - Therese Stowell (Thereses) 12-Nov-1990. Adapted from OS/2 subsystem server\srvpipe.c
@@ -21,6 +23,7 @@ Revision History:
 #include "inputReadHandleData.h"
 #include "readData.hpp"
 #include "../types/inc/IInputEvent.hpp"
+#include "../types/inc/InputRecordRing.hpp"
 
 #include "../server/ObjectHandle.h"
 #include "../server/ObjectHeader.h"
@@ -63,6 +66,14 @@ public:
                   const bool Unicode,
                   const bool Stream);
 
+    [[nodiscard]]
+    NTSTATUS Read(_Inout_ std::vector<INPUT_RECORD>& outRecords,
+                  const size_t AmountToRead,
+                  const bool Peek,
+                  const bool WaitForData,
+                  const bool Unicode,
+                  const bool Stream);
+
     [[nodiscard]]
     NTSTATUS Read(_Out_ std::unique_ptr<IInputEvent>& inEvent,
                   const bool Peek,
@@ -75,17 +86,19 @@ public:
 
     size_t Write(_Inout_ std::unique_ptr<IInputEvent> inEvent);
     size_t Write(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
+    size_t Write(const gsl::span<const INPUT_RECORD> inRecords);
+    size_t WritePaste(const std::wstring_view text);
 
     bool IsInVirtualTerminalInputMode() const;
     Microsoft::Console::VirtualTerminal::TerminalInput& GetTerminalInput();
 
 private:
-    std::deque<std::unique_ptr<IInputEvent>> _storage;
+    InputRecordRing _storage;
     std::unique_ptr<IInputEvent> _readPartialByteSequence;
     std::unique_ptr<IInputEvent> _writePartialByteSequence;
     Microsoft::Console::VirtualTerminal::TerminalInput _termInput;
 
-    void _ReadBuffer(_Out_ std::deque<std::unique_ptr<IInputEvent>>& outEvents,
+    void _ReadBuffer(_Inout_ std::vector<INPUT_RECORD>& outRecords,
                      const size_t readCount,
                      _Out_ size_t& eventsRead,
                      const bool peek,
@@ -93,14 +106,15 @@ private:
                      const bool unicode,
                      const bool streamRead);
 
-    void _WriteBuffer(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inRecords,
+    void _WriteBuffer(const gsl::span<const INPUT_RECORD> inRecords,
                       _Out_ size_t& eventsWritten,
                       _Out_ bool& setWaitEvent);
 
     bool _CanCoalesce(const KeyEvent& a, const KeyEvent& b) const noexcept;
-    bool _CoalesceMouseMovedEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
-    bool _CoalesceRepeatedKeyPressEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
-    void _HandleConsoleSuspensionEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
+    bool _CoalesceMouseMovedEvents(const INPUT_RECORD& inRecord);
+    bool _CoalesceRepeatedKeyPressEvents(const INPUT_RECORD& inRecord);
+    gsl::span<const INPUT_RECORD> _HandleConsoleSuspensionEvents(const gsl::span<const INPUT_RECORD> inRecords,
+                                                                 _Inout_ std::vector<INPUT_RECORD>& keptRecords);
 
     void _HandleTerminalInputCallback(_In_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
 
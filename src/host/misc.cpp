@@ -247,6 +247,43 @@ void SplitToOem(std::deque<std::unique_ptr<IInputEvent>>& events)
     }
 }
 
+// Routine Description:
+// - Converts all key events in the records to the oem char data, one
+// record for each char the key's char converts to.
+// Arguments:
+// - records - on input the records to convert. on output, the
+// converted records
+// Note: may throw on error
+void SplitToOem(std::vector<INPUT_RECORD>& records)
+{
+    const UINT codepage = ServiceLocator::LocateGlobals().getConsoleInformation().CP;
+
+    // convert records to oem codepage
+    std::vector<INPUT_RECORD> convertedRecords;
+    convertedRecords.reserve(records.size());
+    for (const auto& record : records)
+    {
+        if (record.EventType == KEY_EVENT)
+        {
+            // convert from wchar to char
+            std::wstring wstr{ record.Event.KeyEvent.uChar.UnicodeChar };
+            const auto str = ConvertToA(codepage, wstr);
+
+            for (auto& ch : str)
+            {
+                INPUT_RECORD tempRecord = record;
+                tempRecord.Event.KeyEvent.uChar.UnicodeChar = ch;
+                convertedRecords.push_back(tempRecord);
+            }
+        }
+        else
+        {
+            convertedRecords.push_back(record);
+        }
+    }
+    records.swap(convertedRecords);
+}
+
 // Routine Description:
 // - Converts unicode characters to ANSI given a destination codepage
 // Arguments:
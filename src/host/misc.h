@@ -45,6 +45,7 @@ int ConvertToOem(const UINT uiCodePage,
                  const UINT cchTarget) noexcept;
 
 void SplitToOem(std::deque<std::unique_ptr<IInputEvent>>& events);
+void SplitToOem(std::vector<INPUT_RECORD>& records);
 
 int ConvertInputToUnicode(const UINT uiCodePage,
                           _In_reads_(cchSource) const CHAR * const pchSource,
@@ -280,6 +280,30 @@ static void _ScrollScreen(SCREEN_INFORMATION& screenInfo, const Viewport& source
     // Get the render target and send it commands.
     // It will figure out whether or not we're active and where the messages need to go.
     auto& render = screenInfo.GetRenderTarget();
+
+    // If whole rows only moved up or down within the area they cover, tell the
+    //      renderer so it can move them too, rather than redrawing all of them.
+    //      The rows they uncovered are redrawn either way.
+    const SHORT dy = gsl::narrow_cast<SHORT>(target.Top() - source.Top());
+    if (dy != 0 &&
+        target.Left() == source.Left() &&
+        target.Width() == source.Width() &&
+        source.Width() == screenInfo.GetBufferSize().Width() &&
+        abs(dy) < source.Height())
+    {
+        const auto region = Viewport::Union(source, target);
+        const COORD delta{ 0, dy };
+        render.TriggerScrollRegion(region, &delta);
+
+        // The source may have been trimmed to fit the target, so some of the
+        //      fill can be outside the rows that moved.
+        if (!region.IsInBounds(fill))
+        {
+            render.TriggerRedraw(fill);
+        }
+        return;
+    }
+
     // Redraw anything in the target area
     render.TriggerRedraw(target);
     // Also redraw anything that was filled.
@@ -594,6 +594,19 @@ BOOL ConhostInternalGetSet::PrivateEnableAlternateScroll(const bool fEnabled)
     return TRUE;
 }
 
+// Routine Description:
+// - Connects the PrivateEnableBracketedPasteMode call directly into our Driver Message servicing call inside Conhost.exe
+//   PrivateEnableBracketedPasteMode is an internal-only "API" call that the vt commands can execute,
+//     but it is not represented as a function call on out public API surface.
+// Arguments:
+// - fEnabled - set to true to enable bracketed paste mode, false to disable
+// Return Value:
+// - TRUE if successful (see DoSrvPrivateEnableBracketedPasteMode). FALSE otherwise.
+BOOL ConhostInternalGetSet::PrivateEnableBracketedPasteMode(const bool fEnabled)
+{
+    return NT_SUCCESS(DoSrvPrivateEnableBracketedPasteMode(fEnabled));
+}
+
 // Routine Description:
 // - Connects the PrivateEraseAll call directly into our Driver Message servicing call inside Conhost.exe
 //   PrivateEraseAll is an internal-only "API" call that the vt commands can execute,
@@ -736,6 +749,54 @@ BOOL ConhostInternalGetSet::InsertLines(const unsigned int count)
     return TRUE;
 }
 
+// Routine Description:
+// - Connects the PrivateGetCursorAndViewport call directly into our Driver Message servicing call inside Conhost.exe
+// - This is used by cursor movement and erasing in lieu of calling GetConsoleScreenBufferInfoEx.
+// Arguments:
+// - pCursorPosition - Receives the cursor position, relative to the whole buffer
+// - psrViewport - Receives the viewport, with the right and bottom exclusive like srWindow
+// Return Value:
+// - TRUE if successful (see DoSrvPrivateGetCursorAndViewport). FALSE otherwise.
+BOOL ConhostInternalGetSet::PrivateGetCursorAndViewport(_Out_ COORD* const pCursorPosition,
+                                                        _Out_ SMALL_RECT* const psrViewport) const
+{
+    DoSrvPrivateGetCursorAndViewport(_io.GetActiveOutputBuffer(), pCursorPosition, psrViewport);
+    return TRUE;
+}
+
+// Routine Description:
+// - Connects the InsertCharacters call directly into our Driver Message servicing call inside Conhost.exe
+// Arguments:
+// - count - The number of blank characters to insert at the cursor
+// Return Value:
+// - TRUE if successful (see DoSrvPrivateInsertCharacters). FALSE otherwise.
+BOOL ConhostInternalGetSet::InsertCharacters(const unsigned int count)
+{
+    return SUCCEEDED(DoSrvPrivateInsertCharacters(_io.GetActiveOutputBuffer(), count));
+}
+
+// Routine Description:
+// - Connects the DeleteCharacters call directly into our Driver Message servicing call inside Conhost.exe
+// Arguments:
+// - count - The number of characters to delete at the cursor
+// Return Value:
+// - TRUE if successful (see DoSrvPrivateDeleteCharacters). FALSE otherwise.
+BOOL ConhostInternalGetSet::DeleteCharacters(const unsigned int count)
+{
+    return SUCCEEDED(DoSrvPrivateDeleteCharacters(_io.GetActiveOutputBuffer(), count));
+}
+
+// Routine Description:
+// - Connects the EraseCells call directly into our Driver Message servicing call inside Conhost.exe
+// Arguments:
+// - psrRegion - The cells to blank with the current attributes, inclusive
+// Return Value:
+// - TRUE if successful (see DoSrvPrivateEraseCells). FALSE otherwise.
+BOOL ConhostInternalGetSet::EraseCells(const SMALL_RECT* const psrRegion)
+{
+    return SUCCEEDED(DoSrvPrivateEraseCells(_io.GetActiveOutputBuffer(), psrRegion));
+}
+
 // Method Description:
 // - Connects the MoveToBottom call directly into our Driver Message servicing
 //      call inside Conhost.exe
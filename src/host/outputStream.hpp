@@ -130,6 +130,7 @@ public:
     BOOL PrivateEnableButtonEventMouseMode(const bool fEnabled) override;
     BOOL PrivateEnableAnyEventMouseMode(const bool fEnabled) override;
     BOOL PrivateEnableAlternateScroll(const bool fEnabled) override;
+    BOOL PrivateEnableBracketedPasteMode(const bool fEnabled) override;
     BOOL PrivateEraseAll() override;
 
     BOOL PrivateGetConsoleScreenBufferAttributes(_Out_ WORD* const pwAttributes) override;
@@ -153,6 +154,12 @@ public:
     BOOL DeleteLines(const unsigned int count) override;
     BOOL InsertLines(const unsigned int count) override;
 
+    BOOL PrivateGetCursorAndViewport(_Out_ COORD* const pCursorPosition,
+                                     _Out_ SMALL_RECT* const psrViewport) const override;
+    BOOL InsertCharacters(const unsigned int count) override;
+    BOOL DeleteCharacters(const unsigned int count) override;
+    BOOL EraseCells(const SMALL_RECT* const psrRegion) override;
+
     BOOL MoveToBottom() const override;
 
     BOOL PrivateSetColorTableEntry(const short index, const COLORREF value) const noexcept override;
@@ -19,17 +19,17 @@
 // input handle to return partial data appropriately.
 // the user's buffer (pOutRecords)
 // - eventReadCount - the number of events to read
-// - partialEvents - any partial events already read
+// - partialRecords - any partial records already read
 // Return Value:
 // - THROW: Throws E_INVALIDARG for invalid pointers.
 DirectReadData::DirectReadData(_In_ InputBuffer* const pInputBuffer,
                                _In_ INPUT_READ_HANDLE_DATA* const pInputReadHandleData,
                                const size_t eventReadCount,
-                               _In_ std::deque<std::unique_ptr<IInputEvent>> partialEvents) :
+                               _In_ std::vector<INPUT_RECORD> partialRecords) :
     ReadData(pInputBuffer, pInputReadHandleData),
     _eventReadCount{ eventReadCount },
-    _partialEvents{ std::move(partialEvents) },
-    _outEvents{ }
+    _partialRecords{ std::move(partialRecords) },
+    _outRecords{ }
 {
 }
 
@@ -58,9 +58,8 @@ DirectReadData::~DirectReadData()
 // - pNumBytes - not used
 // - pControlKeyState - For certain types of reads, this specifies
 // which modifier keys were held.
-// - pOutputData - a pointer to a
-// std::deque<std::unique_ptr<IInputEvent>> that is used to the read
-// input events back to the server
+// - pOutputData - a pointer to a std::vector<INPUT_RECORD> that is
+// used to the read input records back to the server
 // Return Value:
 // - true if the wait is done and result buffer/status code can be sent back to the client.
 // - false if we need to continue to wait until more data is available.
@@ -82,7 +81,7 @@ bool DirectReadData::Notify(const WaitTerminationReason TerminationReason,
     *pControlKeyState = 0;
     *pNumBytes = 0;
     bool retVal = true;
-    std::deque<std::unique_ptr<IInputEvent>> readEvents;
+    std::vector<INPUT_RECORD> readRecords;
 
     // If ctrl-c or ctrl-break was seen, ignore it.
     if (WI_IsAnyFlagSet(TerminationReason, (WaitTerminationReason::CtrlC | WaitTerminationReason::CtrlBreak)))
@@ -95,7 +94,7 @@ bool DirectReadData::Notify(const WaitTerminationReason TerminationReason,
         _pInputBuffer->IsReadPartialByteSequenceAvailable() &&
         _eventReadCount == 1)
     {
-        _partialEvents.push_back(_pInputBuffer->FetchReadPartialByteSequence(false));
+        _partialRecords.push_back(_pInputBuffer->FetchReadPartialByteSequence(false)->ToInputRecord());
     }
 
     // See if called by CsrDestroyProcess or CsrDestroyThread
@@ -120,7 +119,7 @@ bool DirectReadData::Notify(const WaitTerminationReason TerminationReason,
 
         // calculate how many events we need to read
         size_t amountAlreadyRead;
-        if (FAILED(SizeTAdd(_partialEvents.size(), _outEvents.size(), &amountAlreadyRead)))
+        if (FAILED(SizeTAdd(_partialRecords.size(), _outRecords.size(), &amountAlreadyRead)))
         {
             *pReplyStatus = STATUS_INTEGER_OVERFLOW;
             return retVal;
@@ -132,7 +131,7 @@ bool DirectReadData::Notify(const WaitTerminationReason TerminationReason,
             return retVal;
         }
 
-        *pReplyStatus = _pInputBuffer->Read(readEvents,
+        *pReplyStatus = _pInputBuffer->Read(readRecords,
                                             amountToRead,
                                             false,
                                             false,
@@ -152,41 +151,30 @@ bool DirectReadData::Notify(const WaitTerminationReason TerminationReason,
         {
             try
             {
-                SplitToOem(readEvents);
+                SplitToOem(readRecords);
             }
             CATCH_LOG();
         }
 
-        // combine partial and whole events
-        while (!_partialEvents.empty())
-        {
-            readEvents.push_front(std::move(_partialEvents.back()));
-            _partialEvents.pop_back();
-        }
+        // combine partial and whole records
+        readRecords.insert(readRecords.begin(), _partialRecords.cbegin(), _partialRecords.cend());
+        _partialRecords.clear();
 
-        // move read events to out storage
-        for (size_t i = 0; i < _eventReadCount; ++i)
-        {
-            if (readEvents.empty())
-            {
-                break;
-            }
-            _outEvents.push_back(std::move(readEvents.front()));
-            readEvents.pop_front();
-        }
+        // move read records to out storage
+        const size_t count = std::min(_eventReadCount, readRecords.size());
+        _outRecords.insert(_outRecords.end(), readRecords.cbegin(), readRecords.cbegin() + count);
 
         // store partial event if necessary
-        if (!readEvents.empty())
+        if (readRecords.size() > count)
         {
-            _pInputBuffer->StoreReadPartialByteSequence(std::move(readEvents.front()));
-            readEvents.pop_front();
-            FAIL_FAST_IF(!(readEvents.empty()));
+            _pInputBuffer->StoreReadPartialByteSequence(IInputEvent::Create(readRecords[count]));
+            FAIL_FAST_IF(readRecords.size() > count + 1);
         }
 
-        // move events to pOutputData
-        std::deque<std::unique_ptr<IInputEvent>>* const pOutputDeque = reinterpret_cast<std::deque<std::unique_ptr<IInputEvent>>* const>(pOutputData);
-        *pNumBytes = _outEvents.size() * sizeof(INPUT_RECORD);
-        pOutputDeque->swap(_outEvents);
+        // move records to pOutputData
+        std::vector<INPUT_RECORD>* const pOutputRecords = reinterpret_cast<std::vector<INPUT_RECORD>* const>(pOutputData);
+        *pNumBytes = _outRecords.size() * sizeof(INPUT_RECORD);
+        pOutputRecords->swap(_outRecords);
     }
     return retVal;
 }
@@ -58,6 +58,18 @@ void Registry::GetEditKeys(_In_opt_ HKEY hConsoleKey) const
         gci.SetAltF4CloseAllowed(!!dwValue);
     }
 
+    // determine how long the renderer may coalesce sustained output, in milliseconds (global setting)
+    Status = RegistrySerialization::s_QueryValue(hConsoleKey,
+                                                 CONSOLE_REGISTRY_RENDERLATENCYBUDGET,
+                                                 sizeof(dwValue),
+                                                 REG_DWORD,
+                                                 (PBYTE)& dwValue,
+                                                 nullptr);
+    if (NT_SUCCESS(Status) && dwValue <= 1000)
+    {
+        gci.SetRenderLatencyBudget(dwValue);
+    }
+
     // --- START LOAD BEARING CODE ---
     // NOTE: Because of some accident of history (win2k time or before) the key type of
     // CONSOLE_REGISTRY_WORD_DELIM was set to REG_DWORD when it should have been REG_SZ. Registry key reads
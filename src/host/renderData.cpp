@@ -246,6 +246,24 @@ std::vector<Viewport> RenderData::GetSelectionRects() noexcept
     return result;
 }
 
+// Method Description:
+// - Retrieves one rectangle per line of each match of the find dialog's search
+//   that is in the viewport, to be highlighted like the selection.
+// Return Value:
+// - Vector of Viewports describing the area highlighted
+std::vector<Viewport> RenderData::GetSearchHighlightRects() noexcept
+{
+    try
+    {
+        CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        SCREEN_INFORMATION& screenInfo = gci.GetActiveOutputBuffer();
+        return screenInfo.GetSearchHighlightRects(screenInfo.GetViewport());
+    }
+    CATCH_LOG();
+
+    return {};
+}
+
 // Routine Description:
 // - Checks the user preference as to whether grid line drawing is allowed around the edges of each cell.
 // - This is for backwards compatibility with old behaviors in the legacy console.
@@ -43,6 +43,7 @@ public:
     const bool IsGridLineDrawingAllowed() noexcept override;
 
     std::vector<Microsoft::Console::Types::Viewport> GetSelectionRects() noexcept override;
+    std::vector<Microsoft::Console::Types::Viewport> GetSearchHighlightRects() noexcept override;
 
     const std::wstring GetConsoleTitle() const noexcept override;
 
@@ -9,6 +9,7 @@
 #include "_output.h"
 #include "misc.h"
 #include "handle.h"
+#include "search.h"
 #include "../buffer/out/CharRow.hpp"
 
 #include <math.h>
@@ -56,6 +57,8 @@ SCREEN_INFORMATION::SCREEN_INFORMATION(
     _tabStops{},
     _virtualBottom{ 0 },
     _renderTarget{ *this },
+    _searchHighlight{ nullptr },
+    _searchHighlightCircles{ 0 },
     _currentFont{ fontInfo },
     _desiredFont{ fontInfo }
 {
@@ -1679,6 +1682,9 @@ NTSTATUS SCREEN_INFORMATION::ResizeScreenBuffer(const COORD coordNewScreenSize,
     // cancel any active selection before resizing or it will not necessarily line up with the new buffer positions
     Selection::Instance().ClearSelection();
 
+    // the highlighted matches were found in the old buffer, so they go too
+    ClearSearchHighlight();
+
     // cancel any popups before resizing or they will not necessarily line up with new buffer positions
     CommandLine::Instance().EndAllPopups();
 
@@ -2862,6 +2868,111 @@ IRenderTarget& SCREEN_INFORMATION::GetRenderTarget() noexcept
     return _renderTarget;
 }
 
+// Method Description:
+// - Highlights every match of the search in this buffer, replacing the matches
+//   of any search highlighted before. The matches follow the text written to
+//   the buffer until the highlight is cleared.
+// Arguments:
+// - search - The search to highlight the matches of.
+// Return Value:
+// - <none>
+void SCREEN_INFORMATION::SetSearchHighlight(std::unique_ptr<Search> search)
+{
+    search->FindAll();
+    _searchHighlight = std::move(search);
+    _searchHighlightCircles = 0;
+    _renderTarget.TriggerSelection();
+}
+
+// Method Description:
+// - Stops highlighting the matches of the search, if there is one.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void SCREEN_INFORMATION::ClearSearchHighlight()
+{
+    if (_searchHighlight)
+    {
+        _searchHighlight.reset();
+        _renderTarget.TriggerSelection();
+    }
+}
+
+// Method Description:
+// - Gets the cells of the highlighted matches that are in the rows of the view,
+//   one rectangle per row of each match.
+// Arguments:
+// - view - The part of the buffer being shown.
+// Return Value:
+// - The rectangles, in buffer coordinates. Empty when nothing is highlighted.
+std::vector<Viewport> SCREEN_INFORMATION::GetSearchHighlightRects(const Viewport& view)
+{
+    if (!_searchHighlight)
+    {
+        return {};
+    }
+
+    _CatchUpSearchHighlight();
+    return _searchHighlight->GetMatchRects(view.Top(), view.BottomInclusive());
+}
+
+// Method Description:
+// - Tells the highlighted search that the text of a region of the buffer changed,
+//   so the matches in and around its rows are found again.
+// - If they can't be, the highlight is cleared rather than left showing old text.
+// Arguments:
+// - region - The region of the buffer that changed.
+// Return Value:
+// - True if there's a highlight and it has to be painted again.
+bool SCREEN_INFORMATION::UpdateSearchHighlight(const Viewport& region) noexcept
+{
+    if (!_searchHighlight)
+    {
+        return false;
+    }
+
+    try
+    {
+        _CatchUpSearchHighlight();
+        _searchHighlight->UpdateRows(region.Top(), region.BottomInclusive());
+    }
+    catch (...)
+    {
+        LOG_CAUGHT_EXCEPTION();
+        _searchHighlight.reset();
+    }
+    return true;
+}
+
+// Method Description:
+// - Counts the buffer circling for the highlighted search. The buffer says it's
+//   about to circle before it recycles its first row, so the search is only told
+//   the next time it's used, when the row has been recycled.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void SCREEN_INFORMATION::CircleSearchHighlight() noexcept
+{
+    if (_searchHighlight)
+    {
+        _searchHighlightCircles++;
+    }
+}
+
+// Method Description:
+// - Moves the highlighted search along with the times the buffer circled since
+//   it was last used.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void SCREEN_INFORMATION::_CatchUpSearchHighlight()
+{
+    _searchHighlight->UpdateAfterCircling(std::exchange(_searchHighlightCircles, 0));
+}
+
 // Method Description:
 // - Gets the current font of the screen buffer.
 // Arguments:
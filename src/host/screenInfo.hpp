@@ -53,6 +53,7 @@ using namespace Microsoft::Console::Interactivity;
 using namespace Microsoft::Console::VirtualTerminal;
 
 class ConversionAreaInfo; // forward decl window. circular reference
+class Search;
 
 class SCREEN_INFORMATION : public ConsoleObjectHeader, public Microsoft::Console::IIoProvider
 {
@@ -246,6 +247,12 @@ public:
 
     Microsoft::Console::Render::IRenderTarget& GetRenderTarget() noexcept;
 
+    void SetSearchHighlight(std::unique_ptr<Search> search);
+    void ClearSearchHighlight();
+    std::vector<Microsoft::Console::Types::Viewport> GetSearchHighlightRects(const Microsoft::Console::Types::Viewport& view);
+    bool UpdateSearchHighlight(const Microsoft::Console::Types::Viewport& region) noexcept;
+    void CircleSearchHighlight() noexcept;
+
     FontInfo& GetCurrentFont() noexcept;
     const FontInfo& GetCurrentFont() const noexcept;
 
@@ -294,6 +301,8 @@ private:
     bool _IsAltBuffer() const;
     bool _IsInPtyMode() const;
 
+    void _CatchUpSearchHighlight();
+
     std::shared_ptr<StateMachine> _stateMachine;
 
     Microsoft::Console::Types::Viewport _scrollMargins; //The margins of the VT specified scroll region. Left and Right are currently unused, but could be in the future.
@@ -323,6 +332,12 @@ private:
 
     ScreenBufferRenderTarget _renderTarget;
 
+    // The matches of the find dialog's search stay highlighted until it closes. The render
+    //  target tells the search which rows changed, so the highlight follows new output.
+    //  Circling is only counted, the rows aren't recycled yet when the buffer says so.
+    std::unique_ptr<Search> _searchHighlight;
+    size_t _searchHighlightCircles;
+
 #ifdef UNIT_TESTING
     friend class TextBufferIteratorTests;
     friend class ScreenBufferTests;
@@ -19,10 +19,12 @@
 // - str - The search term you want to find (the "needle")
 // - direction - The direction to search (upward or downward)
 // - sensitivity - Whether or not you care about case
+// - syntax - Whether the search term is plain text or a regular expression
 Search::Search(const SCREEN_INFORMATION& screenInfo,
                const std::wstring& str,
                const Direction direction,
-               const Sensitivity sensitivity) :
+               const Sensitivity sensitivity,
+               const Syntax syntax) :
     _direction(direction),
     _sensitivity(sensitivity),
     _screenInfo(screenInfo),
@@ -30,6 +32,7 @@ Search::Search(const SCREEN_INFORMATION& screenInfo,
     _coordAnchor(s_GetInitialAnchor(screenInfo, direction))
 {
     _coordNext = _coordAnchor;
+    _PrepareIndex(str, syntax);
 }
 
 // Routine Description:
@@ -42,11 +45,13 @@ Search::Search(const SCREEN_INFORMATION& screenInfo,
 // - direction - The direction to search (upward or downward)
 // - sensitivity - Whether or not you care about case
 // - anchor - starting search location in screenInfo
+// - syntax - Whether the search term is plain text or a regular expression
 Search::Search(const SCREEN_INFORMATION& screenInfo,
                const std::wstring& str,
                const Direction direction,
                const Sensitivity sensitivity,
-               const COORD anchor) :
+               const COORD anchor,
+               const Syntax syntax) :
     _direction(direction),
     _sensitivity(sensitivity),
     _screenInfo(screenInfo),
@@ -54,10 +59,14 @@ Search::Search(const SCREEN_INFORMATION& screenInfo,
     _coordAnchor(anchor)
 {
     _coordNext = _coordAnchor;
+    _PrepareIndex(str, syntax);
 }
 
 // Routine Description
 // - Locates the next instance of the search term within the screen buffer.
+// - Rows are scanned whole, in the search direction, starting with the one holding
+//   the next position and stopping at the first row with a match before the anchor.
+//   Regular expressions are matched a logical line at a time instead.
 // Arguments:
 // - <none> - Uses internal state from constructor
 // Return Value:
@@ -71,24 +80,299 @@ bool Search::FindNext()
         return false;
     }
 
-    do
+    // Going on to the next match reads the same rows again, so keep their keys from now on.
+    if (_searched)
+    {
+        _BuildIndex();
+    }
+    _searched = true;
+
+    const bool forward = _direction == Direction::Forward;
+    const size_t total = static_cast<size_t>(_width) * _height;
+    const size_t next = static_cast<size_t>(_coordNext.Y) * _width + _coordNext.X;
+    const size_t anchor = static_cast<size_t>(_coordAnchor.Y) * _width + _coordAnchor.X;
+
+    // The positions left to search run from the next one up to the anchor. When we're
+    // sitting on the anchor, that's the whole buffer.
+    size_t remaining = forward ? (anchor + total - next) % total : (next + total - anchor) % total;
+    if (remaining == 0)
+    {
+        remaining = total;
+    }
+
+    // The rows (or lines) we start in are visited twice: first for the part from the next
+    // position on, and once more at the very end for the part before it.
+    std::vector<std::pair<COORD, COORD>> matches;
+    SHORT row = _coordNext.Y;
+    for (bool firstVisit = true;; firstVisit = false)
     {
-        if (_FindNeedleInHaystackAt(_coordNext, _coordSelStart, _coordSelEnd))
+        SHORT top;
+        SHORT bottom;
+        _FindInUnit(row, top, bottom, matches);
+        if (!forward)
         {
+            std::reverse(matches.begin(), matches.end());
+        }
+
+        const bool lastVisit = !firstVisit && top <= _coordNext.Y && _coordNext.Y <= bottom;
+        for (const auto& match : matches)
+        {
+            const size_t pos = static_cast<size_t>(match.first.Y) * _width + match.first.X;
+            const bool beforeNext = forward ? pos < next : pos > next;
+            if ((firstVisit && beforeNext) || (lastVisit && !beforeNext))
+            {
+                continue;
+            }
+
+            const size_t offset = forward ? (pos + total - next) % total : (next + total - pos) % total;
+            if (offset >= remaining)
+            {
+                break;
+            }
+
+            std::tie(_coordSelStart, _coordSelEnd) = match;
+            _coordNext = _coordSelStart;
             _UpdateNextPosition();
             _reachedEnd = _coordNext == _coordAnchor;
             return true;
         }
-        else
+
+        if (lastVisit)
         {
-            _UpdateNextPosition();
+            break;
         }
 
-    } while (_coordNext != _coordAnchor);
+        // Stop once the nearest position of what comes next is already past the anchor.
+        row = gsl::narrow_cast<SHORT>(forward ? (bottom + 1) % _height : (top + _height - 1) % _height);
+        const size_t nearest = forward ? static_cast<size_t>(row) * _width : static_cast<size_t>(row) * _width + _width - 1;
+        const size_t offset = forward ? (nearest + total - next) % total : (next + total - nearest) % total;
+        if (offset >= remaining)
+        {
+            break;
+        }
+    }
 
+    _coordNext = _coordAnchor;
+    _coordSelStart = { 0 };
+    _coordSelEnd = { 0 };
     return false;
 }
 
+// Routine Description
+// - Locates every instance of the search term within the screen buffer in one pass.
+// - The result is kept, so asking again is free until rows are updated.
+// Arguments:
+// - <none> - Uses internal state from constructor
+// Return Value:
+// - The [start, end] coord positions of each match, in buffer order. Matches may overlap.
+const std::vector<std::pair<COORD, COORD>>& Search::FindAll()
+{
+    if (!_allFound)
+    {
+        // The matches are kept up to date as rows change, which reads the rows around
+        //      the change again.
+        _BuildIndex();
+        _searched = true;
+
+        _matches.clear();
+        _ScanRows(0, gsl::narrow_cast<SHORT>(_height - 1), _matches);
+        _allFound = true;
+    }
+    return _matches;
+}
+
+// Routine Description
+// - Tells the search that the text of some rows changed.
+// - The rows are indexed again the next time they're needed. If all matches were
+//   found already, the ones that may have changed are found again, which are those
+//   starting in the rows or in the rows before that a match can run on from.
+// Arguments:
+// - top - The first row that changed
+// - bottom - The last row that changed
+void Search::UpdateRows(const SHORT top, const SHORT bottom)
+{
+    const SHORT first = std::max<SHORT>(top, 0);
+    const SHORT last = std::min(bottom, gsl::narrow_cast<SHORT>(_height - 1));
+    if (first > last)
+    {
+        return;
+    }
+
+    for (SHORT row = first; row <= last; row++)
+    {
+        _rowIndexed[(row + _indexTop) % _height] = false;
+    }
+
+    if (!_allFound)
+    {
+        return;
+    }
+
+    const auto rescan = [this](const SHORT from, const SHORT to) {
+        const auto startsAbove = [](const std::pair<COORD, COORD>& match, const SHORT row) {
+            return match.first.Y < row;
+        };
+        const auto begin = std::lower_bound(_matches.begin(), _matches.end(), from, startsAbove);
+        const auto end = std::lower_bound(begin, _matches.end(), gsl::narrow_cast<SHORT>(to + 1), startsAbove);
+
+        std::vector<std::pair<COORD, COORD>> found;
+        _ScanRows(from, to, found);
+        const auto at = _matches.erase(begin, end);
+        _matches.insert(at, found.begin(), found.end());
+    };
+
+    // A match can start a few rows above the change and run into it. Above the first row,
+    // that's the last rows of the buffer, since a match can wrap around the end.
+    const int firstAffected = first - _GetRowsSpanned();
+    if (_regex.has_value())
+    {
+        // Matches don't leave their logical line, but the line a changed row belongs to may
+        // have grown or shrunk, and the rows after it may have become lines of their own.
+        _line.Read(_screenInfo.GetTextBuffer(), first);
+        const SHORT lineTop = _line.GetTop();
+        _line.Read(_screenInfo.GetTextBuffer(), std::min(gsl::narrow_cast<SHORT>(last + 1), gsl::narrow_cast<SHORT>(_height - 1)));
+        rescan(lineTop, _line.GetBottom());
+    }
+    else if (firstAffected >= 0)
+    {
+        rescan(gsl::narrow_cast<SHORT>(firstAffected), last);
+    }
+    else if (firstAffected + _height > last)
+    {
+        rescan(0, last);
+        rescan(gsl::narrow_cast<SHORT>(firstAffected + _height), gsl::narrow_cast<SHORT>(_height - 1));
+    }
+    else
+    {
+        _matches.clear();
+        _ScanRows(0, gsl::narrow_cast<SHORT>(_height - 1), _matches);
+    }
+}
+
+// Routine Description
+// - Tells the search that the text buffer circled: its first rows were recycled as the
+//   last ones, and every other row moved up.
+// - The index rotates along with the buffer, so only the recycled rows are indexed again.
+//   Matches move up, the ones in the recycled rows are dropped and those rows are searched
+//   anew as they are now.
+// - For regular expressions, the line now at the top may have lost its first rows, so
+//   it's searched again too.
+// - Call this before passing the rows written after the buffer circled to UpdateRows.
+// Arguments:
+// - count - How many times the buffer circled since the last update, like the count
+//   TextBuffer::WriteStream returns.
+void Search::UpdateAfterCircling(const size_t count)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    if (count >= static_cast<size_t>(_height))
+    {
+        _rowIndexed.assign(_height, false);
+        if (_allFound)
+        {
+            _matches.clear();
+            _ScanRows(0, gsl::narrow_cast<SHORT>(_height - 1), _matches);
+        }
+        return;
+    }
+
+    const SHORT shift = gsl::narrow_cast<SHORT>(count);
+    for (SHORT i = 0; i < shift; i++)
+    {
+        _rowIndexed[(_indexTop + i) % _height] = false;
+    }
+    _indexTop = gsl::narrow_cast<SHORT>((_indexTop + shift) % _height);
+
+    if (_allFound)
+    {
+        const auto firstKept = std::find_if(_matches.begin(), _matches.end(), [shift](const std::pair<COORD, COORD>& match) {
+            return match.first.Y >= shift;
+        });
+        _matches.erase(_matches.begin(), firstKept);
+
+        for (auto& match : _matches)
+        {
+            match.first.Y -= shift;
+            match.second.Y -= shift;
+        }
+    }
+
+    UpdateRows(gsl::narrow_cast<SHORT>(_height - shift), gsl::narrow_cast<SHORT>(_height - 1));
+    if (_regex.has_value())
+    {
+        UpdateRows(0, 0);
+    }
+}
+
+// Routine Description
+// - Gets the cells of every match that shows in a range of rows, for highlighting them.
+// - A match is split into a rectangle per row it covers, and only the rows in the range
+//   are returned. Like FindAll, a match can wrap from the bottom of the buffer to the top.
+// Arguments:
+// - top - The first row to get the matches of
+// - bottom - The last row to get the matches of
+// Return Value:
+// - One rectangle a row high for each row of each match in the range.
+std::vector<Microsoft::Console::Types::Viewport> Search::GetMatchRects(const SHORT top, const SHORT bottom)
+{
+    const auto& matches = FindAll();
+    std::vector<Microsoft::Console::Types::Viewport> rects;
+
+    const size_t width = _width;
+    const size_t cells = width * _height;
+    const auto addRects = [&](const std::pair<COORD, COORD>& match) {
+        const size_t start = match.first.Y * width + match.first.X;
+        const size_t end = match.second.Y * width + match.second.X;
+        size_t remaining = (end + cells - start) % cells + 1;
+
+        SHORT row = match.first.Y;
+        size_t left = match.first.X;
+        while (remaining > 0)
+        {
+            const size_t count = std::min(remaining, width - left);
+            if (row >= top && row <= bottom)
+            {
+                rects.push_back(Microsoft::Console::Types::Viewport::FromDimensions({ gsl::narrow_cast<SHORT>(left), row },
+                                                                                    gsl::narrow_cast<SHORT>(count),
+                                                                                    1));
+            }
+            remaining -= count;
+            left = 0;
+            row = gsl::narrow_cast<SHORT>((row + 1) % _height);
+        }
+    };
+
+    const auto startsAbove = [](const std::pair<COORD, COORD>& match, const int row) {
+        return match.first.Y < row;
+    };
+    const auto addRange = [&](const int from, const int to) {
+        const auto begin = std::lower_bound(matches.begin(), matches.end(), from, startsAbove);
+        const auto end = std::lower_bound(begin, matches.end(), to + 1, startsAbove);
+        std::for_each(begin, end, addRects);
+    };
+
+    // A literal match runs into at most a few rows after the one it starts in, and the
+    // ones starting in the last rows can wrap around into the top. A regular expression
+    // can match all of a logical line, so those are all looked at.
+    if (_regex.has_value())
+    {
+        addRange(0, _height - 1);
+    }
+    else
+    {
+        const int firstAffected = top - _GetRowsSpanned();
+        addRange(std::max(firstAffected, 0), bottom);
+        if (firstAffected < 0)
+        {
+            addRange(std::max(firstAffected + _height, bottom + 1), _height - 1);
+        }
+    }
+    return rects;
+}
+
 // Routine Description:
 // - Takes the found word and selects it in the screen buffer
 void Search::Select() const
@@ -232,6 +516,30 @@ bool Search::_CompareChars(const std::wstring_view one, const std::wstring_view
     return true;
 }
 
+// Routine Description:
+// - Folds the text of one cell into the key it's indexed and compared by.
+// Arguments:
+// - chars - The text of the cell
+// Return Value:
+// - The key. KEY_COMPLEX if the text doesn't fit into one.
+Search::Key Search::_KeyFromChars(const std::wstring_view chars) const
+{
+    if (chars.size() == 1)
+    {
+        return _ApplySensitivity(chars[0]);
+    }
+    else if (chars.size() == 2 &&
+             Utf16Parser::IsLeadingSurrogate(chars[0]) &&
+             Utf16Parser::IsTrailingSurrogate(chars[1]))
+    {
+        return 0x10000 + ((static_cast<Key>(chars[0]) - 0xD800) << 10) + (static_cast<Key>(chars[1]) - 0xDC00);
+    }
+    else
+    {
+        return KEY_COMPLEX;
+    }
+}
+
 // Routine Description:
 // - Provides an abstraction for conditionally applying case sensitivity
 //   based on object construction
@@ -289,6 +597,289 @@ void Search::_UpdateNextPosition()
     }
 }
 
+// Routine Description:
+// - Folds the needle into keys. The index itself isn't allocated until it's needed,
+//   see _BuildIndex.
+// - Builds the Horspool shift table. It's looked up by the low byte of a key, so keys
+//   sharing one get the smallest shift of any of them, which is always safe.
+// - A regular expression is compiled instead, and needs no index.
+// Arguments:
+// - str - The search term
+// - syntax - How to interpret the search term
+void Search::_PrepareIndex(const std::wstring& str, const Syntax syntax)
+{
+    const auto dimensions = _screenInfo.GetBufferSize().Dimensions();
+    _width = dimensions.X;
+    _height = dimensions.Y;
+    _rowIndexed.resize(_height, false);
+
+    if (syntax == Syntax::RegularExpression)
+    {
+        auto flags = std::regex_constants::ECMAScript | std::regex_constants::optimize;
+        if (_sensitivity == Sensitivity::CaseInsensitive)
+        {
+            flags |= std::regex_constants::icase;
+        }
+
+        try
+        {
+            _regex.emplace(str, flags);
+        }
+        catch (const std::regex_error&)
+        {
+            THROW_HR(E_INVALIDARG);
+        }
+        return;
+    }
+
+    for (const auto& cell : _needle)
+    {
+        const auto key = _KeyFromChars({ cell.data(), cell.size() });
+        _needleComplex = _needleComplex || key == KEY_COMPLEX;
+        _needleKeys.push_back(key);
+    }
+
+    const size_t length = _needleKeys.size();
+    std::fill(std::begin(_shifts), std::end(_shifts), length);
+    for (size_t i = 0; i + 1 < length; i++)
+    {
+        _shifts[_needleKeys[i] & 0xFF] = length - 1 - i;
+    }
+}
+
+// Routine Description:
+// - Allocates the index, for searches that read rows more than once: finding all the
+//   matches, or finding the next match after the first. A single FindNext folds each
+//   row straight into the window it scans, which saves a key for every cell of the
+//   buffer, most of which it never reads.
+// - Regular expressions don't use the index.
+void Search::_BuildIndex()
+{
+    if (_index.empty() && !_regex.has_value())
+    {
+        _index.resize(static_cast<size_t>(_width) * _height);
+    }
+}
+
+// Routine Description:
+// - Appends the keys of the first cells of a row to the window. They're read from the
+//   index if there is one, indexing the row first if it hasn't been.
+// Arguments:
+// - row - The row of the screen buffer
+// - count - How many cells of the row to append, at most the width of the buffer
+void Search::_AppendRowKeys(const SHORT row, const size_t count)
+{
+    if (_index.empty())
+    {
+        const auto start = _window.size();
+        _window.resize(start + _width);
+        _IndexRow(row, _window.data() + start);
+        _window.resize(start + count);
+        return;
+    }
+
+    const size_t slot = (row + _indexTop) % _height;
+    Key* const pKeys = _index.data() + slot * _width;
+    if (!_rowIndexed[slot])
+    {
+        _IndexRow(row, pKeys);
+        _rowIndexed[slot] = true;
+    }
+    _window.insert(_window.end(), pKeys, pKeys + count);
+}
+
+// Routine Description:
+// - Folds the text of a row into keys. Cells are read straight from the row, only
+//   the ones holding more than one code unit go through the glyph lookup.
+// Arguments:
+// - row - The row of the screen buffer
+// - pKeys - Receives one key per column
+void Search::_IndexRow(const SHORT row, Key* const pKeys) const
+{
+    const auto& charRow = _screenInfo.GetTextBuffer().GetRowByOffset(row).GetCharRow();
+    const auto pCells = charRow.cbegin();
+    const size_t columns = std::min<size_t>(charRow.size(), _width);
+
+    for (size_t column = 0; column < columns; column++)
+    {
+        if (pCells[column].DbcsAttr().IsGlyphStored())
+        {
+            pKeys[column] = _KeyFromChars(charRow.GlyphAt(column));
+        }
+        else
+        {
+            pKeys[column] = _ApplySensitivity(pCells[column].Char());
+        }
+    }
+
+    std::fill(pKeys + columns, pKeys + _width, KEY_COMPLEX);
+}
+
+// Routine Description:
+// - Finds the matches that start in the given row.
+// - Scans the keys of the row, followed by as many cells as a match starting at its end
+//   can run into, with Boyer-Moore-Horspool. Like FindNext, a match can wrap from the
+//   bottom of the buffer to the top.
+// - The columns the matches start at are left in _columns, in ascending order.
+// Arguments:
+// - row - The row of the screen buffer
+void Search::_FindInRow(const SHORT row)
+{
+    _columns.clear();
+
+    const size_t length = _needleKeys.size();
+    const size_t width = _width;
+    if (length == 0 || length > width * _height)
+    {
+        return;
+    }
+
+    _window.clear();
+    _AppendRowKeys(row, width);
+
+    SHORT nextRow = row;
+    while (_window.size() < width + length - 1)
+    {
+        nextRow = gsl::narrow_cast<SHORT>((nextRow + 1) % _height);
+        _AppendRowKeys(nextRow, std::min(width, width + length - 1 - _window.size()));
+    }
+
+    const auto pHaystack = _window.data();
+    const auto pNeedle = _needleKeys.data();
+    const size_t last = length - 1;
+    for (size_t i = 0; i < width; i += _shifts[pHaystack[i + last] & 0xFF])
+    {
+        if (pHaystack[i + last] == pNeedle[last] &&
+            std::equal(pNeedle, pNeedle + last, pHaystack + i))
+        {
+            // Cells that didn't fold into a key all look the same, so those have to be
+            // compared for real.
+            COORD start;
+            COORD end;
+            const COORD pos{ gsl::narrow_cast<SHORT>(i), row };
+            if (!_needleComplex || _FindNeedleInHaystackAt(pos, start, end))
+            {
+                _columns.push_back(pos.X);
+            }
+        }
+    }
+}
+
+// Routine Description:
+// - Finds the matches of the regular expression in the logical line that was last read.
+// - Empty matches are skipped, there's nothing to select. So are matches that start in
+//   the same cell as the one before, which happens when a glyph is more than one character.
+// - The match results are kept from line to line, so searching doesn't allocate once
+//   they've grown to fit the expression.
+// Arguments:
+// - matches - Appended with the [start, end] positions of each match, in buffer order
+void Search::_FindInLine(std::vector<std::pair<COORD, COORD>>& matches)
+{
+    const auto text = _line.GetText();
+    const wchar_t* const begin = text.data();
+    const wchar_t* const end = begin + text.size();
+    const auto first = matches.size();
+
+    auto flags = std::regex_constants::match_not_null;
+    for (auto pos = begin; std::regex_search(pos, end, _lineMatch, *_regex, flags); pos = _lineMatch[0].second)
+    {
+        const auto span = _line.GetCellSpan(gsl::narrow_cast<size_t>(_lineMatch[0].first - begin),
+                                            gsl::narrow_cast<size_t>(_lineMatch.length(0)));
+        if (matches.size() == first || matches.back().first != span.first)
+        {
+            matches.push_back(span);
+        }
+
+        // Let anchors and word boundaries see what came before the rest of the line.
+        flags |= std::regex_constants::match_prev_avail;
+    }
+}
+
+// Routine Description:
+// - Finds the matches in the smallest unit of the buffer a match can't start outside of
+//   and still be found by looking at it: one row for plain text, one logical line for
+//   regular expressions.
+// Arguments:
+// - row - A row of the unit
+// - top - Receives the first row of the unit
+// - bottom - Receives the last row of the unit
+// - matches - Receives the [start, end] positions of each match, in buffer order
+void Search::_FindInUnit(const SHORT row, SHORT& top, SHORT& bottom, std::vector<std::pair<COORD, COORD>>& matches)
+{
+    matches.clear();
+    if (_regex.has_value())
+    {
+        _line.Read(_screenInfo.GetTextBuffer(), row);
+        top = _line.GetTop();
+        bottom = _line.GetBottom();
+        _FindInLine(matches);
+    }
+    else
+    {
+        top = row;
+        bottom = row;
+        _FindInRow(row);
+        for (const auto column : _columns)
+        {
+            matches.push_back(_GetMatchAt(row, column));
+        }
+    }
+}
+
+// Routine Description:
+// - Gets how many rows above a row a match can start and still run into it.
+// Return Value:
+// - The number of rows.
+SHORT Search::_GetRowsSpanned() const noexcept
+{
+    const size_t length = _needleKeys.size();
+    return length == 0 ? 0 : gsl::narrow_cast<SHORT>((length - 1 + _width - 1) / _width);
+}
+
+// Routine Description:
+// - Finds the matches that start in a range of rows.
+// Arguments:
+// - top - The first row to search
+// - bottom - The last row to search
+// - matches - Appended with the [start, end] positions of each match, in buffer order
+void Search::_ScanRows(const SHORT top, const SHORT bottom, std::vector<std::pair<COORD, COORD>>& matches)
+{
+    if (_regex.has_value())
+    {
+        // Whole lines are searched, so the range should start and end on line boundaries.
+        for (int row = top; row <= bottom; row = _line.GetBottom() + 1)
+        {
+            _line.Read(_screenInfo.GetTextBuffer(), gsl::narrow_cast<SHORT>(row));
+            _FindInLine(matches);
+        }
+        return;
+    }
+
+    for (SHORT row = top; row <= bottom; row++)
+    {
+        _FindInRow(row);
+        for (const auto column : _columns)
+        {
+            matches.push_back(_GetMatchAt(row, column));
+        }
+    }
+}
+
+// Routine Description:
+// - Gets the span of the match starting at the given position.
+// Arguments:
+// - row - The row the match starts in
+// - column - The column the match starts at
+// Return Value:
+// - The [start, end] positions of the match. The end wraps around like FindNext does.
+std::pair<COORD, COORD> Search::_GetMatchAt(const SHORT row, const SHORT column) const
+{
+    const size_t total = static_cast<size_t>(_width) * _height;
+    const size_t end = (static_cast<size_t>(row) * _width + column + _needleKeys.size() - 1) % total;
+    return { { column, row },
+             { gsl::narrow_cast<SHORT>(end % _width), gsl::narrow_cast<SHORT>(end / _width) } };
+}
+
 // Routine Description:
 // - Creates a "needle" of the correct format for comparison to the screen buffer text data
 //   that we can use for our search
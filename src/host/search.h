@@ -7,6 +7,12 @@ Module Name:
 
 Abstract:
 - This module is used for searching through the screen for a substring
+- The buffer text is folded into a per-cell index once, so every search pass
+  is a scan over contiguous rows instead of a lookup per cell. All matches
+  can be collected in one pass, and kept up to date as rows change.
+- A search can also be a regular expression. Those are matched against
+  logical lines, rows joined with the rows they wrapped onto, read one line
+  at a time.
 
 Author(s):
 - Michael Niksa (MiNiksa) 20-Apr-2018
@@ -17,6 +23,10 @@ Revision History:
 
 #pragma once
 
+#include <regex>
+
+#include "../buffer/out/LogicalLine.hpp"
+
 // This used to be in find.h.
 #define SEARCH_STRING_LENGTH    (80)
 
@@ -35,16 +45,24 @@ public:
         CaseSensitive
     };
 
+    enum class Syntax
+    {
+        Literal,
+        RegularExpression
+    };
+
     Search(const SCREEN_INFORMATION& ScreenInfo,
            const std::wstring& str,
            const Direction dir,
-           const Sensitivity sensitivity);
+           const Sensitivity sensitivity,
+           const Syntax syntax = Syntax::Literal);
 
     Search(const SCREEN_INFORMATION& ScreenInfo,
            const std::wstring& str,
            const Direction dir,
            const Sensitivity sensitivity,
-           const COORD anchor);
+           const COORD anchor,
+           const Syntax syntax = Syntax::Literal);
 
     bool FindNext();
     void Select() const;
@@ -52,9 +70,20 @@ public:
 
     std::pair<COORD, COORD> GetFoundLocation() const noexcept;
 
+    const std::vector<std::pair<COORD, COORD>>& FindAll();
+    void UpdateRows(const SHORT top, const SHORT bottom);
+    void UpdateAfterCircling(const size_t count);
+    std::vector<Microsoft::Console::Types::Viewport> GetMatchRects(const SHORT top, const SHORT bottom);
+
 private:
+    // The folded form of one cell of text. A single code unit is stored with the case
+    // sensitivity already applied, a surrogate pair as its code point. Anything longer
+    // can't be folded into one key and has to be compared cell by cell.
+    using Key = uint32_t;
+    static constexpr Key KEY_COMPLEX = 0xFFFFFFFF;
 
     wchar_t _ApplySensitivity(const wchar_t wch) const;
+    Key _KeyFromChars(const std::wstring_view chars) const;
     bool Search::_FindNeedleInHaystackAt(const COORD pos, COORD& start, COORD& end) const;
     bool _CompareChars(const std::wstring_view one, const std::wstring_view two) const;
     void _UpdateNextPosition();
@@ -62,6 +91,17 @@ private:
     void _IncrementCoord(COORD& coord) const;
     void _DecrementCoord(COORD& coord) const;
 
+    void _PrepareIndex(const std::wstring& str, const Syntax syntax);
+    void _BuildIndex();
+    void _AppendRowKeys(const SHORT row, const size_t count);
+    void _IndexRow(const SHORT row, Key* const pKeys) const;
+    void _FindInRow(const SHORT row);
+    void _FindInLine(std::vector<std::pair<COORD, COORD>>& matches);
+    void _FindInUnit(const SHORT row, SHORT& top, SHORT& bottom, std::vector<std::pair<COORD, COORD>>& matches);
+    SHORT _GetRowsSpanned() const noexcept;
+    void _ScanRows(const SHORT top, const SHORT bottom, std::vector<std::pair<COORD, COORD>>& matches);
+    std::pair<COORD, COORD> _GetMatchAt(const SHORT row, const SHORT column) const;
+
     static COORD s_GetInitialAnchor(const SCREEN_INFORMATION& screenInfo, const Direction dir);
     static std::vector<std::vector<wchar_t>> s_CreateNeedleFromString(const std::wstring& wstr);
 
@@ -76,6 +116,34 @@ private:
     const Sensitivity _sensitivity;
     const SCREEN_INFORMATION& _screenInfo;
 
+    // The needle as keys, and the Horspool shift for each key, by its low byte.
+    std::vector<Key> _needleKeys;
+    bool _needleComplex = false;
+    size_t _shifts[256] = { 0 };
+
+    // The keys of every cell, indexed as rows are first needed. The index is a ring like
+    // the text buffer, _indexTop being the slot of the buffer's first row. It's only
+    // built once the same buffer is searched again, a single FindNext doesn't need it.
+    SHORT _width = 0;
+    SHORT _height = 0;
+    SHORT _indexTop = 0;
+    std::vector<Key> _index;
+    std::vector<bool> _rowIndexed;
+    bool _searched = false;
+
+    // Reused by _FindInRow for the row and the cells a match may run into past its end,
+    // and for the columns the row's matches start at.
+    std::vector<Key> _window;
+    std::vector<SHORT> _columns;
+
+    bool _allFound = false;
+    std::vector<std::pair<COORD, COORD>> _matches;
+
+    // Set for regular expression searches, which don't use the index.
+    std::optional<std::wregex> _regex;
+    LogicalLine _line;
+    std::wcmatch _lineMatch;
+
 #ifdef UNIT_TESTING
     friend class SearchTests;
 #endif
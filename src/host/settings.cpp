@@ -55,7 +55,8 @@ Settings::Settings() :
     _DefaultForeground(INVALID_COLOR),
     _DefaultBackground(INVALID_COLOR),
     _fUseDx(false),
-    _fCopyColor(false)
+    _fCopyColor(false),
+    _dwRenderLatencyBudget(0)
 {
     _dwScreenBufferSize.X = 80;
     _dwScreenBufferSize.Y = 25;
@@ -946,3 +947,24 @@ bool Settings::GetCopyColor() const noexcept
 {
     return _fCopyColor;
 }
+
+// Method Description:
+// - Gets how long the renderer may coalesce sustained output before painting it.
+// Return Value:
+// - The budget in milliseconds, or 0 to keep the render thread's default.
+DWORD Settings::GetRenderLatencyBudget() const noexcept
+{
+    return _dwRenderLatencyBudget;
+}
+
+// Method Description:
+// - Sets how long the renderer may coalesce sustained output before painting it.
+// Arguments:
+// - dwRenderLatencyBudget - The budget in milliseconds, or 0 to keep the render
+//      thread's default.
+// Return Value:
+// - <none>
+void Settings::SetRenderLatencyBudget(const DWORD dwRenderLatencyBudget) noexcept
+{
+    _dwRenderLatencyBudget = dwRenderLatencyBudget;
+}
@@ -185,6 +185,9 @@ public:
     bool GetUseDx() const noexcept;
     bool GetCopyColor() const noexcept;
 
+    DWORD GetRenderLatencyBudget() const noexcept;
+    void SetRenderLatencyBudget(const DWORD dwRenderLatencyBudget) noexcept;
+
     COLORREF CalculateDefaultForeground() const noexcept;
     COLORREF CalculateDefaultBackground() const noexcept;
     COLORREF LookupForegroundColor(const TextAttribute& attr) const noexcept;
@@ -233,6 +236,7 @@ private:
     bool _fRenderGridWorldwide;
     bool _fUseDx;
     bool _fCopyColor;
+    DWORD _dwRenderLatencyBudget; // in milliseconds, 0 keeps the render thread's default
 
     COLORREF _XtermColorTable[XTERM_COLOR_TABLE_SIZE];
 
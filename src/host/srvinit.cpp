@@ -525,6 +525,13 @@ NTSTATUS ConsoleAllocateConsole(PCONSOLE_API_CONNECTINFO p)
 
         THROW_IF_FAILED(localPointerToThread->Initialize(g.pRender));
 
+        // A budget of 0 means the user didn't set one, so keep the thread's default.
+        const auto latencyBudget = gci.GetRenderLatencyBudget();
+        if (latencyBudget != 0)
+        {
+            localPointerToThread->SetLatencyBudget(std::chrono::milliseconds(latencyBudget));
+        }
+
         // Allow the renderer to paint.
         g.pRender->EnablePainting();
 
@@ -29,20 +29,1129 @@ static const std::vector<std::tuple<unsigned int, std::wstring, CodepointWidth>>
     { 0x1F51C, L"\xD83D\xDD1C", CodepointWidth::Wide } // U+1F51C SOON
 };
 
+// The ranges from http://www.unicode.org/Public/UCD/latest/ucd/EastAsianWidth.txt
+// that CodepointWidthDetector used to search through. Codepoints that aren't in
+// any of them are invalid.
+static const std::vector<std::tuple<unsigned int, unsigned int, CodepointWidth>> eastAsianWidthRanges =
+{
+    { 0x0000, 0x00A0, CodepointWidth::Narrow },
+    { 0x00A1, 0x00A1, CodepointWidth::Ambiguous },
+    { 0x00A2, 0x00A3, CodepointWidth::Narrow },
+    { 0x00A4, 0x00A4, CodepointWidth::Ambiguous },
+    { 0x00A5, 0x00A6, CodepointWidth::Narrow },
+    { 0x00A7, 0x00A8, CodepointWidth::Ambiguous },
+    { 0x00A9, 0x00A9, CodepointWidth::Narrow },
+    { 0x00AA, 0x00AA, CodepointWidth::Ambiguous },
+    { 0x00AB, 0x00AC, CodepointWidth::Narrow },
+    { 0x00AD, 0x00AE, CodepointWidth::Ambiguous },
+    { 0x00AF, 0x00AF, CodepointWidth::Narrow },
+    { 0x00B0, 0x00B4, CodepointWidth::Ambiguous },
+    { 0x00B5, 0x00B5, CodepointWidth::Narrow },
+    { 0x00B6, 0x00BA, CodepointWidth::Ambiguous },
+    { 0x00BB, 0x00BB, CodepointWidth::Narrow },
+    { 0x00BC, 0x00BF, CodepointWidth::Ambiguous },
+    { 0x00C0, 0x00C5, CodepointWidth::Narrow },
+    { 0x00C6, 0x00C6, CodepointWidth::Ambiguous },
+    { 0x00C7, 0x00CF, CodepointWidth::Narrow },
+    { 0x00D0, 0x00D0, CodepointWidth::Ambiguous },
+    { 0x00D1, 0x00D6, CodepointWidth::Narrow },
+    { 0x00D7, 0x00D8, CodepointWidth::Ambiguous },
+    { 0x00D9, 0x00DD, CodepointWidth::Narrow },
+    { 0x00DE, 0x00E1, CodepointWidth::Ambiguous },
+    { 0x00E2, 0x00E5, CodepointWidth::Narrow },
+    { 0x00E6, 0x00E6, CodepointWidth::Ambiguous },
+    { 0x00E7, 0x00E7, CodepointWidth::Narrow },
+    { 0x00E8, 0x00EA, CodepointWidth::Ambiguous },
+    { 0x00EB, 0x00EB, CodepointWidth::Narrow },
+    { 0x00EC, 0x00ED, CodepointWidth::Ambiguous },
+    { 0x00EE, 0x00EF, CodepointWidth::Narrow },
+    { 0x00F0, 0x00F0, CodepointWidth::Ambiguous },
+    { 0x00F1, 0x00F1, CodepointWidth::Narrow },
+    { 0x00F2, 0x00F3, CodepointWidth::Ambiguous },
+    { 0x00F4, 0x00F6, CodepointWidth::Narrow },
+    { 0x00F7, 0x00FA, CodepointWidth::Ambiguous },
+    { 0x00FB, 0x00FB, CodepointWidth::Narrow },
+    { 0x00FC, 0x00FC, CodepointWidth::Ambiguous },
+    { 0x00FD, 0x00FD, CodepointWidth::Narrow },
+    { 0x00FE, 0x00FE, CodepointWidth::Ambiguous },
+    { 0x00FF, 0x0100, CodepointWidth::Narrow },
+    { 0x0101, 0x0101, CodepointWidth::Ambiguous },
+    { 0x0102, 0x0110, CodepointWidth::Narrow },
+    { 0x0111, 0x0111, CodepointWidth::Ambiguous },
+    { 0x0112, 0x0112, CodepointWidth::Narrow },
+    { 0x0113, 0x0113, CodepointWidth::Ambiguous },
+    { 0x0114, 0x011A, CodepointWidth::Narrow },
+    { 0x011B, 0x011B, CodepointWidth::Ambiguous },
+    { 0x011C, 0x0125, CodepointWidth::Narrow },
+    { 0x0126, 0x0127, CodepointWidth::Ambiguous },
+    { 0x0128, 0x012A, CodepointWidth::Narrow },
+    { 0x012B, 0x012B, CodepointWidth::Ambiguous },
+    { 0x012C, 0x0130, CodepointWidth::Narrow },
+    { 0x0131, 0x0133, CodepointWidth::Ambiguous },
+    { 0x0134, 0x0137, CodepointWidth::Narrow },
+    { 0x0138, 0x0138, CodepointWidth::Ambiguous },
+    { 0x0139, 0x013E, CodepointWidth::Narrow },
+    { 0x013F, 0x0142, CodepointWidth::Ambiguous },
+    { 0x0143, 0x0143, CodepointWidth::Narrow },
+    { 0x0144, 0x0144, CodepointWidth::Ambiguous },
+    { 0x0145, 0x0147, CodepointWidth::Narrow },
+    { 0x0148, 0x014B, CodepointWidth::Ambiguous },
+    { 0x014C, 0x014C, CodepointWidth::Narrow },
+    { 0x014D, 0x014D, CodepointWidth::Ambiguous },
+    { 0x014E, 0x0151, CodepointWidth::Narrow },
+    { 0x0152, 0x0153, CodepointWidth::Ambiguous },
+    { 0x0154, 0x0165, CodepointWidth::Narrow },
+    { 0x0166, 0x0167, CodepointWidth::Ambiguous },
+    { 0x0168, 0x016A, CodepointWidth::Narrow },
+    { 0x016B, 0x016B, CodepointWidth::Ambiguous },
+    { 0x016C, 0x01CD, CodepointWidth::Narrow },
+    { 0x01CE, 0x01CE, CodepointWidth::Ambiguous },
+    { 0x01CF, 0x01CF, CodepointWidth::Narrow },
+    { 0x01D0, 0x01D0, CodepointWidth::Ambiguous },
+    { 0x01D1, 0x01D1, CodepointWidth::Narrow },
+    { 0x01D2, 0x01D2, CodepointWidth::Ambiguous },
+    { 0x01D3, 0x01D3, CodepointWidth::Narrow },
+    { 0x01D4, 0x01D4, CodepointWidth::Ambiguous },
+    { 0x01D5, 0x01D5, CodepointWidth::Narrow },
+    { 0x01D6, 0x01D6, CodepointWidth::Ambiguous },
+    { 0x01D7, 0x01D7, CodepointWidth::Narrow },
+    { 0x01D8, 0x01D8, CodepointWidth::Ambiguous },
+    { 0x01D9, 0x01D9, CodepointWidth::Narrow },
+    { 0x01DA, 0x01DA, CodepointWidth::Ambiguous },
+    { 0x01DB, 0x01DB, CodepointWidth::Narrow },
+    { 0x01DC, 0x01DC, CodepointWidth::Ambiguous },
+    { 0x01DD, 0x0250, CodepointWidth::Narrow },
+    { 0x0251, 0x0251, CodepointWidth::Ambiguous },
+    { 0x0252, 0x0260, CodepointWidth::Narrow },
+    { 0x0261, 0x0261, CodepointWidth::Ambiguous },
+    { 0x0262, 0x02C3, CodepointWidth::Narrow },
+    { 0x02C4, 0x02C4, CodepointWidth::Ambiguous },
+    { 0x02C5, 0x02C6, CodepointWidth::Narrow },
+    { 0x02C7, 0x02C7, CodepointWidth::Ambiguous },
+    { 0x02C8, 0x02C8, CodepointWidth::Narrow },
+    { 0x02C9, 0x02CB, CodepointWidth::Ambiguous },
+    { 0x02CC, 0x02CC, CodepointWidth::Narrow },
+    { 0x02CD, 0x02CD, CodepointWidth::Ambiguous },
+    { 0x02CE, 0x02CF, CodepointWidth::Narrow },
+    { 0x02D0, 0x02D0, CodepointWidth::Ambiguous },
+    { 0x02D1, 0x02D7, CodepointWidth::Narrow },
+    { 0x02D8, 0x02DB, CodepointWidth::Ambiguous },
+    { 0x02DC, 0x02DC, CodepointWidth::Narrow },
+    { 0x02DD, 0x02DD, CodepointWidth::Ambiguous },
+    { 0x02DE, 0x02DE, CodepointWidth::Narrow },
+    { 0x02DF, 0x02DF, CodepointWidth::Ambiguous },
+    { 0x02E0, 0x02FF, CodepointWidth::Narrow },
+    { 0x0300, 0x036F, CodepointWidth::Ambiguous },
+    { 0x0370, 0x0377, CodepointWidth::Narrow },
+    { 0x037A, 0x037F, CodepointWidth::Narrow },
+    { 0x0384, 0x038A, CodepointWidth::Narrow },
+    { 0x038C, 0x038C, CodepointWidth::Narrow },
+    { 0x038E, 0x0390, CodepointWidth::Narrow },
+    { 0x0391, 0x03A1, CodepointWidth::Ambiguous },
+    { 0x03A3, 0x03A9, CodepointWidth::Ambiguous },
+    { 0x03AA, 0x03B0, CodepointWidth::Narrow },
+    { 0x03B1, 0x03C1, CodepointWidth::Ambiguous },
+    { 0x03C2, 0x03C2, CodepointWidth::Narrow },
+    { 0x03C3, 0x03C9, CodepointWidth::Ambiguous },
+    { 0x03CA, 0x0400, CodepointWidth::Narrow },
+    { 0x0401, 0x0401, CodepointWidth::Ambiguous },
+    { 0x0402, 0x040F, CodepointWidth::Narrow },
+    { 0x0410, 0x044F, CodepointWidth::Ambiguous },
+    { 0x0450, 0x0450, CodepointWidth::Narrow },
+    { 0x0451, 0x0451, CodepointWidth::Ambiguous },
+    { 0x0452, 0x052F, CodepointWidth::Narrow },
+    { 0x0531, 0x0556, CodepointWidth::Narrow },
+    { 0x0559, 0x055F, CodepointWidth::Narrow },
+    { 0x0561, 0x0587, CodepointWidth::Narrow },
+    { 0x0589, 0x058A, CodepointWidth::Narrow },
+    { 0x058D, 0x058F, CodepointWidth::Narrow },
+    { 0x0591, 0x05C7, CodepointWidth::Narrow },
+    { 0x05D0, 0x05EA, CodepointWidth::Narrow },
+    { 0x05F0, 0x05F4, CodepointWidth::Narrow },
+    { 0x0600, 0x061C, CodepointWidth::Narrow },
+    { 0x061E, 0x070D, CodepointWidth::Narrow },
+    { 0x070F, 0x074A, CodepointWidth::Narrow },
+    { 0x074D, 0x07B1, CodepointWidth::Narrow },
+    { 0x07C0, 0x07FA, CodepointWidth::Narrow },
+    { 0x0800, 0x082D, CodepointWidth::Narrow },
+    { 0x0830, 0x083E, CodepointWidth::Narrow },
+    { 0x0840, 0x085B, CodepointWidth::Narrow },
+    { 0x085E, 0x085E, CodepointWidth::Narrow },
+    { 0x0860, 0x086A, CodepointWidth::Narrow },
+    { 0x08A0, 0x08B4, CodepointWidth::Narrow },
+    { 0x08B6, 0x08BD, CodepointWidth::Narrow },
+    { 0x08D4, 0x0983, CodepointWidth::Narrow },
+    { 0x0985, 0x098C, CodepointWidth::Narrow },
+    { 0x098F, 0x0990, CodepointWidth::Narrow },
+    { 0x0993, 0x09A8, CodepointWidth::Narrow },
+    { 0x09AA, 0x09B0, CodepointWidth::Narrow },
+    { 0x09B2, 0x09B2, CodepointWidth::Narrow },
+    { 0x09B6, 0x09B9, CodepointWidth::Narrow },
+    { 0x09BC, 0x09C4, CodepointWidth::Narrow },
+    { 0x09C7, 0x09C8, CodepointWidth::Narrow },
+    { 0x09CB, 0x09CE, CodepointWidth::Narrow },
+    { 0x09D7, 0x09D7, CodepointWidth::Narrow },
+    { 0x09DC, 0x09DD, CodepointWidth::Narrow },
+    { 0x09DF, 0x09E3, CodepointWidth::Narrow },
+    { 0x09E6, 0x09FD, CodepointWidth::Narrow },
+    { 0x0A01, 0x0A03, CodepointWidth::Narrow },
+    { 0x0A05, 0x0A0A, CodepointWidth::Narrow },
+    { 0x0A0F, 0x0A10, CodepointWidth::Narrow },
+    { 0x0A13, 0x0A28, CodepointWidth::Narrow },
+    { 0x0A2A, 0x0A30, CodepointWidth::Narrow },
+    { 0x0A32, 0x0A33, CodepointWidth::Narrow },
+    { 0x0A35, 0x0A36, CodepointWidth::Narrow },
+    { 0x0A38, 0x0A39, CodepointWidth::Narrow },
+    { 0x0A3C, 0x0A3C, CodepointWidth::Narrow },
+    { 0x0A3E, 0x0A42, CodepointWidth::Narrow },
+    { 0x0A47, 0x0A48, CodepointWidth::Narrow },
+    { 0x0A4B, 0x0A4D, CodepointWidth::Narrow },
+    { 0x0A51, 0x0A51, CodepointWidth::Narrow },
+    { 0x0A59, 0x0A5C, CodepointWidth::Narrow },
+    { 0x0A5E, 0x0A5E, CodepointWidth::Narrow },
+    { 0x0A66, 0x0A75, CodepointWidth::Narrow },
+    { 0x0A81, 0x0A83, CodepointWidth::Narrow },
+    { 0x0A85, 0x0A8D, CodepointWidth::Narrow },
+    { 0x0A8F, 0x0A91, CodepointWidth::Narrow },
+    { 0x0A93, 0x0AA8, CodepointWidth::Narrow },
+    { 0x0AAA, 0x0AB0, CodepointWidth::Narrow },
+    { 0x0AB2, 0x0AB3, CodepointWidth::Narrow },
+    { 0x0AB5, 0x0AB9, CodepointWidth::Narrow },
+    { 0x0ABC, 0x0AC5, CodepointWidth::Narrow },
+    { 0x0AC7, 0x0AC9, CodepointWidth::Narrow },
+    { 0x0ACB, 0x0ACD, CodepointWidth::Narrow },
+    { 0x0AD0, 0x0AD0, CodepointWidth::Narrow },
+    { 0x0AE0, 0x0AE3, CodepointWidth::Narrow },
+    { 0x0AE6, 0x0AF1, CodepointWidth::Narrow },
+    { 0x0AF9, 0x0AFF, CodepointWidth::Narrow },
+    { 0x0B01, 0x0B03, CodepointWidth::Narrow },
+    { 0x0B05, 0x0B0C, CodepointWidth::Narrow },
+    { 0x0B0F, 0x0B10, CodepointWidth::Narrow },
+    { 0x0B13, 0x0B28, CodepointWidth::Narrow },
+    { 0x0B2A, 0x0B30, CodepointWidth::Narrow },
+    { 0x0B32, 0x0B33, CodepointWidth::Narrow },
+    { 0x0B35, 0x0B39, CodepointWidth::Narrow },
+    { 0x0B3C, 0x0B44, CodepointWidth::Narrow },
+    { 0x0B47, 0x0B48, CodepointWidth::Narrow },
+    { 0x0B4B, 0x0B4D, CodepointWidth::Narrow },
+    { 0x0B56, 0x0B57, CodepointWidth::Narrow },
+    { 0x0B5C, 0x0B5D, CodepointWidth::Narrow },
+    { 0x0B5F, 0x0B63, CodepointWidth::Narrow },
+    { 0x0B66, 0x0B77, CodepointWidth::Narrow },
+    { 0x0B82, 0x0B83, CodepointWidth::Narrow },
+    { 0x0B85, 0x0B8A, CodepointWidth::Narrow },
+    { 0x0B8E, 0x0B90, CodepointWidth::Narrow },
+    { 0x0B92, 0x0B95, CodepointWidth::Narrow },
+    { 0x0B99, 0x0B9A, CodepointWidth::Narrow },
+    { 0x0B9C, 0x0B9C, CodepointWidth::Narrow },
+    { 0x0B9E, 0x0B9F, CodepointWidth::Narrow },
+    { 0x0BA3, 0x0BA4, CodepointWidth::Narrow },
+    { 0x0BA8, 0x0BAA, CodepointWidth::Narrow },
+    { 0x0BAE, 0x0BB9, CodepointWidth::Narrow },
+    { 0x0BBE, 0x0BC2, CodepointWidth::Narrow },
+    { 0x0BC6, 0x0BC8, CodepointWidth::Narrow },
+    { 0x0BCA, 0x0BCD, CodepointWidth::Narrow },
+    { 0x0BD0, 0x0BD0, CodepointWidth::Narrow },
+    { 0x0BD7, 0x0BD7, CodepointWidth::Narrow },
+    { 0x0BE6, 0x0BFA, CodepointWidth::Narrow },
+    { 0x0C00, 0x0C03, CodepointWidth::Narrow },
+    { 0x0C05, 0x0C0C, CodepointWidth::Narrow },
+    { 0x0C0E, 0x0C10, CodepointWidth::Narrow },
+    { 0x0C12, 0x0C28, CodepointWidth::Narrow },
+    { 0x0C2A, 0x0C39, CodepointWidth::Narrow },
+    { 0x0C3D, 0x0C44, CodepointWidth::Narrow },
+    { 0x0C46, 0x0C48, CodepointWidth::Narrow },
+    { 0x0C4A, 0x0C4D, CodepointWidth::Narrow },
+    { 0x0C55, 0x0C56, CodepointWidth::Narrow },
+    { 0x0C58, 0x0C5A, CodepointWidth::Narrow },
+    { 0x0C60, 0x0C63, CodepointWidth::Narrow },
+    { 0x0C66, 0x0C6F, CodepointWidth::Narrow },
+    { 0x0C78, 0x0C83, CodepointWidth::Narrow },
+    { 0x0C85, 0x0C8C, CodepointWidth::Narrow },
+    { 0x0C8E, 0x0C90, CodepointWidth::Narrow },
+    { 0x0C92, 0x0CA8, CodepointWidth::Narrow },
+    { 0x0CAA, 0x0CB3, CodepointWidth::Narrow },
+    { 0x0CB5, 0x0CB9, CodepointWidth::Narrow },
+    { 0x0CBC, 0x0CC4, CodepointWidth::Narrow },
+    { 0x0CC6, 0x0CC8, CodepointWidth::Narrow },
+    { 0x0CCA, 0x0CCD, CodepointWidth::Narrow },
+    { 0x0CD5, 0x0CD6, CodepointWidth::Narrow },
+    { 0x0CDE, 0x0CDE, CodepointWidth::Narrow },
+    { 0x0CE0, 0x0CE3, CodepointWidth::Narrow },
+    { 0x0CE6, 0x0CEF, CodepointWidth::Narrow },
+    { 0x0CF1, 0x0CF2, CodepointWidth::Narrow },
+    { 0x0D00, 0x0D03, CodepointWidth::Narrow },
+    { 0x0D05, 0x0D0C, CodepointWidth::Narrow },
+    { 0x0D0E, 0x0D10, CodepointWidth::Narrow },
+    { 0x0D12, 0x0D44, CodepointWidth::Narrow },
+    { 0x0D46, 0x0D48, CodepointWidth::Narrow },
+    { 0x0D4A, 0x0D4F, CodepointWidth::Narrow },
+    { 0x0D54, 0x0D63, CodepointWidth::Narrow },
+    { 0x0D66, 0x0D7F, CodepointWidth::Narrow },
+    { 0x0D82, 0x0D83, CodepointWidth::Narrow },
+    { 0x0D85, 0x0D96, CodepointWidth::Narrow },
+    { 0x0D9A, 0x0DB1, CodepointWidth::Narrow },
+    { 0x0DB3, 0x0DBB, CodepointWidth::Narrow },
+    { 0x0DBD, 0x0DBD, CodepointWidth::Narrow },
+    { 0x0DC0, 0x0DC6, CodepointWidth::Narrow },
+    { 0x0DCA, 0x0DCA, CodepointWidth::Narrow },
+    { 0x0DCF, 0x0DD4, CodepointWidth::Narrow },
+    { 0x0DD6, 0x0DD6, CodepointWidth::Narrow },
+    { 0x0DD8, 0x0DDF, CodepointWidth::Narrow },
+    { 0x0DE6, 0x0DEF, CodepointWidth::Narrow },
+    { 0x0DF2, 0x0DF4, CodepointWidth::Narrow },
+    { 0x0E01, 0x0E3A, CodepointWidth::Narrow },
+    { 0x0E3F, 0x0E5B, CodepointWidth::Narrow },
+    { 0x0E81, 0x0E82, CodepointWidth::Narrow },
+    { 0x0E84, 0x0E84, CodepointWidth::Narrow },
+    { 0x0E87, 0x0E88, CodepointWidth::Narrow },
+    { 0x0E8A, 0x0E8A, CodepointWidth::Narrow },
+    { 0x0E8D, 0x0E8D, CodepointWidth::Narrow },
+    { 0x0E94, 0x0E97, CodepointWidth::Narrow },
+    { 0x0E99, 0x0E9F, CodepointWidth::Narrow },
+    { 0x0EA1, 0x0EA3, CodepointWidth::Narrow },
+    { 0x0EA5, 0x0EA5, CodepointWidth::Narrow },
+    { 0x0EA7, 0x0EA7, CodepointWidth::Narrow },
+    { 0x0EAA, 0x0EAB, CodepointWidth::Narrow },
+    { 0x0EAD, 0x0EB9, CodepointWidth::Narrow },
+    { 0x0EBB, 0x0EBD, CodepointWidth::Narrow },
+    { 0x0EC0, 0x0EC4, CodepointWidth::Narrow },
+    { 0x0EC6, 0x0EC6, CodepointWidth::Narrow },
+    { 0x0EC8, 0x0ECD, CodepointWidth::Narrow },
+    { 0x0ED0, 0x0ED9, CodepointWidth::Narrow },
+    { 0x0EDC, 0x0EDF, CodepointWidth::Narrow },
+    { 0x0F00, 0x0F47, CodepointWidth::Narrow },
+    { 0x0F49, 0x0F6C, CodepointWidth::Narrow },
+    { 0x0F71, 0x0F97, CodepointWidth::Narrow },
+    { 0x0F99, 0x0FBC, CodepointWidth::Narrow },
+    { 0x0FBE, 0x0FCC, CodepointWidth::Narrow },
+    { 0x0FCE, 0x0FDA, CodepointWidth::Narrow },
+    { 0x1000, 0x10C5, CodepointWidth::Narrow },
+    { 0x10C7, 0x10C7, CodepointWidth::Narrow },
+    { 0x10CD, 0x10CD, CodepointWidth::Narrow },
+    { 0x10D0, 0x10FF, CodepointWidth::Narrow },
+    { 0x1100, 0x115F, CodepointWidth::Wide },
+    { 0x1160, 0x1248, CodepointWidth::Narrow },
+    { 0x124A, 0x124D, CodepointWidth::Narrow },
+    { 0x1250, 0x1256, CodepointWidth::Narrow },
+    { 0x1258, 0x1258, CodepointWidth::Narrow },
+    { 0x125A, 0x125D, CodepointWidth::Narrow },
+    { 0x1260, 0x1288, CodepointWidth::Narrow },
+    { 0x128A, 0x128D, CodepointWidth::Narrow },
+    { 0x1290, 0x12B0, CodepointWidth::Narrow },
+    { 0x12B2, 0x12B5, CodepointWidth::Narrow },
+    { 0x12B8, 0x12BE, CodepointWidth::Narrow },
+    { 0x12C0, 0x12C0, CodepointWidth::Narrow },
+    { 0x12C2, 0x12C5, CodepointWidth::Narrow },
+    { 0x12C8, 0x12D6, CodepointWidth::Narrow },
+    { 0x12D8, 0x1310, CodepointWidth::Narrow },
+    { 0x1312, 0x1315, CodepointWidth::Narrow },
+    { 0x1318, 0x135A, CodepointWidth::Narrow },
+    { 0x135D, 0x137C, CodepointWidth::Narrow },
+    { 0x1380, 0x1399, CodepointWidth::Narrow },
+    { 0x13A0, 0x13F5, CodepointWidth::Narrow },
+    { 0x13F8, 0x13FD, CodepointWidth::Narrow },
+    { 0x1400, 0x169C, CodepointWidth::Narrow },
+    { 0x16A0, 0x16F8, CodepointWidth::Narrow },
+    { 0x1700, 0x170C, CodepointWidth::Narrow },
+    { 0x170E, 0x1714, CodepointWidth::Narrow },
+    { 0x1720, 0x1736, CodepointWidth::Narrow },
+    { 0x1740, 0x1753, CodepointWidth::Narrow },
+    { 0x1760, 0x176C, CodepointWidth::Narrow },
+    { 0x176E, 0x1770, CodepointWidth::Narrow },
+    { 0x1772, 0x1773, CodepointWidth::Narrow },
+    { 0x1780, 0x17DD, CodepointWidth::Narrow },
+    { 0x17E0, 0x17E9, CodepointWidth::Narrow },
+    { 0x17F0, 0x17F9, CodepointWidth::Narrow },
+    { 0x1800, 0x180E, CodepointWidth::Narrow },
+    { 0x1810, 0x1819, CodepointWidth::Narrow },
+    { 0x1820, 0x1877, CodepointWidth::Narrow },
+    { 0x1880, 0x18AA, CodepointWidth::Narrow },
+    { 0x18B0, 0x18F5, CodepointWidth::Narrow },
+    { 0x1900, 0x191E, CodepointWidth::Narrow },
+    { 0x1920, 0x192B, CodepointWidth::Narrow },
+    { 0x1930, 0x193B, CodepointWidth::Narrow },
+    { 0x1940, 0x1940, CodepointWidth::Narrow },
+    { 0x1944, 0x196D, CodepointWidth::Narrow },
+    { 0x1970, 0x1974, CodepointWidth::Narrow },
+    { 0x1980, 0x19AB, CodepointWidth::Narrow },
+    { 0x19B0, 0x19C9, CodepointWidth::Narrow },
+    { 0x19D0, 0x19DA, CodepointWidth::Narrow },
+    { 0x19DE, 0x1A1B, CodepointWidth::Narrow },
+    { 0x1A1E, 0x1A5E, CodepointWidth::Narrow },
+    { 0x1A60, 0x1A7C, CodepointWidth::Narrow },
+    { 0x1A7F, 0x1A89, CodepointWidth::Narrow },
+    { 0x1A90, 0x1A99, CodepointWidth::Narrow },
+    { 0x1AA0, 0x1AAD, CodepointWidth::Narrow },
+    { 0x1AB0, 0x1ABE, CodepointWidth::Narrow },
+    { 0x1B00, 0x1B4B, CodepointWidth::Narrow },
+    { 0x1B50, 0x1B7C, CodepointWidth::Narrow },
+    { 0x1B80, 0x1BF3, CodepointWidth::Narrow },
+    { 0x1BFC, 0x1C37, CodepointWidth::Narrow },
+    { 0x1C3B, 0x1C49, CodepointWidth::Narrow },
+    { 0x1C4D, 0x1C88, CodepointWidth::Narrow },
+    { 0x1CC0, 0x1CC7, CodepointWidth::Narrow },
+    { 0x1CD0, 0x1CF9, CodepointWidth::Narrow },
+    { 0x1D00, 0x1DF9, CodepointWidth::Narrow },
+    { 0x1DFB, 0x1F15, CodepointWidth::Narrow },
+    { 0x1F18, 0x1F1D, CodepointWidth::Narrow },
+    { 0x1F20, 0x1F45, CodepointWidth::Narrow },
+    { 0x1F48, 0x1F4D, CodepointWidth::Narrow },
+    { 0x1F50, 0x1F57, CodepointWidth::Narrow },
+    { 0x1F59, 0x1F59, CodepointWidth::Narrow },
+    { 0x1F5B, 0x1F5B, CodepointWidth::Narrow },
+    { 0x1F5D, 0x1F5D, CodepointWidth::Narrow },
+    { 0x1F5F, 0x1F7D, CodepointWidth::Narrow },
+    { 0x1F80, 0x1FB4, CodepointWidth::Narrow },
+    { 0x1FB6, 0x1FC4, CodepointWidth::Narrow },
+    { 0x1FC6, 0x1FD3, CodepointWidth::Narrow },
+    { 0x1FD6, 0x1FDB, CodepointWidth::Narrow },
+    { 0x1FDD, 0x1FEF, CodepointWidth::Narrow },
+    { 0x1FF2, 0x1FF4, CodepointWidth::Narrow },
+    { 0x1FF6, 0x1FFE, CodepointWidth::Narrow },
+    { 0x2000, 0x200F, CodepointWidth::Narrow },
+    { 0x2010, 0x2010, CodepointWidth::Ambiguous },
+    { 0x2011, 0x2012, CodepointWidth::Narrow },
+    { 0x2013, 0x2016, CodepointWidth::Ambiguous },
+    { 0x2017, 0x2017, CodepointWidth::Narrow },
+    { 0x2018, 0x2019, CodepointWidth::Ambiguous },
+    { 0x201A, 0x201B, CodepointWidth::Narrow },
+    { 0x201C, 0x201D, CodepointWidth::Ambiguous },
+    { 0x201E, 0x201F, CodepointWidth::Narrow },
+    { 0x2020, 0x2022, CodepointWidth::Ambiguous },
+    { 0x2023, 0x2023, CodepointWidth::Narrow },
+    { 0x2024, 0x2027, CodepointWidth::Ambiguous },
+    { 0x2028, 0x202F, CodepointWidth::Narrow },
+    { 0x2030, 0x2030, CodepointWidth::Ambiguous },
+    { 0x2031, 0x2031, CodepointWidth::Narrow },
+    { 0x2032, 0x2033, CodepointWidth::Ambiguous },
+    { 0x2034, 0x2034, CodepointWidth::Narrow },
+    { 0x2035, 0x2035, CodepointWidth::Ambiguous },
+    { 0x2036, 0x203A, CodepointWidth::Narrow },
+    { 0x203B, 0x203B, CodepointWidth::Ambiguous },
+    { 0x203C, 0x203D, CodepointWidth::Narrow },
+    { 0x203E, 0x203E, CodepointWidth::Ambiguous },
+    { 0x203F, 0x2064, CodepointWidth::Narrow },
+    { 0x2066, 0x2071, CodepointWidth::Narrow },
+    { 0x2074, 0x2074, CodepointWidth::Ambiguous },
+    { 0x2075, 0x207E, CodepointWidth::Narrow },
+    { 0x207F, 0x207F, CodepointWidth::Ambiguous },
+    { 0x2080, 0x2080, CodepointWidth::Narrow },
+    { 0x2081, 0x2084, CodepointWidth::Ambiguous },
+    { 0x2085, 0x208E, CodepointWidth::Narrow },
+    { 0x2090, 0x209C, CodepointWidth::Narrow },
+    { 0x20A0, 0x20AB, CodepointWidth::Narrow },
+    { 0x20AC, 0x20AC, CodepointWidth::Ambiguous },
+    { 0x20AD, 0x20BF, CodepointWidth::Narrow },
+    { 0x20D0, 0x20F0, CodepointWidth::Narrow },
+    { 0x2100, 0x2102, CodepointWidth::Narrow },
+    { 0x2103, 0x2103, CodepointWidth::Ambiguous },
+    { 0x2104, 0x2104, CodepointWidth::Narrow },
+    { 0x2105, 0x2105, CodepointWidth::Ambiguous },
+    { 0x2106, 0x2108, CodepointWidth::Narrow },
+    { 0x2109, 0x2109, CodepointWidth::Ambiguous },
+    { 0x210A, 0x2112, CodepointWidth::Narrow },
+    { 0x2113, 0x2113, CodepointWidth::Ambiguous },
+    { 0x2114, 0x2115, CodepointWidth::Narrow },
+    { 0x2116, 0x2116, CodepointWidth::Ambiguous },
+    { 0x2117, 0x2120, CodepointWidth::Narrow },
+    { 0x2121, 0x2122, CodepointWidth::Ambiguous },
+    { 0x2123, 0x2125, CodepointWidth::Narrow },
+    { 0x2126, 0x2126, CodepointWidth::Ambiguous },
+    { 0x2127, 0x212A, CodepointWidth::Narrow },
+    { 0x212B, 0x212B, CodepointWidth::Ambiguous },
+    { 0x212C, 0x2152, CodepointWidth::Narrow },
+    { 0x2153, 0x2154, CodepointWidth::Ambiguous },
+    { 0x2155, 0x215A, CodepointWidth::Narrow },
+    { 0x215B, 0x215E, CodepointWidth::Ambiguous },
+    { 0x215F, 0x215F, CodepointWidth::Narrow },
+    { 0x2160, 0x216B, CodepointWidth::Ambiguous },
+    { 0x216C, 0x216F, CodepointWidth::Narrow },
+    { 0x2170, 0x2179, CodepointWidth::Ambiguous },
+    { 0x217A, 0x2188, CodepointWidth::Narrow },
+    { 0x2189, 0x2189, CodepointWidth::Ambiguous },
+    { 0x218A, 0x218B, CodepointWidth::Narrow },
+    { 0x2190, 0x2199, CodepointWidth::Ambiguous },
+    { 0x219A, 0x21B7, CodepointWidth::Narrow },
+    { 0x21B8, 0x21B9, CodepointWidth::Ambiguous },
+    { 0x21BA, 0x21D1, CodepointWidth::Narrow },
+    { 0x21D2, 0x21D2, CodepointWidth::Ambiguous },
+    { 0x21D3, 0x21D3, CodepointWidth::Narrow },
+    { 0x21D4, 0x21D4, CodepointWidth::Ambiguous },
+    { 0x21D5, 0x21E6, CodepointWidth::Narrow },
+    { 0x21E7, 0x21E7, CodepointWidth::Ambiguous },
+    { 0x21E8, 0x21FF, CodepointWidth::Narrow },
+    { 0x2200, 0x2200, CodepointWidth::Ambiguous },
+    { 0x2201, 0x2201, CodepointWidth::Narrow },
+    { 0x2202, 0x2203, CodepointWidth::Ambiguous },
+    { 0x2204, 0x2206, CodepointWidth::Narrow },
+    { 0x2207, 0x2208, CodepointWidth::Ambiguous },
+    { 0x2209, 0x220A, CodepointWidth::Narrow },
+    { 0x220B, 0x220B, CodepointWidth::Ambiguous },
+    { 0x220C, 0x220E, CodepointWidth::Narrow },
+    { 0x220F, 0x220F, CodepointWidth::Ambiguous },
+    { 0x2210, 0x2210, CodepointWidth::Narrow },
+    { 0x2211, 0x2211, CodepointWidth::Ambiguous },
+    { 0x2212, 0x2214, CodepointWidth::Narrow },
+    { 0x2215, 0x2215, CodepointWidth::Ambiguous },
+    { 0x2216, 0x2219, CodepointWidth::Narrow },
+    { 0x221A, 0x221A, CodepointWidth::Ambiguous },
+    { 0x221B, 0x221C, CodepointWidth::Narrow },
+    { 0x221D, 0x2220, CodepointWidth::Ambiguous },
+    { 0x2221, 0x2222, CodepointWidth::Narrow },
+    { 0x2223, 0x2223, CodepointWidth::Ambiguous },
+    { 0x2224, 0x2224, CodepointWidth::Narrow },
+    { 0x2225, 0x2225, CodepointWidth::Ambiguous },
+    { 0x2226, 0x2226, CodepointWidth::Narrow },
+    { 0x2227, 0x222C, CodepointWidth::Ambiguous },
+    { 0x222D, 0x222D, CodepointWidth::Narrow },
+    { 0x222E, 0x222E, CodepointWidth::Ambiguous },
+    { 0x222F, 0x2233, CodepointWidth::Narrow },
+    { 0x2234, 0x2237, CodepointWidth::Ambiguous },
+    { 0x2238, 0x223B, CodepointWidth::Narrow },
+    { 0x223C, 0x223D, CodepointWidth::Ambiguous },
+    { 0x223E, 0x2247, CodepointWidth::Narrow },
+    { 0x2248, 0x2248, CodepointWidth::Ambiguous },
+    { 0x2249, 0x224B, CodepointWidth::Narrow },
+    { 0x224C, 0x224C, CodepointWidth::Ambiguous },
+    { 0x224D, 0x2251, CodepointWidth::Narrow },
+    { 0x2252, 0x2252, CodepointWidth::Ambiguous },
+    { 0x2253, 0x225F, CodepointWidth::Narrow },
+    { 0x2260, 0x2261, CodepointWidth::Ambiguous },
+    { 0x2262, 0x2263, CodepointWidth::Narrow },
+    { 0x2264, 0x2267, CodepointWidth::Ambiguous },
+    { 0x2268, 0x2269, CodepointWidth::Narrow },
+    { 0x226A, 0x226B, CodepointWidth::Ambiguous },
+    { 0x226C, 0x226D, CodepointWidth::Narrow },
+    { 0x226E, 0x226F, CodepointWidth::Ambiguous },
+    { 0x2270, 0x2281, CodepointWidth::Narrow },
+    { 0x2282, 0x2283, CodepointWidth::Ambiguous },
+    { 0x2284, 0x2285, CodepointWidth::Narrow },
+    { 0x2286, 0x2287, CodepointWidth::Ambiguous },
+    { 0x2288, 0x2294, CodepointWidth::Narrow },
+    { 0x2295, 0x2295, CodepointWidth::Ambiguous },
+    { 0x2296, 0x2298, CodepointWidth::Narrow },
+    { 0x2299, 0x2299, CodepointWidth::Ambiguous },
+    { 0x229A, 0x22A4, CodepointWidth::Narrow },
+    { 0x22A5, 0x22A5, CodepointWidth::Ambiguous },
+    { 0x22A6, 0x22BE, CodepointWidth::Narrow },
+    { 0x22BF, 0x22BF, CodepointWidth::Ambiguous },
+    { 0x22C0, 0x2311, CodepointWidth::Narrow },
+    { 0x2312, 0x2312, CodepointWidth::Ambiguous },
+    { 0x2313, 0x2319, CodepointWidth::Narrow },
+    { 0x231A, 0x231B, CodepointWidth::Wide },
+    { 0x231C, 0x2328, CodepointWidth::Narrow },
+    { 0x2329, 0x232A, CodepointWidth::Wide },
+    { 0x232B, 0x23E8, CodepointWidth::Narrow },
+    { 0x23E9, 0x23EC, CodepointWidth::Wide },
+    { 0x23ED, 0x23EF, CodepointWidth::Narrow },
+    { 0x23F0, 0x23F0, CodepointWidth::Wide },
+    { 0x23F1, 0x23F2, CodepointWidth::Narrow },
+    { 0x23F3, 0x23F3, CodepointWidth::Wide },
+    { 0x23F4, 0x2426, CodepointWidth::Narrow },
+    { 0x2440, 0x244A, CodepointWidth::Narrow },
+    { 0x2460, 0x24E9, CodepointWidth::Ambiguous },
+    { 0x24EA, 0x24EA, CodepointWidth::Narrow },
+    { 0x24EB, 0x254B, CodepointWidth::Ambiguous },
+    { 0x254C, 0x254F, CodepointWidth::Narrow },
+    { 0x2550, 0x2573, CodepointWidth::Ambiguous },
+    { 0x2574, 0x257F, CodepointWidth::Narrow },
+    { 0x2580, 0x258F, CodepointWidth::Ambiguous },
+    { 0x2590, 0x2591, CodepointWidth::Narrow },
+    { 0x2592, 0x2595, CodepointWidth::Ambiguous },
+    { 0x2596, 0x259F, CodepointWidth::Narrow },
+    { 0x25A0, 0x25A1, CodepointWidth::Ambiguous },
+    { 0x25A2, 0x25A2, CodepointWidth::Narrow },
+    { 0x25A3, 0x25A9, CodepointWidth::Ambiguous },
+    { 0x25AA, 0x25B1, CodepointWidth::Narrow },
+    { 0x25B2, 0x25B3, CodepointWidth::Ambiguous },
+    { 0x25B4, 0x25B5, CodepointWidth::Narrow },
+    { 0x25B6, 0x25B7, CodepointWidth::Ambiguous },
+    { 0x25B8, 0x25BB, CodepointWidth::Narrow },
+    { 0x25BC, 0x25BD, CodepointWidth::Ambiguous },
+    { 0x25BE, 0x25BF, CodepointWidth::Narrow },
+    { 0x25C0, 0x25C1, CodepointWidth::Ambiguous },
+    { 0x25C2, 0x25C5, CodepointWidth::Narrow },
+    { 0x25C6, 0x25C8, CodepointWidth::Ambiguous },
+    { 0x25C9, 0x25CA, CodepointWidth::Narrow },
+    { 0x25CB, 0x25CB, CodepointWidth::Ambiguous },
+    { 0x25CC, 0x25CD, CodepointWidth::Narrow },
+    { 0x25CE, 0x25D1, CodepointWidth::Ambiguous },
+    { 0x25D2, 0x25E1, CodepointWidth::Narrow },
+    { 0x25E2, 0x25E5, CodepointWidth::Ambiguous },
+    { 0x25E6, 0x25EE, CodepointWidth::Narrow },
+    { 0x25EF, 0x25EF, CodepointWidth::Ambiguous },
+    { 0x25F0, 0x25FC, CodepointWidth::Narrow },
+    { 0x25FD, 0x25FE, CodepointWidth::Wide },
+    { 0x25FF, 0x2604, CodepointWidth::Narrow },
+    { 0x2605, 0x2606, CodepointWidth::Ambiguous },
+    { 0x2607, 0x2608, CodepointWidth::Narrow },
+    { 0x2609, 0x2609, CodepointWidth::Ambiguous },
+    { 0x260A, 0x260D, CodepointWidth::Narrow },
+    { 0x260E, 0x260F, CodepointWidth::Ambiguous },
+    { 0x2610, 0x2613, CodepointWidth::Narrow },
+    { 0x2614, 0x2615, CodepointWidth::Wide },
+    { 0x2616, 0x261B, CodepointWidth::Narrow },
+    { 0x261C, 0x261C, CodepointWidth::Ambiguous },
+    { 0x261D, 0x261D, CodepointWidth::Narrow },
+    { 0x261E, 0x261E, CodepointWidth::Ambiguous },
+    { 0x261F, 0x263F, CodepointWidth::Narrow },
+    { 0x2640, 0x2640, CodepointWidth::Ambiguous },
+    { 0x2641, 0x2641, CodepointWidth::Narrow },
+    { 0x2642, 0x2642, CodepointWidth::Ambiguous },
+    { 0x2643, 0x2647, CodepointWidth::Narrow },
+    { 0x2648, 0x2653, CodepointWidth::Wide },
+    { 0x2654, 0x265F, CodepointWidth::Narrow },
+    { 0x2660, 0x2661, CodepointWidth::Ambiguous },
+    { 0x2662, 0x2662, CodepointWidth::Narrow },
+    { 0x2663, 0x2665, CodepointWidth::Ambiguous },
+    { 0x2666, 0x2666, CodepointWidth::Narrow },
+    { 0x2667, 0x266A, CodepointWidth::Ambiguous },
+    { 0x266B, 0x266B, CodepointWidth::Narrow },
+    { 0x266C, 0x266D, CodepointWidth::Ambiguous },
+    { 0x266E, 0x266E, CodepointWidth::Narrow },
+    { 0x266F, 0x266F, CodepointWidth::Ambiguous },
+    { 0x2670, 0x267E, CodepointWidth::Narrow },
+    { 0x267F, 0x267F, CodepointWidth::Wide },
+    { 0x2680, 0x2692, CodepointWidth::Narrow },
+    { 0x2693, 0x2693, CodepointWidth::Wide },
+    { 0x2694, 0x269D, CodepointWidth::Narrow },
+    { 0x269E, 0x269F, CodepointWidth::Ambiguous },
+    { 0x26A0, 0x26A0, CodepointWidth::Narrow },
+    { 0x26A1, 0x26A1, CodepointWidth::Wide },
+    { 0x26A2, 0x26A9, CodepointWidth::Narrow },
+    { 0x26AA, 0x26AB, CodepointWidth::Wide },
+    { 0x26AC, 0x26BC, CodepointWidth::Narrow },
+    { 0x26BD, 0x26BE, CodepointWidth::Wide },
+    { 0x26BF, 0x26BF, CodepointWidth::Ambiguous },
+    { 0x26C0, 0x26C3, CodepointWidth::Narrow },
+    { 0x26C4, 0x26C5, CodepointWidth::Wide },
+    { 0x26C6, 0x26CD, CodepointWidth::Ambiguous },
+    { 0x26CE, 0x26CE, CodepointWidth::Wide },
+    { 0x26CF, 0x26D3, CodepointWidth::Ambiguous },
+    { 0x26D4, 0x26D4, CodepointWidth::Wide },
+    { 0x26D5, 0x26E1, CodepointWidth::Ambiguous },
+    { 0x26E2, 0x26E2, CodepointWidth::Narrow },
+    { 0x26E3, 0x26E3, CodepointWidth::Ambiguous },
+    { 0x26E4, 0x26E7, CodepointWidth::Narrow },
+    { 0x26E8, 0x26E9, CodepointWidth::Ambiguous },
+    { 0x26EA, 0x26EA, CodepointWidth::Wide },
+    { 0x26EB, 0x26F1, CodepointWidth::Ambiguous },
+    { 0x26F2, 0x26F3, CodepointWidth::Wide },
+    { 0x26F4, 0x26F4, CodepointWidth::Ambiguous },
+    { 0x26F5, 0x26F5, CodepointWidth::Wide },
+    { 0x26F6, 0x26F9, CodepointWidth::Ambiguous },
+    { 0x26FA, 0x26FA, CodepointWidth::Wide },
+    { 0x26FB, 0x26FC, CodepointWidth::Ambiguous },
+    { 0x26FD, 0x26FD, CodepointWidth::Wide },
+    { 0x26FE, 0x26FF, CodepointWidth::Ambiguous },
+    { 0x2700, 0x2704, CodepointWidth::Narrow },
+    { 0x2705, 0x2705, CodepointWidth::Wide },
+    { 0x2706, 0x2709, CodepointWidth::Narrow },
+    { 0x270A, 0x270B, CodepointWidth::Wide },
+    { 0x270C, 0x2727, CodepointWidth::Narrow },
+    { 0x2728, 0x2728, CodepointWidth::Wide },
+    { 0x2729, 0x273C, CodepointWidth::Narrow },
+    { 0x273D, 0x273D, CodepointWidth::Ambiguous },
+    { 0x273E, 0x274B, CodepointWidth::Narrow },
+    { 0x274C, 0x274C, CodepointWidth::Wide },
+    { 0x274D, 0x274D, CodepointWidth::Narrow },
+    { 0x274E, 0x274E, CodepointWidth::Wide },
+    { 0x274F, 0x2752, CodepointWidth::Narrow },
+    { 0x2753, 0x2755, CodepointWidth::Wide },
+    { 0x2756, 0x2756, CodepointWidth::Narrow },
+    { 0x2757, 0x2757, CodepointWidth::Wide },
+    { 0x2758, 0x2775, CodepointWidth::Narrow },
+    { 0x2776, 0x277F, CodepointWidth::Ambiguous },
+    { 0x2780, 0x2794, CodepointWidth::Narrow },
+    { 0x2795, 0x2797, CodepointWidth::Wide },
+    { 0x2798, 0x27AF, CodepointWidth::Narrow },
+    { 0x27B0, 0x27B0, CodepointWidth::Wide },
+    { 0x27B1, 0x27BE, CodepointWidth::Narrow },
+    { 0x27BF, 0x27BF, CodepointWidth::Wide },
+    { 0x27C0, 0x2B1A, CodepointWidth::Narrow },
+    { 0x2B1B, 0x2B1C, CodepointWidth::Wide },
+    { 0x2B1D, 0x2B4F, CodepointWidth::Narrow },
+    { 0x2B50, 0x2B50, CodepointWidth::Wide },
+    { 0x2B51, 0x2B54, CodepointWidth::Narrow },
+    { 0x2B55, 0x2B55, CodepointWidth::Wide },
+    { 0x2B56, 0x2B59, CodepointWidth::Ambiguous },
+    { 0x2B5A, 0x2B73, CodepointWidth::Narrow },
+    { 0x2B76, 0x2B95, CodepointWidth::Narrow },
+    { 0x2B98, 0x2BB9, CodepointWidth::Narrow },
+    { 0x2BBD, 0x2BC8, CodepointWidth::Narrow },
+    { 0x2BCA, 0x2BD2, CodepointWidth::Narrow },
+    { 0x2BEC, 0x2BEF, CodepointWidth::Narrow },
+    { 0x2C00, 0x2C2E, CodepointWidth::Narrow },
+    { 0x2C30, 0x2C5E, CodepointWidth::Narrow },
+    { 0x2C60, 0x2CF3, CodepointWidth::Narrow },
+    { 0x2CF9, 0x2D25, CodepointWidth::Narrow },
+    { 0x2D27, 0x2D27, CodepointWidth::Narrow },
+    { 0x2D2D, 0x2D2D, CodepointWidth::Narrow },
+    { 0x2D30, 0x2D67, CodepointWidth::Narrow },
+    { 0x2D6F, 0x2D70, CodepointWidth::Narrow },
+    { 0x2D7F, 0x2D96, CodepointWidth::Narrow },
+    { 0x2DA0, 0x2DA6, CodepointWidth::Narrow },
+    { 0x2DA8, 0x2DAE, CodepointWidth::Narrow },
+    { 0x2DB0, 0x2DB6, CodepointWidth::Narrow },
+    { 0x2DB8, 0x2DBE, CodepointWidth::Narrow },
+    { 0x2DC0, 0x2DC6, CodepointWidth::Narrow },
+    { 0x2DC8, 0x2DCE, CodepointWidth::Narrow },
+    { 0x2DD0, 0x2DD6, CodepointWidth::Narrow },
+    { 0x2DD8, 0x2DDE, CodepointWidth::Narrow },
+    { 0x2DE0, 0x2E49, CodepointWidth::Narrow },
+    { 0x2E80, 0x2E99, CodepointWidth::Wide },
+    { 0x2E9B, 0x2EF3, CodepointWidth::Wide },
+    { 0x2F00, 0x2FD5, CodepointWidth::Wide },
+    { 0x2FF0, 0x2FFB, CodepointWidth::Wide },
+    { 0x3000, 0x303E, CodepointWidth::Wide },
+    { 0x303F, 0x303F, CodepointWidth::Narrow },
+    { 0x3041, 0x3096, CodepointWidth::Wide },
+    { 0x3099, 0x30FF, CodepointWidth::Wide },
+    { 0x3105, 0x312E, CodepointWidth::Wide },
+    { 0x3131, 0x318E, CodepointWidth::Wide },
+    { 0x3190, 0x31BA, CodepointWidth::Wide },
+    { 0x31C0, 0x31E3, CodepointWidth::Wide },
+    { 0x31F0, 0x321E, CodepointWidth::Wide },
+    { 0x3220, 0x3247, CodepointWidth::Wide },
+    { 0x3248, 0x324F, CodepointWidth::Ambiguous },
+    { 0x3250, 0x32FE, CodepointWidth::Wide },
+    { 0x3300, 0x4DBF, CodepointWidth::Wide },
+    { 0x4DC0, 0x4DFF, CodepointWidth::Narrow },
+    { 0x4E00, 0xA48C, CodepointWidth::Wide },
+    { 0xA490, 0xA4C6, CodepointWidth::Wide },
+    { 0xA4D0, 0xA62B, CodepointWidth::Narrow },
+    { 0xA640, 0xA6F7, CodepointWidth::Narrow },
+    { 0xA700, 0xA7AE, CodepointWidth::Narrow },
+    { 0xA7B0, 0xA7B7, CodepointWidth::Narrow },
+    { 0xA7F7, 0xA82B, CodepointWidth::Narrow },
+    { 0xA830, 0xA839, CodepointWidth::Narrow },
+    { 0xA840, 0xA877, CodepointWidth::Narrow },
+    { 0xA880, 0xA8C5, CodepointWidth::Narrow },
+    { 0xA8CE, 0xA8D9, CodepointWidth::Narrow },
+    { 0xA8E0, 0xA8FD, CodepointWidth::Narrow },
+    { 0xA900, 0xA953, CodepointWidth::Narrow },
+    { 0xA95F, 0xA95F, CodepointWidth::Narrow },
+    { 0xA960, 0xA97C, CodepointWidth::Wide },
+    { 0xA980, 0xA9CD, CodepointWidth::Narrow },
+    { 0xA9CF, 0xA9D9, CodepointWidth::Narrow },
+    { 0xA9DE, 0xA9FE, CodepointWidth::Narrow },
+    { 0xAA00, 0xAA36, CodepointWidth::Narrow },
+    { 0xAA40, 0xAA4D, CodepointWidth::Narrow },
+    { 0xAA50, 0xAA59, CodepointWidth::Narrow },
+    { 0xAA5C, 0xAAC2, CodepointWidth::Narrow },
+    { 0xAADB, 0xAAF6, CodepointWidth::Narrow },
+    { 0xAB01, 0xAB06, CodepointWidth::Narrow },
+    { 0xAB09, 0xAB0E, CodepointWidth::Narrow },
+    { 0xAB11, 0xAB16, CodepointWidth::Narrow },
+    { 0xAB20, 0xAB26, CodepointWidth::Narrow },
+    { 0xAB28, 0xAB2E, CodepointWidth::Narrow },
+    { 0xAB30, 0xAB65, CodepointWidth::Narrow },
+    { 0xAB70, 0xABED, CodepointWidth::Narrow },
+    { 0xABF0, 0xABF9, CodepointWidth::Narrow },
+    { 0xAC00, 0xD7A3, CodepointWidth::Wide },
+    { 0xD7B0, 0xD7C6, CodepointWidth::Narrow },
+    { 0xD7CB, 0xD7FB, CodepointWidth::Narrow },
+    { 0xD800, 0xDFFF, CodepointWidth::Narrow },
+    { 0xE000, 0xF8FF, CodepointWidth::Ambiguous },
+    { 0xF900, 0xFAFF, CodepointWidth::Wide },
+    { 0xFB00, 0xFB06, CodepointWidth::Narrow },
+    { 0xFB13, 0xFB17, CodepointWidth::Narrow },
+    { 0xFB1D, 0xFB36, CodepointWidth::Narrow },
+    { 0xFB38, 0xFB3C, CodepointWidth::Narrow },
+    { 0xFB3E, 0xFB3E, CodepointWidth::Narrow },
+    { 0xFB40, 0xFB41, CodepointWidth::Narrow },
+    { 0xFB43, 0xFB44, CodepointWidth::Narrow },
+    { 0xFB46, 0xFBC1, CodepointWidth::Narrow },
+    { 0xFBD3, 0xFD3F, CodepointWidth::Narrow },
+    { 0xFD50, 0xFD8F, CodepointWidth::Narrow },
+    { 0xFD92, 0xFDC7, CodepointWidth::Narrow },
+    { 0xFDF0, 0xFDFD, CodepointWidth::Narrow },
+    { 0xFE00, 0xFE0F, CodepointWidth::Ambiguous },
+    { 0xFE10, 0xFE19, CodepointWidth::Wide },
+    { 0xFE20, 0xFE2F, CodepointWidth::Narrow },
+    { 0xFE30, 0xFE52, CodepointWidth::Wide },
+    { 0xFE54, 0xFE66, CodepointWidth::Wide },
+    { 0xFE68, 0xFE6B, CodepointWidth::Wide },
+    { 0xFE70, 0xFE74, CodepointWidth::Narrow },
+    { 0xFE76, 0xFEFC, CodepointWidth::Narrow },
+    { 0xFEFF, 0xFEFF, CodepointWidth::Narrow },
+    { 0xFF01, 0xFF60, CodepointWidth::Wide },
+    { 0xFF61, 0xFFBE, CodepointWidth::Narrow },
+    { 0xFFC2, 0xFFC7, CodepointWidth::Narrow },
+    { 0xFFCA, 0xFFCF, CodepointWidth::Narrow },
+    { 0xFFD2, 0xFFD7, CodepointWidth::Narrow },
+    { 0xFFDA, 0xFFDC, CodepointWidth::Narrow },
+    { 0xFFE0, 0xFFE6, CodepointWidth::Wide },
+    { 0xFFE8, 0xFFEE, CodepointWidth::Narrow },
+    { 0xFFF9, 0xFFFC, CodepointWidth::Narrow },
+    { 0xFFFD, 0xFFFD, CodepointWidth::Ambiguous },
+    { 0x10000, 0x1000B, CodepointWidth::Narrow },
+    { 0x1000D, 0x10026, CodepointWidth::Narrow },
+    { 0x10028, 0x1003A, CodepointWidth::Narrow },
+    { 0x1003C, 0x1003D, CodepointWidth::Narrow },
+    { 0x1003F, 0x1004D, CodepointWidth::Narrow },
+    { 0x10050, 0x1005D, CodepointWidth::Narrow },
+    { 0x10080, 0x100FA, CodepointWidth::Narrow },
+    { 0x10100, 0x10102, CodepointWidth::Narrow },
+    { 0x10107, 0x10133, CodepointWidth::Narrow },
+    { 0x10137, 0x1018E, CodepointWidth::Narrow },
+    { 0x10190, 0x1019B, CodepointWidth::Narrow },
+    { 0x101A0, 0x101A0, CodepointWidth::Narrow },
+    { 0x101D0, 0x101FD, CodepointWidth::Narrow },
+    { 0x10280, 0x1029C, CodepointWidth::Narrow },
+    { 0x102A0, 0x102D0, CodepointWidth::Narrow },
+    { 0x102E0, 0x102FB, CodepointWidth::Narrow },
+    { 0x10300, 0x10323, CodepointWidth::Narrow },
+    { 0x1032D, 0x1034A, CodepointWidth::Narrow },
+    { 0x10350, 0x1037A, CodepointWidth::Narrow },
+    { 0x10380, 0x1039D, CodepointWidth::Narrow },
+    { 0x1039F, 0x103C3, CodepointWidth::Narrow },
+    { 0x103C8, 0x103D5, CodepointWidth::Narrow },
+    { 0x10400, 0x1049D, CodepointWidth::Narrow },
+    { 0x104A0, 0x104A9, CodepointWidth::Narrow },
+    { 0x104B0, 0x104D3, CodepointWidth::Narrow },
+    { 0x104D8, 0x104FB, CodepointWidth::Narrow },
+    { 0x10500, 0x10527, CodepointWidth::Narrow },
+    { 0x10530, 0x10563, CodepointWidth::Narrow },
+    { 0x1056F, 0x1056F, CodepointWidth::Narrow },
+    { 0x10600, 0x10736, CodepointWidth::Narrow },
+    { 0x10740, 0x10755, CodepointWidth::Narrow },
+    { 0x10760, 0x10767, CodepointWidth::Narrow },
+    { 0x10800, 0x10805, CodepointWidth::Narrow },
+    { 0x10808, 0x10808, CodepointWidth::Narrow },
+    { 0x1080A, 0x10835, CodepointWidth::Narrow },
+    { 0x10837, 0x10838, CodepointWidth::Narrow },
+    { 0x1083C, 0x1083C, CodepointWidth::Narrow },
+    { 0x1083F, 0x10855, CodepointWidth::Narrow },
+    { 0x10857, 0x1089E, CodepointWidth::Narrow },
+    { 0x108A7, 0x108AF, CodepointWidth::Narrow },
+    { 0x108E0, 0x108F2, CodepointWidth::Narrow },
+    { 0x108F4, 0x108F5, CodepointWidth::Narrow },
+    { 0x108FB, 0x1091B, CodepointWidth::Narrow },
+    { 0x1091F, 0x10939, CodepointWidth::Narrow },
+    { 0x1093F, 0x1093F, CodepointWidth::Narrow },
+    { 0x10980, 0x109B7, CodepointWidth::Narrow },
+    { 0x109BC, 0x109CF, CodepointWidth::Narrow },
+    { 0x109D2, 0x10A03, CodepointWidth::Narrow },
+    { 0x10A05, 0x10A06, CodepointWidth::Narrow },
+    { 0x10A0C, 0x10A13, CodepointWidth::Narrow },
+    { 0x10A15, 0x10A17, CodepointWidth::Narrow },
+    { 0x10A19, 0x10A33, CodepointWidth::Narrow },
+    { 0x10A38, 0x10A3A, CodepointWidth::Narrow },
+    { 0x10A3F, 0x10A47, CodepointWidth::Narrow },
+    { 0x10A50, 0x10A58, CodepointWidth::Narrow },
+    { 0x10A60, 0x10A9F, CodepointWidth::Narrow },
+    { 0x10AC0, 0x10AE6, CodepointWidth::Narrow },
+    { 0x10AEB, 0x10AF6, CodepointWidth::Narrow },
+    { 0x10B00, 0x10B35, CodepointWidth::Narrow },
+    { 0x10B39, 0x10B55, CodepointWidth::Narrow },
+    { 0x10B58, 0x10B72, CodepointWidth::Narrow },
+    { 0x10B78, 0x10B91, CodepointWidth::Narrow },
+    { 0x10B99, 0x10B9C, CodepointWidth::Narrow },
+    { 0x10BA9, 0x10BAF, CodepointWidth::Narrow },
+    { 0x10C00, 0x10C48, CodepointWidth::Narrow },
+    { 0x10C80, 0x10CB2, CodepointWidth::Narrow },
+    { 0x10CC0, 0x10CF2, CodepointWidth::Narrow },
+    { 0x10CFA, 0x10CFF, CodepointWidth::Narrow },
+    { 0x10E60, 0x10E7E, CodepointWidth::Narrow },
+    { 0x11000, 0x1104D, CodepointWidth::Narrow },
+    { 0x11052, 0x1106F, CodepointWidth::Narrow },
+    { 0x1107F, 0x110C1, CodepointWidth::Narrow },
+    { 0x110D0, 0x110E8, CodepointWidth::Narrow },
+    { 0x110F0, 0x110F9, CodepointWidth::Narrow },
+    { 0x11100, 0x11134, CodepointWidth::Narrow },
+    { 0x11136, 0x11143, CodepointWidth::Narrow },
+    { 0x11150, 0x11176, CodepointWidth::Narrow },
+    { 0x11180, 0x111CD, CodepointWidth::Narrow },
+    { 0x111D0, 0x111DF, CodepointWidth::Narrow },
+    { 0x111E1, 0x111F4, CodepointWidth::Narrow },
+    { 0x11200, 0x11211, CodepointWidth::Narrow },
+    { 0x11213, 0x1123E, CodepointWidth::Narrow },
+    { 0x11280, 0x11286, CodepointWidth::Narrow },
+    { 0x11288, 0x11288, CodepointWidth::Narrow },
+    { 0x1128A, 0x1128D, CodepointWidth::Narrow },
+    { 0x1128F, 0x1129D, CodepointWidth::Narrow },
+    { 0x1129F, 0x112A9, CodepointWidth::Narrow },
+    { 0x112B0, 0x112EA, CodepointWidth::Narrow },
+    { 0x112F0, 0x112F9, CodepointWidth::Narrow },
+    { 0x11300, 0x11303, CodepointWidth::Narrow },
+    { 0x11305, 0x1130C, CodepointWidth::Narrow },
+    { 0x1130F, 0x11310, CodepointWidth::Narrow },
+    { 0x11313, 0x11328, CodepointWidth::Narrow },
+    { 0x1132A, 0x11330, CodepointWidth::Narrow },
+    { 0x11332, 0x11333, CodepointWidth::Narrow },
+    { 0x11335, 0x11339, CodepointWidth::Narrow },
+    { 0x1133C, 0x11344, CodepointWidth::Narrow },
+    { 0x11347, 0x11348, CodepointWidth::Narrow },
+    { 0x1134B, 0x1134D, CodepointWidth::Narrow },
+    { 0x11350, 0x11350, CodepointWidth::Narrow },
+    { 0x11357, 0x11357, CodepointWidth::Narrow },
+    { 0x1135D, 0x11363, CodepointWidth::Narrow },
+    { 0x11366, 0x1136C, CodepointWidth::Narrow },
+    { 0x11370, 0x11374, CodepointWidth::Narrow },
+    { 0x11400, 0x11459, CodepointWidth::Narrow },
+    { 0x1145B, 0x1145B, CodepointWidth::Narrow },
+    { 0x1145D, 0x1145D, CodepointWidth::Narrow },
+    { 0x11480, 0x114C7, CodepointWidth::Narrow },
+    { 0x114D0, 0x114D9, CodepointWidth::Narrow },
+    { 0x11580, 0x115B5, CodepointWidth::Narrow },
+    { 0x115B8, 0x115DD, CodepointWidth::Narrow },
+    { 0x11600, 0x11644, CodepointWidth::Narrow },
+    { 0x11650, 0x11659, CodepointWidth::Narrow },
+    { 0x11660, 0x1166C, CodepointWidth::Narrow },
+    { 0x11680, 0x116B7, CodepointWidth::Narrow },
+    { 0x116C0, 0x116C9, CodepointWidth::Narrow },
+    { 0x11700, 0x11719, CodepointWidth::Narrow },
+    { 0x1171D, 0x1172B, CodepointWidth::Narrow },
+    { 0x11730, 0x1173F, CodepointWidth::Narrow },
+    { 0x118A0, 0x118F2, CodepointWidth::Narrow },
+    { 0x118FF, 0x118FF, CodepointWidth::Narrow },
+    { 0x11A00, 0x11A47, CodepointWidth::Narrow },
+    { 0x11A50, 0x11A83, CodepointWidth::Narrow },
+    { 0x11A86, 0x11A9C, CodepointWidth::Narrow },
+    { 0x11A9E, 0x11AA2, CodepointWidth::Narrow },
+    { 0x11AC0, 0x11AF8, CodepointWidth::Narrow },
+    { 0x11C00, 0x11C08, CodepointWidth::Narrow },
+    { 0x11C0A, 0x11C36, CodepointWidth::Narrow },
+    { 0x11C38, 0x11C45, CodepointWidth::Narrow },
+    { 0x11C50, 0x11C6C, CodepointWidth::Narrow },
+    { 0x11C70, 0x11C8F, CodepointWidth::Narrow },
+    { 0x11C92, 0x11CA7, CodepointWidth::Narrow },
+    { 0x11CA9, 0x11CB6, CodepointWidth::Narrow },
+    { 0x11D00, 0x11D06, CodepointWidth::Narrow },
+    { 0x11D08, 0x11D09, CodepointWidth::Narrow },
+    { 0x11D0B, 0x11D36, CodepointWidth::Narrow },
+    { 0x11D3A, 0x11D3A, CodepointWidth::Narrow },
+    { 0x11D3C, 0x11D3D, CodepointWidth::Narrow },
+    { 0x11D3F, 0x11D47, CodepointWidth::Narrow },
+    { 0x11D50, 0x11D59, CodepointWidth::Narrow },
+    { 0x12000, 0x12399, CodepointWidth::Narrow },
+    { 0x12400, 0x1246E, CodepointWidth::Narrow },
+    { 0x12470, 0x12474, CodepointWidth::Narrow },
+    { 0x12480, 0x12543, CodepointWidth::Narrow },
+    { 0x13000, 0x1342E, CodepointWidth::Narrow },
+    { 0x14400, 0x14646, CodepointWidth::Narrow },
+    { 0x16800, 0x16A38, CodepointWidth::Narrow },
+    { 0x16A40, 0x16A5E, CodepointWidth::Narrow },
+    { 0x16A60, 0x16A69, CodepointWidth::Narrow },
+    { 0x16A6E, 0x16A6F, CodepointWidth::Narrow },
+    { 0x16AD0, 0x16AED, CodepointWidth::Narrow },
+    { 0x16AF0, 0x16AF5, CodepointWidth::Narrow },
+    { 0x16B00, 0x16B45, CodepointWidth::Narrow },
+    { 0x16B50, 0x16B59, CodepointWidth::Narrow },
+    { 0x16B5B, 0x16B61, CodepointWidth::Narrow },
+    { 0x16B63, 0x16B77, CodepointWidth::Narrow },
+    { 0x16B7D, 0x16B8F, CodepointWidth::Narrow },
+    { 0x16F00, 0x16F44, CodepointWidth::Narrow },
+    { 0x16F50, 0x16F7E, CodepointWidth::Narrow },
+    { 0x16F8F, 0x16F9F, CodepointWidth::Narrow },
+    { 0x16FE0, 0x16FE1, CodepointWidth::Wide },
+    { 0x17000, 0x187EC, CodepointWidth::Wide },
+    { 0x18800, 0x18AF2, CodepointWidth::Wide },
+    { 0x1B000, 0x1B11E, CodepointWidth::Wide },
+    { 0x1B170, 0x1B2FB, CodepointWidth::Wide },
+    { 0x1BC00, 0x1BC6A, CodepointWidth::Narrow },
+    { 0x1BC70, 0x1BC7C, CodepointWidth::Narrow },
+    { 0x1BC80, 0x1BC88, CodepointWidth::Narrow },
+    { 0x1BC90, 0x1BC99, CodepointWidth::Narrow },
+    { 0x1BC9C, 0x1BCA3, CodepointWidth::Narrow },
+    { 0x1D000, 0x1D0F5, CodepointWidth::Narrow },
+    { 0x1D100, 0x1D126, CodepointWidth::Narrow },
+    { 0x1D129, 0x1D1E8, CodepointWidth::Narrow },
+    { 0x1D200, 0x1D245, CodepointWidth::Narrow },
+    { 0x1D300, 0x1D356, CodepointWidth::Narrow },
+    { 0x1D360, 0x1D371, CodepointWidth::Narrow },
+    { 0x1D400, 0x1D454, CodepointWidth::Narrow },
+    { 0x1D456, 0x1D49C, CodepointWidth::Narrow },
+    { 0x1D49E, 0x1D49F, CodepointWidth::Narrow },
+    { 0x1D4A2, 0x1D4A2, CodepointWidth::Narrow },
+    { 0x1D4A5, 0x1D4A6, CodepointWidth::Narrow },
+    { 0x1D4A9, 0x1D4AC, CodepointWidth::Narrow },
+    { 0x1D4AE, 0x1D4B9, CodepointWidth::Narrow },
+    { 0x1D4BB, 0x1D4BB, CodepointWidth::Narrow },
+    { 0x1D4BD, 0x1D4C3, CodepointWidth::Narrow },
+    { 0x1D4C5, 0x1D505, CodepointWidth::Narrow },
+    { 0x1D507, 0x1D50A, CodepointWidth::Narrow },
+    { 0x1D50D, 0x1D514, CodepointWidth::Narrow },
+    { 0x1D516, 0x1D51C, CodepointWidth::Narrow },
+    { 0x1D51E, 0x1D539, CodepointWidth::Narrow },
+    { 0x1D53B, 0x1D53E, CodepointWidth::Narrow },
+    { 0x1D540, 0x1D544, CodepointWidth::Narrow },
+    { 0x1D546, 0x1D546, CodepointWidth::Narrow },
+    { 0x1D54A, 0x1D550, CodepointWidth::Narrow },
+    { 0x1D552, 0x1D6A5, CodepointWidth::Narrow },
+    { 0x1D6A8, 0x1D7CB, CodepointWidth::Narrow },
+    { 0x1D7CE, 0x1DA8B, CodepointWidth::Narrow },
+    { 0x1DA9B, 0x1DA9F, CodepointWidth::Narrow },
+    { 0x1DAA1, 0x1DAAF, CodepointWidth::Narrow },
+    { 0x1E000, 0x1E006, CodepointWidth::Narrow },
+    { 0x1E008, 0x1E018, CodepointWidth::Narrow },
+    { 0x1E01B, 0x1E021, CodepointWidth::Narrow },
+    { 0x1E023, 0x1E024, CodepointWidth::Narrow },
+    { 0x1E026, 0x1E02A, CodepointWidth::Narrow },
+    { 0x1E800, 0x1E8C4, CodepointWidth::Narrow },
+    { 0x1E8C7, 0x1E8D6, CodepointWidth::Narrow },
+    { 0x1E900, 0x1E94A, CodepointWidth::Narrow },
+    { 0x1E950, 0x1E959, CodepointWidth::Narrow },
+    { 0x1E95E, 0x1E95F, CodepointWidth::Narrow },
+    { 0x1EE00, 0x1EE03, CodepointWidth::Narrow },
+    { 0x1EE05, 0x1EE1F, CodepointWidth::Narrow },
+    { 0x1EE21, 0x1EE22, CodepointWidth::Narrow },
+    { 0x1EE24, 0x1EE24, CodepointWidth::Narrow },
+    { 0x1EE27, 0x1EE27, CodepointWidth::Narrow },
+    { 0x1EE29, 0x1EE32, CodepointWidth::Narrow },
+    { 0x1EE34, 0x1EE37, CodepointWidth::Narrow },
+    { 0x1EE39, 0x1EE39, CodepointWidth::Narrow },
+    { 0x1EE3B, 0x1EE3B, CodepointWidth::Narrow },
+    { 0x1EE42, 0x1EE42, CodepointWidth::Narrow },
+    { 0x1EE47, 0x1EE47, CodepointWidth::Narrow },
+    { 0x1EE49, 0x1EE49, CodepointWidth::Narrow },
+    { 0x1EE4B, 0x1EE4B, CodepointWidth::Narrow },
+    { 0x1EE4D, 0x1EE4F, CodepointWidth::Narrow },
+    { 0x1EE51, 0x1EE52, CodepointWidth::Narrow },
+    { 0x1EE54, 0x1EE54, CodepointWidth::Narrow },
+    { 0x1EE57, 0x1EE57, CodepointWidth::Narrow },
+    { 0x1EE59, 0x1EE59, CodepointWidth::Narrow },
+    { 0x1EE5B, 0x1EE5B, CodepointWidth::Narrow },
+    { 0x1EE5D, 0x1EE5D, CodepointWidth::Narrow },
+    { 0x1EE5F, 0x1EE5F, CodepointWidth::Narrow },
+    { 0x1EE61, 0x1EE62, CodepointWidth::Narrow },
+    { 0x1EE64, 0x1EE64, CodepointWidth::Narrow },
+    { 0x1EE67, 0x1EE6A, CodepointWidth::Narrow },
+    { 0x1EE6C, 0x1EE72, CodepointWidth::Narrow },
+    { 0x1EE74, 0x1EE77, CodepointWidth::Narrow },
+    { 0x1EE79, 0x1EE7C, CodepointWidth::Narrow },
+    { 0x1EE7E, 0x1EE7E, CodepointWidth::Narrow },
+    { 0x1EE80, 0x1EE89, CodepointWidth::Narrow },
+    { 0x1EE8B, 0x1EE9B, CodepointWidth::Narrow },
+    { 0x1EEA1, 0x1EEA3, CodepointWidth::Narrow },
+    { 0x1EEA5, 0x1EEA9, CodepointWidth::Narrow },
+    { 0x1EEAB, 0x1EEBB, CodepointWidth::Narrow },
+    { 0x1EEF0, 0x1EEF1, CodepointWidth::Narrow },
+    { 0x1F000, 0x1F003, CodepointWidth::Narrow },
+    { 0x1F004, 0x1F004, CodepointWidth::Wide },
+    { 0x1F005, 0x1F02B, CodepointWidth::Narrow },
+    { 0x1F030, 0x1F093, CodepointWidth::Narrow },
+    { 0x1F0A0, 0x1F0AE, CodepointWidth::Narrow },
+    { 0x1F0B1, 0x1F0BF, CodepointWidth::Narrow },
+    { 0x1F0C1, 0x1F0CE, CodepointWidth::Narrow },
+    { 0x1F0CF, 0x1F0CF, CodepointWidth::Wide },
+    { 0x1F0D1, 0x1F0F5, CodepointWidth::Narrow },
+    { 0x1F100, 0x1F10A, CodepointWidth::Ambiguous },
+    { 0x1F10B, 0x1F10C, CodepointWidth::Narrow },
+    { 0x1F110, 0x1F12D, CodepointWidth::Ambiguous },
+    { 0x1F12E, 0x1F12E, CodepointWidth::Narrow },
+    { 0x1F130, 0x1F169, CodepointWidth::Ambiguous },
+    { 0x1F16A, 0x1F16B, CodepointWidth::Narrow },
+    { 0x1F170, 0x1F18D, CodepointWidth::Ambiguous },
+    { 0x1F18E, 0x1F18E, CodepointWidth::Wide },
+    { 0x1F18F, 0x1F190, CodepointWidth::Ambiguous },
+    { 0x1F191, 0x1F19A, CodepointWidth::Wide },
+    { 0x1F19B, 0x1F1AC, CodepointWidth::Ambiguous },
+    { 0x1F1E6, 0x1F1FF, CodepointWidth::Narrow },
+    { 0x1F200, 0x1F202, CodepointWidth::Wide },
+    { 0x1F210, 0x1F23B, CodepointWidth::Wide },
+    { 0x1F240, 0x1F248, CodepointWidth::Wide },
+    { 0x1F250, 0x1F251, CodepointWidth::Wide },
+    { 0x1F260, 0x1F265, CodepointWidth::Wide },
+    { 0x1F300, 0x1F320, CodepointWidth::Wide },
+    { 0x1F321, 0x1F32C, CodepointWidth::Narrow },
+    { 0x1F32D, 0x1F335, CodepointWidth::Wide },
+    { 0x1F336, 0x1F336, CodepointWidth::Narrow },
+    { 0x1F337, 0x1F37C, CodepointWidth::Wide },
+    { 0x1F37D, 0x1F37D, CodepointWidth::Narrow },
+    { 0x1F37E, 0x1F393, CodepointWidth::Wide },
+    { 0x1F394, 0x1F39F, CodepointWidth::Narrow },
+    { 0x1F3A0, 0x1F3CA, CodepointWidth::Wide },
+    { 0x1F3CB, 0x1F3CE, CodepointWidth::Narrow },
+    { 0x1F3CF, 0x1F3D3, CodepointWidth::Wide },
+    { 0x1F3D4, 0x1F3DF, CodepointWidth::Narrow },
+    { 0x1F3E0, 0x1F3F0, CodepointWidth::Wide },
+    { 0x1F3F1, 0x1F3F3, CodepointWidth::Narrow },
+    { 0x1F3F4, 0x1F3F4, CodepointWidth::Wide },
+    { 0x1F3F5, 0x1F3F7, CodepointWidth::Narrow },
+    { 0x1F3F8, 0x1F43E, CodepointWidth::Wide },
+    { 0x1F43F, 0x1F43F, CodepointWidth::Narrow },
+    { 0x1F440, 0x1F440, CodepointWidth::Wide },
+    { 0x1F441, 0x1F441, CodepointWidth::Narrow },
+    { 0x1F442, 0x1F4FC, CodepointWidth::Wide },
+    { 0x1F4FD, 0x1F4FE, CodepointWidth::Narrow },
+    { 0x1F4FF, 0x1F53D, CodepointWidth::Wide },
+    { 0x1F53E, 0x1F54A, CodepointWidth::Narrow },
+    { 0x1F54B, 0x1F54E, CodepointWidth::Wide },
+    { 0x1F54F, 0x1F54F, CodepointWidth::Narrow },
+    { 0x1F550, 0x1F567, CodepointWidth::Wide },
+    { 0x1F568, 0x1F579, CodepointWidth::Narrow },
+    { 0x1F57A, 0x1F57A, CodepointWidth::Wide },
+    { 0x1F57B, 0x1F594, CodepointWidth::Narrow },
+    { 0x1F595, 0x1F596, CodepointWidth::Wide },
+    { 0x1F597, 0x1F5A3, CodepointWidth::Narrow },
+    { 0x1F5A4, 0x1F5A4, CodepointWidth::Wide },
+    { 0x1F5A5, 0x1F5FA, CodepointWidth::Narrow },
+    { 0x1F5FB, 0x1F64F, CodepointWidth::Wide },
+    { 0x1F650, 0x1F67F, CodepointWidth::Narrow },
+    { 0x1F680, 0x1F6C5, CodepointWidth::Wide },
+    { 0x1F6C6, 0x1F6CB, CodepointWidth::Narrow },
+    { 0x1F6CC, 0x1F6CC, CodepointWidth::Wide },
+    { 0x1F6CD, 0x1F6CF, CodepointWidth::Narrow },
+    { 0x1F6D0, 0x1F6D2, CodepointWidth::Wide },
+    { 0x1F6D3, 0x1F6D4, CodepointWidth::Narrow },
+    { 0x1F6E0, 0x1F6EA, CodepointWidth::Narrow },
+    { 0x1F6EB, 0x1F6EC, CodepointWidth::Wide },
+    { 0x1F6F0, 0x1F6F3, CodepointWidth::Narrow },
+    { 0x1F6F4, 0x1F6F8, CodepointWidth::Wide },
+    { 0x1F700, 0x1F773, CodepointWidth::Narrow },
+    { 0x1F780, 0x1F7D4, CodepointWidth::Narrow },
+    { 0x1F800, 0x1F80B, CodepointWidth::Narrow },
+    { 0x1F810, 0x1F847, CodepointWidth::Narrow },
+    { 0x1F850, 0x1F859, CodepointWidth::Narrow },
+    { 0x1F860, 0x1F887, CodepointWidth::Narrow },
+    { 0x1F890, 0x1F8AD, CodepointWidth::Narrow },
+    { 0x1F900, 0x1F90B, CodepointWidth::Narrow },
+    { 0x1F910, 0x1F93E, CodepointWidth::Wide },
+    { 0x1F940, 0x1F94C, CodepointWidth::Wide },
+    { 0x1F950, 0x1F96B, CodepointWidth::Wide },
+    { 0x1F980, 0x1F997, CodepointWidth::Wide },
+    { 0x1F9C0, 0x1F9C0, CodepointWidth::Wide },
+    { 0x1F9D0, 0x1F9E6, CodepointWidth::Wide },
+    { 0x20000, 0x2FFFD, CodepointWidth::Wide },
+    { 0x30000, 0x3FFFD, CodepointWidth::Wide },
+    { 0xE0001, 0xE0001, CodepointWidth::Narrow },
+    { 0xE0020, 0xE007F, CodepointWidth::Narrow },
+    { 0xE0100, 0xE01EF, CodepointWidth::Ambiguous },
+    { 0xF0000, 0xFFFFD, CodepointWidth::Ambiguous },
+    { 0x100000, 0x10FFFD, CodepointWidth::Ambiguous },
+};
+
 class CodepointWidthDetectorTests
 {
     TEST_CLASS(CodepointWidthDetectorTests);
 
 
-    TEST_METHOD(CodepointWidthDetectDefersMapPopulation)
+    TEST_METHOD(TableMatchesRangesForEveryCodepoint)
     {
-        CodepointWidthDetector widthDetector;
-        VERIFY_IS_TRUE(widthDetector._map.empty());
-        widthDetector.IsWide(UNICODE_SPACE);
-        VERIFY_IS_TRUE(widthDetector._map.empty());
-        // now force checking
-        widthDetector.GetWidth(emoji);
-        VERIFY_IS_FALSE(widthDetector._map.empty());
+        auto range = eastAsianWidthRanges.cbegin();
+        for (unsigned int codepoint = 0; codepoint <= 0x10FFFF; ++codepoint)
+        {
+            while (range != eastAsianWidthRanges.cend() && std::get<1>(*range) < codepoint)
+            {
+                ++range;
+            }
+
+            const auto expected = range != eastAsianWidthRanges.cend() && std::get<0>(*range) <= codepoint ?
+                                  std::get<2>(*range) :
+                                  CodepointWidth::Invalid;
+            const auto result = CodepointWidthDetector::_lookupWidth(codepoint);
+
+            // Only verify mismatches, so a passing run doesn't log a million comparisons.
+            if (result != expected)
+            {
+                VERIFY_ARE_EQUAL(expected, result, WEX::Common::NoThrowString().Format(L"U+%04X", codepoint));
+            }
+        }
+
+        VERIFY_ARE_EQUAL(CodepointWidth::Invalid, CodepointWidthDetector::_lookupWidth(0x110000));
     }
 
     TEST_METHOD(CanLookUpEmoji)
@@ -51,15 +1160,6 @@ class CodepointWidthDetectorTests
         VERIFY_IS_TRUE(widthDetector.IsWide(emoji));
     }
 
-    TEST_METHOD(TestUnicodeRangeCompare)
-    {
-        CodepointWidthDetector::UnicodeRangeCompare compare;
-        // test comparing 2 search terms
-        CodepointWidthDetector::UnicodeRange a{ 0x10 };
-        CodepointWidthDetector::UnicodeRange b{ 0x15 };
-        VERIFY_IS_TRUE(static_cast<bool>(compare(a, b)));
-    }
-
     TEST_METHOD(CanExtractCodepoint)
     {
         CodepointWidthDetector widthDetector;
@@ -98,27 +1198,78 @@ class CodepointWidthDetectorTests
 
     TEST_METHOD(AmbiguousCache)
     {
-        // Set up a detector with fallback.
+        // Set up a detector with a fallback that counts how often it's asked.
+        size_t fallbackCalls = 0;
         CodepointWidthDetector widthDetector;
-        widthDetector.SetFallbackMethod(std::bind(&FallbackMethod, std::placeholders::_1));
-
-        // Ensure fallback cache is empty.
-        VERIFY_ARE_EQUAL(0u, widthDetector._fallbackCache.size());
+        widthDetector.SetFallbackMethod([&](const std::wstring_view glyph) {
+            ++fallbackCalls;
+            return FallbackMethod(glyph);
+        });
 
         // Lookup ambiguous width character.
-        widthDetector.IsWide(ambiguous);
+        VERIFY_ARE_EQUAL(FallbackMethod(ambiguous), widthDetector.IsWide(ambiguous));
+        VERIFY_ARE_EQUAL(1u, fallbackCalls);
 
         // Cache should hold it.
-        VERIFY_ARE_EQUAL(1u, widthDetector._fallbackCache.size());
-
-        // Cached item should match what we expect
-        const auto it = widthDetector._fallbackCache.begin();
-        VERIFY_ARE_EQUAL(ambiguous, it->first);
-        VERIFY_ARE_EQUAL(FallbackMethod(ambiguous), it->second);
+        VERIFY_ARE_EQUAL(FallbackMethod(ambiguous), widthDetector.IsWide(ambiguous));
+        VERIFY_ARE_EQUAL(1u, fallbackCalls);
+        VERIFY_ARE_EQUAL(1u, widthDetector.GetFallbackCacheStatistics().cHits);
+        VERIFY_ARE_EQUAL(1u, widthDetector.GetFallbackCacheStatistics().cMisses);
 
-        // Cache should empty when font changes.
+        // Cache should be stale when font changes.
         widthDetector.NotifyFontChanged();
-        VERIFY_ARE_EQUAL(0u, widthDetector._fallbackCache.size());
+        VERIFY_ARE_EQUAL(FallbackMethod(ambiguous), widthDetector.IsWide(ambiguous));
+        VERIFY_ARE_EQUAL(2u, fallbackCalls);
+        VERIFY_ARE_EQUAL(2u, widthDetector.GetFallbackCacheStatistics().cMisses);
+        VERIFY_ARE_EQUAL(0u, widthDetector.GetFallbackCacheStatistics().cEvictions);
+    }
+
+    TEST_METHOD(AmbiguousCacheIsBounded)
+    {
+        size_t fallbackCalls = 0;
+        CodepointWidthDetector widthDetector;
+        widthDetector.SetFallbackMethod([&](const std::wstring_view) {
+            ++fallbackCalls;
+            return true;
+        });
+
+        // Two private use codepoints, which are ambiguous, that go in the same slot.
+        const std::wstring first{ L"\xDB80\xDC00" }; // U+F0000
+        const unsigned int second = 0xF0000 + CodepointWidthDetector::s_fallbackCacheSize;
+        const std::wstring secondGlyph{ static_cast<wchar_t>(0xD800 + ((second - 0x10000) >> 10)),
+                                        static_cast<wchar_t>(0xDC00 + ((second - 0x10000) & 0x3FF)) };
+        VERIFY_ARE_EQUAL(CodepointWidth::Ambiguous, widthDetector.GetWidth(first));
+        VERIFY_ARE_EQUAL(CodepointWidth::Ambiguous, widthDetector.GetWidth(secondGlyph));
+
+        widthDetector.IsWide(first);
+        widthDetector.IsWide(secondGlyph);
+        VERIFY_ARE_EQUAL(0u, widthDetector.GetFallbackCacheStatistics().cHits);
+        VERIFY_ARE_EQUAL(1u, widthDetector.GetFallbackCacheStatistics().cEvictions);
+
+        // The second one took the slot, so the first has to be asked about again.
+        widthDetector.IsWide(secondGlyph);
+        widthDetector.IsWide(first);
+        VERIFY_ARE_EQUAL(1u, widthDetector.GetFallbackCacheStatistics().cHits);
+        VERIFY_ARE_EQUAL(3u, fallbackCalls);
+    }
+
+    TEST_METHOD(WarmAmbiguousCache)
+    {
+        size_t fallbackCalls = 0;
+        CodepointWidthDetector widthDetector;
+        widthDetector.SetFallbackMethod([&](const std::wstring_view glyph) {
+            ++fallbackCalls;
+            return FallbackMethod(glyph);
+        });
+
+        // Only the ambiguous glyphs need the fallback: cyrillic capital de,
+        //      a private use character, and cyrillic capital ie.
+        widthDetector.WarmFallbackCache(L"a\x414\x306A\xDB80\xDC00\x415");
+        VERIFY_ARE_EQUAL(3u, fallbackCalls);
+
+        VERIFY_ARE_EQUAL(FallbackMethod(ambiguous), widthDetector.IsWide(ambiguous));
+        VERIFY_ARE_EQUAL(3u, fallbackCalls);
+        VERIFY_ARE_EQUAL(1u, widthDetector.GetFallbackCacheStatistics().cHits);
     }
 
 };
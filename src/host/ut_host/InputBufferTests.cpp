@@ -8,6 +8,7 @@
 
 #include "..\interactivity\inc\ServiceLocator.hpp"
 #include "..\types\inc\IInputEvent.hpp"
+#include "..\types\inc\convert.hpp"
 
 using namespace WEX::Logging;
 
@@ -77,7 +78,7 @@ class InputBufferTests
             INPUT_RECORD record;
             record.EventType = MENU_EVENT;
             VERIFY_IS_GREATER_THAN(inputBuffer.Write(IInputEvent::Create(record)), 0u);
-            VERIFY_ARE_EQUAL(record, inputBuffer._storage.back()->ToInputRecord());
+            VERIFY_ARE_EQUAL(record, inputBuffer._storage.back());
         }
         VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), RECORD_INSERT_COUNT);
     }
@@ -97,7 +98,7 @@ class InputBufferTests
         // verify that the events are the same in storage
         for (size_t i = 0; i < RECORD_INSERT_COUNT; ++i)
         {
-            VERIFY_ARE_EQUAL(inputBuffer._storage[i]->ToInputRecord(), record);
+            VERIFY_ARE_EQUAL(inputBuffer._storage[i], record);
         }
     }
 
@@ -120,10 +121,9 @@ class InputBufferTests
         // check that they coalesced
         VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), 1u);
         // check that the mouse position is being updated correctly
-        const IInputEvent* const pOutEvent = inputBuffer._storage.front().get();
-        const MouseEvent* const pMouseEvent = static_cast<const MouseEvent* const>(pOutEvent);
-        VERIFY_ARE_EQUAL(pMouseEvent->GetPosition().X, static_cast<SHORT>(RECORD_INSERT_COUNT));
-        VERIFY_ARE_EQUAL(pMouseEvent->GetPosition().Y, static_cast<SHORT>(RECORD_INSERT_COUNT * 2));
+        const COORD position = inputBuffer._storage.front().Event.MouseEvent.dwMousePosition;
+        VERIFY_ARE_EQUAL(position.X, static_cast<SHORT>(RECORD_INSERT_COUNT));
+        VERIFY_ARE_EQUAL(position.Y, static_cast<SHORT>(RECORD_INSERT_COUNT * 2));
 
         // add a key event and another mouse event to make sure that
         // an event between two mouse events stopped the coalescing.
@@ -161,10 +161,10 @@ class InputBufferTests
         // no events should have been coalesced
         VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), RECORD_INSERT_COUNT + 1);
         // check that the events stored match those inserted
-        VERIFY_ARE_EQUAL(inputBuffer._storage.front()->ToInputRecord(), mouseRecords[0]);
+        VERIFY_ARE_EQUAL(inputBuffer._storage.front(), mouseRecords[0]);
         for (size_t i = 0; i < RECORD_INSERT_COUNT; ++i)
         {
-            VERIFY_ARE_EQUAL(inputBuffer._storage[i + 1]->ToInputRecord(), mouseRecords[i]);
+            VERIFY_ARE_EQUAL(inputBuffer._storage[i + 1], mouseRecords[i]);
         }
     }
 
@@ -220,10 +220,10 @@ class InputBufferTests
         // no events should have been coalesced
         VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), RECORD_INSERT_COUNT + 1);
         // check that the events stored match those inserted
-        VERIFY_ARE_EQUAL(inputBuffer._storage.front()->ToInputRecord(), keyRecords[0]);
+        VERIFY_ARE_EQUAL(inputBuffer._storage.front(), keyRecords[0]);
         for (size_t i = 0; i < RECORD_INSERT_COUNT; ++i)
         {
-            VERIFY_ARE_EQUAL(inputBuffer._storage[i + 1]->ToInputRecord(), keyRecords[i]);
+            VERIFY_ARE_EQUAL(inputBuffer._storage[i + 1], keyRecords[i]);
         }
     }
 
@@ -238,7 +238,7 @@ class InputBufferTests
         for (size_t i = 0; i < RECORD_INSERT_COUNT; ++i)
         {
             VERIFY_IS_GREATER_THAN(inputBuffer.Write(IInputEvent::Create(record)), 0u);
-            VERIFY_ARE_EQUAL(inputBuffer._storage.back()->ToInputRecord(), record);
+            VERIFY_ARE_EQUAL(inputBuffer._storage.back(), record);
         }
 
         // The events shouldn't be coalesced
@@ -381,10 +381,10 @@ class InputBufferTests
         VERIFY_IS_GREATER_THAN(inputBuffer.Write(inEvents), 0u);
 
         // read one record, make sure ResetWaitEvent isn't set
-        std::deque<std::unique_ptr<IInputEvent>> outEvents;
+        std::vector<INPUT_RECORD> outRecords;
         size_t eventsRead = 0;
         bool resetWaitEvent = false;
-        inputBuffer._ReadBuffer(outEvents,
+        inputBuffer._ReadBuffer(outRecords,
                                 1,
                                 eventsRead,
                                 false,
@@ -395,8 +395,8 @@ class InputBufferTests
         VERIFY_IS_FALSE(!!resetWaitEvent);
 
         // read the rest, resetWaitEvent should be set to true
-        outEvents.clear();
-        inputBuffer._ReadBuffer(outEvents,
+        outRecords.clear();
+        inputBuffer._ReadBuffer(outRecords,
                                 RECORD_INSERT_COUNT - 1,
                                 eventsRead,
                                 false,
@@ -430,10 +430,10 @@ class InputBufferTests
         VERIFY_IS_GREATER_THAN(inputBuffer.Write(inEvents), 0u);
 
         // read them out non-unicode style and compare
-        std::deque<std::unique_ptr<IInputEvent>> outEvents;
+        std::vector<INPUT_RECORD> outRecords;
         size_t eventsRead = 0;
         bool resetWaitEvent = false;
-        inputBuffer._ReadBuffer(outEvents,
+        inputBuffer._ReadBuffer(outRecords,
                                 recordInsertCount,
                                 eventsRead,
                                 false,
@@ -443,10 +443,10 @@ class InputBufferTests
         // the dbcs record should have counted for two elements in
         // the array, making it so that we get less events read
         VERIFY_ARE_EQUAL(eventsRead, recordInsertCount - 1);
-        VERIFY_ARE_EQUAL(eventsRead, outEvents.size());
+        VERIFY_ARE_EQUAL(eventsRead, outRecords.size());
         for (size_t i = 0; i < eventsRead; ++i)
         {
-            VERIFY_ARE_EQUAL(outEvents[i]->ToInputRecord(), inRecords[i]);
+            VERIFY_ARE_EQUAL(outRecords[i], inRecords[i]);
         }
     }
 
@@ -588,22 +588,17 @@ class InputBufferTests
     {
         InputBuffer inputBuffer;
         INPUT_RECORD record = MakeKeyEvent(true, 1, L'a', 0, L'a', 0);
-        std::unique_ptr<IInputEvent> inputEvent = IInputEvent::Create(record);
         size_t eventsWritten;
         bool waitEvent = false;
         inputBuffer.Flush();
         // write one event to an empty buffer
-        std::deque<std::unique_ptr<IInputEvent>> storage;
-        storage.push_back(std::move(inputEvent));
-        inputBuffer._WriteBuffer(storage, eventsWritten, waitEvent);
+        inputBuffer._WriteBuffer(gsl::make_span(&record, 1), eventsWritten, waitEvent);
         VERIFY_IS_TRUE(waitEvent);
         // write another, it shouldn't signal this time
         INPUT_RECORD record2 = MakeKeyEvent(true, 1, L'b', 0, L'b', 0);
-        std::unique_ptr<IInputEvent> inputEvent2 = IInputEvent::Create(record2);
         // write another event to a non-empty buffer
         waitEvent = false;
-        storage.push_back(std::move(inputEvent2));
-        inputBuffer._WriteBuffer(storage, eventsWritten, waitEvent);
+        inputBuffer._WriteBuffer(gsl::make_span(&record2, 1), eventsWritten, waitEvent);
 
         VERIFY_IS_FALSE(waitEvent);
     }
@@ -624,7 +619,7 @@ class InputBufferTests
                                                  true));
         VERIFY_ARE_EQUAL(outEvents.size(), 1u);
         VERIFY_ARE_EQUAL(inputBuffer._storage.size(), 1u);
-        VERIFY_ARE_EQUAL(static_cast<const KeyEvent&>(*inputBuffer._storage.front()).GetRepeatCount(), repeatCount - 1);
+        VERIFY_ARE_EQUAL(inputBuffer._storage.front().Event.KeyEvent.wRepeatCount, repeatCount - 1);
         VERIFY_ARE_EQUAL(static_cast<const KeyEvent&>(*outEvents.front()).GetRepeatCount(), 1u);
     }
 
@@ -644,8 +639,159 @@ class InputBufferTests
                                                  true));
         VERIFY_ARE_EQUAL(outEvents.size(), 1u);
         VERIFY_ARE_EQUAL(inputBuffer._storage.size(), 1u);
-        VERIFY_ARE_EQUAL(static_cast<const KeyEvent&>(*inputBuffer._storage.front()).GetRepeatCount(), repeatCount);
+        VERIFY_ARE_EQUAL(inputBuffer._storage.front().Event.KeyEvent.wRepeatCount, repeatCount);
         VERIFY_ARE_EQUAL(static_cast<const KeyEvent&>(*outEvents.front()).GetRepeatCount(), 1u);
     }
 
+    TEST_METHOD(CanWriteAndReadRecordsInBulk)
+    {
+        InputBuffer inputBuffer;
+        std::vector<INPUT_RECORD> records;
+        for (unsigned int i = 0; i < RECORD_INSERT_COUNT; ++i)
+        {
+            records.push_back(MakeKeyEvent(TRUE, 1, static_cast<WCHAR>(L'A' + i), 0, static_cast<WCHAR>(L'A' + i), 0));
+            records.push_back(MakeKeyEvent(FALSE, 1, static_cast<WCHAR>(L'A' + i), 0, static_cast<WCHAR>(L'A' + i), 0));
+        }
+
+        inputBuffer.Flush();
+        VERIFY_ARE_EQUAL(inputBuffer.Write(records), records.size());
+        VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), records.size());
+
+        // peeking leaves everything in place
+        std::vector<INPUT_RECORD> outRecords;
+        VERIFY_SUCCESS_NTSTATUS(inputBuffer.Read(outRecords,
+                                                 records.size(),
+                                                 true,
+                                                 false,
+                                                 true,
+                                                 false));
+        VERIFY_ARE_EQUAL(outRecords.size(), records.size());
+        VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), records.size());
+
+        // read them back out in two pieces
+        outRecords.clear();
+        VERIFY_SUCCESS_NTSTATUS(inputBuffer.Read(outRecords,
+                                                 RECORD_INSERT_COUNT,
+                                                 false,
+                                                 false,
+                                                 true,
+                                                 false));
+        VERIFY_SUCCESS_NTSTATUS(inputBuffer.Read(outRecords,
+                                                 records.size(),
+                                                 false,
+                                                 false,
+                                                 true,
+                                                 false));
+        VERIFY_ARE_EQUAL(outRecords.size(), records.size());
+        VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), 0u);
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            VERIFY_ARE_EQUAL(records[i], outRecords[i]);
+        }
+    }
+
+    TEST_METHOD(WritingRecordsWithUnknownTypeWritesNothing)
+    {
+        InputBuffer inputBuffer;
+        std::vector<INPUT_RECORD> records;
+        records.push_back(MakeKeyEvent(TRUE, 1, L'a', 0, L'a', 0));
+        records.push_back(MakeKeyEvent(TRUE, 1, L'b', 0, L'b', 0));
+        records.back().EventType = 0x1234;
+
+        inputBuffer.Flush();
+        VERIFY_THROWS_SPECIFIC(inputBuffer.Write(records),
+                               wil::ResultException,
+                               [](wil::ResultException& e) { return e.GetErrorCode() == E_INVALIDARG; });
+        VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), 0u);
+    }
+
+    std::wstring ReadPastedChars(InputBuffer& inputBuffer)
+    {
+        std::vector<INPUT_RECORD> outRecords;
+        VERIFY_SUCCESS_NTSTATUS(inputBuffer.Read(outRecords,
+                                                 inputBuffer.GetNumberOfReadyEvents(),
+                                                 false,
+                                                 false,
+                                                 true,
+                                                 false));
+        std::wstring chars;
+        for (const auto& record : outRecords)
+        {
+            VERIFY_ARE_EQUAL(record.EventType, KEY_EVENT);
+            VERIFY_IS_TRUE(!!record.Event.KeyEvent.bKeyDown);
+            VERIFY_ARE_EQUAL(record.Event.KeyEvent.wRepeatCount, 1u);
+            chars.push_back(record.Event.KeyEvent.uChar.UnicodeChar);
+        }
+        return chars;
+    }
+
+    TEST_METHOD(PastingInVtInputModeWritesChars)
+    {
+        InputBuffer inputBuffer;
+        inputBuffer.InputMode = ENABLE_VIRTUAL_TERMINAL_INPUT;
+        const std::wstring text = L"ls -l\r\x304b";
+
+        inputBuffer.Flush();
+        VERIFY_ARE_EQUAL(inputBuffer.WritePaste(text), text.size());
+        VERIFY_ARE_EQUAL(inputBuffer._storage.front().Event.KeyEvent.wVirtualKeyCode, 0u);
+        VERIFY_ARE_EQUAL(ReadPastedChars(inputBuffer), text);
+    }
+
+    TEST_METHOD(PastingInBracketedPasteModeWrapsText)
+    {
+        InputBuffer inputBuffer;
+        inputBuffer.InputMode = ENABLE_VIRTUAL_TERMINAL_INPUT;
+        inputBuffer.GetTerminalInput().EnableBracketedPasteMode(true);
+        const std::wstring text = L"echo hi\r";
+        const std::wstring expected = L"\x1b[200~echo hi\r\x1b[201~";
+
+        inputBuffer.Flush();
+        VERIFY_ARE_EQUAL(inputBuffer.WritePaste(text), expected.size());
+        VERIFY_ARE_EQUAL(ReadPastedChars(inputBuffer), expected);
+
+        Log::Comment(L"Bracketed paste mode only applies to clients in VT input mode.");
+        inputBuffer.InputMode = ENABLE_LINE_INPUT;
+        VERIFY_ARE_EQUAL(inputBuffer.WritePaste(text), text.size());
+        VERIFY_ARE_EQUAL(ReadPastedChars(inputBuffer), text);
+    }
+
+    TEST_METHOD(PastingInBracketedPasteModeDropsEscapes)
+    {
+        InputBuffer inputBuffer;
+        inputBuffer.InputMode = ENABLE_VIRTUAL_TERMINAL_INPUT;
+        inputBuffer.GetTerminalInput().EnableBracketedPasteMode(true);
+        const std::wstring text = L"one\x1b[201~two\r\x1b";
+        const std::wstring expected = L"\x1b[200~one[201~two\r\x1b[201~";
+
+        Log::Comment(L"A pasted ESC[201~ mustn't end the paste before the text does.");
+        inputBuffer.Flush();
+        VERIFY_ARE_EQUAL(inputBuffer.WritePaste(text), expected.size());
+        VERIFY_ARE_EQUAL(ReadPastedChars(inputBuffer), expected);
+
+        Log::Comment(L"Without bracketed paste mode the text is written as it is.");
+        inputBuffer.GetTerminalInput().EnableBracketedPasteMode(false);
+        VERIFY_ARE_EQUAL(inputBuffer.WritePaste(text), text.size());
+        VERIFY_ARE_EQUAL(ReadPastedChars(inputBuffer), text);
+    }
+
+    TEST_METHOD(PastingInCookedModeWritesKeyDowns)
+    {
+        InputBuffer inputBuffer;
+        inputBuffer.InputMode = ENABLE_LINE_INPUT | ENABLE_PROCESSED_INPUT | ENABLE_ECHO_INPUT;
+        const std::wstring text = L"aBa\r";
+
+        inputBuffer.Flush();
+        VERIFY_ARE_EQUAL(inputBuffer.WritePaste(text), text.size());
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            const KEY_EVENT_RECORD& keyEvent = inputBuffer._storage[i].Event.KeyEvent;
+            const INPUT_RECORD expected = CharToKeyDownRecord(text[i]);
+            VERIFY_ARE_EQUAL(keyEvent.wVirtualKeyCode, expected.Event.KeyEvent.wVirtualKeyCode);
+            VERIFY_ARE_EQUAL(keyEvent.dwControlKeyState, expected.Event.KeyEvent.dwControlKeyState);
+        }
+        VERIFY_ARE_EQUAL(inputBuffer._storage[1].Event.KeyEvent.dwControlKeyState, static_cast<DWORD>(SHIFT_PRESSED));
+        VERIFY_ARE_EQUAL(inputBuffer._storage[3].Event.KeyEvent.wVirtualKeyCode, static_cast<WORD>(VK_RETURN));
+        VERIFY_ARE_EQUAL(ReadPastedChars(inputBuffer), text);
+    }
+
 };
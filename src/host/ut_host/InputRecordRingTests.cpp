@@ -0,0 +1,168 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../../types/inc/InputRecordRing.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class InputRecordRingTests
+{
+    TEST_CLASS(InputRecordRingTests);
+
+    static INPUT_RECORD MakeRecord(const size_t id)
+    {
+        INPUT_RECORD record{};
+        record.EventType = MENU_EVENT;
+        record.Event.MenuEvent.dwCommandId = gsl::narrow<UINT>(id);
+        return record;
+    }
+
+    static std::vector<INPUT_RECORD> MakeRecords(const size_t first, const size_t count)
+    {
+        std::vector<INPUT_RECORD> records;
+        for (size_t i = 0; i < count; ++i)
+        {
+            records.push_back(MakeRecord(first + i));
+        }
+        return records;
+    }
+
+    static void AppendRecords(InputRecordRing& ring, const size_t first, const size_t count)
+    {
+        const auto records = MakeRecords(first, count);
+        ring.append(records);
+    }
+
+    static void VerifyContents(const InputRecordRing& ring, const size_t first, const size_t count)
+    {
+        VERIFY_ARE_EQUAL(count, ring.size());
+        for (size_t i = 0; i < count; ++i)
+        {
+            VERIFY_ARE_EQUAL(first + i, ring[i].Event.MenuEvent.dwCommandId);
+        }
+    }
+
+    TEST_METHOD(StartsEmpty)
+    {
+        InputRecordRing ring;
+        VERIFY_IS_TRUE(ring.empty());
+        VERIFY_ARE_EQUAL(0u, ring.size());
+
+        std::vector<INPUT_RECORD> outRecords;
+        ring.copy_to(0, 0, outRecords);
+        VERIFY_IS_TRUE(outRecords.empty());
+    }
+
+    TEST_METHOD(KeepsOrderWhileWrappingAround)
+    {
+        Log::Comment(L"Reading from the front while writing to the back wraps the ring around without reordering anything.");
+
+        InputRecordRing ring;
+        size_t nextWritten = 0;
+        size_t nextRead = 0;
+        for (size_t round = 0; round < 100; ++round)
+        {
+            const auto records = MakeRecords(nextWritten, 7);
+            ring.append(records);
+            nextWritten += records.size();
+
+            ring.push_back(MakeRecord(nextWritten++));
+
+            ring.erase_front(5);
+            nextRead += 5;
+
+            VerifyContents(ring, nextRead, nextWritten - nextRead);
+            VERIFY_ARE_EQUAL(nextRead, ring.front().Event.MenuEvent.dwCommandId);
+            VERIFY_ARE_EQUAL(nextWritten - 1, ring.back().Event.MenuEvent.dwCommandId);
+        }
+    }
+
+    TEST_METHOD(GrowsAcrossTheWrap)
+    {
+        Log::Comment(L"Growing a ring whose contents wrap around the end moves them without reordering anything.");
+
+        InputRecordRing ring;
+        AppendRecords(ring, 0, 16);
+        ring.erase_front(10);
+        AppendRecords(ring, 16, 8);
+        VerifyContents(ring, 10, 14);
+
+        AppendRecords(ring, 24, 100);
+        VerifyContents(ring, 10, 114);
+    }
+
+    TEST_METHOD(CanCopyOutOfTheMiddle)
+    {
+        InputRecordRing ring;
+        AppendRecords(ring, 0, 16);
+        ring.erase_front(12);
+        AppendRecords(ring, 16, 8);
+
+        std::vector<INPUT_RECORD> outRecords{ MakeRecord(100) };
+        ring.copy_to(2, 6, outRecords);
+
+        // copied records are appended after whatever was there already
+        VERIFY_ARE_EQUAL(7u, outRecords.size());
+        VERIFY_ARE_EQUAL(100u, outRecords[0].Event.MenuEvent.dwCommandId);
+        for (size_t i = 0; i < 6; ++i)
+        {
+            VERIFY_ARE_EQUAL(14 + i, outRecords[i + 1].Event.MenuEvent.dwCommandId);
+        }
+
+        // copying doesn't remove anything
+        VerifyContents(ring, 12, 12);
+    }
+
+    TEST_METHOD(CanEraseFromEitherEnd)
+    {
+        InputRecordRing ring;
+        AppendRecords(ring, 0, 20);
+
+        ring.erase_front(3);
+        VerifyContents(ring, 3, 17);
+
+        ring.erase_back(4);
+        VerifyContents(ring, 3, 13);
+
+        ring.erase_back(13);
+        VERIFY_IS_TRUE(ring.empty());
+
+        // an emptied ring starts over at the beginning of its storage
+        AppendRecords(ring, 50, 3);
+        VerifyContents(ring, 50, 3);
+    }
+
+    TEST_METHOD(CanUpdateRecordsInPlace)
+    {
+        InputRecordRing ring;
+        AppendRecords(ring, 0, 4);
+
+        ring.back().Event.MenuEvent.dwCommandId = 42;
+        ring[1].Event.MenuEvent.dwCommandId = 41;
+
+        VERIFY_ARE_EQUAL(41u, ring[1].Event.MenuEvent.dwCommandId);
+        VERIFY_ARE_EQUAL(42u, ring[3].Event.MenuEvent.dwCommandId);
+    }
+
+    TEST_METHOD(LetsGoOfLargeBursts)
+    {
+        Log::Comment(L"Once a burst bigger than the retained capacity is read out, the ring is free to shrink.");
+
+        InputRecordRing ring;
+        const auto burst = MakeRecords(0, InputRecordRing::RETAINED_CAPACITY * 2);
+        ring.append(burst);
+        VerifyContents(ring, 0, burst.size());
+
+        ring.erase_front(burst.size());
+        VERIFY_IS_TRUE(ring.empty());
+
+        ring.push_back(MakeRecord(7));
+        VerifyContents(ring, 7, 1);
+    }
+};
@@ -13,6 +13,7 @@
 
 #include <deque>
 #include <memory>
+#include <vector>
 
 using namespace WEX::Logging;
 
@@ -125,4 +126,58 @@ class InputRecordConversionTests
             VERIFY_ARE_EQUAL(static_cast<char>(pKeyEvent->GetCharData()), dbcsChars[i]);
         }
     }
+
+    TEST_METHOD(SplitToOemSplitsDbcsCharRecords)
+    {
+        Log::Comment(L"dbcs chars in records should be split, other records are kept in order");
+
+        const UINT codepage = ServiceLocator::LocateGlobals().getConsoleInformation().CP;
+
+        std::vector<INPUT_RECORD> records;
+        // U+3042 hiragana letter A
+        wchar_t hiraganaA = 0x3042;
+        wchar_t inChars[INPUT_RECORD_COUNT];
+        for (size_t i = 0; i < INPUT_RECORD_COUNT; ++i)
+        {
+            INPUT_RECORD keyRecord = { 0 };
+            keyRecord.EventType = KEY_EVENT;
+            keyRecord.Event.KeyEvent.bKeyDown = TRUE;
+            keyRecord.Event.KeyEvent.wVirtualKeyCode = static_cast<WORD>(0x41 + i);
+            keyRecord.Event.KeyEvent.uChar.UnicodeChar = static_cast<wchar_t>(hiraganaA + (i * 2));
+            inChars[i] = keyRecord.Event.KeyEvent.uChar.UnicodeChar;
+            records.push_back(keyRecord);
+
+            INPUT_RECORD mouseRecord = { 0 };
+            mouseRecord.EventType = MOUSE_EVENT;
+            mouseRecord.Event.MouseEvent.dwMousePosition.X = static_cast<SHORT>(i);
+            records.push_back(mouseRecord);
+        }
+
+        SplitToOem(records);
+        VERIFY_ARE_EQUAL(INPUT_RECORD_COUNT * 3, records.size());
+
+        // create the data to compare the output to
+        char dbcsChars[INPUT_RECORD_COUNT * 2] = { 0 };
+        int writtenBytes = WideCharToMultiByte(codepage,
+                                               0,
+                                               inChars,
+                                               INPUT_RECORD_COUNT,
+                                               dbcsChars,
+                                               INPUT_RECORD_COUNT * 2,
+                                               nullptr,
+                                               false);
+        VERIFY_ARE_EQUAL(writtenBytes, static_cast<int>(INPUT_RECORD_COUNT * 2));
+        for (size_t i = 0; i < INPUT_RECORD_COUNT; ++i)
+        {
+            for (size_t j = 0; j < 2; ++j)
+            {
+                const auto& keyEvent = records[i * 3 + j].Event.KeyEvent;
+                VERIFY_ARE_EQUAL(KEY_EVENT, records[i * 3 + j].EventType);
+                VERIFY_ARE_EQUAL(static_cast<WORD>(0x41 + i), keyEvent.wVirtualKeyCode);
+                VERIFY_ARE_EQUAL(static_cast<char>(keyEvent.uChar.UnicodeChar), dbcsChars[i * 2 + j]);
+            }
+            VERIFY_ARE_EQUAL(MOUSE_EVENT, records[i * 3 + 2].EventType);
+            VERIFY_ARE_EQUAL(static_cast<SHORT>(i), records[i * 3 + 2].Event.MouseEvent.dwMousePosition.X);
+        }
+    }
 };
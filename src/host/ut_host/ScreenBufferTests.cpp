@@ -17,6 +17,9 @@
 #include "..\interactivity\inc\ServiceLocator.hpp"
 #include "..\..\inc\conattrs.hpp"
 #include "..\..\types\inc\Viewport.hpp"
+#include "..\renderData.hpp"
+#include "..\..\renderer\base\renderer.hpp"
+#include "..\..\renderer\inc\InvalidationBatch.hpp"
 
 #include <sstream>
 
@@ -153,11 +156,20 @@ class ScreenBufferTests
     TEST_METHOD(DeleteCharsNearEndOfLineSimpleFirstCase);
     TEST_METHOD(DeleteCharsNearEndOfLineSimpleSecondCase);
 
+    TEST_METHOD(InsertChars);
+    TEST_METHOD(InsertCharsOutsideMargins);
+    TEST_METHOD(EraseChars);
+    TEST_METHOD(ShiftCharsSplitsWideGlyph);
+
+    SCREEN_INFORMATION& _SetUpEightColumnBuffer();
+
     TEST_METHOD(DontResetColorsAboveVirtualBottom);
 
     TEST_METHOD(ScrollUpInMargins);
     TEST_METHOD(ScrollDownInMargins);
 
+    TEST_METHOD(WritesNotifyRendererOnce);
+
 };
 
 void ScreenBufferTests::SingleAlternateBufferCreationTest()
@@ -2737,6 +2749,195 @@ void ScreenBufferTests::DeleteCharsNearEndOfLineSimpleSecondCase()
 
 }
 
+// Routine Description:
+// - Shrinks the active buffer and its viewport to 8 columns, so that the
+//      character insert/delete/erase tests can check whole rows.
+// Return Value:
+// - The active buffer.
+SCREEN_INFORMATION& ScreenBufferTests::_SetUpEightColumnBuffer()
+{
+    auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    auto& si = gci.GetActiveOutputBuffer();
+    const short newBufferWidth = 8;
+
+    VERIFY_SUCCEEDED(si.ResizeScreenBuffer({newBufferWidth, si.GetBufferSize().Height()}, false));
+    auto& mainBuffer = gci.GetActiveOutputBuffer();
+
+    const COORD newViewSize{newBufferWidth, mainBuffer.GetViewport().Height()};
+    mainBuffer.SetViewportSize(&newViewSize);
+
+    VERIFY_ARE_EQUAL(newBufferWidth, mainBuffer.GetViewport().Width());
+    VERIFY_ARE_EQUAL(mainBuffer.GetBufferSize().Width(), mainBuffer.GetViewport().Width());
+    return mainBuffer;
+}
+
+void ScreenBufferTests::InsertChars()
+{
+    // Write a string, move the cursor into it, then insert some chars (ICH).
+    // The rest of the row moves right, what's pushed past the edge is lost,
+    // and the blanks are in the current colors.
+
+    auto& mainBuffer = _SetUpEightColumnBuffer();
+    auto& stateMachine = mainBuffer.GetStateMachine();
+    auto& tbi = mainBuffer.GetTextBuffer();
+    auto& mainCursor = tbi.GetCursor();
+
+    stateMachine.ProcessString(L"ABCDEFG");
+    const auto textAttr = mainBuffer.GetAttributes();
+
+    // Place the cursor on the 'C' and insert 2 blue blanks.
+    mainCursor.SetPosition({2, 0});
+    stateMachine.ProcessString(L"\x1b[44m\x1b[2@");
+    const auto fillAttr = mainBuffer.GetAttributes();
+    VERIFY_ARE_NOT_EQUAL(textAttr, fillAttr);
+
+    Log::Comment(NoThrowString().Format(L"after =[%s]", tbi.GetRowByOffset(0).GetText().c_str()));
+    VERIFY_ARE_EQUAL(COORD({2, 0}), mainCursor.GetPosition());
+    VERIFY_ARE_EQUAL(L"AB  CDEF", tbi.GetRowByOffset(0).GetText());
+
+    auto iter = tbi.GetCellDataAt({0, 0});
+    const TextAttribute expectedAttrs[] = { textAttr, textAttr, fillAttr, fillAttr, textAttr, textAttr, textAttr, textAttr };
+    for (const auto& expectedAttr : expectedAttrs)
+    {
+        VERIFY_ARE_EQUAL(expectedAttr, iter->TextAttr());
+        iter++;
+    }
+
+    Log::Comment(L"A count that reaches the edge of the viewport blanks the rest of the row.");
+    mainCursor.SetPosition({5, 0});
+    stateMachine.ProcessString(L"\x1b[10@");
+
+    Log::Comment(NoThrowString().Format(L"after =[%s]", tbi.GetRowByOffset(0).GetText().c_str()));
+    VERIFY_ARE_EQUAL(COORD({5, 0}), mainCursor.GetPosition());
+    VERIFY_ARE_EQUAL(L"AB  C   ", tbi.GetRowByOffset(0).GetText());
+    VERIFY_ARE_EQUAL(fillAttr, tbi.GetCellDataAt({7, 0})->TextAttr());
+}
+
+void ScreenBufferTests::InsertCharsOutsideMargins()
+{
+    // With scroll margins set and the cursor outside them, ICH leaves the row
+    // alone, unless the count reaches the edge of the viewport. Then the rest
+    // of the row is blanked anyways.
+
+    auto& mainBuffer = _SetUpEightColumnBuffer();
+    auto& stateMachine = mainBuffer.GetStateMachine();
+    auto& tbi = mainBuffer.GetTextBuffer();
+    auto& mainCursor = tbi.GetCursor();
+
+    stateMachine.ProcessString(L"ABCDEFG");
+
+    // Rows 2 and 3 of the viewport. Setting the margins homes the cursor.
+    stateMachine.ProcessString(L"\x1b[2;3r");
+    mainCursor.SetPosition({2, 0});
+    stateMachine.ProcessString(L"\x1b[2@");
+
+    Log::Comment(NoThrowString().Format(L"after =[%s]", tbi.GetRowByOffset(0).GetText().c_str()));
+    VERIFY_ARE_EQUAL(COORD({2, 0}), mainCursor.GetPosition());
+    VERIFY_ARE_EQUAL(L"ABCDEFG ", tbi.GetRowByOffset(0).GetText());
+
+    stateMachine.ProcessString(L"\x1b[6@");
+
+    Log::Comment(NoThrowString().Format(L"after =[%s]", tbi.GetRowByOffset(0).GetText().c_str()));
+    VERIFY_ARE_EQUAL(COORD({2, 0}), mainCursor.GetPosition());
+    VERIFY_ARE_EQUAL(L"AB      ", tbi.GetRowByOffset(0).GetText());
+
+    stateMachine.ProcessString(L"\x1b[r");
+}
+
+void ScreenBufferTests::EraseChars()
+{
+    // Write a string, move the cursor into it, then erase some chars (ECH).
+    // Nothing moves, the erased cells are blank in the current colors, and
+    // a count past the edge of the viewport stops at the edge.
+
+    auto& mainBuffer = _SetUpEightColumnBuffer();
+    auto& stateMachine = mainBuffer.GetStateMachine();
+    auto& tbi = mainBuffer.GetTextBuffer();
+    auto& mainCursor = tbi.GetCursor();
+
+    stateMachine.ProcessString(L"ABCDEFG");
+    const auto textAttr = mainBuffer.GetAttributes();
+
+    // Place the cursor on the 'B' and erase 3 chars - [B, C, D].
+    mainCursor.SetPosition({1, 0});
+    stateMachine.ProcessString(L"\x1b[44m\x1b[3X");
+    const auto fillAttr = mainBuffer.GetAttributes();
+
+    Log::Comment(NoThrowString().Format(L"after =[%s]", tbi.GetRowByOffset(0).GetText().c_str()));
+    VERIFY_ARE_EQUAL(COORD({1, 0}), mainCursor.GetPosition());
+    VERIFY_ARE_EQUAL(L"A   EFG ", tbi.GetRowByOffset(0).GetText());
+
+    auto iter = tbi.GetCellDataAt({0, 0});
+    const TextAttribute expectedAttrs[] = { textAttr, fillAttr, fillAttr, fillAttr, textAttr, textAttr, textAttr, textAttr };
+    for (const auto& expectedAttr : expectedAttrs)
+    {
+        VERIFY_ARE_EQUAL(expectedAttr, iter->TextAttr());
+        iter++;
+    }
+
+    Log::Comment(L"A count past the edge of the viewport stops at the edge.");
+    mainCursor.SetPosition({5, 0});
+    stateMachine.ProcessString(L"\x1b[100X");
+
+    Log::Comment(NoThrowString().Format(L"after =[%s]", tbi.GetRowByOffset(0).GetText().c_str()));
+    VERIFY_ARE_EQUAL(COORD({5, 0}), mainCursor.GetPosition());
+    VERIFY_ARE_EQUAL(L"A   E   ", tbi.GetRowByOffset(0).GetText());
+    VERIFY_IS_FALSE(tbi.GetRowByOffset(1).GetCharRow().ContainsText());
+}
+
+void ScreenBufferTests::ShiftCharsSplitsWideGlyph()
+{
+    // A wide glyph that an ICH or DCH would cut in half is blanked, both
+    // halves of it. One that moves as a whole keeps both halves.
+
+    auto& mainBuffer = _SetUpEightColumnBuffer();
+    auto& stateMachine = mainBuffer.GetStateMachine();
+    auto& tbi = mainBuffer.GetTextBuffer();
+    auto& mainCursor = tbi.GetCursor();
+
+    Log::Comment(L"Inserting at the trailing half splits the glyph at the start of the shift.");
+    stateMachine.ProcessString(L"A\x3042" L"BCDE");
+    VERIFY_IS_TRUE(tbi.GetCellDataAt({1, 0})->DbcsAttr().IsLeading());
+    VERIFY_IS_TRUE(tbi.GetCellDataAt({2, 0})->DbcsAttr().IsTrailing());
+
+    mainCursor.SetPosition({2, 0});
+    stateMachine.ProcessString(L"\x1b[@");
+
+    Log::Comment(NoThrowString().Format(L"after =[%s]", tbi.GetRowByOffset(0).GetText().c_str()));
+    VERIFY_ARE_EQUAL(L"A   BCDE", tbi.GetRowByOffset(0).GetText());
+    for (SHORT column = 0; column < 8; column++)
+    {
+        VERIFY_IS_FALSE(tbi.GetCellDataAt({column, 0})->DbcsAttr().IsDbcs());
+    }
+
+    Log::Comment(L"Deleting in front of the glyph moves it as a whole.");
+    stateMachine.ProcessString(L"\r\x1b[K\x3042" L"B");
+    mainCursor.SetPosition({0, 0});
+    stateMachine.ProcessString(L"\x1b[@");
+
+    Log::Comment(NoThrowString().Format(L"after =[%s]", tbi.GetRowByOffset(0).GetText().c_str()));
+    VERIFY_ARE_EQUAL(L" \x3042" L"B    ", tbi.GetRowByOffset(0).GetText());
+    VERIFY_IS_TRUE(tbi.GetCellDataAt({1, 0})->DbcsAttr().IsLeading());
+    VERIFY_IS_TRUE(tbi.GetCellDataAt({2, 0})->DbcsAttr().IsTrailing());
+
+    stateMachine.ProcessString(L"\x1b[P");
+
+    Log::Comment(NoThrowString().Format(L"after =[%s]", tbi.GetRowByOffset(0).GetText().c_str()));
+    VERIFY_ARE_EQUAL(L"\x3042" L"B     ", tbi.GetRowByOffset(0).GetText());
+    VERIFY_IS_TRUE(tbi.GetCellDataAt({0, 0})->DbcsAttr().IsLeading());
+    VERIFY_IS_TRUE(tbi.GetCellDataAt({1, 0})->DbcsAttr().IsTrailing());
+
+    Log::Comment(L"Inserting pushes the glyph at the edge half out of the row, so it's blanked.");
+    stateMachine.ProcessString(L"\r\x1b[KABCDEF\x3042");
+    VERIFY_IS_TRUE(tbi.GetCellDataAt({6, 0})->DbcsAttr().IsLeading());
+    mainCursor.SetPosition({0, 0});
+    stateMachine.ProcessString(L"\x1b[@");
+
+    Log::Comment(NoThrowString().Format(L"after =[%s]", tbi.GetRowByOffset(0).GetText().c_str()));
+    VERIFY_ARE_EQUAL(L" ABCDEF ", tbi.GetRowByOffset(0).GetText());
+    VERIFY_IS_FALSE(tbi.GetCellDataAt({7, 0})->DbcsAttr().IsDbcs());
+}
+
 void ScreenBufferTests::DontResetColorsAboveVirtualBottom()
 {
     // Created for MSFT:19989333.
@@ -3015,3 +3216,52 @@ void ScreenBufferTests::ScrollDownInMargins()
         VERIFY_ARE_EQUAL(L"B" , iter5->Chars());
     }
 }
+
+void ScreenBufferTests::WritesNotifyRendererOnce()
+{
+    // A render thread that never paints. All we want is the renderer's count of
+    //      how often it would have been told to.
+    class NullRenderThread final : public Microsoft::Console::Render::IRenderThread
+    {
+    public:
+        void NotifyPaint() override {}
+        void EnablePainting() override {}
+        void WaitForPaintCompletionAndDisable(const DWORD) override {}
+    };
+
+    Globals& g = ServiceLocator::LocateGlobals();
+    CONSOLE_INFORMATION& gci = g.getConsoleInformation();
+    SCREEN_INFORMATION& si = gci.GetActiveOutputBuffer().GetActiveBuffer();
+    StateMachine& stateMachine = si.GetStateMachine();
+    Cursor& cursor = si.GetTextBuffer().GetCursor();
+
+    RenderData renderData;
+    Renderer renderer{ &renderData, nullptr, 0, std::make_unique<NullRenderThread>() };
+    g.pRender = &renderer;
+    auto resetRenderer = wil::scope_exit([&] { g.pRender = nullptr; });
+
+    Log::Comment(L"Outside of a batch, every redraw notifies the render thread.");
+    renderer.TriggerRedraw(Viewport::FromCoord({ 0, 0 }));
+    renderer.TriggerRedraw(Viewport::FromCoord({ 1, 0 }));
+    const auto unbatched = renderer.GetInvalidationStatistics();
+    VERIFY_ARE_EQUAL(2u, unbatched.cRedrawsRequested);
+    VERIFY_ARE_EQUAL(0u, unbatched.cRedrawsBatched);
+    VERIFY_ARE_EQUAL(2u, unbatched.cPaintNotifications);
+
+    Log::Comment(L"Writing a string notifies it once, however many cells and cursor moves that took.");
+    wchar_t* str = L"Hello, world";
+    size_t seqCb = 24;
+    VERIFY_SUCCESS_NTSTATUS(WriteCharsLegacy(si, str, str, str, &seqCb, nullptr, cursor.GetPosition().X, 0, nullptr));
+    const auto written = renderer.GetInvalidationStatistics();
+    VERIFY_IS_GREATER_THAN(written.cRedrawsRequested - unbatched.cRedrawsRequested, static_cast<size_t>(1));
+    VERIFY_ARE_EQUAL(written.cRedrawsRequested - unbatched.cRedrawsRequested, written.cRedrawsBatched - unbatched.cRedrawsBatched);
+    VERIFY_ARE_EQUAL(unbatched.cPaintNotifications + 1, written.cPaintNotifications);
+
+    Log::Comment(L"Nested batches only flush when the outermost one ends.");
+    {
+        Microsoft::Console::Render::InvalidationBatch invalidationBatch{ &renderer };
+        stateMachine.ProcessString(L"\x1b[31mred\x1b[m and plain");
+        VERIFY_ARE_EQUAL(written.cPaintNotifications, renderer.GetInvalidationStatistics().cPaintNotifications);
+    }
+    VERIFY_ARE_EQUAL(written.cPaintNotifications + 1, renderer.GetInvalidationStatistics().cPaintNotifications);
+}
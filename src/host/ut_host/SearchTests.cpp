@@ -49,6 +49,9 @@ class SearchTests
 
     TEST_METHOD_CLEANUP(MethodCleanup)
     {
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        gci.GetActiveOutputBuffer().ClearSearchHighlight();
+
         m_state->CleanupNewTextBufferInfo();
 
         return true;
@@ -163,4 +166,205 @@ class SearchTests
         Search s(outputBuffer, L"\x304b", Search::Direction::Backward, Search::Sensitivity::CaseInsensitive);
         DoFoundChecks(s, coordStartExpected, -1);
     }
+
+    void DoFindAllChecks(Search& s, const std::vector<SHORT>& rowsExpected)
+    {
+        const auto& matches = s.FindAll();
+        VERIFY_ARE_EQUAL(rowsExpected.size(), matches.size());
+        for (size_t i = 0; i < matches.size(); i++)
+        {
+            VERIFY_ARE_EQUAL((COORD{ 0, rowsExpected[i] }), matches[i].first);
+            VERIFY_ARE_EQUAL((COORD{ 1, rowsExpected[i] }), matches[i].second);
+        }
+    }
+
+    TEST_METHOD(FindAllCaseInsensitive)
+    {
+        const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        const auto& outputBuffer = gci.GetActiveOutputBuffer();
+
+        Search s(outputBuffer, L"ab", Search::Direction::Forward, Search::Sensitivity::CaseInsensitive);
+        DoFindAllChecks(s, { 0, 1, 2, 3 });
+
+        // Asking again gives the same answer without searching again.
+        DoFindAllChecks(s, { 0, 1, 2, 3 });
+    }
+
+    void DoFindAllMatchChecks(Search& s, const std::vector<std::pair<COORD, COORD>>& matchesExpected)
+    {
+        const auto& matches = s.FindAll();
+        VERIFY_ARE_EQUAL(matchesExpected.size(), matches.size());
+        for (size_t i = 0; i < matches.size(); i++)
+        {
+            VERIFY_ARE_EQUAL(matchesExpected[i].first, matches[i].first);
+            VERIFY_ARE_EQUAL(matchesExpected[i].second, matches[i].second);
+        }
+    }
+
+    TEST_METHOD(FindAllInMiddleOfRow)
+    {
+        const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        const auto& outputBuffer = gci.GetActiveOutputBuffer();
+
+        Log::Comment(L"The match starts after the wide characters and ends on the second half of one.");
+        Search s(outputBuffer, L"C\x304d", Search::Direction::Forward, Search::Sensitivity::CaseSensitive);
+        DoFindAllMatchChecks(s, { { { 4, 0 }, { 6, 0 } }, { { 4, 1 }, { 6, 1 } }, { { 4, 2 }, { 6, 2 } }, { { 4, 3 }, { 6, 3 } } });
+    }
+
+    TEST_METHOD(FindAllCaseInsensitiveInMiddleOfRow)
+    {
+        const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        const auto& outputBuffer = gci.GetActiveOutputBuffer();
+
+        Search s(outputBuffer, L"dE", Search::Direction::Forward, Search::Sensitivity::CaseInsensitive);
+        DoFindAllMatchChecks(s, { { { 7, 0 }, { 8, 0 } }, { { 7, 1 }, { 8, 1 } }, { { 7, 2 }, { 8, 2 } }, { { 7, 3 }, { 8, 3 } } });
+    }
+
+    TEST_METHOD(FindAllNoMatch)
+    {
+        const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        const auto& outputBuffer = gci.GetActiveOutputBuffer();
+
+        Log::Comment(L"Text that isn't in the buffer.");
+        Search absent(outputBuffer, L"zq", Search::Direction::Forward, Search::Sensitivity::CaseInsensitive);
+        VERIFY_IS_TRUE(absent.FindAll().empty());
+
+        Log::Comment(L"Text that's only in the buffer in another case.");
+        Search otherCase(outputBuffer, L"de", Search::Direction::Forward, Search::Sensitivity::CaseSensitive);
+        VERIFY_IS_TRUE(otherCase.FindAll().empty());
+    }
+
+    TEST_METHOD(FindAllSeveralInOneRow)
+    {
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        auto& outputBuffer = gci.GetActiveOutputBuffer();
+        auto& textBuffer = outputBuffer.GetTextBuffer();
+
+        textBuffer.Write(OutputCellIterator(L"abcABCabc"), { 0, 10 });
+
+        Search s(outputBuffer, L"abc", Search::Direction::Forward, Search::Sensitivity::CaseInsensitive);
+        DoFindAllMatchChecks(s, { { { 0, 10 }, { 2, 10 } }, { { 3, 10 }, { 5, 10 } }, { { 6, 10 }, { 8, 10 } } });
+    }
+
+    TEST_METHOD(FindAllSpansWrappedRows)
+    {
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        auto& outputBuffer = gci.GetActiveOutputBuffer();
+        auto& textBuffer = outputBuffer.GetTextBuffer();
+
+        Log::Comment(L"Write a word over the end of a row, so it wraps onto the next.");
+        textBuffer.Write(OutputCellIterator(L"world"), { 77, 20 });
+
+        Search s(outputBuffer, L"world", Search::Direction::Forward, Search::Sensitivity::CaseSensitive);
+        DoFindAllMatchChecks(s, { { { 77, 20 }, { 1, 21 } } });
+
+        Log::Comment(L"The match is highlighted a row at a time.");
+        const auto rects = s.GetMatchRects(0, 299);
+        VERIFY_ARE_EQUAL(2u, rects.size());
+        VERIFY_ARE_EQUAL((SMALL_RECT{ 77, 20, 79, 20 }), rects[0].ToInclusive());
+        VERIFY_ARE_EQUAL((SMALL_RECT{ 0, 21, 1, 21 }), rects[1].ToInclusive());
+
+        Log::Comment(L"Asking for the second row only still finds the match that started above it.");
+        const auto lower = s.GetMatchRects(21, 21);
+        VERIFY_ARE_EQUAL(1u, lower.size());
+        VERIFY_ARE_EQUAL((SMALL_RECT{ 0, 21, 1, 21 }), lower[0].ToInclusive());
+    }
+
+    TEST_METHOD(FindAllUpdatesRows)
+    {
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        auto& outputBuffer = gci.GetActiveOutputBuffer();
+        auto& textBuffer = outputBuffer.GetTextBuffer();
+
+        Search s(outputBuffer, L"AB", Search::Direction::Forward, Search::Sensitivity::CaseSensitive);
+        DoFindAllChecks(s, { 0, 1, 2, 3 });
+
+        Log::Comment(L"Clearing a row drops its match.");
+        VERIFY_IS_TRUE(textBuffer.GetRowByOffset(1).Reset(TextAttribute{}));
+        s.UpdateRows(1, 1);
+        DoFindAllChecks(s, { 0, 2, 3 });
+
+        Log::Comment(L"Circling the buffer moves the matches up a row and drops the ones in the first.");
+        textBuffer.IncrementCircularBuffer();
+        s.UpdateAfterCircling(1);
+        DoFindAllChecks(s, { 1, 2 });
+    }
+
+    void DoHighlightChecks(SCREEN_INFORMATION& screenInfo, const std::vector<SMALL_RECT>& rectsExpected)
+    {
+        const auto rects = screenInfo.GetSearchHighlightRects(screenInfo.GetBufferSize());
+        VERIFY_ARE_EQUAL(rectsExpected.size(), rects.size());
+        for (size_t i = 0; i < rects.size(); i++)
+        {
+            VERIFY_ARE_EQUAL(rectsExpected[i], rects[i].ToInclusive());
+        }
+    }
+
+    TEST_METHOD(SearchHighlightFollowsOutput)
+    {
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        auto& outputBuffer = gci.GetActiveOutputBuffer();
+        auto& textBuffer = outputBuffer.GetTextBuffer();
+
+        outputBuffer.SetSearchHighlight(std::make_unique<Search>(outputBuffer, L"AB", Search::Direction::Forward, Search::Sensitivity::CaseSensitive));
+        DoHighlightChecks(outputBuffer, { { 0, 0, 1, 0 }, { 0, 1, 1, 1 }, { 0, 2, 1, 2 }, { 0, 3, 1, 3 } });
+
+        Log::Comment(L"Text written to the buffer is searched as it's written.");
+        textBuffer.Write(OutputCellIterator(L"xxAB"), { 0, 5 });
+        DoHighlightChecks(outputBuffer, { { 0, 0, 1, 0 }, { 0, 1, 1, 1 }, { 0, 2, 1, 2 }, { 0, 3, 1, 3 }, { 2, 5, 3, 5 } });
+
+        Log::Comment(L"Circling the buffer moves the highlight up with the text.");
+        textBuffer.IncrementCircularBuffer();
+        DoHighlightChecks(outputBuffer, { { 0, 0, 1, 0 }, { 0, 1, 1, 1 }, { 0, 2, 1, 2 }, { 2, 4, 3, 4 } });
+
+        Log::Comment(L"Writing over a match after circling drops it.");
+        textBuffer.Write(OutputCellIterator(L"zz"), { 0, 0 });
+        DoHighlightChecks(outputBuffer, { { 0, 1, 1, 1 }, { 0, 2, 1, 2 }, { 2, 4, 3, 4 } });
+
+        outputBuffer.ClearSearchHighlight();
+        DoHighlightChecks(outputBuffer, {});
+    }
+
+    TEST_METHOD(ForwardRegularExpression)
+    {
+        const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        const auto& outputBuffer = gci.GetActiveOutputBuffer();
+
+        Search s(outputBuffer, L"B\x304b[A-Z]", Search::Direction::Forward, Search::Sensitivity::CaseSensitive, Search::Syntax::RegularExpression);
+        const auto& matches = s.FindAll();
+        VERIFY_ARE_EQUAL(4u, matches.size());
+        for (SHORT row = 0; row < 4; row++)
+        {
+            // The wide character takes two cells, so the match ends on the C at the 5th cell.
+            VERIFY_ARE_EQUAL((COORD{ 1, row }), matches[row].first);
+            VERIFY_ARE_EQUAL((COORD{ 4, row }), matches[row].second);
+        }
+
+        VERIFY_IS_TRUE(s.FindNext());
+        VERIFY_ARE_EQUAL((COORD{ 1, 0 }), s._coordSelStart);
+        VERIFY_ARE_EQUAL((COORD{ 4, 0 }), s._coordSelEnd);
+    }
+
+    TEST_METHOD(RegularExpressionSpansWrappedRows)
+    {
+        const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        const auto& outputBuffer = gci.GetActiveOutputBuffer();
+
+        Log::Comment(L"Row 1 wraps into row 2, so only that pair of rows is one line.");
+        Search s(outputBuffer, L"e\\s+a", Search::Direction::Forward, Search::Sensitivity::CaseInsensitive, Search::Syntax::RegularExpression);
+        const auto& matches = s.FindAll();
+        VERIFY_ARE_EQUAL(1u, matches.size());
+        VERIFY_ARE_EQUAL((COORD{ 8, 1 }), matches[0].first);
+        VERIFY_ARE_EQUAL((COORD{ 0, 2 }), matches[0].second);
+    }
+
+    TEST_METHOD(InvalidRegularExpressionThrows)
+    {
+        const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        const auto& outputBuffer = gci.GetActiveOutputBuffer();
+
+        VERIFY_THROWS_SPECIFIC(Search(outputBuffer, L"(", Search::Direction::Forward, Search::Sensitivity::CaseSensitive, Search::Syntax::RegularExpression),
+                               wil::ResultException,
+                               [](wil::ResultException& e) { return e.GetErrorCode() == E_INVALIDARG; });
+    }
 };
@@ -10,6 +10,7 @@
 #include "globals.h"
 #include "../buffer/out/textBuffer.hpp"
 #include "../buffer/out/CharRow.hpp"
+#include "../buffer/out/LogicalLine.hpp"
 
 #include "input.h"
 #include "_stream.h"
@@ -142,6 +143,18 @@ class TextBufferTests
 
     TEST_METHOD(TestBurrito);
 
+    TEST_METHOD(TestWriteStreamWrapsAtRightEdge);
+    TEST_METHOD(TestWriteStreamCyclesBuffer);
+    TEST_METHOD(TestWriteStreamWideGlyphAtRightEdge);
+    TEST_METHOD(TestWriteStreamSurrogatePairs);
+
+    TEST_METHOD(ScrollRowsAroundCircularBufferEnd);
+    TEST_METHOD(ResizeTraditionalKeepsRowsInCellSlab);
+    TEST_METHOD(OverwritingStoredGlyphReleasesIt);
+    TEST_METHOD(WriteCellsMergesAttributeRuns);
+
+    TEST_METHOD(TestLogicalLineJoinsWrappedRows);
+
 };
 
 void TextBufferTests::TestBufferCreate()
@@ -1899,14 +1912,17 @@ void TextBufferTests::ResizeTraditionalHighUnicodeRowRemoval()
     const auto readBackText = *readBack;
     VERIFY_ARE_EQUAL(String(emoji), String(readBackText.data(), gsl::narrow<int>(readBackText.size())));
 
-    VERIFY_ARE_EQUAL(1u, _buffer->GetUnicodeStorage()._map.size(), L"There should be one item in the map.");
+    VERIFY_ARE_EQUAL(1u, _buffer->_storage[pos.Y].GetUnicodeStorage().size(), L"There should be one item in the row's storage.");
 
     // Perform resize to trim off the row of the buffer that included the emoji
     COORD trimmedBufferSize{ bufferSize.X, bufferSize.Y - 1 };
 
     VERIFY_NT_SUCCESS(_buffer->ResizeTraditional(trimmedBufferSize));
 
-    VERIFY_IS_TRUE(_buffer->GetUnicodeStorage()._map.empty(), L"The map should now be empty.");
+    for (const auto& row : _buffer->_storage)
+    {
+        VERIFY_IS_TRUE(row.GetUnicodeStorage().empty(), L"Every row's storage should now be empty.");
+    }
 }
 
 // This tests that columns removed from the buffer while resizing traditionally will also drop the high unicode
@@ -1934,14 +1950,17 @@ void TextBufferTests::ResizeTraditionalHighUnicodeColumnRemoval()
     const auto readBackText = *readBack;
     VERIFY_ARE_EQUAL(String(emoji), String(readBackText.data(), gsl::narrow<int>(readBackText.size())));
 
-    VERIFY_ARE_EQUAL(1u, _buffer->GetUnicodeStorage()._map.size(), L"There should be one item in the map.");
+    VERIFY_ARE_EQUAL(1u, _buffer->_storage[pos.Y].GetUnicodeStorage().size(), L"There should be one item in the row's storage.");
 
     // Perform resize to trim off the column of the buffer that included the emoji
     COORD trimmedBufferSize{ bufferSize.X - 1, bufferSize.Y};
 
     VERIFY_NT_SUCCESS(_buffer->ResizeTraditional(trimmedBufferSize));
 
-    VERIFY_IS_TRUE(_buffer->GetUnicodeStorage()._map.empty(), L"The map should now be empty.");
+    for (const auto& row : _buffer->_storage)
+    {
+        VERIFY_IS_TRUE(row.GetUnicodeStorage().empty(), L"Every row's storage should now be empty.");
+    }
 }
 
 void TextBufferTests::TestBurrito()
@@ -1964,3 +1983,322 @@ void TextBufferTests::TestBurrito()
     _buffer->IncrementCursor();
     VERIFY_IS_FALSE(afterBurritoIter);
 }
+
+void TextBufferTests::TestWriteStreamWrapsAtRightEdge()
+{
+    COORD bufferSize{ 10, 5 };
+    UINT cursorSize = 12;
+    TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    Log::Comment(L"Filling the row exactly leaves the cursor on the last column with a delayed wrap.");
+    auto cCycled = _buffer->WriteStream(L"0123456789", attr);
+    VERIFY_ARE_EQUAL(0u, cCycled);
+    VERIFY_ARE_EQUAL(COORD({ 9, 0 }), _buffer->GetCursor().GetPosition());
+    VERIFY_IS_TRUE(_buffer->GetCursor().IsDelayedEOLWrap());
+    VERIFY_IS_FALSE(_buffer->GetRowByOffset(0).GetCharRow().WasWrapForced());
+
+    Log::Comment(L"Then the next character wraps onto the next row.");
+    cCycled = _buffer->WriteStream(L"abc", attr);
+    VERIFY_ARE_EQUAL(0u, cCycled);
+    VERIFY_ARE_EQUAL(COORD({ 3, 1 }), _buffer->GetCursor().GetPosition());
+
+    const auto& firstRow = _buffer->GetRowByOffset(0).GetCharRow();
+    const auto& secondRow = _buffer->GetRowByOffset(1).GetCharRow();
+    VERIFY_IS_TRUE(firstRow.WasWrapForced());
+    VERIFY_IS_FALSE(secondRow.WasWrapForced());
+    VERIFY_IS_TRUE(std::wstring_view{ firstRow.GlyphAt(9) } == L"9");
+    VERIFY_IS_TRUE(std::wstring_view{ secondRow.GlyphAt(0) } == L"a");
+    VERIFY_IS_TRUE(std::wstring_view{ secondRow.GlyphAt(2) } == L"c");
+
+    Log::Comment(L"Moving the cursor cancels the delayed wrap.");
+    _buffer->WriteStream(L"defghij", attr);
+    VERIFY_ARE_EQUAL(COORD({ 9, 1 }), _buffer->GetCursor().GetPosition());
+    _buffer->GetCursor().SetPosition({ 9, 2 });
+    VERIFY_IS_FALSE(_buffer->GetCursor().IsDelayedEOLWrap());
+
+    _buffer->WriteStream(L"k", attr);
+    VERIFY_ARE_EQUAL(COORD({ 9, 2 }), _buffer->GetCursor().GetPosition());
+    VERIFY_IS_FALSE(secondRow.WasWrapForced());
+    VERIFY_IS_TRUE(std::wstring_view{ _buffer->GetRowByOffset(2).GetCharRow().GlyphAt(9) } == L"k");
+    VERIFY_IS_TRUE(std::wstring_view{ _buffer->GetRowByOffset(3).GetCharRow().GlyphAt(0) } == L" ");
+}
+
+void TextBufferTests::TestWriteStreamCyclesBuffer()
+{
+    COORD bufferSize{ 10, 5 };
+    UINT cursorSize = 12;
+    TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    _buffer->GetCursor().SetPosition({ 0, 4 });
+
+    Log::Comment(L"Write 2.5 rows worth of text starting on the last row. The buffer should cycle twice.");
+    const std::wstring text(25, L'X');
+    const auto cCycled = _buffer->WriteStream(text, attr);
+    VERIFY_ARE_EQUAL(2u, cCycled);
+    VERIFY_ARE_EQUAL(COORD({ 5, 4 }), _buffer->GetCursor().GetPosition());
+
+    VERIFY_IS_TRUE(_buffer->GetRowByOffset(2).GetCharRow().WasWrapForced());
+    VERIFY_IS_TRUE(_buffer->GetRowByOffset(3).GetCharRow().WasWrapForced());
+    VERIFY_IS_TRUE(std::wstring_view{ _buffer->GetRowByOffset(4).GetCharRow().GlyphAt(4) } == L"X");
+    VERIFY_IS_TRUE(std::wstring_view{ _buffer->GetRowByOffset(4).GetCharRow().GlyphAt(5) } == L" ");
+}
+
+void TextBufferTests::TestWriteStreamWideGlyphAtRightEdge()
+{
+    COORD bufferSize{ 10, 5 };
+    UINT cursorSize = 12;
+    TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    Log::Comment(L"A wide glyph that only has one column left pads the row and moves to the next.");
+    _buffer->WriteStream(L"012345678\x3042", attr);
+    VERIFY_ARE_EQUAL(COORD({ 2, 1 }), _buffer->GetCursor().GetPosition());
+
+    const auto& firstRow = _buffer->GetRowByOffset(0).GetCharRow();
+    const auto& secondRow = _buffer->GetRowByOffset(1).GetCharRow();
+    VERIFY_IS_TRUE(firstRow.WasDoubleBytePadded());
+    VERIFY_IS_TRUE(firstRow.WasWrapForced());
+    VERIFY_IS_TRUE(secondRow.DbcsAttrAt(0).IsLeading());
+    VERIFY_IS_TRUE(secondRow.DbcsAttrAt(1).IsTrailing());
+    VERIFY_IS_TRUE(std::wstring_view{ secondRow.GlyphAt(0) } == L"\x3042");
+}
+
+void TextBufferTests::TestWriteStreamSurrogatePairs()
+{
+    COORD bufferSize{ 10, 5 };
+    UINT cursorSize = 12;
+    TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    // This is the burrito emoji, twice, with a letter in between.
+    _buffer->WriteStream(L"\xD83C\xDF2F" L"a" L"\xD83C\xDF2F", attr);
+
+    const auto& row = _buffer->GetRowByOffset(0).GetCharRow();
+    const auto cursor = _buffer->GetCursor().GetPosition();
+    VERIFY_ARE_EQUAL(0, cursor.Y);
+
+    // Whether the emoji takes one or two cells depends on the font, so
+    //      find the 'a' rather than assuming where it landed.
+    const auto cellsPerEmoji = (cursor.X - 1) / 2;
+    VERIFY_IS_TRUE(cellsPerEmoji == 1 || cellsPerEmoji == 2);
+    VERIFY_IS_TRUE(std::wstring_view{ row.GlyphAt(0) } == L"\xD83C\xDF2F");
+    VERIFY_IS_TRUE(std::wstring_view{ row.GlyphAt(cellsPerEmoji) } == L"a");
+    VERIFY_IS_TRUE(std::wstring_view{ row.GlyphAt(cellsPerEmoji + 1) } == L"\xD83C\xDF2F");
+}
+
+void TextBufferTests::ScrollRowsAroundCircularBufferEnd()
+{
+    COORD bufferSize{ 10, 6 };
+    UINT cursorSize = 12;
+    TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    Log::Comment(L"Start the circular buffer near the end of the storage so the scrolled rows straddle it.");
+    _buffer->_SetFirstRowIndex(4);
+
+    const std::wstring_view labels{ L"ABCDEF" };
+    for (size_t i = 0; i < labels.size(); ++i)
+    {
+        _buffer->GetRowByOffset(i).GetCharRow().GlyphAt(0) = labels.substr(i, 1);
+    }
+
+    // This is the glowing star emoji: 🌟
+    // It's encoded in UTF-16 and has to go through the UnicodeStorage.
+    const auto star = L"\xD83C\xDF1F";
+    _buffer->GetRowByOffset(2).GetCharRow().GlyphAt(1) = star;
+
+    Log::Comment(L"Move rows 2 and 3 up by one. Row 1 should end up below them.");
+    _buffer->ScrollRows(2, 2, -1);
+
+    const std::wstring_view expected{ L"ACDBEF" };
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        VERIFY_IS_TRUE(std::wstring_view{ _buffer->GetRowByOffset(i).GetCharRow().GlyphAt(0) } == expected.substr(i, 1));
+    }
+    VERIFY_IS_TRUE(std::wstring_view{ _buffer->GetRowByOffset(1).GetCharRow().GlyphAt(1) } == star);
+    VERIFY_IS_TRUE(std::wstring_view{ _buffer->GetRowByOffset(2).GetCharRow().GlyphAt(1) } == L" ");
+
+    Log::Comment(L"The circular buffer shouldn't have been rotated back to the front to do the scroll.");
+    VERIFY_ARE_EQUAL(4, _buffer->GetFirstRowIndex());
+
+    for (size_t i = 0; i < _buffer->_storage.size(); ++i)
+    {
+        VERIFY_ARE_EQUAL(gsl::narrow<SHORT>(i), _buffer->_storage[i].GetId());
+    }
+}
+
+void TextBufferTests::ResizeTraditionalKeepsRowsInCellSlab()
+{
+    COORD bufferSize{ 10, 6 };
+    UINT cursorSize = 12;
+    TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    _buffer->_SetFirstRowIndex(3);
+
+    const std::wstring_view labels{ L"ABCDEF" };
+    for (size_t i = 0; i < labels.size(); ++i)
+    {
+        _buffer->GetRowByOffset(i).GetCharRow().GlyphAt(9) = labels.substr(i, 1);
+    }
+
+    const COORD newSize{ 12, 8 };
+    VERIFY_SUCCEEDED(_buffer->ResizeTraditional(newSize));
+    VERIFY_ARE_EQUAL(0, _buffer->GetFirstRowIndex());
+
+    const auto slabBegin = _buffer->_cells.data();
+    const auto slabEnd = slabBegin + _buffer->_cells.size();
+    for (SHORT i = 0; i < newSize.Y; ++i)
+    {
+        auto& charRow = _buffer->GetRowByOffset(i).GetCharRow();
+
+        Log::Comment(NoThrowString().Format(L"Row %d should be backed by the buffer's cell slab.", i));
+        VERIFY_ARE_EQUAL(static_cast<size_t>(newSize.X), charRow.size());
+        VERIFY_IS_TRUE(charRow.cbegin() >= slabBegin && charRow.cend() <= slabEnd);
+
+        const auto expected = i < gsl::narrow<SHORT>(labels.size()) ? labels.substr(i, 1) : std::wstring_view{ L" " };
+        VERIFY_IS_TRUE(std::wstring_view{ charRow.GlyphAt(9) } == expected);
+        VERIFY_IS_TRUE(std::wstring_view{ charRow.GlyphAt(11) } == L" ");
+    }
+}
+
+void TextBufferTests::OverwritingStoredGlyphReleasesIt()
+{
+    COORD bufferSize{ 10, 3 };
+    UINT cursorSize = 12;
+    TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    auto& row = _buffer->GetRowByOffset(1);
+    auto& charRow = row.GetCharRow();
+
+    // This is the crescent moon emoji: 🌙
+    const auto moon = L"\xD83C\xDF19";
+    charRow.GlyphAt(2) = moon;
+    charRow.GlyphAt(5) = moon;
+    charRow.GlyphAt(7) = moon;
+    VERIFY_ARE_EQUAL(3u, row.GetUnicodeStorage().size());
+
+    Log::Comment(L"Writing a single character over a stored glyph should drop it from the storage.");
+    charRow.GlyphAt(2) = L"a";
+    VERIFY_ARE_EQUAL(2u, row.GetUnicodeStorage().size());
+    VERIFY_IS_TRUE(std::wstring_view{ charRow.GlyphAt(2) } == L"a");
+
+    Log::Comment(L"Clearing a cell should drop its glyph too.");
+    charRow.ClearCell(5);
+    VERIFY_ARE_EQUAL(1u, row.GetUnicodeStorage().size());
+    VERIFY_IS_TRUE(std::wstring_view{ charRow.GlyphAt(7) } == moon);
+
+    Log::Comment(L"Writing text over a stored glyph through the row should drop it too.");
+    charRow.GlyphAt(8) = moon;
+    VERIFY_ARE_EQUAL(2u, row.GetUnicodeStorage().size());
+    row.WriteCells(OutputCellIterator{ std::wstring_view{ L"bc" }, attr }, 7, false);
+    VERIFY_IS_TRUE(row.GetUnicodeStorage().empty());
+    VERIFY_IS_TRUE(std::wstring_view{ charRow.GlyphAt(7) } == L"b");
+    VERIFY_IS_TRUE(std::wstring_view{ charRow.GlyphAt(8) } == L"c");
+
+    Log::Comment(L"Resetting the row should leave nothing behind.");
+    VERIFY_IS_TRUE(row.Reset(attr));
+    VERIFY_IS_TRUE(row.GetUnicodeStorage().empty());
+}
+
+void TextBufferTests::WriteCellsMergesAttributeRuns()
+{
+    COORD bufferSize{ 20, 3 };
+    UINT cursorSize = 12;
+    TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    auto& row = _buffer->GetRowByOffset(1);
+    const auto& attrRow = row.GetAttrRow();
+
+    const TextAttribute red{ FOREGROUND_RED };
+    const TextAttribute green{ FOREGROUND_GREEN };
+    const DbcsAttribute single{};
+
+    Log::Comment(L"A colored line written in one call should come out as one run per color change.");
+    std::vector<OutputCell> cells;
+    for (const auto wch : std::wstring_view{ L"drwx hi.txt" })
+    {
+        cells.emplace_back(std::wstring_view{ &wch, 1 }, single, wch == L' ' || wch == L'.' ? attr : (wch < L'i' ? red : green));
+    }
+    row.WriteCells(OutputCellIterator({ cells.data(), cells.size() }), 2, false);
+
+    const std::vector<TextAttribute> expected{ attr, attr,
+                                               red, green, green, green, attr, red, green, attr, green, green, green,
+                                               attr, attr, attr, attr, attr, attr, attr };
+    const std::vector<TextAttribute> actual{ attrRow.begin(), attrRow.end() };
+    VERIFY_ARE_EQUAL(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        VERIFY_ARE_EQUAL(expected[i], actual[i]);
+    }
+    VERIFY_ARE_EQUAL(9u, attrRow.GetNumberOfRuns());
+
+    Log::Comment(L"Text written without colors should keep the ones already there.");
+    row.WriteCells(OutputCellIterator(std::wstring_view{ L"abcdef" }), 4, false);
+    const std::vector<TextAttribute> kept{ attrRow.begin(), attrRow.end() };
+    VERIFY_ARE_EQUAL(expected.size(), kept.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        VERIFY_ARE_EQUAL(expected[i], kept[i]);
+    }
+    VERIFY_IS_TRUE(std::wstring_view{ row.GetCharRow().GlyphAt(9) } == L"f");
+
+    Log::Comment(L"Writing one color over the boundaries of several runs should merge with its neighbors.");
+    row.WriteCells(OutputCellIterator(L'-', green, 5), 4, false);
+    VERIFY_ARE_EQUAL(red, attrRow.GetAttrByColumn(2));
+    VERIFY_ARE_EQUAL(green, attrRow.GetAttrByColumn(3));
+    VERIFY_ARE_EQUAL(green, attrRow.GetAttrByColumn(8));
+    VERIFY_ARE_EQUAL(attr, attrRow.GetAttrByColumn(9));
+    VERIFY_ARE_EQUAL(6u, attrRow.GetNumberOfRuns());
+
+    Log::Comment(L"Writing the whole row in one color should leave a single run.");
+    row.WriteCells(OutputCellIterator(L' ', attr, bufferSize.X), 0, false);
+    VERIFY_ARE_EQUAL(1u, attrRow.GetNumberOfRuns());
+}
+
+void TextBufferTests::TestLogicalLineJoinsWrappedRows()
+{
+    COORD bufferSize{ 10, 5 };
+    UINT cursorSize = 12;
+    TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    // The text wraps after "hello worl", and the wide character takes cells 2 and 3 of the second row.
+    _buffer->WriteStream(L"hello world \x304b!", attr);
+
+    LogicalLine line;
+
+    Log::Comment(L"Reading either row gives the whole line, without the trailing spaces.");
+    line.Read(*_buffer, 1);
+    VERIFY_ARE_EQUAL(0, line.GetTop());
+    VERIFY_ARE_EQUAL(1, line.GetBottom());
+    VERIFY_IS_TRUE(line.GetText() == L"hello world \x304b!");
+
+    line.Read(*_buffer, 0);
+    VERIFY_ARE_EQUAL(0, line.GetTop());
+    VERIFY_ARE_EQUAL(1, line.GetBottom());
+
+    Log::Comment(L"Text across the wrap maps back onto both rows.");
+    auto span = line.GetCellSpan(6, 5);
+    VERIFY_ARE_EQUAL(COORD({ 6, 0 }), span.first);
+    VERIFY_ARE_EQUAL(COORD({ 0, 1 }), span.second);
+
+    Log::Comment(L"A wide character maps back onto both of its cells.");
+    span = line.GetCellSpan(12, 1);
+    VERIFY_ARE_EQUAL(COORD({ 2, 1 }), span.first);
+    VERIFY_ARE_EQUAL(COORD({ 3, 1 }), span.second);
+
+    span = line.GetCellSpan(13, 1);
+    VERIFY_ARE_EQUAL(COORD({ 4, 1 }), span.first);
+    VERIFY_ARE_EQUAL(COORD({ 4, 1 }), span.second);
+
+    Log::Comment(L"A blank row is a line of its own with no text.");
+    line.Read(*_buffer, 2);
+    VERIFY_ARE_EQUAL(2, line.GetTop());
+    VERIFY_ARE_EQUAL(2, line.GetBottom());
+    VERIFY_IS_TRUE(line.GetText().empty());
+}
@@ -0,0 +1,132 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../../types/inc/Utf8Decoder.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class Utf8DecoderTests
+{
+    TEST_CLASS(Utf8DecoderTests);
+
+    // "A", e with acute, the kanji for "day", and a grinning face emoji.
+    // Each one is a different length in UTF-8.
+    static constexpr std::string_view s_mixed{ "A\xC3\xA9\xE6\x97\xA5\xF0\x9F\x98\x80" };
+    static constexpr std::wstring_view s_mixedExpected{ L"A\x00E9\x65E5\xD83D\xDE00" };
+
+    TEST_METHOD(DecodesAscii)
+    {
+        Utf8Decoder decoder;
+
+        // Long enough to go through the 8 bytes at a time path, and the tail.
+        const std::string_view ascii{ "The quick brown fox jumps over the lazy dog\r\n\x1b[0m" };
+        const std::wstring_view expected{ L"The quick brown fox jumps over the lazy dog\r\n\x1b[0m" };
+
+        const auto actual = decoder.Decode(ascii);
+        VERIFY_ARE_EQUAL(String(std::wstring{ expected }.c_str()), String(std::wstring{ actual }.c_str()));
+        VERIFY_IS_TRUE(decoder.Flush().empty());
+    }
+
+    TEST_METHOD(DecodesMultiByteSequences)
+    {
+        Utf8Decoder decoder;
+
+        const auto actual = decoder.Decode(s_mixed);
+        VERIFY_ARE_EQUAL(s_mixedExpected.size(), actual.size());
+        VERIFY_IS_TRUE(s_mixedExpected == actual);
+    }
+
+    TEST_METHOD(CarriesPartialSequencesAcrossCalls)
+    {
+        Log::Comment(L"Split the input at every possible point, and make sure we get the same text back either way.");
+        for (size_t split = 0; split <= s_mixed.size(); split++)
+        {
+            Utf8Decoder decoder;
+
+            std::wstring actual{ decoder.Decode(s_mixed.substr(0, split)) };
+            actual += decoder.Decode(s_mixed.substr(split));
+            actual += decoder.Flush();
+
+            Log::Comment(NoThrowString().Format(L"Split at %zu", split));
+            VERIFY_IS_TRUE(s_mixedExpected == actual);
+        }
+
+        Log::Comment(L"Feed it one byte at a time.");
+        Utf8Decoder decoder;
+        std::wstring actual;
+        for (const auto ch : s_mixed)
+        {
+            actual += decoder.Decode({ &ch, 1 });
+        }
+        VERIFY_IS_TRUE(s_mixedExpected == actual);
+    }
+
+    TEST_METHOD(ReplacesInvalidSequences)
+    {
+        struct TestCase
+        {
+            std::string_view input;
+            std::wstring_view expected;
+        };
+
+        const TestCase cases[] = {
+            // A stray continuation byte
+            { "a\x80z", L"a\xFFFDz" },
+            // Bytes that never appear in UTF-8
+            { "a\xC0\xC1\xF5\xFFz", L"a\xFFFD\xFFFD\xFFFD\xFFFDz" },
+            // A truncated sequence, followed by ASCII. The ASCII is kept.
+            { "\xE6\x97z", L"\xFFFDz" },
+            // A truncated sequence, followed by a new sequence.
+            { "\xF0\x9F\xE6\x97\xA5", L"\xFFFD\x65E5" },
+            // An overlong encoding of "/". Every byte is replaced on its own.
+            { "\xE0\x80\xAF", L"\xFFFD\xFFFD\xFFFD" },
+            // An encoded surrogate
+            { "\xED\xA0\x80", L"\xFFFD\xFFFD\xFFFD" },
+            // Past U+10FFFF
+            { "\xF4\x90\x80\x80", L"\xFFFD\xFFFD\xFFFD\xFFFD" },
+        };
+
+        for (const auto& test : cases)
+        {
+            Utf8Decoder decoder;
+            std::wstring actual{ decoder.Decode(test.input) };
+            actual += decoder.Flush();
+            VERIFY_ARE_EQUAL(String(std::wstring{ test.expected }.c_str()), String(actual.c_str()));
+        }
+    }
+
+    TEST_METHOD(FlushReplacesIncompleteSequence)
+    {
+        Utf8Decoder decoder;
+
+        VERIFY_IS_TRUE(decoder.Decode("a\xF0\x9F\x98").size() == 1);
+
+        const auto flushed = decoder.Flush();
+        VERIFY_ARE_EQUAL(1u, flushed.size());
+        VERIFY_ARE_EQUAL(Utf8Decoder::UNICODE_REPLACEMENT, flushed.front());
+
+        Log::Comment(L"The sequence was dropped, so the next call starts fresh.");
+        VERIFY_IS_TRUE(decoder.Decode("\x80").front() == Utf8Decoder::UNICODE_REPLACEMENT);
+    }
+
+    TEST_METHOD(ReusesOutputBuffer)
+    {
+        Utf8Decoder decoder;
+
+        const std::string chunk(4096, 'x');
+        const auto pwchFirst = decoder.Decode(chunk).data();
+
+        Log::Comment(L"Chunks no bigger than the first shouldn't need a new buffer.");
+        for (size_t i = 0; i < 16; i++)
+        {
+            const auto decoded = decoder.Decode({ chunk.data(), chunk.size() - i });
+            VERIFY_ARE_EQUAL(pwchFirst, decoded.data());
+        }
+    }
+};
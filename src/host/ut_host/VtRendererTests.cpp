@@ -11,6 +11,9 @@
 #include "../../renderer/vt/WinTelnetEngine.hpp"
 #include "../Settings.hpp"
 
+#include <chrono>
+#include <thread>
+
 using namespace WEX::Common;
 using namespace WEX::Logging;
 using namespace WEX::TestExecution;
@@ -94,8 +97,12 @@ class Microsoft::Console::Render::VtRendererTest
     TEST_METHOD(VtSequenceHelperTests);
 
     TEST_METHOD(Xterm256TestInvalidate);
+    TEST_METHOD(Xterm256TestInvalidateRegions);
     TEST_METHOD(Xterm256TestColors);
     TEST_METHOD(Xterm256TestCursor);
+    TEST_METHOD(Xterm256TestCursorMoveCosts);
+    TEST_METHOD(Xterm256TestShadowBuffer);
+    TEST_METHOD(Xterm256TestScrollRegion);
 
     TEST_METHOD(XtermTestInvalidate);
     TEST_METHOD(XtermTestColors);
@@ -109,6 +116,16 @@ class Microsoft::Console::Render::VtRendererTest
 
     TEST_METHOD(TestResize);
 
+    TEST_METHOD(TestFrameIsWrittenOnPresent);
+
+    TEST_METHOD(TestSlowPipeDoesNotHoldLock);
+
+    TEST_METHOD(TestFullFrameRepaintSequences);
+
+    TEST_METHOD(TestTuiCorpusBytes);
+
+    TEST_METHOD(TestShadowBufferBytes);
+
     void Test16Colors(VtEngine* engine);
 
     std::deque<std::string> qExpectedInput;
@@ -230,6 +247,18 @@ void VtRendererTest::VtSequenceHelperTests()
     qExpectedInput.push_back("\x1b[2X");
     VERIFY_SUCCEEDED(engine->_EraseCharacter(2));
 
+    qExpectedInput.push_back("\x1b[3;7r");
+    VERIFY_SUCCEEDED(engine->_SetScrollingRegion(2, 6));
+
+    qExpectedInput.push_back("\x1b[r");
+    VERIFY_SUCCEEDED(engine->_ResetScrollingRegion());
+
+    qExpectedInput.push_back("\x1b[S");
+    VERIFY_SUCCEEDED(engine->_ScrollUpDown(1, true));
+
+    qExpectedInput.push_back("\x1b[3T");
+    VERIFY_SUCCEEDED(engine->_ScrollUpDown(3, false));
+
     qExpectedInput.push_back("\x1b[2;3H");
     VERIFY_SUCCEEDED(engine->_CursorPosition({2, 1}));
 
@@ -247,6 +276,23 @@ void VtRendererTest::VtSequenceHelperTests()
 
     qExpectedInput.push_back("\x1b[10C");
     VERIFY_SUCCEEDED(engine->_CursorForward(10));
+
+    qExpectedInput.push_back("\x1b[38;2;1;2;3m");
+    VERIFY_SUCCEEDED(engine->_SetGraphicsRenditionRGBColor(RGB(1, 2, 3), true));
+
+    qExpectedInput.push_back("\x1b[48;2;255;0;128m");
+    VERIFY_SUCCEEDED(engine->_SetGraphicsRenditionRGBColor(RGB(255, 0, 128), false));
+
+    qExpectedInput.push_back("\x1b[97m");
+    VERIFY_SUCCEEDED(engine->_SetGraphicsRendition16Color(FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE | FOREGROUND_INTENSITY, true));
+
+    qExpectedInput.push_back("\x1b[32767;32767H");
+    VERIFY_SUCCEEDED(engine->_CursorPosition({ SHORT_MAX - 1, SHORT_MAX - 1 }));
+
+    Log::Comment(NoThrowString().Format(
+        L"A sequence with more parameters than we ever emit is rejected rather than overflowing."
+    ));
+    VERIFY_ARE_EQUAL(E_INVALIDARG, engine->_WriteCsi({ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 }, 'm'));
 }
 
 void VtRendererTest::Xterm256TestInvalidate()
@@ -334,7 +380,7 @@ void VtRendererTest::Xterm256TestInvalidate()
 
         VERIFY_ARE_EQUAL(invalid, engine->_invalidRect.ToExclusive());
 
-        qExpectedInput.push_back("\x1b[32;1H"); // Bottom of buffer
+        qExpectedInput.push_back("\x1b[32d"); // Bottom of buffer, the cursor is already in the first column
         qExpectedInput.push_back("\n"); // Scroll down once
         VERIFY_SUCCEEDED(engine->ScrollFrame());
     });
@@ -390,20 +436,91 @@ void VtRendererTest::Xterm256TestInvalidate()
         VerifyOutputTraits<SMALL_RECT>::ToString(engine->_invalidRect.ToExclusive())
     ));
 
-    qExpectedInput.push_back("\x1b[2J");
-    TestPaint(*engine, [&]()
+    TestPaintXterm(*engine, [&]()
     {
         Log::Comment(NoThrowString().Format(
-            L"---- Scrolled one down and one up, nothing should change ----"
-            L" But it still does for now MSFT:14169294"
+            L"---- Scrolled one down and one up, nothing should move ----"
+            L" The invalid region spans the whole viewport, but only the top"
+            L" and bottom lines are actually dirty, so don't clear the screen."
         ));
         invalid = view.ToExclusive();
         VERIFY_ARE_EQUAL(invalid, engine->_invalidRect.ToExclusive());
 
+        const SMALL_RECT topLine = { 0, 0, 79, 0 };
+        const SMALL_RECT bottomLine = { 0, 31, 79, 31 };
+        const auto dirty = engine->GetDirtyArea();
+        VERIFY_ARE_EQUAL(static_cast<size_t>(2), dirty.size());
+        VERIFY_ARE_EQUAL(topLine, dirty[0]);
+        VERIFY_ARE_EQUAL(bottomLine, dirty[1]);
+
         VERIFY_SUCCEEDED(engine->ScrollFrame());
     });
 }
 
+void VtRendererTest::Xterm256TestInvalidateRegions()
+{
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    std::unique_ptr<Xterm256Engine> engine = std::make_unique<Xterm256Engine>(std::move(hFile), p, SetUpViewport(), g_ColorTable, static_cast<WORD>(COLOR_TABLE_SIZE));
+    auto pfn = std::bind(&VtRendererTest::WriteCallback, this, std::placeholders::_1, std::placeholders::_2);
+    engine->SetTestCallback(pfn);
+
+    // Verify the first paint emits a clear and go home
+    qExpectedInput.push_back("\x1b[2J");
+    VERIFY_IS_TRUE(engine->_firstPaint);
+    TestPaint(*engine, [&]() {
+        VERIFY_IS_FALSE(engine->_firstPaint);
+    });
+
+    Viewport view = SetUpViewport();
+
+    Log::Comment(NoThrowString().Format(
+        L"Make sure that invalidating opposite corners, like a spinner and a "
+        L"clock, only dirties those corners and not everything between them."
+    ));
+    const SMALL_RECT spinner = { 0, 0, 1, 1 };
+    const SMALL_RECT clock = { 72, 31, 80, 32 };
+    VERIFY_SUCCEEDED(engine->Invalidate(&spinner));
+    VERIFY_SUCCEEDED(engine->Invalidate(&clock));
+    TestPaintXterm(*engine, [&]()
+    {
+        VERIFY_ARE_EQUAL(view, engine->_invalidRect);
+
+        const auto dirty = engine->GetDirtyArea();
+        VERIFY_ARE_EQUAL(static_cast<size_t>(2), dirty.size());
+        VERIFY_ARE_EQUAL(Viewport::FromExclusive(spinner), Viewport::FromInclusive(dirty[0]));
+        VERIFY_ARE_EQUAL(Viewport::FromExclusive(clock), Viewport::FromInclusive(dirty[1]));
+    });
+
+    Log::Comment(NoThrowString().Format(
+        L"Make sure that rows with the same invalid columns are merged into one region."
+    ));
+    const SMALL_RECT block = { 10, 4, 20, 8 };
+    VERIFY_SUCCEEDED(engine->Invalidate(&block));
+    TestPaintXterm(*engine, [&]()
+    {
+        const auto dirty = engine->GetDirtyArea();
+        VERIFY_ARE_EQUAL(static_cast<size_t>(1), dirty.size());
+        VERIFY_ARE_EQUAL(Viewport::FromExclusive(block), Viewport::FromInclusive(dirty[0]));
+    });
+
+    Log::Comment(NoThrowString().Format(
+        L"Make sure that scrolling moves the invalid columns of each row along with it."
+    ));
+    const SMALL_RECT word = { 5, 2, 10, 3 };
+    VERIFY_SUCCEEDED(engine->Invalidate(&word));
+    COORD scrollDelta = { 0, 1 };
+    VERIFY_SUCCEEDED(engine->InvalidateScroll(&scrollDelta));
+    TestPaintXterm(*engine, [&]()
+    {
+        const SMALL_RECT topLine = { 0, 0, 79, 0 };
+        const SMALL_RECT scrolledWord = { 5, 2, 9, 3 };
+        const auto dirty = engine->GetDirtyArea();
+        VERIFY_ARE_EQUAL(static_cast<size_t>(2), dirty.size());
+        VERIFY_ARE_EQUAL(topLine, dirty[0]);
+        VERIFY_ARE_EQUAL(scrolledWord, dirty[1]);
+    });
+}
+
 void VtRendererTest::Xterm256TestColors()
 {
     wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
@@ -428,8 +545,7 @@ void VtRendererTest::Xterm256TestColors()
         L"Begin by setting some test values - FG,BG = (1,2,3), (4,5,6) to start"
         L"These values were picked for ease of formatting raw COLORREF values."
     ));
-    qExpectedInput.push_back("\x1b[38;2;1;2;3m");
-    qExpectedInput.push_back("\x1b[48;2;5;6;7m");
+    qExpectedInput.push_back("\x1b[38;2;1;2;3;48;2;5;6;7m");
     VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(0x00030201, 0x00070605, 0, false, false));
 
     TestPaint(*engine, [&]()
@@ -534,7 +650,7 @@ void VtRendererTest::Xterm256TestCursor()
     Viewport view = SetUpViewport();
 
     Log::Comment(NoThrowString().Format(
-        L"Test moving the cursor around. Every sequence should have both params to CUP explicitly."
+        L"Test moving the cursor around. Every move should use the shortest sequence that gets it there."
     ));
     TestPaint(*engine, [&]()
     {
@@ -542,15 +658,15 @@ void VtRendererTest::Xterm256TestCursor()
         VERIFY_SUCCEEDED(engine->_MoveCursor({1, 1}));
 
         Log::Comment(NoThrowString().Format(
-            L"----Only move Y coord----"
+            L"----Only move Y coord, VPA is shorter than CUP----"
         ));
-        qExpectedInput.push_back("\x1b[31;2H");
+        qExpectedInput.push_back("\x1b[31d");
         VERIFY_SUCCEEDED(engine->_MoveCursor({1, 30}));
 
         Log::Comment(NoThrowString().Format(
-            L"----Only move X coord----"
+            L"----Only move X coord, CHA is as short as CUF, and doesn't depend on where we think the cursor is----"
         ));
-        qExpectedInput.push_back("\x1b[29C");
+        qExpectedInput.push_back("\x1b[31G");
         VERIFY_SUCCEEDED(engine->_MoveCursor({30, 30}));
 
         Log::Comment(NoThrowString().Format(
@@ -569,7 +685,7 @@ void VtRendererTest::Xterm256TestCursor()
         Log::Comment(NoThrowString().Format(
             L"----move into the line to test some other sequences----"
         ));
-        qExpectedInput.push_back("\x1b[7C");
+        qExpectedInput.push_back("\x1b[8G");
         VERIFY_SUCCEEDED(engine->_MoveCursor({7, 0}));
 
         Log::Comment(NoThrowString().Format(
@@ -612,7 +728,7 @@ void VtRendererTest::Xterm256TestCursor()
         Log::Comment(NoThrowString().Format(
             L"Paint some text at 0,0, then try moving the cursor to where it currently is."
         ));
-        qExpectedInput.push_back("\x1b[1C");
+        qExpectedInput.push_back("\x1b[C");
         qExpectedInput.push_back("asdfghjkl");
 
         const wchar_t* const line = L"asdfghjkl";
@@ -645,6 +761,449 @@ void VtRendererTest::Xterm256TestCursor()
     });
 }
 
+void VtRendererTest::Xterm256TestCursorMoveCosts()
+{
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    std::unique_ptr<Xterm256Engine> engine = std::make_unique<Xterm256Engine>(std::move(hFile), p, SetUpViewport(), g_ColorTable, static_cast<WORD>(COLOR_TABLE_SIZE));
+    auto pfn = std::bind(&VtRendererTest::WriteCallback, this, std::placeholders::_1, std::placeholders::_2);
+    engine->SetTestCallback(pfn);
+
+    qExpectedInput.push_back("\x1b[2J");
+    TestPaint(*engine, [&]() {
+        VERIFY_IS_FALSE(engine->_firstPaint);
+    });
+
+    TestPaint(*engine, [&]()
+    {
+        Log::Comment(NoThrowString().Format(
+            L"----We don't know where the cursor is yet, so the first move is a CUP----"
+        ));
+        qExpectedInput.push_back("\x1b[2;2H");
+        VERIFY_SUCCEEDED(engine->_MoveCursor({ 1, 1 }));
+
+        Log::Comment(NoThrowString().Format(
+            L"----A couple of LFs are shorter than any sequence----"
+        ));
+        qExpectedInput.push_back("\n\n");
+        VERIFY_SUCCEEDED(engine->_MoveCursor({ 1, 3 }));
+
+        Log::Comment(NoThrowString().Format(
+            L"----VPA leaves out its parameter for the first row----"
+        ));
+        qExpectedInput.push_back("\x1b[d");
+        VERIFY_SUCCEEDED(engine->_MoveCursor({ 1, 0 }));
+
+        Log::Comment(NoThrowString().Format(
+            L"----CUD is as long as VPA, and the absolute move wins the tie----"
+        ));
+        qExpectedInput.push_back("\x1b[26d");
+        VERIFY_SUCCEEDED(engine->_MoveCursor({ 1, 25 }));
+
+        Log::Comment(NoThrowString().Format(
+            L"----A short distance up is shorter as a CUU----"
+        ));
+        qExpectedInput.push_back("\x1b[2A");
+        VERIFY_SUCCEEDED(engine->_MoveCursor({ 1, 23 }));
+
+        Log::Comment(NoThrowString().Format(
+            L"----A short distance forward is shorter as a CUF----"
+        ));
+        qExpectedInput.push_back("\x1b[9C");
+        VERIFY_SUCCEEDED(engine->_MoveCursor({ 10, 23 }));
+
+        Log::Comment(NoThrowString().Format(
+            L"----Back a couple of columns is a couple of BS----"
+        ));
+        qExpectedInput.push_back("\b\b");
+        VERIFY_SUCCEEDED(engine->_MoveCursor({ 8, 23 }));
+
+        Log::Comment(NoThrowString().Format(
+            L"----A long distance forward is CHA----"
+        ));
+        qExpectedInput.push_back("\x1b[76G");
+        VERIFY_SUCCEEDED(engine->_MoveCursor({ 75, 23 }));
+
+        Log::Comment(NoThrowString().Format(
+            L"----Back a few columns far from the left is CUB----"
+        ));
+        qExpectedInput.push_back("\x1b[5D");
+        VERIFY_SUCCEEDED(engine->_MoveCursor({ 70, 23 }));
+
+        Log::Comment(NoThrowString().Format(
+            L"----The start of the next line is still \\r\\n----"
+        ));
+        qExpectedInput.push_back("\r\n");
+        VERIFY_SUCCEEDED(engine->_MoveCursor({ 0, 24 }));
+
+        qExpectedInput.push_back("\x1b[4G");
+        VERIFY_SUCCEEDED(engine->_MoveCursor({ 3, 24 }));
+
+        Log::Comment(NoThrowString().Format(
+            L"----The start of a line further up is a CR and a CUU----"
+        ));
+        qExpectedInput.push_back("\r\x1b[2A");
+        VERIFY_SUCCEEDED(engine->_MoveCursor({ 0, 22 }));
+
+        Log::Comment(NoThrowString().Format(
+            L"----Write text up to the right edge. The terminal leaves the "
+            L"cursor in the last column, so we can't move relative to our "
+            L"idea of where it is----"
+        ));
+        qExpectedInput.push_back("\x1b[6;78H");
+        qExpectedInput.push_back("abc");
+
+        const wchar_t* const line = L"abc";
+        std::vector<Cluster> clusters;
+        for (size_t i = 0; i < wcslen(line); i++)
+        {
+            clusters.emplace_back(std::wstring_view{ &line[i], 1 }, static_cast<size_t>(1));
+        }
+        VERIFY_SUCCEEDED(engine->PaintBufferLine({ clusters.data(), clusters.size() }, { 77, 5 }, false));
+
+        qExpectedInput.push_back("\n\x1b[80G");
+        VERIFY_SUCCEEDED(engine->_MoveCursor({ 79, 6 }));
+
+        qExpectedInput.push_back("\x1b[?25h");
+    });
+
+    TestPaint(*engine, [&]()
+    {
+        Log::Comment(NoThrowString().Format(
+            L"Moves that stay on the line or use LFs don't need the cursor hidden."
+        ));
+        qExpectedInput.push_back("\b");
+        VERIFY_SUCCEEDED(engine->_MoveCursor({ 78, 6 }));
+
+        qExpectedInput.push_back("\r\n");
+        VERIFY_SUCCEEDED(engine->_MoveCursor({ 0, 7 }));
+
+        VERIFY_IS_FALSE(engine->_needToDisableCursor);
+    });
+}
+
+void VtRendererTest::Xterm256TestShadowBuffer()
+{
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    std::unique_ptr<Xterm256Engine> engine = std::make_unique<Xterm256Engine>(std::move(hFile), p, SetUpViewport(), g_ColorTable, static_cast<WORD>(COLOR_TABLE_SIZE));
+    auto pfn = std::bind(&VtRendererTest::WriteCallback, this, std::placeholders::_1, std::placeholders::_2);
+    engine->SetTestCallback(pfn);
+    VERIFY_SUCCEEDED(engine->SetShadowBufferEnabled(true));
+
+    const COLORREF defaultFg = g_ColorTable[15];
+    const COLORREF defaultBg = g_ColorTable[0];
+
+    std::vector<Cluster> clusters;
+    const auto paint = [&](const std::wstring_view text, const COORD coord) {
+        clusters.clear();
+        for (const auto& wch : text)
+        {
+            clusters.emplace_back(std::wstring_view{ &wch, 1 }, static_cast<size_t>(1));
+        }
+        VERIFY_SUCCEEDED(engine->PaintBufferLine({ clusters.data(), clusters.size() }, coord, false));
+    };
+
+    qExpectedInput.push_back("\x1b[2J");
+    TestPaint(*engine, [&]() {
+        VERIFY_IS_FALSE(engine->_firstPaint);
+    });
+
+    TestPaintXterm(*engine, [&]()
+    {
+        Log::Comment(NoThrowString().Format(
+            L"----Brushes aren't written until something is painted with them----"
+        ));
+        qExpectedInput.push_back(EMPTY_CALLBACK_SENTINEL);
+        VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(defaultFg, defaultBg, 0, false, false));
+        WriteCallback(EMPTY_CALLBACK_SENTINEL, 1);
+
+        qExpectedInput.push_back("\x1b[m");
+        qExpectedInput.push_back("\x1b[H");
+        qExpectedInput.push_back("Hello, world");
+        paint(L"Hello, world", { 0, 0 });
+
+        qExpectedInput.push_back("\r\n");
+        qExpectedInput.push_back("abcdefgh");
+        paint(L"abcdefgh", { 0, 1 });
+    });
+
+    TestPaintXterm(*engine, [&]()
+    {
+        Log::Comment(NoThrowString().Format(
+            L"----Painting the same text again writes nothing----"
+        ));
+        qExpectedInput.push_back(EMPTY_CALLBACK_SENTINEL);
+        VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(defaultFg, defaultBg, 0, false, false));
+        paint(L"Hello, world", { 0, 0 });
+        paint(L"abcdefgh", { 0, 1 });
+        WriteCallback(EMPTY_CALLBACK_SENTINEL, 1);
+
+        Log::Comment(NoThrowString().Format(
+            L"----Only the cells that changed are written----"
+        ));
+        qExpectedInput.push_back("\x1b[d\b");
+        qExpectedInput.push_back("there");
+        paint(L"Hello, there", { 0, 0 });
+
+        Log::Comment(NoThrowString().Format(
+            L"----A couple of unchanged cells between two changes are written "
+            L"again, instead of moving over them----"
+        ));
+        qExpectedInput.push_back("\n\x1b[2G");
+        qExpectedInput.push_back("XcdY");
+        paint(L"aXcdYfgh", { 0, 1 });
+    });
+
+    TestPaintXterm(*engine, [&]()
+    {
+        qExpectedInput.push_back("\x1b[91m");
+        qExpectedInput.push_back("\r\n\n");
+        qExpectedInput.push_back("Hi");
+        VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(g_ColorTable[12], defaultBg, 0, false, false));
+        paint(L"Hi", { 0, 3 });
+
+        Log::Comment(NoThrowString().Format(
+            L"----Runs that don't change don't switch colors back and forth----"
+        ));
+        qExpectedInput.push_back(EMPTY_CALLBACK_SENTINEL);
+        VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(defaultFg, defaultBg, 0, false, false));
+        paint(L"Hello, there", { 0, 0 });
+        VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(g_ColorTable[12], defaultBg, 0, false, false));
+        paint(L"Hi", { 0, 3 });
+        WriteCallback(EMPTY_CALLBACK_SENTINEL, 1);
+
+        Log::Comment(NoThrowString().Format(
+            L"----The same text in other colors has changed----"
+        ));
+        qExpectedInput.push_back("\x1b[m");
+        qExpectedInput.push_back("\r");
+        qExpectedInput.push_back("Hi");
+        VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(defaultFg, defaultBg, 0, false, false));
+        paint(L"Hi", { 0, 3 });
+    });
+
+    Log::Comment(NoThrowString().Format(
+        L"----Scrolling moves the rows of the shadow buffer along with the "
+        L"terminal's----"
+    ));
+    COORD scrollDelta = { 0, -1 };
+    VERIFY_SUCCEEDED(engine->InvalidateScroll(&scrollDelta));
+    TestPaintXterm(*engine, [&]()
+    {
+        qExpectedInput.push_back("\r\x1b[32d");
+        qExpectedInput.push_back("\n");
+        VERIFY_SUCCEEDED(engine->ScrollFrame());
+
+        qExpectedInput.push_back(EMPTY_CALLBACK_SENTINEL);
+        VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(defaultFg, defaultBg, 0, false, false));
+        paint(L"aXcdYfgh", { 0, 0 });
+        paint(L"Hi", { 0, 2 });
+        WriteCallback(EMPTY_CALLBACK_SENTINEL, 1);
+
+        Log::Comment(NoThrowString().Format(
+            L"----The row that scrolled in is blank, but we can't tell in which "
+            L"color, so it doesn't match anything----"
+        ));
+        VERIFY_IS_FALSE(engine->_ShadowMatches({ L" ", 1 }, { 0, 31 }));
+    });
+
+    Log::Comment(NoThrowString().Format(
+        L"----Writing to the terminal directly forgets the shadow buffer----"
+    ));
+    qExpectedInput.push_back("\x1b[2J");
+    VERIFY_SUCCEEDED(engine->WriteTerminalUtf8("\x1b[2J"));
+    TestPaintXterm(*engine, [&]()
+    {
+        qExpectedInput.push_back("\x1b[H");
+        qExpectedInput.push_back("aXcdYfgh");
+        paint(L"aXcdYfgh", { 0, 0 });
+    });
+
+    TestPaintXterm(*engine, [&]()
+    {
+        Log::Comment(NoThrowString().Format(
+            L"----Painting over half of a wide glyph means the glyph has to be "
+            L"written again----"
+        ));
+        const std::wstring_view wide{ L"\x6f22" };
+        clusters.clear();
+        clusters.emplace_back(wide, static_cast<size_t>(2));
+        qExpectedInput.push_back("\n\x1b[5G");
+        qExpectedInput.push_back("\xe6\xbc\xa2");
+        VERIFY_SUCCEEDED(engine->PaintBufferLine({ clusters.data(), clusters.size() }, { 4, 1 }, false));
+
+        qExpectedInput.push_back(EMPTY_CALLBACK_SENTINEL);
+        VERIFY_SUCCEEDED(engine->PaintBufferLine({ clusters.data(), clusters.size() }, { 4, 1 }, false));
+        WriteCallback(EMPTY_CALLBACK_SENTINEL, 1);
+
+        qExpectedInput.push_back("\b");
+        qExpectedInput.push_back("x");
+        paint(L"x", { 5, 1 });
+
+        clusters.clear();
+        clusters.emplace_back(wide, static_cast<size_t>(2));
+        qExpectedInput.push_back("\b\b");
+        qExpectedInput.push_back("\xe6\xbc\xa2");
+        VERIFY_SUCCEEDED(engine->PaintBufferLine({ clusters.data(), clusters.size() }, { 4, 1 }, false));
+    });
+
+    TestPaint(*engine, [&]()
+    {
+        Log::Comment(NoThrowString().Format(
+            L"----Turning the shadow buffer off writes the brushes it held on to----"
+        ));
+        VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(g_ColorTable[12], defaultBg, 0, false, false));
+        qExpectedInput.push_back("\x1b[91m");
+        VERIFY_SUCCEEDED(engine->SetShadowBufferEnabled(false));
+        VERIFY_IS_TRUE(engine->_shadowBuffer.empty());
+    });
+}
+
+void VtRendererTest::Xterm256TestScrollRegion()
+{
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    std::unique_ptr<Xterm256Engine> engine = std::make_unique<Xterm256Engine>(std::move(hFile), p, SetUpViewport(), g_ColorTable, static_cast<WORD>(COLOR_TABLE_SIZE));
+    auto pfn = std::bind(&VtRendererTest::WriteCallback, this, std::placeholders::_1, std::placeholders::_2);
+    engine->SetTestCallback(pfn);
+    VERIFY_SUCCEEDED(engine->SetShadowBufferEnabled(true));
+
+    const COLORREF defaultFg = g_ColorTable[15];
+    const COLORREF defaultBg = g_ColorTable[0];
+
+    std::vector<Cluster> clusters;
+    const auto paint = [&](const std::wstring_view text, const COORD coord) {
+        clusters.clear();
+        for (const auto& wch : text)
+        {
+            clusters.emplace_back(std::wstring_view{ &wch, 1 }, static_cast<size_t>(1));
+        }
+        VERIFY_SUCCEEDED(engine->PaintBufferLine({ clusters.data(), clusters.size() }, coord, false));
+    };
+
+    qExpectedInput.push_back("\x1b[2J");
+    TestPaint(*engine, [&]() {
+        VERIFY_IS_FALSE(engine->_firstPaint);
+    });
+
+    TestPaintXterm(*engine, [&]()
+    {
+        qExpectedInput.push_back("\x1b[m");
+        qExpectedInput.push_back("\x1b[H");
+        qExpectedInput.push_back("row0");
+        VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(defaultFg, defaultBg, 0, false, false));
+        paint(L"row0", { 0, 0 });
+        for (SHORT row = 1; row < 6; row++)
+        {
+            const std::wstring text{ L"row" + std::to_wstring(row) };
+            qExpectedInput.push_back("\r\n");
+            qExpectedInput.push_back(std::string(text.begin(), text.end()));
+            paint(text, { 0, row });
+        }
+    });
+
+    Log::Comment(NoThrowString().Format(
+        L"----Scrolling inside the margins sets them, scrolls them, and clears "
+        L"them again. Only the rows that were uncovered are invalid.----"
+    ));
+    SMALL_RECT region = { 0, 1, 80, 5 };
+    COORD scrollDelta = { 0, -1 };
+    VERIFY_SUCCEEDED(engine->InvalidateScrollRegion(&region, &scrollDelta));
+    VERIFY_SUCCEEDED(engine->InvalidateScrollRegion(&region, &scrollDelta));
+    TestPaintXterm(*engine, [&]()
+    {
+        const SMALL_RECT invalid = { 0, 3, 80, 5 };
+        VERIFY_ARE_EQUAL(invalid, engine->_invalidRect.ToExclusive());
+
+        qExpectedInput.push_back("\x1b[2;5r");
+        qExpectedInput.push_back("\x1b[2S");
+        qExpectedInput.push_back("\x1b[r");
+        VERIFY_SUCCEEDED(engine->ScrollFrame());
+        VERIFY_ARE_EQUAL(COORD({ 0, 0 }), engine->_lastText);
+        VERIFY_IS_TRUE(engine->_needToDisableCursor);
+
+        Log::Comment(NoThrowString().Format(
+            L"----The shadow buffer only scrolled inside the margins----"
+        ));
+        VERIFY_IS_TRUE(engine->_ShadowMatches({ L"0", 1 }, { 3, 0 }));
+        VERIFY_IS_TRUE(engine->_ShadowMatches({ L"3", 1 }, { 3, 1 }));
+        VERIFY_IS_TRUE(engine->_ShadowMatches({ L"4", 1 }, { 3, 2 }));
+        VERIFY_IS_FALSE(engine->_ShadowMatches({ L"r", 1 }, { 0, 3 }));
+        VERIFY_IS_FALSE(engine->_ShadowMatches({ L"r", 1 }, { 0, 4 }));
+        VERIFY_IS_TRUE(engine->_ShadowMatches({ L"5", 1 }, { 3, 5 }));
+    });
+
+    Log::Comment(NoThrowString().Format(
+        L"----Rows that reach the bottom of the screen don't need margins----"
+    ));
+    region = { 0, 10, 80, 32 };
+    scrollDelta = { 0, 2 };
+    VERIFY_SUCCEEDED(engine->InvalidateScrollRegion(&region, &scrollDelta));
+    TestPaintXterm(*engine, [&]()
+    {
+        const SMALL_RECT invalid = { 0, 10, 80, 12 };
+        VERIFY_ARE_EQUAL(invalid, engine->_invalidRect.ToExclusive());
+
+        qExpectedInput.push_back("\x1b[11d");
+        qExpectedInput.push_back("\x1b[2L");
+        VERIFY_SUCCEEDED(engine->ScrollFrame());
+    });
+
+    Log::Comment(NoThrowString().Format(
+        L"----When a second region scrolls, the first is repainted instead----"
+    ));
+    region = { 0, 1, 80, 5 };
+    scrollDelta = { 0, -1 };
+    VERIFY_SUCCEEDED(engine->InvalidateScrollRegion(&region, &scrollDelta));
+    region = { 0, 2, 80, 7 };
+    scrollDelta = { 0, 1 };
+    VERIFY_SUCCEEDED(engine->InvalidateScrollRegion(&region, &scrollDelta));
+    TestPaintXterm(*engine, [&]()
+    {
+        const SMALL_RECT invalid = { 0, 1, 80, 6 };
+        VERIFY_ARE_EQUAL(invalid, engine->_invalidRect.ToExclusive());
+
+        qExpectedInput.push_back("\x1b[3;7r");
+        qExpectedInput.push_back("\x1b[T");
+        qExpectedInput.push_back("\x1b[r");
+        VERIFY_SUCCEEDED(engine->ScrollFrame());
+    });
+
+    Log::Comment(NoThrowString().Format(
+        L"----When the whole frame scrolls after the region, the region is "
+        L"repainted instead----"
+    ));
+    region = { 0, 1, 80, 5 };
+    scrollDelta = { 0, -1 };
+    VERIFY_SUCCEEDED(engine->InvalidateScrollRegion(&region, &scrollDelta));
+    VERIFY_SUCCEEDED(engine->InvalidateScroll(&scrollDelta));
+    TestPaintXterm(*engine, [&]()
+    {
+        const SMALL_RECT rows = { 0, 0, 79, 4 };
+        const SMALL_RECT bottomLine = { 0, 31, 79, 31 };
+        const auto dirty = engine->GetDirtyArea();
+        VERIFY_ARE_EQUAL(static_cast<size_t>(2), dirty.size());
+        VERIFY_ARE_EQUAL(rows, dirty[0]);
+        VERIFY_ARE_EQUAL(bottomLine, dirty[1]);
+
+        qExpectedInput.push_back("\x1b[32d");
+        qExpectedInput.push_back("\n");
+        VERIFY_SUCCEEDED(engine->ScrollFrame());
+    });
+
+    Log::Comment(NoThrowString().Format(
+        L"----A region that doesn't span the whole width is just repainted----"
+    ));
+    region = { 2, 1, 80, 5 };
+    VERIFY_SUCCEEDED(engine->InvalidateScrollRegion(&region, &scrollDelta));
+    TestPaintXterm(*engine, [&]()
+    {
+        VERIFY_ARE_EQUAL(region, engine->_invalidRect.ToExclusive());
+
+        qExpectedInput.push_back(EMPTY_CALLBACK_SENTINEL);
+        VERIFY_SUCCEEDED(engine->ScrollFrame());
+        WriteCallback(EMPTY_CALLBACK_SENTINEL, 1);
+    });
+}
+
 void VtRendererTest::XtermTestInvalidate()
 {
     wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
@@ -729,7 +1288,7 @@ void VtRendererTest::XtermTestInvalidate()
 
         VERIFY_ARE_EQUAL(invalid, engine->_invalidRect.ToExclusive());
 
-        qExpectedInput.push_back("\x1b[32;1H"); // Bottom of buffer
+        qExpectedInput.push_back("\x1b[32d"); // Bottom of buffer, the cursor is already in the first column
         qExpectedInput.push_back("\n"); // Scroll down once
         VERIFY_SUCCEEDED(engine->ScrollFrame());
     });
@@ -785,16 +1344,23 @@ void VtRendererTest::XtermTestInvalidate()
         VerifyOutputTraits<SMALL_RECT>::ToString(engine->_invalidRect.ToExclusive())
     ));
 
-    qExpectedInput.push_back("\x1b[2J");
-    TestPaint(*engine, [&]()
+    TestPaintXterm(*engine, [&]()
     {
         Log::Comment(NoThrowString().Format(
-            L"---- Scrolled one down and one up, nothing should change ----"
-            L" But it still does for now MSFT:14169294"
+            L"---- Scrolled one down and one up, nothing should move ----"
+            L" The invalid region spans the whole viewport, but only the top"
+            L" and bottom lines are actually dirty, so don't clear the screen."
         ));
         invalid = view.ToExclusive();
         VERIFY_ARE_EQUAL(view, engine->_invalidRect);
 
+        const SMALL_RECT topLine = { 0, 0, 79, 0 };
+        const SMALL_RECT bottomLine = { 0, 31, 79, 31 };
+        const auto dirty = engine->GetDirtyArea();
+        VERIFY_ARE_EQUAL(static_cast<size_t>(2), dirty.size());
+        VERIFY_ARE_EQUAL(topLine, dirty[0]);
+        VERIFY_ARE_EQUAL(bottomLine, dirty[1]);
+
         VERIFY_SUCCEEDED(engine->ScrollFrame());
     });
 }
@@ -890,7 +1456,7 @@ void VtRendererTest::XtermTestCursor()
     Viewport view = SetUpViewport();
 
     Log::Comment(NoThrowString().Format(
-        L"Test moving the cursor around. Every sequence should have both params to CUP explicitly."
+        L"Test moving the cursor around. Every move should use the shortest sequence that gets it there."
     ));
     TestPaint(*engine, [&]()
     {
@@ -898,15 +1464,15 @@ void VtRendererTest::XtermTestCursor()
         VERIFY_SUCCEEDED(engine->_MoveCursor({1, 1}));
 
         Log::Comment(NoThrowString().Format(
-            L"----Only move Y coord----"
+            L"----Only move Y coord, VPA is shorter than CUP----"
         ));
-        qExpectedInput.push_back("\x1b[31;2H");
+        qExpectedInput.push_back("\x1b[31d");
         VERIFY_SUCCEEDED(engine->_MoveCursor({1, 30}));
 
         Log::Comment(NoThrowString().Format(
-            L"----Only move X coord----"
+            L"----Only move X coord, CHA is as short as CUF, and doesn't depend on where we think the cursor is----"
         ));
-        qExpectedInput.push_back("\x1b[29C");
+        qExpectedInput.push_back("\x1b[31G");
         VERIFY_SUCCEEDED(engine->_MoveCursor({30, 30}));
 
         Log::Comment(NoThrowString().Format(
@@ -925,7 +1491,7 @@ void VtRendererTest::XtermTestCursor()
         Log::Comment(NoThrowString().Format(
             L"----move into the line to test some other sequences----"
         ));
-        qExpectedInput.push_back("\x1b[7C");
+        qExpectedInput.push_back("\x1b[8G");
         VERIFY_SUCCEEDED(engine->_MoveCursor({7, 0}));
 
         Log::Comment(NoThrowString().Format(
@@ -968,7 +1534,7 @@ void VtRendererTest::XtermTestCursor()
         Log::Comment(NoThrowString().Format(
             L"Paint some text at 0,0, then try moving the cursor to where it currently is."
         ));
-        qExpectedInput.push_back("\x1b[1C");
+        qExpectedInput.push_back("\x1b[C");
         qExpectedInput.push_back("asdfghjkl");
 
         const wchar_t* const line = L"asdfghjkl";
@@ -1338,3 +1904,477 @@ void VtRendererTest::TestResize()
 
 
 }
+
+void VtRendererTest::TestFrameIsWrittenOnPresent()
+{
+    // Don't set a test callback - we want to see what the engine buffers for the pipe.
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    auto engine = std::make_unique<Xterm256Engine>(std::move(hFile), p, SetUpViewport(), g_ColorTable, static_cast<WORD>(COLOR_TABLE_SIZE));
+
+    Log::Comment(NoThrowString().Format(
+        L"The renderer holds the console lock until EndPaint, so the frame "
+        L"must not be written to the pipe until Present."
+    ));
+    VERIFY_SUCCEEDED(engine->StartPaint());
+    VERIFY_SUCCEEDED(engine->EndPaint());
+
+    VERIFY_IS_TRUE(engine->_buffer.empty());
+    VERIFY_ARE_EQUAL(CLEAR_SCREEN, engine->_presentBuffer.substr(0, CLEAR_SCREEN.size()));
+
+    VERIFY_SUCCEEDED(engine->Present());
+    VERIFY_IS_TRUE(engine->_presentBuffer.empty());
+
+    Log::Comment(NoThrowString().Format(
+        L"If a frame is never presented, the next one is written after it."
+    ));
+    VERIFY_SUCCEEDED(engine->InvalidateAll());
+    VERIFY_SUCCEEDED(engine->StartPaint());
+    VERIFY_SUCCEEDED(engine->EndPaint());
+    const auto firstFrame = engine->_presentBuffer;
+    VERIFY_IS_FALSE(firstFrame.empty());
+
+    VERIFY_SUCCEEDED(engine->InvalidateAll());
+    VERIFY_SUCCEEDED(engine->StartPaint());
+    VERIFY_SUCCEEDED(engine->EndPaint());
+    VERIFY_ARE_EQUAL(firstFrame + firstFrame, engine->_presentBuffer);
+
+    VERIFY_SUCCEEDED(engine->Present());
+    VERIFY_IS_TRUE(engine->_presentBuffer.empty());
+
+    Log::Comment(NoThrowString().Format(
+        L"A cursor request must not overtake a frame that wasn't presented yet."
+    ));
+    VERIFY_SUCCEEDED(engine->InvalidateAll());
+    VERIFY_SUCCEEDED(engine->StartPaint());
+    VERIFY_SUCCEEDED(engine->EndPaint());
+    VERIFY_ARE_EQUAL(firstFrame, engine->_presentBuffer);
+
+    VERIFY_SUCCEEDED(engine->_RequestCursor());
+    VERIFY_SUCCEEDED(engine->_QueueForPresent());
+    VERIFY_IS_TRUE(engine->_buffer.empty());
+    VERIFY_ARE_EQUAL(firstFrame + "\x1b[6n", engine->_presentBuffer);
+
+    VERIFY_SUCCEEDED(engine->RequestCursor());
+    VERIFY_IS_TRUE(engine->_buffer.empty());
+    VERIFY_IS_TRUE(engine->_presentBuffer.empty());
+}
+
+void VtRendererTest::TestSlowPipeDoesNotHoldLock()
+{
+    using namespace std::chrono;
+
+    // How long the other end of the pipe waits before it starts reading.
+    constexpr auto readerDelay = milliseconds(250);
+    // Big enough that writing the frame fills the pipe and blocks until it's read.
+    const std::string frameText(64 * 1024, 'x');
+
+    // Paints one frame into an engine whose pipe isn't read for readerDelay.
+    //      Returns how long the frame kept the console lock, which is how long
+    //      a WriteConsole call waiting on the lock would have been held up, and
+    //      how long Present took after the lock was released.
+    // - flushUnderLock: write the frame to the pipe before the lock is
+    //      released, the way EndPaint did before frames went through Present.
+    auto paintFrame = [&](const bool flushUnderLock) {
+        HANDLE readHandle = INVALID_HANDLE_VALUE;
+        HANDLE writeHandle = INVALID_HANDLE_VALUE;
+        VERIFY_WIN32_BOOL_SUCCEEDED(CreatePipe(&readHandle, &writeHandle, nullptr, 0));
+        wil::unique_hfile readSide(readHandle);
+        wil::unique_hfile writeSide(writeHandle);
+
+        std::thread reader([&readSide, readerDelay]() {
+            std::this_thread::sleep_for(readerDelay);
+            char buffer[4096];
+            DWORD read = 0;
+            while (ReadFile(readSide.get(), buffer, sizeof(buffer), &read, nullptr) && read != 0)
+            {
+            }
+        });
+
+        auto engine = std::make_unique<Xterm256Engine>(std::move(writeSide), p, SetUpViewport(), g_ColorTable, static_cast<WORD>(COLOR_TABLE_SIZE));
+
+        const auto lockTaken = steady_clock::now();
+        VERIFY_SUCCEEDED(engine->StartPaint());
+        VERIFY_SUCCEEDED(engine->_Write(frameText));
+        VERIFY_SUCCEEDED(engine->EndPaint());
+        if (flushUnderLock)
+        {
+            VERIFY_SUCCEEDED(engine->Present());
+        }
+        const auto lockReleased = steady_clock::now();
+        VERIFY_SUCCEEDED(engine->Present());
+        const auto presented = steady_clock::now();
+
+        // Closing the write side ends the reader.
+        engine.reset();
+        reader.join();
+
+        return std::make_pair(duration_cast<milliseconds>(lockReleased - lockTaken).count(),
+                              duration_cast<milliseconds>(presented - lockReleased).count());
+    };
+
+    const auto [heldBefore, presentBefore] = paintFrame(true);
+    const auto [heldAfter, presentAfter] = paintFrame(false);
+
+    Log::Comment(NoThrowString().Format(
+        L"Pipe read after %lldms. Writing under the lock: lock held %lldms, Present %lldms. "
+        L"Writing from Present: lock held %lldms, Present %lldms.",
+        readerDelay.count(),
+        heldBefore, presentBefore,
+        heldAfter, presentAfter
+    ));
+
+    // The write only finishes once the reader wakes up, so whichever step
+    //      writes the frame takes about readerDelay.
+    const auto halfDelay = (readerDelay / 2).count();
+    VERIFY_IS_GREATER_THAN_OR_EQUAL(heldBefore, halfDelay);
+    VERIFY_IS_LESS_THAN(heldAfter, halfDelay);
+    VERIFY_IS_GREATER_THAN_OR_EQUAL(presentAfter, halfDelay);
+}
+
+void VtRendererTest::TestTuiCorpusBytes()
+{
+    const Viewport view = SetUpViewport();
+    const COLORREF defaultFg = g_ColorTable[15];
+    const COLORREF defaultBg = g_ColorTable[0];
+
+    // A run of text the way the renderer hands it to the engine.
+    struct Run
+    {
+        COORD coord;
+        std::wstring text;
+        COLORREF fg;
+        COLORREF bg;
+    };
+
+    // Replays a recorded-style session: every frame invalidates and paints its
+    //      runs, then puts the cursor back where the application left it.
+    //      Returns the bytes conpty would have written for all but the first
+    //      frame, which clears the screen.
+    const auto replay = [&](const size_t cFrames, std::function<void(size_t, std::vector<Run>&, COORD&)> frameFn) -> size_t {
+        wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+        auto engine = std::make_unique<Xterm256Engine>(std::move(hFile), p, view, g_ColorTable, static_cast<WORD>(COLOR_TABLE_SIZE));
+
+        VERIFY_SUCCEEDED(engine->StartPaint());
+        VERIFY_SUCCEEDED(engine->EndPaint());
+        VERIFY_SUCCEEDED(engine->Present());
+
+        size_t cb = 0;
+        std::vector<Run> runs;
+        std::vector<Cluster> clusters;
+        for (size_t frame = 0; frame < cFrames; frame++)
+        {
+            runs.clear();
+            COORD cursor{};
+            frameFn(frame, runs, cursor);
+
+            for (const auto& run : runs)
+            {
+                SMALL_RECT rect{ run.coord.X, run.coord.Y, gsl::narrow<SHORT>(run.coord.X + run.text.size() - 1), run.coord.Y };
+                VERIFY_SUCCEEDED(engine->Invalidate(&rect));
+            }
+
+            VERIFY_SUCCEEDED(engine->StartPaint());
+            for (const auto& run : runs)
+            {
+                clusters.clear();
+                for (const auto& wch : run.text)
+                {
+                    clusters.emplace_back(std::wstring_view{ &wch, 1 }, static_cast<size_t>(1));
+                }
+                VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(run.fg, run.bg, 0, false, false));
+                VERIFY_SUCCEEDED(engine->PaintBufferLine({ clusters.data(), clusters.size() }, run.coord, false));
+            }
+            VERIFY_SUCCEEDED(engine->_MoveCursor(cursor));
+            VERIFY_SUCCEEDED(engine->EndPaint());
+
+            cb += engine->_presentBuffer.size();
+            VERIFY_SUCCEEDED(engine->Present());
+        }
+        return cb;
+    };
+
+    Log::Comment(NoThrowString().Format(
+        L"A process monitor: a clock in the header, and a CPU column that "
+        L"changes value and color on every row, every frame."
+    ));
+    const size_t cbMonitor = replay(50, [&](const size_t frame, std::vector<Run>& runs, COORD& cursor) {
+        runs.push_back({ { 70, 0 }, L"12:00:" + std::to_wstring(10 + frame % 50), RGB(0, 0, 0), RGB(0, 255, 255) });
+        for (SHORT row = 2; row < view.Height(); row++)
+        {
+            const size_t load = (frame * 7 + row * 13) % 100;
+            const COLORREF color = load > 80 ? g_ColorTable[12] : load > 40 ? g_ColorTable[14] : g_ColorTable[10];
+            runs.push_back({ { 40, row }, std::to_wstring(100 + load), color, defaultBg });
+        }
+        cursor = { 0, 1 };
+    });
+
+    Log::Comment(NoThrowString().Format(
+        L"An editor: typing at the end of a line, with the position in the "
+        L"status bar following along."
+    ));
+    const size_t cbEditor = replay(50, [&](const size_t frame, std::vector<Run>& runs, COORD& cursor) {
+        const SHORT col = static_cast<SHORT>(10 + frame);
+        runs.push_back({ { col, 12 }, std::wstring(1, static_cast<wchar_t>(L'a' + frame % 26)), defaultFg, defaultBg });
+        runs.push_back({ { 60, 31 }, L"Ln 13, Col " + std::to_wstring(col + 2), defaultBg, defaultFg });
+        cursor = { static_cast<SHORT>(col + 1), 12 };
+    });
+
+    Log::Comment(NoThrowString().Format(
+        L"A menu: the highlight moves down a list one entry per frame."
+    ));
+    const size_t cbMenu = replay(25, [&](const size_t frame, std::vector<Run>& runs, COORD& cursor) {
+        const SHORT row = static_cast<SHORT>(4 + frame);
+        if (frame > 0)
+        {
+            runs.push_back({ { 10, static_cast<SHORT>(row - 1) }, L"  Entry " + std::to_wstring(frame - 1) + L"          ", defaultFg, RGB(0, 0, 128) });
+        }
+        runs.push_back({ { 10, row }, L"> Entry " + std::to_wstring(frame) + L"          ", RGB(0, 0, 128), g_ColorTable[7] });
+        cursor = { 10, row };
+    });
+
+    Log::Comment(NoThrowString().Format(
+        L"Bytes written: monitor %zu, editor %zu, menu %zu",
+        cbMonitor,
+        cbEditor,
+        cbMenu
+    ));
+
+    // What the engine wrote for the same sessions when it moved the cursor
+    //      with CUP in most cases and wrote each color as its own SGR.
+    VERIFY_IS_LESS_THAN(cbMonitor, 22585u);
+    VERIFY_IS_LESS_THAN(cbEditor, 2758u);
+    VERIFY_IS_LESS_THAN(cbMenu, 2360u);
+}
+
+void VtRendererTest::TestShadowBufferBytes()
+{
+    const Viewport view = SetUpViewport();
+    const SHORT height = view.Height();
+    const COLORREF defaultFg = g_ColorTable[15];
+    const COLORREF defaultBg = g_ColorTable[0];
+
+    // A run of text in one color. A row of the screen is made of these, and
+    //      the rest of the row is blank.
+    struct Run
+    {
+        std::wstring text;
+        COLORREF fg;
+        COLORREF bg;
+    };
+    using Screen = std::vector<std::vector<Run>>;
+
+    // Replays a session in which every frame repaints the whole viewport, the
+    //      way conpty does after the console scrolled or redrew everything.
+    //      Returns the bytes conpty would have written for all but the first
+    //      frame, which clears the screen.
+    const auto replay = [&](const bool useShadowBuffer, const size_t cFrames, std::function<void(size_t, Screen&)> frameFn) -> size_t {
+        wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+        auto engine = std::make_unique<Xterm256Engine>(std::move(hFile), p, view, g_ColorTable, static_cast<WORD>(COLOR_TABLE_SIZE));
+        VERIFY_SUCCEEDED(engine->SetShadowBufferEnabled(useShadowBuffer));
+
+        VERIFY_SUCCEEDED(engine->StartPaint());
+        VERIFY_SUCCEEDED(engine->EndPaint());
+        VERIFY_SUCCEEDED(engine->Present());
+
+        size_t cb = 0;
+        Screen screen(height);
+        std::vector<Cluster> clusters;
+        const auto paint = [&](const std::wstring& text, const COORD coord) {
+            clusters.clear();
+            for (const auto& wch : text)
+            {
+                clusters.emplace_back(std::wstring_view{ &wch, 1 }, static_cast<size_t>(1));
+            }
+            VERIFY_SUCCEEDED(engine->PaintBufferLine({ clusters.data(), clusters.size() }, coord, false));
+        };
+
+        for (size_t frame = 0; frame < cFrames; frame++)
+        {
+            for (auto& row : screen)
+            {
+                row.clear();
+            }
+            frameFn(frame, screen);
+
+            // Conpty updates the viewport every frame, which keeps a repaint
+            //      of everything from clearing the screen first.
+            VERIFY_SUCCEEDED(engine->UpdateViewport(view.ToInclusive()));
+            VERIFY_SUCCEEDED(engine->InvalidateAll());
+            VERIFY_SUCCEEDED(engine->StartPaint());
+            for (SHORT row = 0; row < height; row++)
+            {
+                SHORT col = 0;
+                for (const auto& run : screen.at(row))
+                {
+                    VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(run.fg, run.bg, 0, false, false));
+                    paint(run.text, { col, row });
+                    col += gsl::narrow<SHORT>(run.text.size());
+                }
+                VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(defaultFg, defaultBg, 0, false, false));
+                paint(std::wstring(view.Width() - col, L' '), { col, row });
+            }
+            VERIFY_SUCCEEDED(engine->_MoveCursor({ 0, static_cast<SHORT>(height - 1) }));
+            VERIFY_SUCCEEDED(engine->EndPaint());
+
+            if (frame > 0)
+            {
+                cb += engine->_presentBuffer.size();
+            }
+            VERIFY_SUCCEEDED(engine->Present());
+        }
+        return cb;
+    };
+
+    const auto rightAlign = [](const std::wstring& text, const size_t width) {
+        return text.size() < width ? std::wstring(width - text.size(), L' ') + text : text;
+    };
+
+    Log::Comment(NoThrowString().Format(
+        L"An editor scrolling through a file one line per frame, with line "
+        L"numbers and a status line."
+    ));
+    const auto sourceLine = [](const size_t n) -> std::wstring {
+        switch (n % 8)
+        {
+        case 0:
+            return L"";
+        case 1:
+            return L"void Function" + std::to_wstring(n) + L"(int argument)";
+        case 2:
+            return L"{";
+        case 7:
+            return L"}";
+        default:
+            return L"    const auto value" + std::to_wstring(n) + L" = Compute(argument, " + std::to_wstring(n * 37 % 1000) + L");";
+        }
+    };
+    const auto editor = [&](const size_t frame, Screen& screen) {
+        for (SHORT row = 0; row < height - 1; row++)
+        {
+            const size_t line = frame + row;
+            screen.at(row).push_back({ rightAlign(std::to_wstring(line + 1), 4) + L" ", g_ColorTable[6], defaultBg });
+            screen.at(row).push_back({ sourceLine(line), defaultFg, defaultBg });
+        }
+        screen.at(height - 1).push_back({ L"\"source.cpp\" 400L, 9876B" + std::wstring(40, L' ') + std::to_wstring(frame + 1) + L",1", defaultFg, defaultBg });
+    };
+    const size_t cbEditor = replay(false, 60, editor);
+    const size_t cbEditorShadow = replay(true, 60, editor);
+
+    Log::Comment(NoThrowString().Format(
+        L"A process monitor: a header with a clock and totals, and a table "
+        L"where a few columns of every row change every frame."
+    ));
+    const auto monitor = [&](const size_t frame, Screen& screen) {
+        screen.at(0).push_back({ L"top - 12:00:" + std::to_wstring(10 + frame) + L" up 3 days,  2 users,  load average: 0." + std::to_wstring(frame % 90 + 10), defaultFg, defaultBg });
+        screen.at(1).push_back({ L"Tasks: 214 total,   1 running, 213 sleeping,   0 stopped,   0 zombie", defaultFg, defaultBg });
+        screen.at(2).push_back({ L"%Cpu(s):  " + std::to_wstring(frame * 7 % 10) + L".3 us,  1.1 sy,  0.0 ni, 9" + std::to_wstring(frame * 3 % 10) + L".4 id", defaultFg, defaultBg });
+        screen.at(3).push_back({ L"MiB Mem :  15923.4 total,   " + std::to_wstring(4000 + frame * 13 % 100) + L".2 free", defaultFg, defaultBg });
+        screen.at(5).push_back({ L"    PID USER      %CPU  %MEM     TIME+ COMMAND" + std::wstring(34, L' '), defaultBg, g_ColorTable[7] });
+        for (SHORT row = 6; row < height; row++)
+        {
+            const size_t cpu = (frame * 7 + row * 13) % 50;
+            const size_t time = 100 + (row % 3 == 0 ? frame : 0);
+            screen.at(row).push_back({ rightAlign(std::to_wstring(1000 + row * 17), 7) +
+                                           L" user      " +
+                                           rightAlign(std::to_wstring(cpu / 10) + L"." + std::to_wstring(cpu % 10), 4) +
+                                           L"   0.4  " +
+                                           rightAlign(L"0:" + std::to_wstring(time) + L".00", 8) +
+                                           L" process" + std::to_wstring(row),
+                                       defaultFg,
+                                       defaultBg });
+        }
+    };
+    const size_t cbMonitor = replay(false, 30, monitor);
+    const size_t cbMonitorShadow = replay(true, 30, monitor);
+
+    Log::Comment(NoThrowString().Format(
+        L"A progress bar on the last line, under the output of a build."
+    ));
+    const auto progress = [&](const size_t frame, Screen& screen) {
+        for (SHORT row = 0; row < height - 1; row++)
+        {
+            screen.at(row).push_back({ L"  Compiling module" + std::to_wstring(row) + L".cpp", defaultFg, defaultBg });
+        }
+        const size_t done = frame * 40 / 100;
+        screen.at(height - 1).push_back({ L"[", defaultFg, defaultBg });
+        screen.at(height - 1).push_back({ std::wstring(done, L'#'), g_ColorTable[10], defaultBg });
+        screen.at(height - 1).push_back({ std::wstring(40 - done, L'-') + L"] " + std::to_wstring(frame) + L"%", defaultFg, defaultBg });
+    };
+    const size_t cbProgress = replay(false, 100, progress);
+    const size_t cbProgressShadow = replay(true, 100, progress);
+
+    Log::Comment(NoThrowString().Format(
+        L"Bytes written without and with the shadow buffer: editor %zu -> %zu, "
+        L"monitor %zu -> %zu, progress %zu -> %zu",
+        cbEditor,
+        cbEditorShadow,
+        cbMonitor,
+        cbMonitorShadow,
+        cbProgress,
+        cbProgressShadow
+    ));
+
+    VERIFY_IS_LESS_THAN(cbEditorShadow, cbEditor);
+    VERIFY_IS_LESS_THAN(cbMonitorShadow, cbMonitor);
+    VERIFY_IS_LESS_THAN(cbProgressShadow, cbProgress);
+}
+
+void VtRendererTest::TestFullFrameRepaintSequences()
+{
+    // Don't set a test callback - we want to time composing into the pipe buffer.
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    auto engine = std::make_unique<Xterm256Engine>(std::move(hFile), p, SetUpViewport(), g_ColorTable, static_cast<WORD>(COLOR_TABLE_SIZE));
+    const auto view = SetUpViewport();
+
+    Log::Comment(NoThrowString().Format(
+        L"Repaint the whole viewport, moving the cursor and changing both "
+        L"colors every 8 columns, the way conpty does for a full-screen redraw."
+    ));
+
+    const size_t cFrames = 200;
+    size_t cSequences = 0;
+    std::string lastFrame;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t frame = 0; frame < cFrames; frame++)
+    {
+        VERIFY_SUCCEEDED(engine->InvalidateAll());
+        VERIFY_SUCCEEDED(engine->StartPaint());
+        for (SHORT row = 0; row < view.Height(); row++)
+        {
+            for (SHORT col = 0; col < view.Width(); col += 8)
+            {
+                const BYTE shade = static_cast<BYTE>(frame + row + col);
+                VERIFY_SUCCEEDED(engine->_CursorPosition({ col, row }));
+                VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(RGB(shade, 1, 2), RGB(3, shade, 4), 0, false, false));
+                cSequences += 2;
+            }
+        }
+        VERIFY_SUCCEEDED(engine->EndPaint());
+
+        if (frame == cFrames - 1)
+        {
+            lastFrame = engine->_presentBuffer;
+        }
+        VERIFY_SUCCEEDED(engine->Present());
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    Log::Comment(NoThrowString().Format(
+        L"%zu frames, %zu sequences: %lld us per frame, %lld ns per sequence",
+        cFrames,
+        cSequences,
+        ns / 1000 / static_cast<long long>(cFrames),
+        ns / static_cast<long long>(cSequences)
+    ));
+
+    Log::Comment(NoThrowString().Format(
+        L"Spot check the last cell of the last frame."
+    ));
+    const BYTE shade = static_cast<BYTE>((cFrames - 1) + (view.Height() - 1) + (view.Width() - 8));
+    const std::string expected = "\x1b[32;73H"
+                                 "\x1b[38;2;" + std::to_string(shade) + ";1;2;48;2;3;" + std::to_string(shade) + ";4m";
+    VERIFY_IS_TRUE(lastFrame.size() >= expected.size());
+    VERIFY_ARE_EQUAL(expected, lastFrame.substr(lastFrame.size() - expected.size()));
+}
@@ -104,11 +104,24 @@ void Clipboard::StringPaste(_In_reads_(cchData) const wchar_t* const pData,
     }
 
     CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    InputBuffer* const pInputBuffer = gci.pInputBuffer;
 
     try
     {
-        std::deque<std::unique_ptr<IInputEvent>> inEvents = TextToKeyEvents(pData, cchData);
-        gci.pInputBuffer->Write(inEvents);
+        // A client in VT input mode or in a cooked read only looks at the characters,
+        // so the text goes in as it is. Anyone else reads the raw input records and
+        // gets every key press and release it would take to type the text.
+        if (pInputBuffer->IsInVirtualTerminalInputMode() ||
+            WI_IsFlagSet(pInputBuffer->InputMode, ENABLE_LINE_INPUT))
+        {
+            const std::wstring text = FilterTextOnPaste(pData, cchData);
+            pInputBuffer->WritePaste(text);
+        }
+        else
+        {
+            std::deque<std::unique_ptr<IInputEvent>> inEvents = TextToKeyEvents(pData, cchData);
+            pInputBuffer->Write(inEvents);
+        }
     }
     catch (...)
     {
@@ -133,10 +146,42 @@ void Clipboard::StringPaste(_In_reads_(cchData) const wchar_t* const pData,
 std::deque<std::unique_ptr<IInputEvent>> Clipboard::TextToKeyEvents(_In_reads_(cchData) const wchar_t* const pData,
                                                                     const size_t cchData)
 {
-    THROW_IF_NULL_ALLOC(pData);
+    const std::wstring text = FilterTextOnPaste(pData, cchData);
+    const UINT codepage = ServiceLocator::LocateGlobals().getConsoleInformation().OutputCP;
 
     std::deque<std::unique_ptr<IInputEvent>> keyEvents;
+    for (const wchar_t currentChar : text)
+    {
+        std::deque<std::unique_ptr<KeyEvent>> convertedEvents = CharToKeyEvents(currentChar, codepage);
+        while (!convertedEvents.empty())
+        {
+            keyEvents.push_back(std::move(convertedEvents.front()));
+            convertedEvents.pop_front();
+        }
+    }
+    return keyEvents;
+}
 
+// Routine Description:
+// - prepares a wchar_t* for pasting: drops or replaces the characters that
+// FilterCharacterOnPaste says to, turns CR LF into CR and stops at the first
+// null.
+// Arguments:
+// - pData - the text to paste
+// - cchData - the size of pData, in wchars
+// Return Value:
+// - the text as it should be sent to the input buffer
+// Note:
+// - will throw exception on error
+std::wstring Clipboard::FilterTextOnPaste(_In_reads_(cchData) const wchar_t* const pData,
+                                          const size_t cchData)
+{
+    THROW_IF_NULL_ALLOC(pData);
+
+    const bool vtInputMode = IsInVirtualTerminalInputMode();
+
+    std::wstring text;
+    text.reserve(cchData);
     for (size_t i = 0; i < cchData; ++i)
     {
         wchar_t currentChar = pData[i];
@@ -168,20 +213,14 @@ std::deque<std::unique_ptr<IInputEvent>> Clipboard::TextToKeyEvents(_In_reads_(c
         // This change doesn't break pasting text into any of those applications
         //      with CR/LF (Windows) line endings either. That apparently always
         //      worked right.
-        if (IsInVirtualTerminalInputMode() && currentChar == UNICODE_LINEFEED)
+        if (vtInputMode && currentChar == UNICODE_LINEFEED)
         {
             currentChar = UNICODE_CARRIAGERETURN;
         }
 
-        const UINT codepage = ServiceLocator::LocateGlobals().getConsoleInformation().OutputCP;
-        std::deque<std::unique_ptr<KeyEvent>> convertedEvents = CharToKeyEvents(currentChar, codepage);
-        while (!convertedEvents.empty())
-        {
-            keyEvents.push_back(std::move(convertedEvents.front()));
-            convertedEvents.pop_front();
-        }
+        text.push_back(currentChar);
     }
-    return keyEvents;
+    return text;
 }
 
 // Routine Description:
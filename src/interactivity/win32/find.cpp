@@ -55,6 +55,12 @@ INT_PTR FindDialogProc(HWND hWnd, UINT Message, WPARAM wParam, LPARAM lParam)
                                   Reverse ? Search::Direction::Backward : Search::Direction::Forward,
                                   IgnoreCase ? Search::Sensitivity::CaseInsensitive : Search::Sensitivity::CaseSensitive);
 
+                    // Every match stays highlighted while the dialog is open, following the output.
+                    ScreenInfo.SetSearchHighlight(std::make_unique<Search>(ScreenInfo,
+                                                                           wstr,
+                                                                           Search::Direction::Forward,
+                                                                           IgnoreCase ? Search::Sensitivity::CaseInsensitive : Search::Sensitivity::CaseSensitive));
+
                     if (search.FindNext())
                     {
                         Telemetry::Instance().LogFindDialogNextClicked(StringLength, (Reverse != 0), (IgnoreCase == 0));
@@ -69,9 +75,19 @@ INT_PTR FindDialogProc(HWND hWnd, UINT Message, WPARAM wParam, LPARAM lParam)
                     break;
                 }
                 case IDCANCEL:
+                {
                     Telemetry::Instance().FindDialogClosed();
+
+                    // The buffers may have been switched since the search, so both let go of it.
+                    LockConsole();
+                    auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
+                    SCREEN_INFORMATION& ScreenInfo = gci.GetActiveOutputBuffer();
+                    ScreenInfo.ClearSearchHighlight();
+                    ScreenInfo.GetMainBuffer().ClearSearchHighlight();
+
                     EndDialog(hWnd, 0);
                     return TRUE;
+                }
             }
             break;
         }
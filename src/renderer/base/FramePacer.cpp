@@ -0,0 +1,146 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "FramePacer.hpp"
+
+#pragma hdrstop
+
+using namespace Microsoft::Console::Render;
+
+// Routine Description:
+// - Creates a pacer that hasn't painted anything yet.
+// Arguments:
+// - frameInterval - The shortest time to leave between two frames.
+// - latencyBudget - The longest time a change may wait while it's being
+//      coalesced with further output, up to the start of the frame that
+//      paints it.
+// Return Value:
+// - An instance of a FramePacer.
+FramePacer::FramePacer(const clock::duration frameInterval,
+                       const clock::duration latencyBudget) noexcept :
+    _frameInterval{ frameInterval },
+    _latencyBudget{ latencyBudget },
+    _pending{ false },
+    _pendingSince{},
+    _lastFrameEnd{},
+    _statistics{}
+{
+}
+
+// Routine Description:
+// - Changes how long sustained output may be coalesced before it's painted.
+// Arguments:
+// - latencyBudget - The longest time a change may wait to be painted.
+// Return Value:
+// - <none>
+void FramePacer::SetLatencyBudget(const clock::duration latencyBudget) noexcept
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _latencyBudget = latencyBudget;
+}
+
+// Routine Description:
+// - Records that something changed and needs to be painted. Only the first
+//      change before a frame starts the latency clock, the rest are coalesced
+//      into the same frame.
+// Arguments:
+// - now - The time of the change.
+// Return Value:
+// - <none>
+void FramePacer::NotifyPaint(const clock::time_point now) noexcept
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if (_pending)
+    {
+        _statistics.cNotificationsCoalesced++;
+    }
+    else
+    {
+        _pending = true;
+        _pendingSince = now;
+    }
+}
+
+// Routine Description:
+// - Determines how long the render thread should wait before painting the
+//      pending changes.
+// - If the first change came in well after the last frame, this is
+//      interactive use and the change is painted as soon as the frame limit
+//      allows. If it came in during or right after the last frame, output is
+//      streaming, so wait out the latency budget to fold more of it into the
+//      next frame.
+// Arguments:
+// - now - The current time.
+// Return Value:
+// - The time to wait. Zero if the frame should be painted right away.
+FramePacer::clock::duration FramePacer::GetDelay(const clock::time_point now) const noexcept
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if (!_pending)
+    {
+        return clock::duration::zero();
+    }
+
+    const bool sustained = _pendingSince - _lastFrameEnd < _frameInterval;
+    const auto paintAt = sustained ?
+                            _pendingSince + _latencyBudget :
+                            _lastFrameEnd + _frameInterval;
+
+    return std::max(paintAt - now, clock::duration::zero());
+}
+
+// Routine Description:
+// - Records that the render thread is about to paint everything pending.
+//      Changes that come in from here on belong to the next frame.
+// Arguments:
+// - now - The time the frame starts.
+// Return Value:
+// - <none>
+void FramePacer::FrameStarting(const clock::time_point now) noexcept
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if (_pending)
+    {
+        const auto latency = now - _pendingSince;
+        _statistics.lastLatency = latency;
+        _statistics.maxLatency = std::max(_statistics.maxLatency, latency);
+        _statistics.totalLatency += latency;
+        _pending = false;
+    }
+}
+
+// Routine Description:
+// - Records that the render thread finished a frame.
+// Arguments:
+// - now - The time the frame finished.
+// - painted - False if none of the engines had anything to paint. Skipped
+//      frames don't count towards the frame limit.
+// Return Value:
+// - <none>
+void FramePacer::FrameCompleted(const clock::time_point now, const bool painted) noexcept
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if (painted)
+    {
+        _statistics.cFramesPainted++;
+        _lastFrameEnd = now;
+    }
+    else
+    {
+        _statistics.cFramesSkipped++;
+    }
+}
+
+// Routine Description:
+// - Gets the counters collected so far.
+// Arguments:
+// - <none>
+// Return Value:
+// - A copy of the counters.
+FramePacer::Statistics FramePacer::GetStatistics() const noexcept
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _statistics;
+}
@@ -0,0 +1,69 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- FramePacer.hpp
+
+Abstract:
+- Decides when the render thread should paint the next frame.
+- A change that follows a quiet period is painted right away, so that echoing
+  a keystroke doesn't wait behind the frame limit. While output keeps arriving,
+  changes are coalesced into fewer frames, but no change waits longer than the
+  latency budget before it's painted.
+- Latency is measured from the first change of a frame to the start of that
+  frame. Painting and presenting the frame come on top of the budget, so the
+  budget bounds how long a change is held back, not when it reaches the screen.
+- Keeps counters of what it did so the budget can be tuned.
+--*/
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+
+namespace Microsoft::Console::Render
+{
+    class FramePacer final
+    {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        struct Statistics
+        {
+            size_t cFramesPainted;
+            size_t cFramesSkipped;
+            size_t cNotificationsCoalesced;
+            // From the first change of a frame to the frame starting to paint.
+            clock::duration lastLatency;
+            clock::duration maxLatency;
+            clock::duration totalLatency;
+        };
+
+        FramePacer(const clock::duration frameInterval,
+                   const clock::duration latencyBudget) noexcept;
+
+        void SetLatencyBudget(const clock::duration latencyBudget) noexcept;
+
+        void NotifyPaint(const clock::time_point now) noexcept;
+        clock::duration GetDelay(const clock::time_point now) const noexcept;
+        void FrameStarting(const clock::time_point now) noexcept;
+        void FrameCompleted(const clock::time_point now, const bool painted) noexcept;
+
+        Statistics GetStatistics() const noexcept;
+
+    private:
+        // NotifyPaint is called by whichever thread changed the console, everything else by
+        //      the render thread.
+        mutable std::mutex _lock;
+
+        clock::duration _frameInterval;
+        clock::duration _latencyBudget;
+
+        bool _pending;
+        clock::time_point _pendingSince;
+        clock::time_point _lastFrameEnd;
+
+        Statistics _statistics;
+    };
+}
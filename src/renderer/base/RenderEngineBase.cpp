@@ -10,7 +10,8 @@ using namespace Microsoft::Console::Render;
 
 RenderEngineBase::RenderEngineBase() :
     _titleChanged(false),
-    _lastFrameTitle(L"")
+    _lastFrameTitle(L""),
+    _dirtyRect{ 0 }
 {
 
 }
@@ -37,3 +38,34 @@ HRESULT RenderEngineBase::UpdateTitle(const std::wstring& newTitle) noexcept
     }
     return hr;
 }
+
+// Routine Description:
+// - Notifies us that the rows of the given region moved up or down within it,
+//      as when an application scrolls inside its scroll margins.
+// - Engines that can't move part of the frame simply repaint the whole region.
+// Arguments:
+// - psrRegion - The region that scrolled, in characters. Exclusive rect.
+// - pcoordDelta - How far the contents of the region moved.
+// Return Value:
+// - S_OK, else an appropriate HRESULT from invalidating the region.
+[[nodiscard]]
+HRESULT RenderEngineBase::InvalidateScrollRegion(const SMALL_RECT* const psrRegion,
+                                                 const COORD* const /*pcoordDelta*/) noexcept
+{
+    return Invalidate(psrRegion);
+}
+
+// Routine Description:
+// - Gets the dirty portion of the frame as a set of rectangles in characters.
+// - By default this is the single rectangle from GetDirtyRectInChars. Engines
+//      that can track disjoint regions override this so that the renderer only
+//      walks the parts of the frame that actually changed.
+// Arguments:
+// - <none>
+// Return Value:
+// - A view of Inclusive rectangles that is valid until the next call.
+std::basic_string_view<SMALL_RECT> RenderEngineBase::GetDirtyArea()
+{
+    _dirtyRect = GetDirtyRectInChars();
+    return { &_dirtyRect, 1 };
+}
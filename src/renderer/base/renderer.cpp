@@ -55,6 +55,7 @@ Renderer::~Renderer()
 // - <none>
 // Return Value:
 // - HRESULT S_OK, GDI error, Safe Math error, or state/argument errors.
+//      S_FALSE if none of the engines had anything to paint.
 [[nodiscard]]
 HRESULT Renderer::PaintFrame()
 {
@@ -63,12 +64,15 @@ HRESULT Renderer::PaintFrame()
         return S_FALSE;
     }
 
+    bool painted = false;
     for (IRenderEngine* const pEngine : _rgpEngines)
     {
-        LOG_IF_FAILED(_PaintFrameForEngine(pEngine));
+        const HRESULT hr = _PaintFrameForEngine(pEngine);
+        LOG_IF_FAILED(hr);
+        painted = painted || hr != S_FALSE;
     }
 
-    return S_OK;
+    return painted ? S_OK : S_FALSE;
 }
 
 
@@ -95,7 +99,7 @@ HRESULT Renderer::_PaintFrameForEngine(_In_ IRenderEngine* const pEngine)
     //      engine won't know that.
     if (S_FALSE == hr)
     {
-        return S_OK;
+        return S_FALSE;
     }
 
     auto endPaint = wil::scope_exit([&]()
@@ -142,6 +146,8 @@ HRESULT Renderer::_PaintFrameForEngine(_In_ IRenderEngine* const pEngine)
 
 void Renderer::_NotifyPaintFrame()
 {
+    _invalidationStatistics.cPaintNotifications++;
+
     // The thread will provide throttling for us.
     _pThread->NotifyPaint();
 }
@@ -169,16 +175,15 @@ void Renderer::TriggerSystemRedraw(const RECT* const prcDirtyClient)
 // - <none>
 void Renderer::TriggerRedraw(const Viewport& region)
 {
-    Viewport view = _pData->GetViewport();
-    SMALL_RECT srUpdateRegion = region.ToExclusive();
+    _invalidationStatistics.cRedrawsRequested++;
 
-    if (view.TrimToViewport(&srUpdateRegion))
+    if (_cBatchDepth > 0)
+    {
+        _invalidationStatistics.cRedrawsBatched++;
+        _BatchRegion(region.ToExclusive());
+    }
+    else if (_InvalidateRegion(region))
     {
-        view.ConvertToOrigin(&srUpdateRegion);
-        std::for_each(_rgpEngines.begin(), _rgpEngines.end(), [&](IRenderEngine* const pEngine) {
-            LOG_IF_FAILED(pEngine->Invalidate(&srUpdateRegion));
-        });
-
         _NotifyPaintFrame();
     }
 }
@@ -204,25 +209,195 @@ void Renderer::TriggerRedraw(const COORD* const pcoord)
 // Return Value:
 // - <none>
 void Renderer::TriggerRedrawCursor(const COORD* const pcoord)
+{
+    _invalidationStatistics.cRedrawsRequested++;
+
+    if (_cBatchDepth > 0)
+    {
+        // Only where the cursor was when the batch started and where it ends up
+        //      need painting. Every stop in between was covered by the text anyway.
+        _invalidationStatistics.cRedrawsBatched++;
+        if (!_batchedCursorFrom.has_value())
+        {
+            _batchedCursorFrom = *pcoord;
+        }
+        _batchedCursorTo = *pcoord;
+    }
+    else if (_InvalidateCursor(*pcoord))
+    {
+        _NotifyPaintFrame();
+    }
+}
+
+// Routine Description:
+// - Hands a buffer-space region to every engine, if any of it is in the viewport.
+// Arguments:
+// - region: The buffer-space region that has changed.
+// Return Value:
+// - True if the engines were told about it and a frame needs painting. False otherwise.
+bool Renderer::_InvalidateRegion(const Viewport& region)
 {
     Viewport view = _pData->GetViewport();
-    COORD updateCoord = *pcoord;
+    SMALL_RECT srUpdateRegion = region.ToExclusive();
 
-    if (view.IsInBounds(updateCoord))
+    if (!view.TrimToViewport(&srUpdateRegion))
     {
-        view.ConvertToOrigin(&updateCoord);
-        for (IRenderEngine* pEngine : _rgpEngines)
+        return false;
+    }
+
+    view.ConvertToOrigin(&srUpdateRegion);
+    std::for_each(_rgpEngines.begin(), _rgpEngines.end(), [&](IRenderEngine* const pEngine) {
+        _invalidationStatistics.cInvalidations++;
+        LOG_IF_FAILED(pEngine->Invalidate(&srUpdateRegion));
+    });
+    return true;
+}
+
+// Routine Description:
+// - Hands a buffer-space cursor position to every engine, if it's in the viewport.
+// Arguments:
+// - coord: The buffer-space position of the cursor.
+// Return Value:
+// - True if the engines were told about it and a frame needs painting. False otherwise.
+bool Renderer::_InvalidateCursor(const COORD coord)
+{
+    Viewport view = _pData->GetViewport();
+    COORD updateCoord = coord;
+
+    if (!view.IsInBounds(updateCoord))
+    {
+        return false;
+    }
+
+    view.ConvertToOrigin(&updateCoord);
+    for (IRenderEngine* pEngine : _rgpEngines)
+    {
+        _invalidationStatistics.cInvalidations++;
+        LOG_IF_FAILED(pEngine->InvalidateCursor(&updateCoord));
+
+        // Double-wide cursors need to invalidate the right half as well.
+        if (_pData->IsCursorDoubleWidth())
         {
+            updateCoord.X++;
             LOG_IF_FAILED(pEngine->InvalidateCursor(&updateCoord));
+        }
+    }
+    return true;
+}
 
-            // Double-wide cursors need to invalidate the right half as well.
-            if (_pData->IsCursorDoubleWidth())
-            {
-                updateCoord.X++;
-                LOG_IF_FAILED(pEngine->InvalidateCursor(&updateCoord));
-            }
+// Routine Description:
+// - Starts holding on to redraws of the buffer and the cursor instead of handing
+//      them to the engines one at a time. They're merged as they come in and
+//      flushed when the outermost batch ends.
+// - Use InvalidationBatch rather than calling this directly, so every Begin is
+//      matched by an End.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Renderer::BeginInvalidationBatch()
+{
+    _cBatchDepth++;
+}
+
+// Routine Description:
+// - Ends a batch started with BeginInvalidationBatch. If it's the outermost one,
+//      everything gathered is handed to the engines and the render thread is
+//      notified once.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Renderer::EndInvalidationBatch()
+{
+    if (_cBatchDepth > 0 && --_cBatchDepth == 0)
+    {
+        try
+        {
+            _FlushInvalidationBatch();
+        }
+        CATCH_LOG();
+    }
+}
+
+// Routine Description:
+// - Gets the counts of redraws requested of this renderer and of what was
+//      actually handed on to the engines and the render thread.
+// Arguments:
+// - <none>
+// Return Value:
+// - The counts since this renderer was created.
+Renderer::InvalidationStatistics Renderer::GetInvalidationStatistics() const noexcept
+{
+    return _invalidationStatistics;
+}
+
+// Routine Description:
+// - Adds a region to the open batch. A region on the same rows as the last one
+//      that touches it, or on the same columns right above or below it, grows the
+//      last one instead, which is what writing a run of text or a column of cells
+//      looks like. Past a limit everything is merged into the last region, which
+//      paints a bit more but keeps a pathological write from growing the list.
+// Arguments:
+// - srRegion: The buffer-space region that has changed, exclusive.
+// Return Value:
+// - <none>
+void Renderer::_BatchRegion(const SMALL_RECT& srRegion)
+{
+    if (!_batchedRegions.empty())
+    {
+        SMALL_RECT& srLast = _batchedRegions.back();
+        const bool fSameRows = srLast.Top == srRegion.Top && srLast.Bottom == srRegion.Bottom;
+        const bool fSameColumns = srLast.Left == srRegion.Left && srLast.Right == srRegion.Right;
+        const bool fTouchesHorizontally = srRegion.Left <= srLast.Right && srRegion.Right >= srLast.Left;
+        const bool fTouchesVertically = srRegion.Top <= srLast.Bottom && srRegion.Bottom >= srLast.Top;
+
+        if ((fSameRows && fTouchesHorizontally) ||
+            (fSameColumns && fTouchesVertically) ||
+            _batchedRegions.size() >= s_cMaxBatchedRegions)
+        {
+            srLast.Left = std::min(srLast.Left, srRegion.Left);
+            srLast.Top = std::min(srLast.Top, srRegion.Top);
+            srLast.Right = std::max(srLast.Right, srRegion.Right);
+            srLast.Bottom = std::max(srLast.Bottom, srRegion.Bottom);
+            return;
         }
+    }
+
+    _batchedRegions.push_back(srRegion);
+}
+
+// Routine Description:
+// - Hands everything gathered by the open batch to the engines and notifies the
+//      render thread once if any of it was in the viewport. The batch stays open.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Renderer::_FlushInvalidationBatch()
+{
+    bool fInvalidated = false;
+    for (const auto& srRegion : _batchedRegions)
+    {
+        fInvalidated = _InvalidateRegion(Viewport::FromExclusive(srRegion)) || fInvalidated;
+    }
+    _batchedRegions.clear();
 
+    if (_batchedCursorFrom.has_value())
+    {
+        const COORD coordFrom = _batchedCursorFrom.value();
+        const COORD coordTo = _batchedCursorTo.value();
+        fInvalidated = _InvalidateCursor(coordFrom) || fInvalidated;
+        if (coordTo.X != coordFrom.X || coordTo.Y != coordFrom.Y)
+        {
+            fInvalidated = _InvalidateCursor(coordTo) || fInvalidated;
+        }
+    }
+    _batchedCursorFrom.reset();
+    _batchedCursorTo.reset();
+
+    if (fInvalidated)
+    {
         _NotifyPaintFrame();
     }
 }
@@ -236,6 +411,8 @@ void Renderer::TriggerRedrawCursor(const COORD* const pcoord)
 // - <none>
 void Renderer::TriggerRedrawAll()
 {
+    _FlushInvalidationBatch();
+
     std::for_each(_rgpEngines.begin(), _rgpEngines.end(), [&](IRenderEngine* const pEngine) {
         LOG_IF_FAILED(pEngine->InvalidateAll());
     });
@@ -252,6 +429,8 @@ void Renderer::TriggerRedrawAll()
 // - <none>
 void Renderer::TriggerTeardown()
 {
+    _FlushInvalidationBatch();
+
     // We need to shut down the paint thread on teardown.
     _pThread->WaitForPaintCompletionAndDisable(INFINITE);
 
@@ -344,6 +523,10 @@ void Renderer::TriggerScroll()
 // - <none>
 void Renderer::TriggerScroll(const COORD* const pcoordDelta)
 {
+    // The rows of the buffer were renumbered under us, so what's batched so far
+    //      has to go out before the engines shift their frames.
+    _FlushInvalidationBatch();
+
     std::for_each(_rgpEngines.begin(), _rgpEngines.end(), [&](IRenderEngine* const pEngine) {
         LOG_IF_FAILED(pEngine->InvalidateScroll(pcoordDelta));
     });
@@ -351,6 +534,45 @@ void Renderer::TriggerScroll(const COORD* const pcoordDelta)
     _NotifyPaintFrame();
 }
 
+// Routine Description:
+// - Called when the rows of a region of the buffer were moved up or down
+//      within that region, such as when an application scrolls inside the
+//      margins it set. Engines that can move those rows on their own surface
+//      only need to repaint the rows that were uncovered.
+// - If the region isn't made of whole rows of the viewport, the engines can't
+//      shift it, so it's redrawn like any other change.
+// Arguments:
+// - region: The buffer-space region whose rows moved. This covers both where
+//      the rows came from and where they went.
+// - pcoordDelta: How far the rows moved. Only Y may be non-zero.
+// Return Value:
+// - <none>
+void Renderer::TriggerScrollRegion(const Viewport& region, const COORD* const pcoordDelta)
+{
+    // The engines move what they've already drawn, so anything batched that
+    //      moves along with it has to reach them first.
+    _FlushInvalidationBatch();
+
+    Viewport view = _pData->GetViewport();
+    SMALL_RECT srRegion = region.ToExclusive();
+
+    if (pcoordDelta->X != 0 ||
+        region.Left() != view.Left() ||
+        region.RightInclusive() != view.RightInclusive() ||
+        !view.IsInBounds(region))
+    {
+        TriggerRedraw(region);
+        return;
+    }
+
+    view.ConvertToOrigin(&srRegion);
+    std::for_each(_rgpEngines.begin(), _rgpEngines.end(), [&](IRenderEngine* const pEngine) {
+        LOG_IF_FAILED(pEngine->InvalidateScrollRegion(&srRegion, pcoordDelta));
+    });
+
+    _NotifyPaintFrame();
+}
+
 // Routine Description:
 // - Called when the text buffer is about to circle it's backing buffer.
 //      A renderer might want to get painted before that happens.
@@ -360,6 +582,8 @@ void Renderer::TriggerScroll(const COORD* const pcoordDelta)
 // - <none>
 void Renderer::TriggerCircling()
 {
+    _FlushInvalidationBatch();
+
     for (IRenderEngine* const pEngine : _rgpEngines)
     {
         bool fEngineRequestsRepaint = false;
@@ -542,44 +766,53 @@ void Renderer::_PaintBufferOutput(_In_ IRenderEngine* const pEngine)
     // relative to the entire buffer.
     const auto view = _pData->GetViewport();
 
-    // This is effectively the number of cells on the visible screen that need to be redrawn.
-    // The origin is always 0, 0 because it represents the screen itself, not the underlying buffer.
-    auto dirty = Viewport::FromInclusive(pEngine->GetDirtyRectInChars());
+    // Retrieve the text buffer so we can read information out of it.
+    const auto& buffer = _pData->GetTextBuffer();
 
-    // Shift the origin of the dirty region to match the underlying buffer so we can
-    // compare the two regions directly for intersection.
-    dirty = Viewport::Offset(dirty, view.Origin());
+    // This is effectively the cells on the visible screen that need to be redrawn.
+    // The engine may hand back several disjoint rectangles so that two small changes
+    // at opposite ends of the screen don't cost a repaint of everything in between.
+    // The origin is always 0, 0 because it represents the screen itself, not the underlying buffer.
+    for (const auto& dirtyRect : pEngine->GetDirtyArea())
+    {
+        auto dirty = Viewport::FromInclusive(dirtyRect);
 
-    // The intersection between what is dirty on the screen (in need of repaint)
-    // and what is supposed to be visible on the screen (the viewport) is what
-    // we need to walk through line-by-line and repaint onto the screen.
-    const auto redraw = Viewport::Intersect(dirty, view);
+        // Shift the origin of the dirty region to match the underlying buffer so we can
+        // compare the two regions directly for intersection.
+        dirty = Viewport::Offset(dirty, view.Origin());
 
-    // Shortcut: don't bother redrawing if the width is 0.
-    if (redraw.Width() > 0)
-    {
-        // Retrieve the text buffer so we can read information out of it.
-        const auto& buffer = _pData->GetTextBuffer();
+        // The intersection between what is dirty on the screen (in need of repaint)
+        // and what is supposed to be visible on the screen (the viewport) is what
+        // we need to walk through line-by-line and repaint onto the screen.
+        const auto redraw = Viewport::Intersect(dirty, view);
 
-        // Now walk through each row of text that we need to redraw.
-        for (auto row = redraw.Top(); row < redraw.BottomExclusive(); row++)
+        // Shortcut: don't bother redrawing if the width is 0.
+        if (redraw.Width() > 0)
         {
-            // Calculate the boundaries of a single line. This is from the left to right edge of the dirty
-            // area in width and exactly 1 tall.
-            const auto bufferLine = Viewport::FromDimensions({ redraw.Left(), row }, { redraw.Width(), 1 });
-
-            // Find where on the screen we should place this line information. This requires us to re-map
-            // the buffer-based origin of the line back onto the screen-based origin of the line
-            // For example, the screen might say we need to paint 1,1 because it is dirty but the viewport is actually looking
-            // at 13,26 relative to the buffer.
-            // This means that we need 14,27 out of the backing buffer to fill in the 1,1 cell of the screen.
-            const auto screenLine = Viewport::Offset(bufferLine, -view.Origin());
-
-            // Retrieve the cell information iterator limited to just this line we want to redraw.
-            auto it = buffer.GetCellDataAt(bufferLine.Origin(), bufferLine);
-
-            // Ask the helper to paint through this specific line.
-            _PaintBufferOutputHelper(pEngine, it, screenLine.Origin());
+            // No run can be longer than the line it's on, so make sure the cluster buffer
+            // can hold a whole line now instead of growing it run by run.
+            _clusterBuffer.reserve(redraw.Width());
+
+            // Now walk through each row of text that we need to redraw.
+            for (auto row = redraw.Top(); row < redraw.BottomExclusive(); row++)
+            {
+                // Calculate the boundaries of a single line. This is from the left to right edge of the dirty
+                // area in width and exactly 1 tall.
+                const auto bufferLine = Viewport::FromDimensions({ redraw.Left(), row }, { redraw.Width(), 1 });
+
+                // Find where on the screen we should place this line information. This requires us to re-map
+                // the buffer-based origin of the line back onto the screen-based origin of the line
+                // For example, the screen might say we need to paint 1,1 because it is dirty but the viewport is actually looking
+                // at 13,26 relative to the buffer.
+                // This means that we need 14,27 out of the backing buffer to fill in the 1,1 cell of the screen.
+                const auto screenLine = Viewport::Offset(bufferLine, -view.Origin());
+
+                // Retrieve the cell information iterator limited to just this line we want to redraw.
+                auto it = buffer.GetCellDataAt(bufferLine.Origin(), bufferLine);
+
+                // Ask the helper to paint through this specific line.
+                _PaintBufferOutputHelper(pEngine, it, screenLine.Origin());
+            }
         }
     }
 }
@@ -591,11 +824,10 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
     // If we have valid data, let's figure out how to draw it.
     if (it)
     {
-        // TODO: MSFT: 20961091 -  This is a perf issue. Instead of rebuilding this and allocing memory to hold the reinterpretation,
-        // we should have an iterator/view adapter for the rendering.
-        // That would probably also eliminate the RenderData needing to give us the entire TextBuffer as well...
-        // Retrieve the iterator for one line of information.
-        std::vector<Cluster> clusters;
+        // The clusters are views into the text buffer, collected into the renderer's
+        // reusable buffer so that painting a run doesn't allocate once it has grown
+        // to fit the widest run.
+        auto& clusters = _clusterBuffer;
         size_t cols = 0;
 
         // Retrieve the first color.
@@ -897,6 +1129,11 @@ HRESULT Renderer::_PerformScrolling(_In_ IRenderEngine* const pEngine)
 std::vector<SMALL_RECT> Renderer::_GetSelectionRects() const
 {
     auto rects = _pData->GetSelectionRects();
+
+    // Search matches are highlighted the same way as the selection.
+    const auto highlights = _pData->GetSearchHighlightRects();
+    rects.insert(rects.end(), highlights.begin(), highlights.end());
+
     // Adjust rectangles to viewport
     Viewport view = _pData->GetViewport();
 
@@ -30,6 +30,18 @@ namespace Microsoft::Console::Render
     class Renderer sealed : public IRenderer
     {
     public:
+        struct InvalidationStatistics
+        {
+            // Calls to TriggerRedraw and TriggerRedrawCursor.
+            size_t cRedrawsRequested;
+            // How many of those were held in a batch instead of going straight to the engines.
+            size_t cRedrawsBatched;
+            // Regions and cursor positions handed to the engines, once per engine.
+            size_t cInvalidations;
+            // Times the render thread was told there's something to paint.
+            size_t cPaintNotifications;
+        };
+
         Renderer(IRenderData* pData,
                  _In_reads_(cEngines) IRenderEngine** const pEngine,
                  const size_t cEngines,
@@ -60,10 +72,15 @@ namespace Microsoft::Console::Render
         void TriggerSelection() override;
         void TriggerScroll() override;
         void TriggerScroll(const COORD* const pcoordDelta) override;
+        void TriggerScrollRegion(const Microsoft::Console::Types::Viewport& region, const COORD* const pcoordDelta) override;
 
         void TriggerCircling() override;
         void TriggerTitleChange() override;
 
+        void BeginInvalidationBatch() override;
+        void EndInvalidationBatch() override;
+        InvalidationStatistics GetInvalidationStatistics() const noexcept;
+
         void TriggerFontChange(const int iDpi,
                                const FontInfoDesired& FontInfoDesired,
                                _Out_ FontInfo& FontInfo) override;
@@ -90,6 +107,21 @@ namespace Microsoft::Console::Render
 
         void _NotifyPaintFrame();
 
+        // While a batch is open, redraws of the buffer are gathered here, in buffer
+        //      coordinates, and handed to the engines when the outermost batch ends.
+        //      The vector keeps its capacity, so batching doesn't allocate once warm.
+        static constexpr size_t s_cMaxBatchedRegions = 128;
+        size_t _cBatchDepth = 0;
+        std::vector<SMALL_RECT> _batchedRegions;
+        std::optional<COORD> _batchedCursorFrom;
+        std::optional<COORD> _batchedCursorTo;
+        InvalidationStatistics _invalidationStatistics{};
+
+        void _BatchRegion(const SMALL_RECT& srRegion);
+        void _FlushInvalidationBatch();
+        bool _InvalidateRegion(const Microsoft::Console::Types::Viewport& region);
+        bool _InvalidateCursor(const COORD coord);
+
         [[nodiscard]]
         HRESULT _PaintFrameForEngine(_In_ IRenderEngine* const pEngine);
 
@@ -104,6 +136,10 @@ namespace Microsoft::Console::Render
                                       TextBufferCellIterator it,
                                       const COORD target);
 
+        // Holds the clusters of the run being painted. It's kept across runs and frames
+        // so that painting text doesn't allocate once it has grown to the widest line.
+        std::vector<Cluster> _clusterBuffer;
+
         static IRenderEngine::GridLines s_GetGridlines(const TextAttribute& textAttribute) noexcept;
 
         void _PaintBufferOutputGridLineHelper(_In_ IRenderEngine* const pEngine,
@@ -16,7 +16,9 @@ RenderThread::RenderThread() :
     _hEvent(INVALID_HANDLE_VALUE),
     _hPaintCompletedEvent(INVALID_HANDLE_VALUE),
     _fKeepRunning(true),
-    _hPaintEnabledEvent(INVALID_HANDLE_VALUE)
+    _hPaintEnabledEvent(INVALID_HANDLE_VALUE),
+    _pacer(std::chrono::milliseconds(s_FrameLimitMilliseconds),
+           std::chrono::milliseconds(s_LatencyBudgetMilliseconds))
 {
 
 }
@@ -160,20 +162,31 @@ DWORD WINAPI RenderThread::_ThreadProc()
 {
     while (_fKeepRunning)
     {
-        WaitForSingleObject(_hPaintEnabledEvent, INFINITE);
         WaitForSingleObject(_hEvent, INFINITE);
 
+        // Let the pacer decide whether to paint now or to wait for more output
+        //      to fold into this frame. Changes made while we wait set the event
+        //      again, but they'll be painted by this frame, so that next wake-up
+        //      is skipped cheaply when nothing is left to paint.
+        // Extra check before we sleep since it's a "long" activity, relatively speaking.
+        const auto delay = _pacer.GetDelay(FramePacer::clock::now());
+        if (_fKeepRunning && delay > FramePacer::clock::duration::zero())
+        {
+            Sleep(gsl::narrow_cast<DWORD>(std::chrono::ceil<std::chrono::milliseconds>(delay).count()));
+        }
+
+        WaitForSingleObject(_hPaintEnabledEvent, INFINITE);
+
         ResetEvent(_hPaintCompletedEvent);
 
-        LOG_IF_FAILED(_pRenderer->PaintFrame());
+        _pacer.FrameStarting(FramePacer::clock::now());
 
-        SetEvent(_hPaintCompletedEvent);
+        const HRESULT hr = _pRenderer->PaintFrame();
+        LOG_IF_FAILED(hr);
 
-        // extra check before we sleep since it's a "long" activity, relatively speaking.
-        if (_fKeepRunning)
-        {
-            Sleep(s_FrameLimitMilliseconds);
-        }
+        _pacer.FrameCompleted(FramePacer::clock::now(), hr != S_FALSE);
+
+        SetEvent(_hPaintCompletedEvent);
     }
 
     return S_OK;
@@ -181,9 +194,36 @@ DWORD WINAPI RenderThread::_ThreadProc()
 
 void RenderThread::NotifyPaint()
 {
+    _pacer.NotifyPaint(FramePacer::clock::now());
     SetEvent(_hEvent);
 }
 
+// Method Description:
+// - Changes how long sustained output may be coalesced before it's painted.
+//      A longer budget paints fewer frames during bulk output, a shorter one
+//      keeps the screen closer to what's been written.
+// Arguments:
+// - latencyBudget - The longest time a change may wait to be painted.
+// Return Value:
+// - <none>
+void RenderThread::SetLatencyBudget(const std::chrono::milliseconds latencyBudget) noexcept
+{
+    _pacer.SetLatencyBudget(latencyBudget);
+}
+
+// Method Description:
+// - Gets the counters kept by the frame pacer: how many frames were painted
+//      or skipped, how many changes were coalesced into an earlier frame, and
+//      how long changes waited before they were painted.
+// Arguments:
+// - <none>
+// Return Value:
+// - A copy of the counters.
+FramePacer::Statistics RenderThread::GetFrameStatistics() const noexcept
+{
+    return _pacer.GetStatistics();
+}
+
 void RenderThread::EnablePainting()
 {
     SetEvent(_hPaintEnabledEvent);
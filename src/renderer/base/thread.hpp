@@ -16,6 +16,7 @@ Author(s):
 
 #include "..\inc\IRenderer.hpp"
 #include "..\inc\IRenderThread.hpp"
+#include "FramePacer.hpp"
 
 namespace Microsoft::Console::Render
 {
@@ -32,12 +33,18 @@ namespace Microsoft::Console::Render
 
         void EnablePainting() override;
         void WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs) override;
-        
+
+        void SetLatencyBudget(const std::chrono::milliseconds latencyBudget) noexcept;
+        FramePacer::Statistics GetFrameStatistics() const noexcept;
+
     private:
         static DWORD WINAPI s_ThreadProc(_In_ LPVOID lpParameter);
         DWORD WINAPI _ThreadProc();
 
         static DWORD const s_FrameLimitMilliseconds = 8;
+        static DWORD const s_LatencyBudgetMilliseconds = 33;
+
+        FramePacer _pacer;
 
         HANDLE _hThread;
         HANDLE _hEvent;
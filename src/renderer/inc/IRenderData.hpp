@@ -64,6 +64,7 @@ namespace Microsoft::Console::Render
         virtual const bool IsGridLineDrawingAllowed() noexcept = 0;
 
         virtual std::vector<Microsoft::Console::Types::Viewport> GetSelectionRects() noexcept = 0;
+        virtual std::vector<Microsoft::Console::Types::Viewport> GetSearchHighlightRects() noexcept = 0;
 
         virtual const std::wstring GetConsoleTitle() const noexcept = 0;
 
@@ -89,6 +89,8 @@ namespace Microsoft::Console::Render
         [[nodiscard]]
         virtual HRESULT InvalidateScroll(const COORD* const pcoordDelta) noexcept = 0;
         [[nodiscard]]
+        virtual HRESULT InvalidateScrollRegion(const SMALL_RECT* const psrRegion, const COORD* const pcoordDelta) noexcept = 0;
+        [[nodiscard]]
         virtual HRESULT InvalidateAll() noexcept = 0;
         [[nodiscard]]
         virtual HRESULT InvalidateCircling(_Out_ bool* const pForcePaint) noexcept = 0;
@@ -133,6 +135,7 @@ namespace Microsoft::Console::Render
                                         const int iDpi) noexcept = 0;
 
         virtual SMALL_RECT GetDirtyRectInChars() = 0;
+        virtual std::basic_string_view<SMALL_RECT> GetDirtyArea() = 0;
         [[nodiscard]]
         virtual HRESULT GetFontSize(_Out_ COORD* const pFontSize) noexcept = 0;
         [[nodiscard]]
@@ -35,8 +35,12 @@ namespace Microsoft::Console::Render
         virtual void TriggerSelection() = 0;
         virtual void TriggerScroll() = 0;
         virtual void TriggerScroll(const COORD* const pcoordDelta) = 0;
+        virtual void TriggerScrollRegion(const Microsoft::Console::Types::Viewport& region, const COORD* const pcoordDelta) = 0;
         virtual void TriggerCircling() = 0;
         virtual void TriggerTitleChange() = 0;
+
+        virtual void BeginInvalidationBatch() = 0;
+        virtual void EndInvalidationBatch() = 0;
     };
 
     inline Microsoft::Console::Render::IRenderTarget::~IRenderTarget() { }
@@ -0,0 +1,48 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- InvalidationBatch.hpp
+
+Abstract:
+- Holds the redraws of a render target for as long as it's in scope, so that
+    a write that changes many cells and moves the cursor many times is
+    invalidated once, when it's done.
+- Batches can be nested. Only the outermost one flushes.
+--*/
+
+#pragma once
+
+#include "IRenderTarget.hpp"
+
+namespace Microsoft::Console::Render
+{
+    class InvalidationBatch final
+    {
+    public:
+        // Does nothing if there's no render target, so callers don't have to check.
+        InvalidationBatch(IRenderTarget* const pRenderTarget) :
+            _pRenderTarget{ pRenderTarget }
+        {
+            if (_pRenderTarget != nullptr)
+            {
+                _pRenderTarget->BeginInvalidationBatch();
+            }
+        }
+
+        ~InvalidationBatch()
+        {
+            if (_pRenderTarget != nullptr)
+            {
+                _pRenderTarget->EndInvalidationBatch();
+            }
+        }
+
+        InvalidationBatch(const InvalidationBatch&) = delete;
+        InvalidationBatch& operator=(const InvalidationBatch&) = delete;
+
+    private:
+        IRenderTarget* const _pRenderTarget;
+    };
+}
@@ -33,6 +33,11 @@ namespace Microsoft::Console::Render
         [[nodiscard]]
         HRESULT UpdateTitle(const std::wstring& newTitle) noexcept override;
 
+        [[nodiscard]]
+        HRESULT InvalidateScrollRegion(const SMALL_RECT* const psrRegion, const COORD* const pcoordDelta) noexcept override;
+
+        std::basic_string_view<SMALL_RECT> GetDirtyArea() override;
+
     protected:
         [[nodiscard]]
         virtual HRESULT _DoUpdateTitle(const std::wstring& newTitle) noexcept = 0;
@@ -40,6 +45,9 @@ namespace Microsoft::Console::Render
         bool _titleChanged;
         std::wstring _lastFrameTitle;
 
+        // Engines that only track a single dirty rectangle hand it out from here.
+        SMALL_RECT _dirtyRect;
+
     };
 
     inline Microsoft::Console::Render::RenderEngineBase::~RenderEngineBase() { }
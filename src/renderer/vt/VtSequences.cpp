@@ -87,9 +87,7 @@ HRESULT VtEngine::_EraseLine() noexcept
 [[nodiscard]]
 HRESULT VtEngine::_EraseCharacter(const short chars) noexcept
 {
-    static const std::string format = "\x1b[%dX";
-
-    return _WriteFormattedString(&format, chars);
+    return _WriteCsi({ chars }, 'X');
 }
 
 // Method Description:
@@ -101,10 +99,7 @@ HRESULT VtEngine::_EraseCharacter(const short chars) noexcept
 [[nodiscard]]
 HRESULT VtEngine::_CursorForward(const short chars) noexcept
 {
-
-    static const std::string format = "\x1b[%dC";
-
-    return _WriteFormattedString(&format, chars);
+    return _WriteCsi({ chars }, 'C');
 }
 
 // Method Description:
@@ -139,9 +134,8 @@ HRESULT VtEngine::_InsertDeleteLine(const short sLines, const bool fInsertLine)
     {
         return _Write(fInsertLine ? "\x1b[L" : "\x1b[M");
     }
-    const std::string format = fInsertLine ? "\x1b[%dL" : "\x1b[%dM";
 
-    return _WriteFormattedString(&format, sLines);
+    return _WriteCsi({ sLines }, fInsertLine ? 'L' : 'M');
 }
 
 // Method Description:
@@ -170,6 +164,58 @@ HRESULT VtEngine::_InsertLine(const short sLines) noexcept
     return _InsertDeleteLine(sLines, true);
 }
 
+// Method Description:
+// - Formats and writes a sequence to set the top and bottom scroll margins.
+//      The terminal also moves the cursor to the origin.
+// Arguments:
+// - top: the first row inside the margins, where origin=0.
+// - bottom: the last row inside the margins, where origin=0.
+// Return Value:
+// - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]]
+HRESULT VtEngine::_SetScrollingRegion(const short top, const short bottom) noexcept
+{
+    // VT rows start at 1
+    return _WriteCsi({ top + 1, bottom + 1 }, 'r');
+}
+
+// Method Description:
+// - Formats and writes a sequence to clear the scroll margins, so that the
+//      whole screen scrolls again. The terminal also moves the cursor to the
+//      origin.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]]
+HRESULT VtEngine::_ResetScrollingRegion() noexcept
+{
+    return _Write("\x1b[r");
+}
+
+// Method Description:
+// - Formats and writes a sequence to scroll the contents of the scroll
+//      margins up or down, without moving the cursor.
+// Arguments:
+// - sLines: a number of lines to scroll by
+// - fScrollUp: true iff the contents should move up (SU), false for down (SD).
+// Return Value:
+// - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]]
+HRESULT VtEngine::_ScrollUpDown(const short sLines, const bool fScrollUp) noexcept
+{
+    if (sLines <= 0)
+    {
+        return S_OK;
+    }
+    if (sLines == 1)
+    {
+        return _Write(fScrollUp ? "\x1b[S" : "\x1b[T");
+    }
+
+    return _WriteCsi({ sLines }, fScrollUp ? 'S' : 'T');
+}
+
 // Method Description:
 // - Formats and writes a sequence to move the cursor to the specified
 //      coordinate position. The input coord should be in console coordinates,
@@ -181,14 +227,8 @@ HRESULT VtEngine::_InsertLine(const short sLines) noexcept
 [[nodiscard]]
 HRESULT VtEngine::_CursorPosition(const COORD coord) noexcept
 {
-    static const std::string cursorFormat = "\x1b[%d;%dH";
-
     // VT coords start at 1,1
-    COORD coordVt = coord;
-    coordVt.X++;
-    coordVt.Y++;
-
-    return _WriteFormattedString(&cursorFormat, coordVt.Y, coordVt.X);
+    return _WriteCsi({ coord.Y + 1, coord.X + 1 }, 'H');
 }
 
 // Method Description:
@@ -212,8 +252,7 @@ HRESULT VtEngine::_CursorHome() noexcept
 [[nodiscard]]
 HRESULT VtEngine::_SetGraphicsBoldness(const bool isBold) noexcept
 {
-    const std::string fmt = isBold ? "\x1b[1m" : "\x1b[22m";
-    return _Write(fmt);
+    return _Write(isBold ? "\x1b[1m" : "\x1b[22m");
 }
 
 // Method Description:
@@ -239,8 +278,18 @@ HRESULT VtEngine::_SetGraphicsDefault() noexcept
 HRESULT VtEngine::_SetGraphicsRendition16Color(const WORD wAttr,
                                                const bool fIsForeground) noexcept
 {
-    static const std::string fmt = "\x1b[%dm";
+    return _WriteCsi({ _16ColorSgrParameter(wAttr, fIsForeground) }, 'm');
+}
 
+// Method Description:
+// - Gets the SGR parameter that selects one of the 16 legacy colors.
+// Arguments:
+// - wAttr: Windows color table index to get the parameter for
+// - fIsForeground: true for the foreground parameter, false for background
+// Return Value:
+// - The SGR parameter.
+int VtEngine::_16ColorSgrParameter(const WORD wAttr, const bool fIsForeground) noexcept
+{
     // Always check using the foreground flags, because the bg flags constants
     //  are a higher byte
     // Foreground sequences are in [30,37] U [90,97]
@@ -260,7 +309,7 @@ HRESULT VtEngine::_SetGraphicsRendition16Color(const WORD wAttr,
                         + (WI_IsFlagSet(wAttr, FOREGROUND_GREEN) ? 2 : 0)
                         + (WI_IsFlagSet(wAttr, FOREGROUND_BLUE) ? 4 : 0);
 
-    return _WriteFormattedString(&fmt, vtIndex);
+    return vtIndex;
 }
 
 // Method Description:
@@ -275,15 +324,11 @@ HRESULT VtEngine::_SetGraphicsRendition16Color(const WORD wAttr,
 HRESULT VtEngine::_SetGraphicsRenditionRGBColor(const COLORREF color,
                                                 const bool fIsForeground) noexcept
 {
-    const std::string fmt = fIsForeground ?
-        "\x1b[38;2;%d;%d;%dm" :
-        "\x1b[48;2;%d;%d;%dm";
+    const int r = GetRValue(color);
+    const int g = GetGValue(color);
+    const int b = GetBValue(color);
 
-    DWORD const r = GetRValue(color);
-    DWORD const g = GetGValue(color);
-    DWORD const b = GetBValue(color);
-
-    return _WriteFormattedString(&fmt, r, g, b);
+    return _WriteCsi({ fIsForeground ? 38 : 48, 2, r, g, b }, 'm');
 }
 
 // Method Description:
@@ -296,9 +341,7 @@ HRESULT VtEngine::_SetGraphicsRenditionRGBColor(const COLORREF color,
 [[nodiscard]]
 HRESULT VtEngine::_SetGraphicsRenditionDefaultColor(const bool fIsForeground) noexcept
 {
-    const std::string fmt = fIsForeground ? ("\x1b[39m") : ("\x1b[49m");
-
-    return _Write(fmt);
+    return _Write(fIsForeground ? "\x1b[39m" : "\x1b[49m");
 }
 
 // Method Description:
@@ -311,13 +354,12 @@ HRESULT VtEngine::_SetGraphicsRenditionDefaultColor(const bool fIsForeground) no
 [[nodiscard]]
 HRESULT VtEngine::_ResizeWindow(const short sWidth, const short sHeight) noexcept
 {
-    static const std::string resizeFormat = "\x1b[8;%d;%dt";
     if (sWidth < 0 || sHeight < 0)
     {
         return E_INVALIDARG;
     }
 
-    return _WriteFormattedString(&resizeFormat, sHeight, sWidth);
+    return _WriteCsi({ 8, sHeight, sWidth }, 't');
 }
 
 // Method Description:
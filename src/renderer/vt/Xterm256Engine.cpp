@@ -25,16 +25,14 @@ Xterm256Engine::Xterm256Engine(_In_ wil::unique_hfile hPipe,
 // - colorBackground: The RGB Color to use to paint the background of the text.
 // - legacyColorAttribute: A console attributes bit field specifying the brush
 //      colors we should use.
-// - isSettingDefaultBrushes: indicates if we should change the background color of
-//      the window. Unused for VT
+// - isBold: whether the text should be bold.
 // Return Value:
 // - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
 [[nodiscard]]
-HRESULT Xterm256Engine::UpdateDrawingBrushes(const COLORREF colorForeground,
-                                             const COLORREF colorBackground,
-                                             const WORD legacyColorAttribute,
-                                             const bool isBold,
-                                             const bool /*isSettingDefaultBrushes*/) noexcept
+HRESULT Xterm256Engine::_SetDrawingBrushes(const COLORREF colorForeground,
+                                           const COLORREF colorBackground,
+                                           const WORD legacyColorAttribute,
+                                           const bool isBold) noexcept
 {
     //When we update the brushes, check the wAttrs to see if the LVB_UNDERSCORE
     //      flag is there. If the state of that flag is different then our
@@ -31,12 +31,12 @@ namespace Microsoft::Console::Render
 
         virtual ~Xterm256Engine() override = default;
 
+    protected:
         [[nodiscard]]
-        HRESULT UpdateDrawingBrushes(const COLORREF colorForeground,
-                                    const COLORREF colorBackground,
-                                    const WORD legacyColorAttribute,
-                                    const bool isBold,
-                                    const bool isSettingDefaultBrushes) noexcept override;
+        HRESULT _SetDrawingBrushes(const COLORREF colorForeground,
+                                   const COLORREF colorBackground,
+                                   const WORD legacyColorAttribute,
+                                   const bool isBold) noexcept override;
 
     private:
 
@@ -21,7 +21,12 @@ XtermEngine::XtermEngine(_In_ wil::unique_hfile hPipe,
     _fUseAsciiOnly(fUseAsciiOnly),
     _previousLineWrapped(false),
     _usingUnderLine(false),
-    _needToDisableCursor(false)
+    _needToDisableCursor(false),
+    _shadowBufferEnabled(false),
+    _shadowBuffer(),
+    _shadowWidth(0),
+    _pendingBrushes(),
+    _pendingRegionScroll()
 {
     // Set out initial cursor position to -1, -1. This will force our initial
     //      paint to manually move the cursor to 0, 0, not just ignore it.
@@ -60,7 +65,7 @@ HRESULT XtermEngine::StartPaint() noexcept
     {
         const auto dirtyRect = GetDirtyRectInChars();
         const auto dirtyView = Viewport::FromInclusive(dirtyRect);
-        if (!_resized && dirtyView == _lastViewport)
+        if (!_resized && dirtyView == _lastViewport && _AllIsInvalid())
         {
             // TODO: MSFT:21096414 - This is never actually hit. We set
             // _resized=true on every frame (see VtEngine::UpdateViewport).
@@ -71,6 +76,16 @@ HRESULT XtermEngine::StartPaint() noexcept
         }
     }
 
+    // A cleared screen doesn't show anything we wrote before, and after a
+    //      resize we can't tell how the terminal rearranged it.
+    if (_shadowBufferEnabled &&
+        (_clearedAllThisFrame ||
+         _shadowWidth != _lastViewport.Width() ||
+         _shadowBuffer.size() != gsl::narrow_cast<size_t>(_lastViewport.Width()) * _lastViewport.Height()))
+    {
+        RETURN_IF_FAILED(_ResetShadowBuffer());
+    }
+
     if (!_quickReturn)
     {
         if (!_WillWriteSingleChar())
@@ -114,7 +129,7 @@ HRESULT XtermEngine::EndPaint() noexcept
     //      the cursor here.
     if (_needToDisableCursor)
     {
-        _buffer.insert(0, "\x1b[25l");
+        _buffer.insert(0, "\x1b[?25l");
         RETURN_IF_FAILED(_ShowCursor());
     }
 
@@ -153,13 +168,17 @@ HRESULT XtermEngine::_UpdateUnderline(const WORD legacyColorAttribute) noexcept
 }
 
 // Routine Description:
-// - Write a VT sequence to change the current colors of text. Only writes
-//      16-color attributes.
+// - Changes the colors of the text painted from here on.
+//   With the shadow buffer enabled, the brushes are only written once a cell
+//      that uses them actually needs painting. The renderer sets the brushes
+//      for every run it repaints, and most of those runs usually end up
+//      unchanged.
 // Arguments:
 // - colorForeground: The RGB Color to use to paint the foreground text.
 // - colorBackground: The RGB Color to use to paint the background of the text.
 // - legacyColorAttribute: A console attributes bit field specifying the brush
 //      colors we should use.
+// - isBold: whether the text should be bold.
 // - isSettingDefaultBrushes: indicates if we should change the background color of
 //      the window. Unused for VT
 // Return Value:
@@ -170,6 +189,53 @@ HRESULT XtermEngine::UpdateDrawingBrushes(const COLORREF colorForeground,
                                           const WORD legacyColorAttribute,
                                           const bool isBold,
                                           const bool /*isSettingDefaultBrushes*/) noexcept
+{
+    if (_shadowBufferEnabled)
+    {
+        _pendingBrushes = Brushes{ colorForeground, colorBackground, legacyColorAttribute, isBold };
+        return S_OK;
+    }
+
+    return _SetDrawingBrushes(colorForeground, colorBackground, legacyColorAttribute, isBold);
+}
+
+// Routine Description:
+// - Writes the brushes UpdateDrawingBrushes held on to, if there are any.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]]
+HRESULT XtermEngine::_FlushPendingBrushes() noexcept
+{
+    if (_pendingBrushes.has_value())
+    {
+        const auto brushes = _pendingBrushes.value();
+        RETURN_IF_FAILED(_SetDrawingBrushes(brushes.colorForeground,
+                                            brushes.colorBackground,
+                                            brushes.legacyColorAttribute,
+                                            brushes.isBold));
+        _pendingBrushes.reset();
+    }
+    return S_OK;
+}
+
+// Routine Description:
+// - Write a VT sequence to change the current colors of text. Only writes
+//      16-color attributes.
+// Arguments:
+// - colorForeground: The RGB Color to use to paint the foreground text.
+// - colorBackground: The RGB Color to use to paint the background of the text.
+// - legacyColorAttribute: A console attributes bit field specifying the brush
+//      colors we should use.
+// - isBold: whether the text should be bold.
+// Return Value:
+// - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]]
+HRESULT XtermEngine::_SetDrawingBrushes(const COLORREF colorForeground,
+                                        const COLORREF colorBackground,
+                                        const WORD legacyColorAttribute,
+                                        const bool isBold) noexcept
 {
     //When we update the brushes, check the wAttrs to see if the LVB_UNDERSCORE
     //      flag is there. If the state of that flag is different then our
@@ -186,11 +252,10 @@ HRESULT XtermEngine::UpdateDrawingBrushes(const COLORREF colorForeground,
 // Routine Description:
 // - Write a VT sequence to move the cursor to the specified coordinates. We
 //      also store the last place we left the cursor for future optimizations.
-//  If the cursor only needs to go to the origin, only write the home sequence.
-//  If the new cursor is only down one line from the current, only write a newline
-//  If the new cursor is only down one line and at the start of the line, write
-//      a carriage return.
-//  Otherwise just write the whole sequence for moving it.
+//  If the new cursor is down one line and at the start of the line, and the
+//      previous line wrapped, the cursor is already there.
+//  Otherwise write whichever sequence gets the cursor there in the fewest
+//      bytes. See _WriteCheapestMove.
 // Arguments:
 // - coord: location to move the cursor to.
 // Return Value:
@@ -202,68 +267,226 @@ HRESULT XtermEngine::_MoveCursor(COORD const coord) noexcept
 
     if (coord.X != _lastText.X || coord.Y != _lastText.Y)
     {
-        if (coord.X == 0 && coord.Y == 0)
+        if (coord.X == 0 && coord.Y == (_lastText.Y+1) && _previousLineWrapped)
         {
-            _needToDisableCursor = true;
-            hr = _CursorHome();
+            // If the previous line wrapped, then the cursor is already at this
+            //      position, we just don't know it yet. Don't emit anything.
+            hr = S_OK;
         }
-        else if (coord.X == 0 && coord.Y == (_lastText.Y+1))
+        else
         {
-            // Down one line, at the start of the line.
+            hr = _WriteCheapestMove(coord);
+        }
 
-            // If the previous line wrapped, then the cursor is already at this
-            //      position, we just don't know it yet. Don't emit anything.
-            if (_previousLineWrapped)
+        if (SUCCEEDED(hr))
+        {
+            _lastText = coord;
+        }
+    }
+    if (_lastText.Y != _lastViewport.ToOrigin().BottomInclusive())
+    {
+        _newBottomLine = false;
+    }
+    _deferredCursorPos = INVALID_COORDS;
+    return hr;
+}
+
+// Routine Description:
+// - Writes the shortest sequence that moves the cursor from _lastText to
+//      coord, as a single write. The candidates are a CUP, or a vertical move
+//      (LFs, CUD, CUU or VPA) followed by a horizontal one (CR, BSs, CUB, CUF
+//      or CHA). Bytes on the wire matter when conpty's output
+//      goes over a network.
+//  Relative moves are only used when we know where the terminal's cursor is:
+//      not before the first move, and not after text ran up to the right edge,
+//      where the terminal holds the cursor in the last column until the next
+//      character is printed. When two moves are the same length, the absolute
+//      one wins, since it doesn't depend on our idea of the cursor position.
+//  Any move that jumps rows with a sequence means the cursor needs to be
+//      hidden during the frame, same as a CUP.
+// Arguments:
+// - coord: location to move the cursor to.
+// Return Value:
+// - S_OK if we succeeded, else an appropriate HRESULT for failing to write.
+[[nodiscard]]
+HRESULT XtermEngine::_WriteCheapestMove(const COORD coord) noexcept
+{
+    enum class VerticalMove { None, LineFeed, Down, Up, Absolute };
+    enum class HorizontalMove { None, CarriageReturn, Backspace, Back, Forward, Absolute };
+
+    // A control char repeated n times only beats a sequence for a few cells,
+    //      so never compose more than this many of them.
+    const int maxRepeatedControls = 3;
+
+    const auto digitCount = [](int n) noexcept -> size_t {
+        size_t cch = 1;
+        for (; n >= 10; n /= 10)
+        {
+            cch++;
+        }
+        return cch;
+    };
+
+    // The length of a CSI with one parameter, which is left out when it's the
+    //      default of 1.
+    const auto csiLength = [&](const int n) noexcept -> size_t {
+        return n == 1 ? 3 : 3 + digitCount(n);
+    };
+
+    const auto view = _lastViewport.ToOrigin();
+    const bool rowKnown = _lastText.Y >= 0 && _lastText.Y <= view.BottomInclusive();
+    const bool columnKnown = _lastText.X >= 0 && _lastText.X <= view.RightInclusive();
+
+    const int dy = coord.Y - _lastText.Y;
+    const int dx = coord.X - _lastText.X;
+
+    // Start with the CUP. The home sequence leaves out both parameters.
+    const bool isHome = coord.X == 0 && coord.Y == 0;
+    size_t bestLength = isHome ? 3 : 4 + digitCount(coord.Y + 1) + digitCount(coord.X + 1);
+    bool useCup = true;
+    VerticalMove bestVertical = VerticalMove::None;
+    HorizontalMove bestHorizontal = HorizontalMove::None;
+
+    const auto consider = [&](const VerticalMove vertical, const size_t verticalLength) noexcept {
+        const auto considerHorizontal = [&](const HorizontalMove horizontal, const size_t horizontalLength) noexcept {
+            if (verticalLength + horizontalLength < bestLength)
             {
-                hr = S_OK;
+                bestLength = verticalLength + horizontalLength;
+                useCup = false;
+                bestVertical = vertical;
+                bestHorizontal = horizontal;
+            }
+        };
+
+        // Absolute moves first, so that they win ties.
+        if (coord.X == 0)
+        {
+            considerHorizontal(HorizontalMove::CarriageReturn, 1);
+        }
+        else
+        {
+            considerHorizontal(HorizontalMove::Absolute, csiLength(coord.X + 1));
+        }
+
+        if (columnKnown)
+        {
+            if (dx == 0)
+            {
+                considerHorizontal(HorizontalMove::None, 0);
+            }
+            else if (dx > 0)
+            {
+                considerHorizontal(HorizontalMove::Forward, csiLength(dx));
             }
             else
             {
-                std::string seq = "\r\n";
-                hr = _Write(seq);
+                considerHorizontal(HorizontalMove::Back, csiLength(-dx));
+                if (-dx <= maxRepeatedControls)
+                {
+                    considerHorizontal(HorizontalMove::Backspace, -dx);
+                }
             }
         }
-        else if (coord.X == 0 && coord.Y == _lastText.Y)
+    };
+
+    consider(VerticalMove::Absolute, csiLength(coord.Y + 1));
+    if (rowKnown)
+    {
+        if (dy == 0)
         {
-            // Start of this line
-            std::string seq = "\r";
-            hr = _Write(seq);
+            consider(VerticalMove::None, 0);
         }
-        else if (coord.X == _lastText.X && coord.Y == (_lastText.Y+1))
+        else if (dy > 0)
         {
-            // Down one line, same X position
-            std::string seq = "\n";
-            hr = _Write(seq);
+            consider(VerticalMove::Down, csiLength(dy));
+            if (dy <= maxRepeatedControls)
+            {
+                consider(VerticalMove::LineFeed, dy);
+            }
         }
-        else if (coord.X == (_lastText.X-1) && coord.Y == (_lastText.Y))
+        else
         {
-            // Back one char, same Y position
-            std::string seq = "\b";
-            hr = _Write(seq);
+            consider(VerticalMove::Up, csiLength(-dy));
         }
-        else if (coord.Y == _lastText.Y && coord.X > _lastText.X)
+    }
+
+    // At most a CR or a few control chars, and two CSIs.
+    char sequence[1 + 2 * MAX_CSI_LENGTH];
+    char* pch = sequence;
+
+    // Formats a CSI with one parameter, leaving it out when it's the default.
+    const auto formatCsi = [&](const int n, const char finalChar) noexcept {
+        pch = (n == 1) ?
+              _FormatCsi(pch, {}, finalChar) :
+              _FormatCsi(pch, { &n, 1 }, finalChar);
+    };
+
+    if (useCup)
+    {
+        if (isHome)
         {
-            // Same line, forward some distance
-            short distance = coord.X - _lastText.X;
-            hr = _CursorForward(distance);
+            pch = _FormatCsi(pch, {}, 'H');
         }
         else
+        {
+            const int parameters[] = { coord.Y + 1, coord.X + 1 };
+            pch = _FormatCsi(pch, parameters, 'H');
+        }
+        _needToDisableCursor = true;
+    }
+    else
+    {
+        // A CR goes in front, so that a move to the start of the next line
+        //      still reads as the familiar \r\n. None of the vertical moves
+        //      change the column.
+        if (bestHorizontal == HorizontalMove::CarriageReturn)
+        {
+            *pch++ = '\r';
+        }
+
+        switch (bestVertical)
+        {
+        case VerticalMove::LineFeed:
+            pch = std::fill_n(pch, dy, '\n');
+            break;
+        case VerticalMove::Down:
+            formatCsi(dy, 'B');
+            break;
+        case VerticalMove::Up:
+            formatCsi(-dy, 'A');
+            break;
+        case VerticalMove::Absolute:
+            formatCsi(coord.Y + 1, 'd');
+            break;
+        default:
+            break;
+        }
+
+        if (bestVertical != VerticalMove::None && bestVertical != VerticalMove::LineFeed)
         {
             _needToDisableCursor = true;
-            hr = _CursorPosition(coord);
         }
 
-        if (SUCCEEDED(hr))
+        switch (bestHorizontal)
         {
-            _lastText = coord;
+        case HorizontalMove::Backspace:
+            pch = std::fill_n(pch, -dx, '\b');
+            break;
+        case HorizontalMove::Back:
+            formatCsi(-dx, 'D');
+            break;
+        case HorizontalMove::Forward:
+            formatCsi(dx, 'C');
+            break;
+        case HorizontalMove::Absolute:
+            formatCsi(coord.X + 1, 'G');
+            break;
+        default:
+            break;
         }
     }
-    if (_lastText.Y != _lastViewport.ToOrigin().BottomInclusive())
-    {
-        _newBottomLine = false;
-    }
-    _deferredCursorPos = INVALID_COORDS;
-    return hr;
+
+    return _Write({ sequence, gsl::narrow_cast<size_t>(pch - sequence) });
 }
 
 // Routine Description:
@@ -273,6 +496,9 @@ HRESULT XtermEngine::_MoveCursor(COORD const coord) noexcept
 //  Move the cursor to the origin, and insert or delete rows as appropriate.
 //      The inserted rows will be blank, but marked invalid by InvalidateScroll,
 //      so they will later be written by PaintBufferLine.
+//  Then scroll the rows inside the host's scroll margins, if they moved. That
+//      happened after the whole frame scrolled, or the scroll inside the
+//      margins would've been abandoned.
 // Arguments:
 // - <none>
 // Return Value:
@@ -280,6 +506,8 @@ HRESULT XtermEngine::_MoveCursor(COORD const coord) noexcept
 [[nodiscard]]
 HRESULT XtermEngine::ScrollFrame() noexcept
 {
+    const auto regionScroll = std::exchange(_pendingRegionScroll, std::nullopt);
+
     if (_scrollDelta.X != 0)
     {
         // No easy way to shift left-right. Everything needs repainting.
@@ -287,13 +515,17 @@ HRESULT XtermEngine::ScrollFrame() noexcept
     }
     if (_scrollDelta.Y == 0)
     {
-        // There's nothing to do here. Do nothing.
-        return S_OK;
+        // Only the rows inside the margins might have moved.
+        return regionScroll.has_value() ? _ScrollRegion(regionScroll.value()) : S_OK;
     }
 
     const short dy = _scrollDelta.Y;
     const short absDy = static_cast<short>(abs(dy));
 
+    // The rows scrolled in are blank in the current background color, so
+    //      make sure that's the one the frame started with.
+    RETURN_IF_FAILED(_FlushPendingBrushes());
+
     HRESULT hr = S_OK;
     if (dy < 0)
     {
@@ -325,9 +557,84 @@ HRESULT XtermEngine::ScrollFrame() noexcept
         }
     }
 
+    if (SUCCEEDED(hr) && _shadowBufferEnabled)
+    {
+        _ScrollShadowBuffer(0, _lastViewport.ToOrigin().BottomInclusive(), dy);
+    }
+
+    if (SUCCEEDED(hr) && regionScroll.has_value())
+    {
+        hr = _ScrollRegion(regionScroll.value());
+    }
+
     return hr;
 }
 
+// Routine Description:
+// - Writes a scroll of the rows inside the host's scroll margins.
+//  If they reach the bottom of the screen, inserting or deleting lines at the
+//      top of them does that without any margins. Otherwise set the margins
+//      (DECSTBM), scroll them (SU/SD) and clear them again, so that everything
+//      else we write, like the LFs _WriteCheapestMove might use, still acts on
+//      the whole screen.
+//  Either way the rows scrolled in are blank, and were already marked invalid
+//      by InvalidateScrollRegion.
+// Arguments:
+// - scroll: the rows that scrolled and how far.
+// Return Value:
+// - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]]
+HRESULT XtermEngine::_ScrollRegion(const RegionScroll scroll) noexcept
+{
+    if (_clearedAllThisFrame)
+    {
+        // Everything gets painted again anyways.
+        return S_OK;
+    }
+
+    const SHORT bottom = _lastViewport.ToOrigin().BottomInclusive();
+    if (scroll.bottom > bottom)
+    {
+        // The viewport shrank since the rows scrolled.
+        return InvalidateAll();
+    }
+
+    // The rows scrolled in are blank in the current background color, so
+    //      make sure that's the one the frame started with.
+    RETURN_IF_FAILED(_FlushPendingBrushes());
+
+    const short absDy = static_cast<short>(abs(scroll.dy));
+    if (scroll.bottom == bottom)
+    {
+        RETURN_IF_FAILED(_MoveCursor({ 0, scroll.top }));
+        RETURN_IF_FAILED(_InsertDeleteLine(absDy, scroll.dy > 0));
+    }
+    else
+    {
+        RETURN_IF_FAILED(_SetScrollingRegion(scroll.top, scroll.bottom));
+        RETURN_IF_FAILED(_ScrollUpDown(absDy, scroll.dy < 0));
+        RETURN_IF_FAILED(_ResetScrollingRegion());
+
+        // Setting the margins moved the cursor to the origin. Keep track of
+        //      that the way _MoveCursor does for a CUP home, which also means
+        //      the cursor has to be hidden for the rest of the frame.
+        _lastText = { 0, 0 };
+        _previousLineWrapped = false;
+        _needToDisableCursor = true;
+        if (_lastText.Y != bottom)
+        {
+            _newBottomLine = false;
+        }
+    }
+
+    if (_shadowBufferEnabled)
+    {
+        _ScrollShadowBuffer(scroll.top, scroll.bottom, scroll.dy);
+    }
+
+    return S_OK;
+}
+
 // Routine Description:
 // - Notifies us that the console is attempting to scroll the existing screen
 //      area. Add the top or bottom rows to the invalid region, and update the
@@ -345,6 +652,10 @@ HRESULT XtermEngine::InvalidateScroll(const COORD* const pcoordDelta) noexcept
 
     if (dx != 0 || dy != 0)
     {
+        // A scroll inside the margins that we haven't written yet would now
+        //      have to be written before this one. Just repaint those rows.
+        RETURN_IF_FAILED(_AbandonRegionScroll());
+
         // Scroll the current offset
         RETURN_IF_FAILED(_InvalidOffset(pcoordDelta));
 
@@ -373,6 +684,107 @@ HRESULT XtermEngine::InvalidateScroll(const COORD* const pcoordDelta) noexcept
     return S_OK;
 }
 
+// Routine Description:
+// - Notifies us that the rows of a region of the frame moved up or down
+//      within it, like when an application scrolls inside the margins it set.
+//      Move what was already invalid in the region along with it, add the rows
+//      that were uncovered to the invalid area, and remember the scroll for
+//      ScrollFrame. See _ScrollRegion.
+//  Only one region can be scrolled a frame. If a different one scrolls, the
+//      first is repainted instead.
+// Arguments:
+// - psrRegion - The rows that scrolled. Exclusive rect.
+// - pcoordDelta - How far the rows moved within the region.
+// Return Value:
+// - S_OK if we succeeded, else an appropriate HRESULT for safemath failure
+[[nodiscard]]
+HRESULT XtermEngine::InvalidateScrollRegion(const SMALL_RECT* const psrRegion,
+                                            const COORD* const pcoordDelta) noexcept
+{
+    const auto view = _lastViewport.ToOrigin();
+    const SHORT top = psrRegion->Top;
+    const SHORT bottom = gsl::narrow_cast<SHORT>(psrRegion->Bottom - 1);
+    const SHORT dy = pcoordDelta->Y;
+
+    // The terminal can only scroll whole rows, and the rows above the virtual
+    //      top aren't ours to move.
+    if (pcoordDelta->X != 0 ||
+        psrRegion->Left != view.Left() ||
+        psrRegion->Right != view.RightExclusive() ||
+        top < std::max<SHORT>(_virtualTop, 0) ||
+        bottom > view.BottomInclusive() ||
+        top >= bottom)
+    {
+        return Invalidate(psrRegion);
+    }
+
+    if (dy == 0)
+    {
+        return S_OK;
+    }
+
+    if (_pendingRegionScroll.has_value() &&
+        (_pendingRegionScroll->top != top || _pendingRegionScroll->bottom != bottom))
+    {
+        RETURN_IF_FAILED(_AbandonRegionScroll());
+    }
+
+    RegionScroll scroll = _pendingRegionScroll.value_or(RegionScroll{ top, bottom, 0 });
+    RETURN_IF_FAILED(ShortAdd(scroll.dy, dy, &scroll.dy));
+
+    RETURN_IF_FAILED(_InvalidOffsetRows(top, bottom, dy));
+
+    SMALL_RECT uncovered = *psrRegion;
+    if (dy > 0)
+    {
+        uncovered.Bottom = std::min(uncovered.Bottom, static_cast<SHORT>(top + dy));
+    }
+    else
+    {
+        uncovered.Top = std::max(uncovered.Top, static_cast<SHORT>(psrRegion->Bottom + dy));
+    }
+    RETURN_IF_FAILED(_InvalidCombine(Viewport::FromExclusive(uncovered)));
+
+    if (scroll.dy == 0)
+    {
+        _pendingRegionScroll.reset();
+    }
+    else if (abs(scroll.dy) > bottom - top)
+    {
+        // Nothing that was there is left to move.
+        _pendingRegionScroll.reset();
+        RETURN_IF_FAILED(_InvalidCombine(Viewport::FromExclusive(*psrRegion)));
+    }
+    else
+    {
+        _pendingRegionScroll = scroll;
+    }
+
+    return S_OK;
+}
+
+// Method Description:
+// - Gives up on writing the pending scroll inside the margins, and marks the
+//      rows it covered invalid instead, so they're painted in full.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK, else an appropriate HRESULT for failing to combine the invalid area.
+[[nodiscard]]
+HRESULT XtermEngine::_AbandonRegionScroll() noexcept
+{
+    if (_pendingRegionScroll.has_value())
+    {
+        const auto scroll = _pendingRegionScroll.value();
+        _pendingRegionScroll.reset();
+
+        const SMALL_RECT rows{ 0, scroll.top, _lastViewport.Width(), static_cast<SHORT>(scroll.bottom + 1) };
+        RETURN_IF_FAILED(_InvalidCombine(Viewport::FromExclusive(rows)));
+    }
+
+    return S_OK;
+}
+
 // Routine Description:
 // - Draws one line of the buffer to the screen. Writes the characters to the
 //      pipe, encoded in UTF-8 or ASCII only, depending on the VtIoMode.
@@ -389,15 +801,381 @@ HRESULT XtermEngine::InvalidateScroll(const COORD* const pcoordDelta) noexcept
 HRESULT XtermEngine::PaintBufferLine(std::basic_string_view<Cluster> const clusters,
                                      const COORD coord,
                                      const bool /*trimLeft*/) noexcept
+{
+    return _shadowBufferEnabled ?
+        _PaintChangedCells(clusters, coord) :
+        _PaintLine(clusters, coord);
+}
+
+// Routine Description:
+// - Writes the clusters to the pipe, encoded in UTF-8 or ASCII only,
+//      depending on the VtIoMode.
+// Arguments:
+// - clusters - text and column counts for each piece of text.
+// - coord - character coordinate target to render within viewport
+// Return Value:
+// - S_OK or suitable HRESULT error from writing pipe.
+[[nodiscard]]
+HRESULT XtermEngine::_PaintLine(std::basic_string_view<Cluster> const clusters,
+                                const COORD coord) noexcept
 {
     return _fUseAsciiOnly ?
         VtEngine::_PaintAsciiBufferLine(clusters, coord) :
         VtEngine::_PaintUtf8BufferLine(clusters, coord);
 }
 
+// Routine Description:
+// - Writes only the clusters that the terminal doesn't already show, going by
+//      the shadow buffer, and records what it wrote there.
+//   Changed clusters are written in runs. A few unchanged cells between two
+//      changed ones are written again along with them, since that's as cheap
+//      as moving the cursor over them. See MAX_SHADOW_GAP.
+// Arguments:
+// - clusters - text and column counts for each piece of text.
+// - coord - character coordinate target to render within viewport
+// Return Value:
+// - S_OK or suitable HRESULT error from writing pipe.
+[[nodiscard]]
+HRESULT XtermEngine::_PaintChangedCells(std::basic_string_view<Cluster> const clusters,
+                                        const COORD coord) noexcept
+{
+    // Rows above the virtual top and rows outside the viewport have nothing to
+    //      compare against. Paint them the usual way, and don't trust whatever
+    //      we knew about the row any longer.
+    if (coord.Y < _virtualTop || coord.Y >= _lastViewport.Height() || coord.X < 0)
+    {
+        RETURN_IF_FAILED(_FlushPendingBrushes());
+        RETURN_IF_FAILED(_PaintLine(clusters, coord));
+        _ForgetShadowCells(coord, _shadowWidth);
+        return S_OK;
+    }
+
+    const auto columnsOf = [](const Cluster& cluster) noexcept {
+        return gsl::narrow_cast<SHORT>(cluster.GetColumns());
+    };
+
+    size_t i = 0;
+    SHORT x = coord.X;
+    while (i < clusters.size())
+    {
+        if (_ShadowMatches(clusters.at(i), { x, coord.Y }))
+        {
+            x += columnsOf(clusters.at(i));
+            i++;
+            continue;
+        }
+
+        // Find the end of this run of changes: the last changed cluster that
+        //      isn't more than MAX_SHADOW_GAP unchanged columns from the one
+        //      before it.
+        const size_t first = i;
+        const SHORT firstX = x;
+        x += columnsOf(clusters.at(i));
+        i++;
+
+        size_t end = i;
+        SHORT endX = x;
+        SHORT gap = 0;
+        while (i < clusters.size() && gap <= MAX_SHADOW_GAP)
+        {
+            const bool matches = _ShadowMatches(clusters.at(i), { x, coord.Y });
+            x += columnsOf(clusters.at(i));
+            i++;
+            if (matches)
+            {
+                gap += columnsOf(clusters.at(i - 1));
+            }
+            else
+            {
+                end = i;
+                endX = x;
+                gap = 0;
+            }
+        }
+
+        const auto run = clusters.substr(first, end - first);
+        const COORD runCoord{ firstX, coord.Y };
+
+        // Trailing spaces aren't written to a line that was just cleared or
+        //      scrolled in, see _PaintUtf8BufferLine. The terminal shows blanks
+        //      there, but in the color it cleared them with, not ours.
+        const bool skipsTrailingSpaces = !_fUseAsciiOnly && (_clearedAllThisFrame || _newBottomLine);
+
+        RETURN_IF_FAILED(_FlushPendingBrushes());
+        RETURN_IF_FAILED(_PaintLine(run, runCoord));
+        _RecordShadowCells(run, runCoord);
+
+        if (skipsTrailingSpaces)
+        {
+            SHORT cTrailingSpaces = 0;
+            for (auto it = run.crbegin(); it != run.crend() && it->GetText() == L" "; ++it)
+            {
+                cTrailingSpaces += columnsOf(*it);
+            }
+            _ForgetShadowCells({ endX - cTrailingSpaces, coord.Y }, cTrailingSpaces);
+        }
+
+        i = end;
+        x = endX;
+    }
+
+    return S_OK;
+}
+
+// Method Description:
+// - Turns the shadow buffer on or off. While it's on, the engine keeps a copy
+//      of what the terminal shows in the viewport, and only writes the cells
+//      that are different from what it's asked to paint. That saves most of
+//      the output when the console invalidates much more than changed, for
+//      example when it repaints everything after a scroll.
+// Arguments:
+// - enabled: whether the shadow buffer should be used.
+// Return Value:
+// - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]]
+HRESULT XtermEngine::SetShadowBufferEnabled(const bool enabled) noexcept
+{
+    if (enabled == _shadowBufferEnabled)
+    {
+        return S_OK;
+    }
+
+    if (enabled)
+    {
+        _shadowBufferEnabled = true;
+        return _ResetShadowBuffer();
+    }
+
+    // Don't lose brushes the next line will be painted with.
+    RETURN_IF_FAILED(_FlushPendingBrushes());
+    _shadowBufferEnabled = false;
+    _shadowBuffer = std::vector<ShadowCell>();
+    _shadowWidth = 0;
+    return S_OK;
+}
+
+// Method Description:
+// - Sizes the shadow buffer to the viewport, and forgets everything in it. No
+//      cell will match until it's painted again.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK, or E_OUTOFMEMORY if the buffer couldn't be allocated.
+[[nodiscard]]
+HRESULT XtermEngine::_ResetShadowBuffer() noexcept
+{
+    try
+    {
+        const SHORT width = _lastViewport.Width();
+        const SHORT height = _lastViewport.Height();
+        _shadowBuffer.assign(gsl::narrow_cast<size_t>(width) * height, ShadowCell{});
+        _shadowWidth = width;
+    }
+    CATCH_RETURN();
+
+    return S_OK;
+}
+
+// Method Description:
+// - Moves the rows of the shadow buffer the same way ScrollFrame just moved
+//      the terminal's. The rows that scrolled in are blank, but we don't know
+//      in which color, so they don't match anything.
+// Arguments:
+// - top: the first row that moved.
+// - bottom: the last row that moved. Rows past the shadow buffer are ignored.
+// - dy: the number of rows the contents moved down. Negative if they moved up.
+// Return Value:
+// - <none>
+void XtermEngine::_ScrollShadowBuffer(const SHORT top, const SHORT bottom, const SHORT dy) noexcept
+{
+    const size_t width = _shadowWidth;
+    const size_t height = width > 0 ? _shadowBuffer.size() / width : 0;
+    const size_t first = static_cast<size_t>(std::max<SHORT>(top, 0));
+    const size_t last = std::min(static_cast<size_t>(std::max<SHORT>(bottom, -1) + 1), height);
+    if (first >= last)
+    {
+        return;
+    }
+
+    const auto begin = _shadowBuffer.begin() + first * width;
+    const auto end = _shadowBuffer.begin() + last * width;
+    const size_t absDy = static_cast<size_t>(abs(dy));
+
+    if (absDy >= last - first)
+    {
+        std::fill(begin, end, ShadowCell{});
+    }
+    else if (dy < 0)
+    {
+        const auto scrolledIn = std::move(begin + absDy * width, end, begin);
+        std::fill(scrolledIn, end, ShadowCell{});
+    }
+    else if (dy > 0)
+    {
+        const auto scrolledIn = std::move_backward(begin, end - absDy * width, end);
+        std::fill(begin, scrolledIn, ShadowCell{});
+    }
+}
+
+// Method Description:
+// - Gets the shadow cell that painting this cluster with the current brushes
+//      would leave behind in its first column. Only clusters of a single
+//      code unit are tracked, anything longer is never known.
+// Arguments:
+// - cluster: the text and width to be painted.
+// Return Value:
+// - The cell the cluster would leave behind.
+XtermEngine::ShadowCell XtermEngine::_ShadowCellFor(const Cluster& cluster) const noexcept
+{
+    ShadowCell cell{};
+    const auto& text = cluster.GetText();
+    cell.isKnown = text.size() == 1;
+    cell.wch = cell.isKnown ? text.front() : UNICODE_NULL;
+    cell.columns = gsl::narrow_cast<BYTE>(cluster.GetColumns());
+
+    if (_pendingBrushes.has_value())
+    {
+        const auto& brushes = _pendingBrushes.value();
+        cell.isBold = brushes.isBold;
+        cell.isUnderlined = WI_IsFlagSet(brushes.legacyColorAttribute, COMMON_LVB_UNDERSCORE);
+        cell.colorForeground = brushes.colorForeground;
+        cell.colorBackground = brushes.colorBackground;
+    }
+    else
+    {
+        cell.isBold = _lastWasBold;
+        cell.isUnderlined = _usingUnderLine;
+        cell.colorForeground = _LastFG;
+        cell.colorBackground = _LastBG;
+    }
+    return cell;
+}
+
+// Method Description:
+// - Returns true if the terminal already shows this cluster, in the current
+//      brushes, at this position.
+//   The second column of a wide glyph only matches as part of the glyph. If
+//      half of it has been painted over since, it won't match any longer.
+// Arguments:
+// - cluster: the text and width to be painted.
+// - coord: the position it would be painted at.
+// Return Value:
+// - true if painting the cluster wouldn't change anything.
+bool XtermEngine::_ShadowMatches(const Cluster& cluster, const COORD coord) const noexcept
+{
+    const SHORT columns = gsl::narrow_cast<SHORT>(cluster.GetColumns());
+    if (columns <= 0 || coord.X < 0 || coord.X + columns > _shadowWidth || coord.Y < 0)
+    {
+        return false;
+    }
+
+    const size_t index = gsl::narrow_cast<size_t>(coord.Y) * _shadowWidth + coord.X;
+    if (index + columns > _shadowBuffer.size())
+    {
+        return false;
+    }
+
+    const auto expected = _ShadowCellFor(cluster);
+    if (!expected.isKnown)
+    {
+        return false;
+    }
+
+    for (SHORT column = 0; column < columns; column++)
+    {
+        const auto& cell = _shadowBuffer[index + column];
+        if (!cell.isKnown ||
+            cell.wch != expected.wch ||
+            cell.columns != (column == 0 ? expected.columns : 0) ||
+            cell.isBold != expected.isBold ||
+            cell.isUnderlined != expected.isUnderlined ||
+            cell.colorForeground != expected.colorForeground ||
+            cell.colorBackground != expected.colorBackground)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Method Description:
+// - Records in the shadow buffer that the terminal now shows these clusters,
+//      in the current brushes, starting at this position.
+// Arguments:
+// - clusters: the text and widths that were painted.
+// - coord: the position they were painted at.
+// Return Value:
+// - <none>
+void XtermEngine::_RecordShadowCells(std::basic_string_view<Cluster> const clusters,
+                                     const COORD coord) noexcept
+{
+    if (coord.Y < 0 || coord.X < 0)
+    {
+        return;
+    }
+
+    const size_t rowIndex = gsl::narrow_cast<size_t>(coord.Y) * _shadowWidth;
+    SHORT x = coord.X;
+    for (const auto& cluster : clusters)
+    {
+        auto cell = _ShadowCellFor(cluster);
+        const SHORT columns = gsl::narrow_cast<SHORT>(cluster.GetColumns());
+        for (SHORT column = 0; column < columns && x < _shadowWidth; column++, x++)
+        {
+            if (rowIndex + x < _shadowBuffer.size())
+            {
+                _shadowBuffer[rowIndex + x] = cell;
+            }
+            cell.columns = 0;
+        }
+    }
+}
+
+// Method Description:
+// - Forgets what the terminal shows in this part of a row.
+// Arguments:
+// - coord: the first cell to forget.
+// - cCells: how many cells to forget.
+// Return Value:
+// - <none>
+void XtermEngine::_ForgetShadowCells(const COORD coord, const SHORT cCells) noexcept
+{
+    if (coord.Y < 0 || coord.Y >= _lastViewport.Height() || _shadowWidth == 0)
+    {
+        return;
+    }
+
+    const SHORT left = std::max<SHORT>(coord.X, 0);
+    const SHORT right = std::min<SHORT>(gsl::narrow_cast<SHORT>(coord.X + cCells), _shadowWidth);
+    const size_t rowIndex = gsl::narrow_cast<size_t>(coord.Y) * _shadowWidth;
+    for (SHORT x = left; x < right && rowIndex + x < _shadowBuffer.size(); x++)
+    {
+        _shadowBuffer[rowIndex + x] = ShadowCell{};
+    }
+}
+
+// Method Description:
+// - Wrapper for ITerminalOutputConnection. Writes the string to the pipe
+//      as is. We can't tell what it does to the terminal's contents, so
+//      forget everything in the shadow buffer.
+// Arguments:
+// - str - string of text to be written
+// Return Value:
+// - S_OK or suitable HRESULT error from writing pipe.
+[[nodiscard]]
+HRESULT XtermEngine::WriteTerminalUtf8(const std::string& str) noexcept
+{
+    if (_shadowBufferEnabled)
+    {
+        RETURN_IF_FAILED(_ResetShadowBuffer());
+    }
+    return VtEngine::WriteTerminalUtf8(str);
+}
+
 // Method Description:
 // - Wrapper for ITerminalOutputConnection. Write either an ascii-only, or a
-//      proper utf-8 string, depending on our mode.
+//      proper utf-8 string, depending on our mode. Like WriteTerminalUtf8,
+//      this forgets everything in the shadow buffer.
 // Arguments:
 // - wstr - wstring of text to be written
 // Return Value:
@@ -405,6 +1183,10 @@ HRESULT XtermEngine::PaintBufferLine(std::basic_string_view<Cluster> const clust
 [[nodiscard]]
 HRESULT XtermEngine::WriteTerminalW(const std::wstring& wstr) noexcept
 {
+    if (_shadowBufferEnabled)
+    {
+        RETURN_IF_FAILED(_ResetShadowBuffer());
+    }
     return _fUseAsciiOnly ?
         VtEngine::_WriteTerminalAscii(wstr) :
         VtEngine::_WriteTerminalUtf8(wstr);
@@ -21,6 +21,7 @@ Author(s):
 #pragma once
 
 #include "vtrenderer.hpp"
+#include <optional>
 
 namespace Microsoft::Console::Render
 {
@@ -42,11 +43,11 @@ namespace Microsoft::Console::Render
         HRESULT EndPaint() noexcept override;
 
         [[nodiscard]]
-        virtual HRESULT UpdateDrawingBrushes(const COLORREF colorForeground,
-                                            const COLORREF colorBackground,
-                                            const WORD legacyColorAttribute,
-                                            const bool isBold,
-                                            const bool isSettingDefaultBrushes) noexcept override;
+        HRESULT UpdateDrawingBrushes(const COLORREF colorForeground,
+                                     const COLORREF colorBackground,
+                                     const WORD legacyColorAttribute,
+                                     const bool isBold,
+                                     const bool isSettingDefaultBrushes) noexcept override;
         [[nodiscard]]
         HRESULT PaintBufferLine(std::basic_string_view<Cluster> const clusters,
                                 const COORD coord,
@@ -56,11 +57,54 @@ namespace Microsoft::Console::Render
 
         [[nodiscard]]
         HRESULT InvalidateScroll(const COORD* const pcoordDelta) noexcept override;
+        [[nodiscard]]
+        HRESULT InvalidateScrollRegion(const SMALL_RECT* const psrRegion, const COORD* const pcoordDelta) noexcept override;
 
+        [[nodiscard]]
+        HRESULT WriteTerminalUtf8(const std::string& str) noexcept override;
         [[nodiscard]]
         HRESULT WriteTerminalW(_In_ const std::wstring& str) noexcept override;
 
+        [[nodiscard]]
+        HRESULT SetShadowBufferEnabled(const bool enabled) noexcept;
+
+        // A run of unchanged cells no longer than this, between two changed
+        //      ones, is written again rather than moved over. Rewriting it
+        //      costs no more than the cursor move would.
+        static const SHORT MAX_SHADOW_GAP = 3;
+
     protected:
+        // What one cell of the terminal shows, as of the frames we've written.
+        //      The second cell of a wide glyph has no columns of its own.
+        struct ShadowCell
+        {
+            bool isKnown;
+            wchar_t wch;
+            BYTE columns;
+            bool isBold;
+            bool isUnderlined;
+            COLORREF colorForeground;
+            COLORREF colorBackground;
+        };
+
+        // The arguments of the last UpdateDrawingBrushes that haven't been
+        //      written yet.
+        struct Brushes
+        {
+            COLORREF colorForeground;
+            COLORREF colorBackground;
+            WORD legacyColorAttribute;
+            bool isBold;
+        };
+
+        // The rows between top and bottom (inclusive) moved by dy within them.
+        struct RegionScroll
+        {
+            SHORT top;
+            SHORT bottom;
+            SHORT dy;
+        };
+
         const COLORREF* const _ColorTable;
         const WORD _cColorTable;
         const bool _fUseAsciiOnly;
@@ -68,11 +112,52 @@ namespace Microsoft::Console::Render
         bool _usingUnderLine;
         bool _needToDisableCursor;
 
+        // When enabled, a copy of the viewport as the terminal shows it. Cells
+        //      that already show what we're asked to paint aren't written again.
+        bool _shadowBufferEnabled;
+        std::vector<ShadowCell> _shadowBuffer;
+        SHORT _shadowWidth;
+        std::optional<Brushes> _pendingBrushes;
+
+        // A scroll inside the host's scroll margins, waiting for ScrollFrame.
+        //      Only one region is tracked a frame, a second one gets repainted.
+        std::optional<RegionScroll> _pendingRegionScroll;
+
         [[nodiscard]]
         HRESULT _MoveCursor(const COORD coord) noexcept override;
+        [[nodiscard]]
+        HRESULT _WriteCheapestMove(const COORD coord) noexcept;
 
         [[nodiscard]]
         HRESULT _UpdateUnderline(const WORD wLegacyAttrs) noexcept;
+        [[nodiscard]]
+        virtual HRESULT _SetDrawingBrushes(const COLORREF colorForeground,
+                                           const COLORREF colorBackground,
+                                           const WORD legacyColorAttribute,
+                                           const bool isBold) noexcept;
+        [[nodiscard]]
+        HRESULT _FlushPendingBrushes() noexcept;
+
+        [[nodiscard]]
+        HRESULT _ScrollRegion(const RegionScroll scroll) noexcept;
+        [[nodiscard]]
+        HRESULT _AbandonRegionScroll() noexcept;
+
+        [[nodiscard]]
+        HRESULT _PaintLine(std::basic_string_view<Cluster> const clusters,
+                           const COORD coord) noexcept;
+        [[nodiscard]]
+        HRESULT _PaintChangedCells(std::basic_string_view<Cluster> const clusters,
+                                   const COORD coord) noexcept;
+
+        [[nodiscard]]
+        HRESULT _ResetShadowBuffer() noexcept;
+        void _ScrollShadowBuffer(const SHORT top, const SHORT bottom, const SHORT dy) noexcept;
+        ShadowCell _ShadowCellFor(const Cluster& cluster) const noexcept;
+        bool _ShadowMatches(const Cluster& cluster, const COORD coord) const noexcept;
+        void _RecordShadowCells(std::basic_string_view<Cluster> const clusters,
+                                const COORD coord) noexcept;
+        void _ForgetShadowCells(const COORD coord, const SHORT cCells) noexcept;
 
         [[nodiscard]]
         HRESULT _DoUpdateTitle(const std::wstring& newTitle) noexcept override;
@@ -157,6 +157,17 @@ HRESULT VtEngine::_InvalidCombine(const Viewport invalid) noexcept
     // Ensure invalid areas remain within bounds of window.
     RETURN_IF_FAILED(_InvalidRestrict());
 
+    // Also remember exactly which columns of each row changed, so that two
+    //      small regions far apart don't make everything between them dirty.
+    SMALL_RECT rows = invalid.ToExclusive();
+    if (_lastViewport.ToOrigin().TrimToViewport(&rows))
+    {
+        for (auto row = rows.Top; row < rows.Bottom; row++)
+        {
+            _InvalidCombineRow(row, rows.Left, rows.Right);
+        }
+    }
+
     return S_OK;
 }
 
@@ -182,6 +193,109 @@ HRESULT VtEngine::_InvalidOffset(const COORD* const pCoord) noexcept
 
             // Ensure invalid areas remain within bounds of window.
             RETURN_IF_FAILED(_InvalidRestrict());
+
+            // Do the same for each row: it picks up the invalid columns of the
+            //      row that scrolled onto it. Walk against the direction of the
+            //      scroll so every source row is read before it's updated.
+            const SHORT dx = pCoord->X;
+            const SHORT dy = pCoord->Y;
+            const SHORT width = _lastViewport.Width();
+            const SHORT height = gsl::narrow<SHORT>(_invalidRows.size());
+            const auto offsetRow = [&](const SHORT row) noexcept {
+                const int source = row - dy;
+                if (source >= 0 && source < height)
+                {
+                    const auto span = _invalidRows[source];
+                    const auto left = static_cast<SHORT>(std::clamp(span.first + dx, 0, static_cast<int>(width)));
+                    const auto right = static_cast<SHORT>(std::clamp(span.second + dx, 0, static_cast<int>(width)));
+                    if (span.first < span.second && left < right)
+                    {
+                        _InvalidCombineRow(row, left, right);
+                    }
+                }
+            };
+
+            if (dy > 0)
+            {
+                for (SHORT row = height - 1; row >= 0; row--)
+                {
+                    offsetRow(row);
+                }
+            }
+            else
+            {
+                for (SHORT row = 0; row < height; row++)
+                {
+                    offsetRow(row);
+                }
+            }
+        }
+        CATCH_RETURN();
+    }
+
+    return S_OK;
+}
+
+// Routine Description:
+// - Helper to move the invalid region between two rows by the given distance,
+//      such as when the rows inside the scroll margins scroll. Rows outside
+//      of them don't move, and nothing moves past them.
+// Arguments:
+// - top - The first row that scrolled
+// - bottom - The last row that scrolled
+// - dy - How far the rows moved. Negative if they moved up.
+// Return Value:
+// - S_OK, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]]
+HRESULT VtEngine::_InvalidOffsetRows(const SHORT top, const SHORT bottom, const SHORT dy) noexcept
+{
+    if (_fInvalidRectUsed && dy != 0)
+    {
+        try
+        {
+            // Like _InvalidOffset, keep what was invalid and add where it moved to.
+            SMALL_RECT moved = _invalidRect.ToExclusive();
+            const int first = std::max<int>(moved.Top, top);
+            const int last = std::min<int>(moved.Bottom, bottom + 1);
+            if (first < last)
+            {
+                moved.Top = static_cast<SHORT>(std::clamp(first + dy, static_cast<int>(top), bottom + 1));
+                moved.Bottom = static_cast<SHORT>(std::clamp(last + dy, static_cast<int>(top), bottom + 1));
+                if (moved.Top < moved.Bottom)
+                {
+                    _invalidRect = Viewport::Union(_invalidRect, Viewport::FromExclusive(moved));
+                }
+            }
+
+            // Walk against the direction of the scroll so every source row is
+            //      read before it's updated.
+            const auto offsetRow = [&](const SHORT row) noexcept {
+                const int source = row - dy;
+                if (source >= top && source <= bottom &&
+                    static_cast<size_t>(source) < _invalidRows.size())
+                {
+                    const auto span = _invalidRows[source];
+                    if (span.first < span.second)
+                    {
+                        _InvalidCombineRow(row, span.first, span.second);
+                    }
+                }
+            };
+
+            if (dy > 0)
+            {
+                for (SHORT row = bottom; row >= top; row--)
+                {
+                    offsetRow(row);
+                }
+            }
+            else
+            {
+                for (SHORT row = top; row <= bottom; row++)
+                {
+                    offsetRow(row);
+                }
+            }
         }
         CATCH_RETURN();
     }
@@ -206,3 +320,28 @@ HRESULT VtEngine::_InvalidRestrict() noexcept
 
     return S_OK;
 }
+
+// Routine Description:
+// - Helper to add the given columns to the invalid span of a single row.
+// Arguments:
+// - row - The row of the viewport that changed
+// - left - The first column that changed
+// - right - One past the last column that changed
+// Return Value:
+// - <none>
+void VtEngine::_InvalidCombineRow(const SHORT row, const SHORT left, const SHORT right) noexcept
+{
+    if (row >= 0 && static_cast<size_t>(row) < _invalidRows.size())
+    {
+        auto& span = _invalidRows[row];
+        if (span.first < span.second)
+        {
+            span.first = std::min(span.first, left);
+            span.second = std::max(span.second, right);
+        }
+        else
+        {
+            span = { left, right };
+        }
+    }
+}
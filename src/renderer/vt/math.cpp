@@ -27,6 +27,46 @@ SMALL_RECT VtEngine::GetDirtyRectInChars()
     return dirty;
 }
 
+// Routine Description:
+// - Gets the dirty portion of the frame as the set of rectangles that actually
+//      changed, rather than their bounding box. Each row contributes the span
+//      of columns invalidated on it, and rows with identical spans directly
+//      below one another are merged into a single rectangle.
+// Arguments:
+// - <none>
+// Return Value:
+// - A view of Inclusive rectangles, valid until the next call.
+std::basic_string_view<SMALL_RECT> VtEngine::GetDirtyArea()
+{
+    _dirtyArea.clear();
+
+    const SHORT width = _lastViewport.Width();
+    const SHORT height = gsl::narrow<SHORT>(_invalidRows.size());
+    for (SHORT row = std::max<SHORT>(_virtualTop, 0); row < height; row++)
+    {
+        const SHORT left = _invalidRows[row].first;
+        const SHORT right = std::min(_invalidRows[row].second, width) - 1;
+        if (left > right)
+        {
+            continue;
+        }
+
+        if (!_dirtyArea.empty())
+        {
+            auto& last = _dirtyArea.back();
+            if (last.Bottom == row - 1 && last.Left == left && last.Right == right)
+            {
+                last.Bottom = row;
+                continue;
+            }
+        }
+
+        _dirtyArea.push_back({ left, row, right, row });
+    }
+
+    return { _dirtyArea.data(), _dirtyArea.size() };
+}
+
 // Routine Description:
 // - Uses the currently selected font to determine how wide the given character will be when renderered.
 // - NOTE: Only supports determining half-width/full-width status for CJK-type languages (e.g. is it 1 character wide or 2. a.k.a. is it a rectangle or square.)
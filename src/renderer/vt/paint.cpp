@@ -52,6 +52,10 @@ HRESULT VtEngine::EndPaint() noexcept
 {
     _trace.TraceEndPaint();
 
+    if (_fInvalidRectUsed)
+    {
+        std::fill(_invalidRows.begin(), _invalidRows.end(), std::pair<SHORT, SHORT>{ 0, 0 });
+    }
     _invalidRect = Viewport::Empty();
     _fInvalidRectUsed = false;
     _scrollDelta = {0};
@@ -79,23 +83,49 @@ HRESULT VtEngine::EndPaint() noexcept
         RETURN_IF_FAILED(_MoveCursor(_deferredCursorPos));
     }
 
-    RETURN_IF_FAILED(_Flush());
-
-    return S_OK;
+    // Don't write to the pipe here. The renderer still holds the console lock,
+    //      and a slow reader on the other end of the pipe would stall every
+    //      client waiting on it. Hand the frame over to Present instead.
+    return _QueueForPresent();
 }
 
 // Routine Description:
 // - Used to perform longer running presentation steps outside the lock so the
 //      other threads can continue.
-// - Not currently used by VtEngine.
+// - Writes everything that has been handed over by _QueueForPresent to the
+//      pipe. This doesn't need the console lock: the pending output is taken
+//      under _presentLock, and the write itself is serialized by _pipeLock.
 // Arguments:
 // - <none>
 // Return Value:
-// - S_FALSE since we do nothing.
+// - S_OK or suitable HRESULT error from writing pipe.
 [[nodiscard]]
 HRESULT VtEngine::Present() noexcept
 {
-    return S_FALSE;
+    HRESULT hr = S_OK;
+    bool fBrokePipe = false;
+    try
+    {
+        std::unique_lock<std::mutex> pipeLock{ _pipeLock };
+        {
+            std::unique_lock<std::mutex> presentLock{ _presentLock };
+            _pipeBuffer.swap(_presentBuffer);
+        }
+
+        const bool fWasBroken = _pipeBroken;
+        hr = _FlushBuffer(_pipeBuffer);
+        fBrokePipe = !fWasBroken && _pipeBroken;
+    }
+    CATCH_RETURN();
+
+    // Closing the output can tear down the console, which paints and presents
+    //      one last time, so it mustn't happen while we hold the pipe lock.
+    if (fBrokePipe && _terminalOwner)
+    {
+        _terminalOwner->CloseOutput();
+    }
+
+    return hr;
 }
 
 // Routine Description:
@@ -181,6 +211,8 @@ HRESULT VtEngine::PaintSelection(const SMALL_RECT /*rect*/) noexcept
 // Routine Description:
 // - Write a VT sequence to change the current colors of text. Writes true RGB
 //      color sequences.
+//   Only the attributes that changed are written, and they're all written as
+//      the parameters of a single SGR, instead of one SGR per attribute.
 // Arguments:
 // - colorForeground: The RGB Color to use to paint the foreground text.
 // - colorBackground: The RGB Color to use to paint the background of the text.
@@ -198,67 +230,79 @@ HRESULT VtEngine::_RgbUpdateDrawingBrushes(const COLORREF colorForeground,
     const bool fgIsDefault = colorForeground == _colorProvider.GetDefaultForeground();
     const bool bgIsDefault = colorBackground == _colorProvider.GetDefaultBackground();
 
+    int parameters[MAX_CSI_PARAMETERS];
+    size_t cParameters = 0;
+
+    // Appends the shortest parameters that select the color: the default
+    //      color, then an entry of the color table, then the RGB value.
+    const auto appendColor = [&](const COLORREF color, const bool isDefault, const bool fIsForeground) noexcept {
+        WORD wFoundColor = 0;
+        if (isDefault)
+        {
+            parameters[cParameters++] = fIsForeground ? 39 : 49;
+        }
+        else if (::FindTableIndex(color, ColorTable, cColorTable, &wFoundColor))
+        {
+            parameters[cParameters++] = _16ColorSgrParameter(wFoundColor, fIsForeground);
+        }
+        else
+        {
+            parameters[cParameters++] = fIsForeground ? 38 : 48;
+            parameters[cParameters++] = 2;
+            parameters[cParameters++] = GetRValue(color);
+            parameters[cParameters++] = GetGValue(color);
+            parameters[cParameters++] = GetBValue(color);
+        }
+    };
+
+    bool newIsBold = _lastWasBold;
+
     // If both the FG and BG should be the defaults, emit a SGR reset.
     if ((fgChanged || bgChanged) && fgIsDefault && bgIsDefault)
     {
         // SGR Reset will also clear out the boldness of the text.
-        RETURN_IF_FAILED(_SetGraphicsDefault());
-        _LastFG = colorForeground;
-        _LastBG = colorBackground;
-        _lastWasBold = false;
+        newIsBold = false;
 
         // I'm not sure this is possible currently, but if the text is bold, but
         //      default colors, make sure we bold it.
         if (isBold)
         {
-            RETURN_IF_FAILED(_SetGraphicsBoldness(isBold));
-            _lastWasBold = isBold;
+            parameters[cParameters++] = 0;
+            parameters[cParameters++] = 1;
+            newIsBold = true;
         }
     }
     else
     {
         if (_lastWasBold != isBold)
         {
-            RETURN_IF_FAILED(_SetGraphicsBoldness(isBold));
-            _lastWasBold = isBold;
+            parameters[cParameters++] = isBold ? 1 : 22;
+            newIsBold = isBold;
         }
 
-        WORD wFoundColor = 0;
         if (fgChanged)
         {
-            if (fgIsDefault)
-            {
-                RETURN_IF_FAILED(_SetGraphicsRenditionDefaultColor(true));
-            }
-            else if (::FindTableIndex(colorForeground, ColorTable, cColorTable, &wFoundColor))
-            {
-                RETURN_IF_FAILED(_SetGraphicsRendition16Color(wFoundColor, true));
-            }
-            else
-            {
-                RETURN_IF_FAILED(_SetGraphicsRenditionRGBColor(colorForeground, true));
-            }
-            _LastFG = colorForeground;
+            appendColor(colorForeground, fgIsDefault, true);
         }
 
         if (bgChanged)
         {
-            if (bgIsDefault)
-            {
-                RETURN_IF_FAILED(_SetGraphicsRenditionDefaultColor(false));
-            }
-            else if (::FindTableIndex(colorBackground, ColorTable, cColorTable, &wFoundColor))
-            {
-                RETURN_IF_FAILED(_SetGraphicsRendition16Color(wFoundColor, false));
-            }
-            else
-            {
-                RETURN_IF_FAILED(_SetGraphicsRenditionRGBColor(colorBackground, false));
-            }
-            _LastBG = colorBackground;
+            appendColor(colorBackground, bgIsDefault, false);
+        }
+
+        if (cParameters == 0)
+        {
+            // Nothing changed. An SGR without parameters would be a reset.
+            return S_OK;
         }
     }
 
+    RETURN_IF_FAILED(_WriteCsi(gsl::make_span(parameters, cParameters), 'm'));
+
+    _LastFG = colorForeground;
+    _LastBG = colorBackground;
+    _lastWasBold = newIsBold;
+
     return S_OK;
 }
 
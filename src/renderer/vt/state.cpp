@@ -6,9 +6,7 @@
 #include "../../inc/conattrs.hpp"
 #include "../../types/inc/convert.hpp"
 
-// For _vcprintf
-#include <conio.h>
-#include <stdarg.h>
+#include <charconv>
 
 #pragma hdrstop
 
@@ -37,6 +35,8 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
     _lastViewport(initialViewport),
     _invalidRect(Viewport::Empty()),
     _fInvalidRectUsed(false),
+    _invalidRows(initialViewport.Height()),
+    _dirtyArea{},
     _lastRealCursor({0}),
     _lastText({0}),
     _scrollDelta({0}),
@@ -63,6 +63,8 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
     // member is only defined when UNIT_TESTING is.
     _usingTestCallback = false;
 #endif
+
+    _dirtyArea.reserve(_invalidRows.size());
 }
 
 // Method Description:
@@ -94,29 +96,63 @@ HRESULT VtEngine::_Write(std::string_view const str) noexcept
     CATCH_RETURN();
 }
 
+// Method Description:
+// - Hands everything buffered by _Write over to Present, behind any output
+//      that was handed over before and hasn't been written to the pipe yet.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK, or E_OUTOFMEMORY if the output couldn't be queued.
+[[nodiscard]]
+HRESULT VtEngine::_QueueForPresent() noexcept
+{
+    try
+    {
+        std::unique_lock<std::mutex> presentLock{ _presentLock };
+        if (_presentBuffer.empty())
+        {
+            _presentBuffer.swap(_buffer);
+        }
+        else
+        {
+            _presentBuffer.append(_buffer);
+            _buffer.clear();
+        }
+    }
+    CATCH_RETURN();
+
+    return S_OK;
+}
+
+// Method Description:
+// - Writes the given buffer to the pipe and empties it. The buffer keeps its
+//      capacity, so the next frame can be composed into it without allocating.
+//      The caller must hold _pipeLock, and must close the output once it has
+//      released the lock if this breaks the pipe.
+// Arguments:
+// - buffer: The output to write to the pipe.
+// Return Value:
+// - S_OK or suitable HRESULT error from writing pipe.
 [[nodiscard]]
-HRESULT VtEngine::_Flush() noexcept
+HRESULT VtEngine::_FlushBuffer(std::string& buffer) noexcept
 {
 #ifdef UNIT_TESTING
     if (_hFile.get() == INVALID_HANDLE_VALUE)
     {
         // Do not flush during Unit Testing because we won't have a valid file.
+        buffer.clear();
         return S_OK;
     }
 #endif
 
     if (!_pipeBroken)
     {
-        bool fSuccess = !!WriteFile(_hFile.get(), _buffer.data(), static_cast<DWORD>(_buffer.size()), nullptr, nullptr);
-        _buffer.clear();
+        bool fSuccess = !!WriteFile(_hFile.get(), buffer.data(), static_cast<DWORD>(buffer.size()), nullptr, nullptr);
+        buffer.clear();
         if (!fSuccess)
         {
             _exitResult = HRESULT_FROM_WIN32(GetLastError());
             _pipeBroken = true;
-            if (_terminalOwner)
-            {
-                _terminalOwner->CloseOutput();
-            }
             return _exitResult;
         }
     }
@@ -178,39 +214,77 @@ HRESULT VtEngine::_WriteTerminalAscii(const std::wstring& wstr) noexcept
 }
 
 // Method Description:
-// - Helper for calling _Write with a string for formatting a sequence. Used
-//      extensively by VtSequences.cpp
+// - Helper for calling _Write with a CSI sequence that takes numeric
+//      parameters. Used extensively by VtSequences.cpp
+//   The sequence is composed on the stack and handed to _Write whole, so
+//      emitting one doesn't parse a format string or allocate. Conpty emits
+//      thousands of these per frame during a full repaint.
 // Arguments:
-// - pFormat: the pointer to the string to write to the pipe.
-// - ...: a va_list of args to format the string with.
+// - parameters: the parameters of the sequence, in order. They're written in
+//      decimal, separated by ';'.
+// - finalChar: the character that ends the sequence, eg 'H' for CUP.
 // Return Value:
-// - S_OK, E_INVALIDARG for a invalid format string, or suitable HRESULT error
-//      from writing pipe.
+// - S_OK, E_INVALIDARG for more than MAX_CSI_PARAMETERS parameters, or suitable
+//      HRESULT error from writing pipe.
 [[nodiscard]]
-HRESULT VtEngine::_WriteFormattedString(const std::string* const pFormat, ...) noexcept
+HRESULT VtEngine::_WriteCsi(const std::initializer_list<int> parameters, const char finalChar) noexcept
 {
+    return _WriteCsi(gsl::make_span(parameters.begin(), parameters.size()), finalChar);
+}
 
-    HRESULT hr = E_FAIL;
-    va_list argList;
-    va_start(argList, pFormat);
+// Method Description:
+// - Same as above, for callers that collect the parameters as they go.
+// Arguments:
+// - parameters: the parameters of the sequence, in order. May be empty.
+// - finalChar: the character that ends the sequence, eg 'm' for SGR.
+// Return Value:
+// - S_OK, E_INVALIDARG for more than MAX_CSI_PARAMETERS parameters, or suitable
+//      HRESULT error from writing pipe.
+[[nodiscard]]
+HRESULT VtEngine::_WriteCsi(const gsl::span<const int> parameters, const char finalChar) noexcept
+{
+    RETURN_HR_IF(E_INVALIDARG, gsl::narrow_cast<size_t>(parameters.size()) > MAX_CSI_PARAMETERS);
 
-    int cchNeeded = _scprintf(pFormat->c_str(), argList);
-    // -1 is the _scprintf error case https://msdn.microsoft.com/en-us/library/t32cf9tb.aspx
-    if (cchNeeded > -1)
-    {
-        wistd::unique_ptr<char[]> psz = wil::make_unique_nothrow<char[]>(cchNeeded + 1);
-        RETURN_IF_NULL_ALLOC(psz);
+    char sequence[MAX_CSI_LENGTH];
+    const char* const pchEnd = _FormatCsi(sequence, parameters, finalChar);
 
-        int cchWritten = _vsnprintf_s(psz.get(), cchNeeded + 1, cchNeeded, pFormat->c_str(), argList);
-        hr = _Write({ psz.get(), gsl::narrow<size_t>(cchWritten) });
-    }
-    else
+    return _Write({ sequence, gsl::narrow_cast<size_t>(pchEnd - sequence) });
+}
+
+// Method Description:
+// - Formats a CSI sequence into a caller's buffer, so that several sequences
+//      can be composed into a single write.
+// Arguments:
+// - pch: where to write the sequence. Must have room for MAX_CSI_LENGTH chars.
+// - parameters: the parameters of the sequence, in order. At most
+//      MAX_CSI_PARAMETERS.
+// - finalChar: the character that ends the sequence.
+// Return Value:
+// - A pointer just past the end of the sequence.
+char* VtEngine::_FormatCsi(_Out_writes_(MAX_CSI_LENGTH) char* pch,
+                           const gsl::span<const int> parameters,
+                           const char finalChar) noexcept
+{
+    char* const pchEnd = pch + MAX_CSI_LENGTH;
+
+    *pch++ = '\x1b';
+    *pch++ = '[';
+
+    bool first = true;
+    for (const int parameter : parameters)
     {
-        hr = E_INVALIDARG;
+        if (!first)
+        {
+            *pch++ = ';';
+        }
+        first = false;
+
+        pch = std::to_chars(pch, pchEnd, parameter).ptr;
     }
 
-    va_end(argList);
-    return hr;
+    *pch++ = finalChar;
+
+    return pch;
 }
 
 // Method Description:
@@ -259,6 +333,14 @@ HRESULT VtEngine::UpdateViewport(const SMALL_RECT srNewViewport) noexcept
 
     _lastViewport = newView;
 
+    // Keep one span of invalid columns for every row of the new viewport.
+    try
+    {
+        _invalidRows.resize(newView.Height());
+        _dirtyArea.reserve(_invalidRows.size());
+    }
+    CATCH_RETURN();
+
     if ((oldView.Height() != newView.Height()) || (oldView.Width() != newView.Width()))
     {
         // Don't emit a resize event if we've requested it be suppressed
@@ -377,7 +459,13 @@ void VtEngine::SetTestCallback(_In_ std::function<bool(const char* const, size_t
 // - true if the entire viewport has been invalidated
 bool VtEngine::_AllIsInvalid() const
 {
-    return _lastViewport == _invalidRect;
+    // The bounding box alone isn't enough - two small regions in opposite
+    //      corners of the viewport span the whole thing too.
+    const SHORT width = _lastViewport.Width();
+    return _lastViewport == _invalidRect &&
+           std::all_of(_invalidRows.cbegin(), _invalidRows.cend(), [width](const auto& span) {
+               return span.first == 0 && span.second >= width;
+           });
 }
 
 // Method Description:
@@ -423,7 +511,9 @@ void VtEngine::SetTerminalOwner(Microsoft::Console::ITerminalOwner* const termin
 // Method Description:
 // - sends a sequence to request the end terminal to tell us the
 //      cursor position. The terminal will reply back on the vt input handle.
-//   Flushes the buffer as well, to make sure the request is sent to the terminal.
+//   Presents the request right away as well, to make sure it is sent to the
+//      terminal. It goes through the same queue as the frames, so it can't
+//      overtake a frame that has been painted but not presented yet.
 // Arguments:
 // - <none>
 // Return Value:
@@ -431,6 +521,7 @@ void VtEngine::SetTerminalOwner(Microsoft::Console::ITerminalOwner* const termin
 HRESULT VtEngine::RequestCursor() noexcept
 {
     RETURN_IF_FAILED(_RequestCursor());
-    RETURN_IF_FAILED(_Flush());
+    RETURN_IF_FAILED(_QueueForPresent());
+    RETURN_IF_FAILED(Present());
     return S_OK;
 }
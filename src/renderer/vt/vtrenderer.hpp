@@ -31,6 +31,13 @@ namespace Microsoft::Console::Render
     public:
         // See _PaintUtf8BufferLine for explanation of this value.
         static const size_t ERASE_CHARACTER_STRING_LENGTH = 8;
+        // The most parameters any sequence we emit takes: an SGR that sets
+        //      boldness and an RGB foreground and background at once.
+        static const size_t MAX_CSI_PARAMETERS = 11;
+        // The longest sequence _FormatCsi can write: the introducer, then each
+        //      parameter (at most digits10 + 1 digits and a sign) with its
+        //      separator or the final char.
+        static const size_t MAX_CSI_LENGTH = 2 + MAX_CSI_PARAMETERS * (std::numeric_limits<int>::digits10 + 3);
         static const COORD INVALID_COORDS;
 
         VtEngine(_In_ wil::unique_hfile hPipe,
@@ -103,6 +110,7 @@ namespace Microsoft::Console::Render
                                 const int iDpi) noexcept override;
 
         SMALL_RECT GetDirtyRectInChars() override;
+        std::basic_string_view<SMALL_RECT> GetDirtyArea() override;
         [[nodiscard]]
         HRESULT GetFontSize(_Out_ COORD* const pFontSize) noexcept override;
         [[nodiscard]]
@@ -128,6 +136,19 @@ namespace Microsoft::Console::Render
         wil::unique_hfile _hFile;
         std::string _buffer;
 
+        // The output of the last frame, waiting for Present to write it to the
+        //      pipe once the renderer has released the console lock.
+        //      _presentLock guards the hand-off, since Present runs without
+        //      the console lock.
+        std::string _presentBuffer;
+        std::mutex _presentLock;
+
+        // Serializes everything that writes to the pipe. The output being
+        //      written is moved into _pipeBuffer first, so that EndPaint can
+        //      hand over the next frame while a slow write is still going.
+        std::string _pipeBuffer;
+        std::mutex _pipeLock;
+
         const Microsoft::Console::IDefaultColorProvider& _colorProvider;
 
         COLORREF _LastFG;
@@ -138,6 +159,12 @@ namespace Microsoft::Console::Render
         Microsoft::Console::Types::Viewport _invalidRect;
 
         bool _fInvalidRectUsed;
+
+        // The invalid columns of each row of the viewport, as [first, second).
+        //      _invalidRect is the bounding box of all of these.
+        std::vector<std::pair<SHORT, SHORT>> _invalidRows;
+        std::vector<SMALL_RECT> _dirtyArea;
+
         COORD _lastRealCursor;
         COORD _lastText;
         COORD _scrollDelta;
@@ -156,7 +183,7 @@ namespace Microsoft::Console::Render
         bool _newBottomLine;
         COORD _deferredCursorPos;
 
-        bool _pipeBroken;
+        std::atomic<bool> _pipeBroken;
         HRESULT _exitResult;
         Microsoft::Console::ITerminalOwner* _terminalOwner;
 
@@ -165,9 +192,16 @@ namespace Microsoft::Console::Render
         [[nodiscard]]
         HRESULT _Write(std::string_view const str) noexcept;
         [[nodiscard]]
-        HRESULT _WriteFormattedString(const std::string* const pFormat, ...) noexcept;
+        HRESULT _WriteCsi(const std::initializer_list<int> parameters, const char finalChar) noexcept;
+        [[nodiscard]]
+        HRESULT _WriteCsi(const gsl::span<const int> parameters, const char finalChar) noexcept;
+        static char* _FormatCsi(_Out_writes_(MAX_CSI_LENGTH) char* pch,
+                                const gsl::span<const int> parameters,
+                                const char finalChar) noexcept;
         [[nodiscard]]
-        HRESULT _Flush() noexcept;
+        HRESULT _QueueForPresent() noexcept;
+        [[nodiscard]]
+        HRESULT _FlushBuffer(std::string& buffer) noexcept;
 
         void _OrRect(_Inout_ SMALL_RECT* const pRectExisting, const SMALL_RECT* const pRectToOr) const;
         [[nodiscard]]
@@ -175,7 +209,10 @@ namespace Microsoft::Console::Render
         [[nodiscard]]
         HRESULT _InvalidOffset(const COORD* const ppt) noexcept;
         [[nodiscard]]
+        HRESULT _InvalidOffsetRows(const SHORT top, const SHORT bottom, const SHORT dy) noexcept;
+        [[nodiscard]]
         HRESULT _InvalidRestrict() noexcept;
+        void _InvalidCombineRow(const SHORT row, const SHORT left, const SHORT right) noexcept;
         bool _AllIsInvalid() const;
 
         [[nodiscard]]
@@ -195,6 +232,12 @@ namespace Microsoft::Console::Render
         [[nodiscard]]
         HRESULT _InsertLine(const short sLines) noexcept;
         [[nodiscard]]
+        HRESULT _SetScrollingRegion(const short top, const short bottom) noexcept;
+        [[nodiscard]]
+        HRESULT _ResetScrollingRegion() noexcept;
+        [[nodiscard]]
+        HRESULT _ScrollUpDown(const short sLines, const bool fScrollUp) noexcept;
+        [[nodiscard]]
         HRESULT _CursorForward(const short chars) noexcept;
         [[nodiscard]]
         HRESULT _EraseCharacter(const short chars) noexcept;
@@ -209,6 +252,7 @@ namespace Microsoft::Console::Render
         [[nodiscard]]
         HRESULT _SetGraphicsRendition16Color(const WORD wAttr,
                                             const bool fIsForeground) noexcept;
+        static int _16ColorSgrParameter(const WORD wAttr, const bool fIsForeground) noexcept;
         [[nodiscard]]
         HRESULT _SetGraphicsRenditionRGBColor(const COLORREF color,
                                             const bool fIsForeground) noexcept;
@@ -70,28 +70,28 @@ public:
 
     [[nodiscard]]
     virtual HRESULT PeekConsoleInputAImpl(IConsoleInputObject& context,
-                                          std::deque<std::unique_ptr<IInputEvent>>& outEvents,
+                                          std::vector<INPUT_RECORD>& outRecords,
                                           const size_t eventsToRead,
                                           INPUT_READ_HANDLE_DATA& readHandleState,
                                           std::unique_ptr<IWaitRoutine>& waiter) noexcept = 0;
 
     [[nodiscard]]
     virtual HRESULT PeekConsoleInputWImpl(IConsoleInputObject& context,
-                                          std::deque<std::unique_ptr<IInputEvent>>& outEvents,
+                                          std::vector<INPUT_RECORD>& outRecords,
                                           const size_t eventsToRead,
                                           INPUT_READ_HANDLE_DATA& readHandleState,
                                           std::unique_ptr<IWaitRoutine>& waiter) noexcept = 0;
 
     [[nodiscard]]
     virtual HRESULT ReadConsoleInputAImpl(IConsoleInputObject& context,
-                                          std::deque<std::unique_ptr<IInputEvent>>& outEvents,
+                                          std::vector<INPUT_RECORD>& outRecords,
                                           const size_t eventsToRead,
                                           INPUT_READ_HANDLE_DATA& readHandleState,
                                           std::unique_ptr<IWaitRoutine>& waiter) noexcept = 0;
 
     [[nodiscard]]
     virtual HRESULT ReadConsoleInputWImpl(IConsoleInputObject& context,
-                                          std::deque<std::unique_ptr<IInputEvent>>& outEvents,
+                                          std::vector<INPUT_RECORD>& outRecords,
                                           const size_t eventsToRead,
                                           INPUT_READ_HANDLE_DATA& readHandleState,
                                           std::unique_ptr<IWaitRoutine>& waiter) noexcept = 0;
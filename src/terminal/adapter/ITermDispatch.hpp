@@ -64,6 +64,7 @@ public:
     virtual bool EnableButtonEventMouseMode(const bool fEnabled) = 0; // ?1002
     virtual bool EnableAnyEventMouseMode(const bool fEnabled) = 0; // ?1003
     virtual bool EnableAlternateScroll(const bool fEnabled) = 0; // ?1007
+    virtual bool EnableBracketedPasteMode(const bool fEnabled) = 0; // ?2004
     virtual bool SetColorTableEntry(const size_t tableIndex, const DWORD dwColor) = 0; // OSCColorTable
 
     virtual bool EraseInDisplay(const DispatchTypes::EraseType  eraseType) = 0; // ED
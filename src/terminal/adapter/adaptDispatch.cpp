@@ -78,23 +78,22 @@ void AdaptDispatch::PrintString(const wchar_t* const rgwch, const size_t cch)
 // - True if handled successfully. False otherwise.
 bool AdaptDispatch::_CursorMovement(const CursorDirection dir, _In_ unsigned int const uiDistance) const
 {
-    // First retrieve some information about the buffer
-    CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
-    csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
+    // First retrieve the cursor and the viewport
+    COORD coordCursor = { 0 };
+    SMALL_RECT srViewport = { 0 };
     // Make sure to reset the viewport (with MoveToBottom )to where it was
     //      before the user scrolled the console output
-    bool fSuccess = !!(_conApi->MoveToBottom() && _conApi->GetConsoleScreenBufferInfoEx(&csbiex));
+    bool fSuccess = !!(_conApi->MoveToBottom() && _conApi->PrivateGetCursorAndViewport(&coordCursor, &srViewport));
 
     if (fSuccess)
     {
-        COORD coordCursor = csbiex.dwCursorPosition;
 
         // For next/previous line, we unconditionally need to move the X position to the left edge of the viewport.
         switch (dir)
         {
         case CursorDirection::NextLine:
         case CursorDirection::PrevLine:
-            coordCursor.X = csbiex.srWindow.Left;
+            coordCursor.X = srViewport.Left;
             break;
         }
 
@@ -131,17 +130,17 @@ bool AdaptDispatch::_CursorMovement(const CursorDirection dir, _In_ unsigned int
             {
             case CursorDirection::Up:
             case CursorDirection::PrevLine:
-                sBoundaryVal = csbiex.srWindow.Top;
+                sBoundaryVal = srViewport.Top;
                 break;
             case CursorDirection::Down:
             case CursorDirection::NextLine:
-                sBoundaryVal = csbiex.srWindow.Bottom;
+                sBoundaryVal = srViewport.Bottom;
                 break;
             case CursorDirection::Left:
-                sBoundaryVal = csbiex.srWindow.Left;
+                sBoundaryVal = srViewport.Left;
                 break;
             case CursorDirection::Right:
-                sBoundaryVal = csbiex.srWindow.Right;
+                sBoundaryVal = srViewport.Right;
                 break;
             default:
                 fSuccess = false;
@@ -300,12 +299,12 @@ bool AdaptDispatch::_CursorMovePosition(_In_opt_ const unsigned int* const puiRo
 {
     bool fSuccess = true;
 
-    // First retrieve some information about the buffer
-    CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
-    csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
+    // First retrieve the cursor and the viewport
+    COORD coordCursor = { 0 };
+    SMALL_RECT srViewport = { 0 };
     // Make sure to reset the viewport (with MoveToBottom )to where it was
     //      before the user scrolled the console output
-    fSuccess = !!(_conApi->MoveToBottom() && _conApi->GetConsoleScreenBufferInfoEx(&csbiex));
+    fSuccess = !!(_conApi->MoveToBottom() && _conApi->PrivateGetCursorAndViewport(&coordCursor, &srViewport));
 
     if (fSuccess)
     {
@@ -326,7 +325,7 @@ bool AdaptDispatch::_CursorMovePosition(_In_opt_ const unsigned int* const puiRo
         }
         else
         {
-            uiRow = csbiex.dwCursorPosition.Y - csbiex.srWindow.Top; // remember, in VT speak, this is relative to the viewport. not absolute.
+            uiRow = coordCursor.Y - srViewport.Top; // remember, in VT speak, this is relative to the viewport. not absolute.
         }
 
         if (puiCol != nullptr)
@@ -342,27 +341,25 @@ bool AdaptDispatch::_CursorMovePosition(_In_opt_ const unsigned int* const puiRo
         }
         else
         {
-            uiCol = csbiex.dwCursorPosition.X - csbiex.srWindow.Left; // remember, in VT speak, this is relative to the viewport. not absolute.
+            uiCol = coordCursor.X - srViewport.Left; // remember, in VT speak, this is relative to the viewport. not absolute.
         }
 
         if (fSuccess)
         {
-            COORD coordCursor = csbiex.dwCursorPosition;
-
             // Safely convert the UINT positions we were given into shorts (which is the size the console deals with)
             fSuccess = SUCCEEDED(UIntToShort(uiRow, &coordCursor.Y)) && SUCCEEDED(UIntToShort(uiCol, &coordCursor.X));
 
             if (fSuccess)
             {
                 // Set the line and column values as offsets from the viewport edge. Use safe math to prevent overflow.
-                fSuccess = SUCCEEDED(ShortAdd(coordCursor.Y, csbiex.srWindow.Top, &coordCursor.Y)) &&
-                    SUCCEEDED(ShortAdd(coordCursor.X, csbiex.srWindow.Left, &coordCursor.X));
+                fSuccess = SUCCEEDED(ShortAdd(coordCursor.Y, srViewport.Top, &coordCursor.Y)) &&
+                    SUCCEEDED(ShortAdd(coordCursor.X, srViewport.Left, &coordCursor.X));
 
                 if (fSuccess)
                 {
                     // Apply boundary tests to ensure the cursor isn't outside the viewport rectangle.
-                    coordCursor.Y = std::clamp(coordCursor.Y, csbiex.srWindow.Top, gsl::narrow<SHORT>(csbiex.srWindow.Bottom - 1));
-                    coordCursor.X = std::clamp(coordCursor.X, csbiex.srWindow.Left, gsl::narrow<SHORT>(csbiex.srWindow.Right - 1));
+                    coordCursor.Y = std::clamp(coordCursor.Y, srViewport.Top, gsl::narrow<SHORT>(srViewport.Bottom - 1));
+                    coordCursor.X = std::clamp(coordCursor.X, srViewport.Left, gsl::narrow<SHORT>(srViewport.Right - 1));
 
                     // Finally, attempt to set the adjusted cursor position back into the console.
                     fSuccess = !!_conApi->SetConsoleCursorPosition(coordCursor);
@@ -416,21 +413,17 @@ bool AdaptDispatch::CursorPosition(_In_ unsigned int const uiLine, _In_ unsigned
 // - True if handled successfully. False otherwise.
 bool AdaptDispatch::CursorSavePosition()
 {
-    // First retrieve some information about the buffer
-    CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
-    csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
+    // First retrieve the cursor and the viewport
+    COORD coordCursor = { 0 };
+    SMALL_RECT srViewport = { 0 };
     // Make sure to reset the viewport (with MoveToBottom )to where it was
     //      before the user scrolled the console output
-    bool fSuccess = !!(_conApi->MoveToBottom() && _conApi->GetConsoleScreenBufferInfoEx(&csbiex));
+    bool fSuccess = !!(_conApi->MoveToBottom() && _conApi->PrivateGetCursorAndViewport(&coordCursor, &srViewport));
 
     if (fSuccess)
     {
         // The cursor is given to us by the API as relative to the whole buffer.
         // But in VT speak, the cursor should be relative to the current viewport. Adjust.
-        COORD const coordCursor = csbiex.dwCursorPosition;
-
-        SMALL_RECT const srViewport = csbiex.srWindow;
-
         // VT is also 1 based, not 0 based, so correct by 1.
         _coordSavedCursor.X = coordCursor.X - srViewport.Left + 1;
         _coordSavedCursor.Y = coordCursor.Y - srViewport.Top + 1;
@@ -477,128 +470,17 @@ bool AdaptDispatch::CursorVisibility(const bool fIsVisible)
 // - True if handled successfully. False otherwise.
 bool AdaptDispatch::_InsertDeleteHelper(_In_ unsigned int const uiCount, const bool fIsInsert) const
 {
-    // We'll be doing short math on the distance since all console APIs use shorts. So check that we can successfully convert the uint into a short first.
+    // All console APIs use shorts for distances. So check that we can successfully convert the uint into a short first.
     SHORT sDistance;
     RETURN_IF_FALSE(SUCCEEDED(UIntToShort(uiCount, &sDistance)));
 
-    // get current cursor, viewport
-    CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
-    csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
     // Make sure to reset the viewport (with MoveToBottom )to where it was
     //      before the user scrolled the console output
     RETURN_IF_FALSE(_conApi->MoveToBottom());
-    RETURN_IF_FALSE(_conApi->GetConsoleScreenBufferInfoEx(&csbiex));
-
-    const auto cursor = csbiex.dwCursorPosition;
-    const auto viewport = Viewport::FromExclusive(csbiex.srWindow);
-    // Rectangle to cut out of the existing buffer
-    SMALL_RECT srScroll;
-    srScroll.Left = cursor.X;
-    srScroll.Right = viewport.RightExclusive();
-    srScroll.Top = cursor.Y;
-    srScroll.Bottom = srScroll.Top;
-
-    // Paste coordinate for cut text above
-    COORD coordDestination;
-    coordDestination.Y = cursor.Y;
-    coordDestination.X = cursor.X;
-
-    // Fill character for remaining space left behind by "cut" operation (or for fill if we "cut" the entire line)
-    CHAR_INFO ciFill;
-    ciFill.Attributes = csbiex.wAttributes;
-    ciFill.Char.UnicodeChar = L' ';
-
-    bool fSuccess = false;
-    if (fIsInsert)
-    {
-        // Insert makes space by moving characters out to the right. So move the destination of the cut/paste region.
-        fSuccess = SUCCEEDED(ShortAdd(coordDestination.X, sDistance, &coordDestination.X));
-    }
-    else
-    {
-        // for delete, we need to add to the scroll region to move it off toward the right.
-        fSuccess = SUCCEEDED(ShortAdd(srScroll.Left, sDistance, &srScroll.Left));
-    }
-
-    if (fSuccess)
-    {
-        if (srScroll.Left >= viewport.RightExclusive() ||
-            coordDestination.X >= viewport.RightExclusive())
-        {
-            DWORD const nLength = viewport.RightExclusive() - cursor.X;
-            size_t written = 0;
-
-            // if the select/scroll region is off screen to the right or the destination is off screen to the right, fill instead of scrolling.
-            fSuccess = !!_conApi->FillConsoleOutputCharacterW(ciFill.Char.UnicodeChar,
-                                                              nLength,
-                                                              cursor,
-                                                              written);
-
-            if (fSuccess)
-            {
-                written = 0;
-                fSuccess = !!_conApi->FillConsoleOutputAttribute(ciFill.Attributes,
-                                                                 nLength,
-                                                                 cursor,
-                                                                 written);
-            }
-        }
-        else
-        {
-            // clip inside the viewport.
-            fSuccess = !!_conApi->ScrollConsoleScreenBufferW(&srScroll,
-                                                             &csbiex.srWindow,
-                                                             coordDestination,
-                                                             &ciFill);
 
-            if (fSuccess && !fIsInsert)
-            {
-                // See MSFT:19888564
-                // We've now shifted a number of the characters to the left.
-                // If the number of chars we've shifted doesn't fill the
-                //      entire region we deleted, then artifacts of the
-                //      previous contents of the row can get left behind.
-                //
-                // Example: (this is tested by DeleteCharsNearEndOfLineSimpleFirstCase)
-                // start with the following buffer contents, and the cursor on the "D"
-                // [ABCDEFG ]
-                //     ^
-                // When you DCH(3) here, we are trying to delete the D, E and F.
-                // We do that by shifting the contents of the line after the deleted
-                // characters to the left. HOWEVER, there are only 2 chars left to move.
-                // So (before the fix) the buffer end up like this:
-                // [ABCG F  ]
-                //     ^
-                // The G and " " have moved, but the F did not get overwritten.
-                //
-                // Fill the remaining space after the characters we
-                //      shifted with spaces (empty cells).
-                const short scrolledChars = viewport.RightExclusive() - srScroll.Left;
-                const short shiftedRightPos = cursor.X + scrolledChars;
-                if (shiftedRightPos < srScroll.Left)
-                {
-                    size_t written = 0;
-                    const short spacesToFill = viewport.RightInclusive() - (shiftedRightPos);
-                    const COORD fillPos{ shiftedRightPos, cursor.Y };
-                    fSuccess = !!_conApi->FillConsoleOutputCharacterW(ciFill.Char.UnicodeChar,
-                                                                      spacesToFill,
-                                                                      fillPos,
-                                                                      written);
-                    if (fSuccess)
-                    {
-                        written = 0;
-                        fSuccess = !!_conApi->FillConsoleOutputAttribute(ciFill.Attributes,
-                                                                         spacesToFill,
-                                                                         fillPos,
-                                                                         written);
-                    }
-                }
-            }
-        }
-    }
-
-
-    return fSuccess;
+    // The console moves the rest of the cursor's row over by itself, and
+    //      fills the space left behind with the current attributes.
+    return !!(fIsInsert ? _conApi->InsertCharacters(uiCount) : _conApi->DeleteCharacters(uiCount));
 }
 
 // Routine Description:
@@ -675,50 +557,40 @@ bool AdaptDispatch::_EraseAreaHelper(const COORD coordStartPosition, const COORD
 
 // Routine Description:
 // - Internal helper to erase one particular line of the buffer. Either from beginning to the cursor, from the cursor to the end, or the entire line.
-// - Used by both erase line (used just once) and by erase screen (used in a loop) to erase a portion of the buffer.
+// - Used by both erase line and by erase screen to erase a portion of the buffer.
 // Arguments:
-// - pcsbiex - Pointer to the console screen buffer that we will be erasing (and getting cursor data from within)
+// - coordCursor - The cursor position, relative to the whole buffer
+// - srViewport - The viewport, with the right and bottom one past the last visible column and row
 // - DispatchTypes::EraseType - Enumeration mode of which kind of erase to perform: beginning to cursor, cursor to end, or entire line.
 // - sLineId - The line number (array index value, starts at 0) of the line to operate on within the buffer.
 //           - This is not aware of circular buffer. Line 0 is always the top visible line if you scrolled the whole way up the window.
 // Return Value:
 // - True if handled successfully. False otherwise.
-bool AdaptDispatch::_EraseSingleLineHelper(const CONSOLE_SCREEN_BUFFER_INFOEX* const pcsbiex, const DispatchTypes::EraseType eraseType, const SHORT sLineId, const WORD wFillColor) const
+bool AdaptDispatch::_EraseSingleLineHelper(const COORD coordCursor, const SMALL_RECT srViewport, const DispatchTypes::EraseType eraseType, const SHORT sLineId) const
 {
-    COORD coordStartPosition = { 0 };
-    coordStartPosition.Y = sLineId;
+    SMALL_RECT srErase = { 0 };
+    srErase.Top = sLineId;
+    srErase.Bottom = sLineId;
 
-    // determine start position from the erase type
+    // determine the start and end of the erase from the erase type
     // remember that erases are inclusive of the current cursor position.
     switch (eraseType)
     {
     case DispatchTypes::EraseType::FromBeginning:
-    case DispatchTypes::EraseType::All:
-        coordStartPosition.X = pcsbiex->srWindow.Left; // from beginning and the whole line start from the left viewport edge.
+        srErase.Left = srViewport.Left;
+        srErase.Right = coordCursor.X;
         break;
     case DispatchTypes::EraseType::ToEnd:
-        coordStartPosition.X = pcsbiex->dwCursorPosition.X; // from the current cursor position (including it)
-        break;
-    }
-
-    DWORD nLength = 0;
-
-    // determine length of erase from erase type
-    switch (eraseType)
-    {
-    case DispatchTypes::EraseType::FromBeginning:
-        // +1 because if cursor were at the left edge, the length would be 0 and we want to paint at least the 1 character the cursor is on.
-        nLength = (pcsbiex->dwCursorPosition.X - pcsbiex->srWindow.Left) + 1;
+        srErase.Left = coordCursor.X;
+        srErase.Right = gsl::narrow_cast<SHORT>(srViewport.Right - 1); // The viewport's .Right is 1 farther than the right most displayed character.
         break;
-    case DispatchTypes::EraseType::ToEnd:
     case DispatchTypes::EraseType::All:
-        // Remember the .Right value is 1 farther than the right most displayed character in the viewport. Therefore no +1.
-        nLength = pcsbiex->srWindow.Right - coordStartPosition.X;
+        srErase.Left = srViewport.Left;
+        srErase.Right = gsl::narrow_cast<SHORT>(srViewport.Right - 1);
         break;
     }
 
-    return _EraseSingleLineDistanceHelper(coordStartPosition, nLength, wFillColor);
-
+    return !!_conApi->EraseCells(&srErase);
 }
 
 // Routine Description:
@@ -732,20 +604,22 @@ bool AdaptDispatch::_EraseSingleLineHelper(const CONSOLE_SCREEN_BUFFER_INFOEX* c
 // - True if handled successfully. False otherwise.
 bool AdaptDispatch::EraseCharacters(_In_ unsigned int const uiNumChars)
 {
-    CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
-    csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
-    bool fSuccess = !!_conApi->GetConsoleScreenBufferInfoEx(&csbiex);
+    COORD coordCursor = { 0 };
+    SMALL_RECT srViewport = { 0 };
+    bool fSuccess = !!_conApi->PrivateGetCursorAndViewport(&coordCursor, &srViewport);
 
     if (fSuccess)
     {
-        const COORD coordStartPosition = csbiex.dwCursorPosition;
-
-        const SHORT sRemainingSpaces = csbiex.srWindow.Right - coordStartPosition.X;
+        const SHORT sRemainingSpaces = srViewport.Right - coordCursor.X;
         const unsigned short usActualRemaining = (sRemainingSpaces < 0)? 0 : sRemainingSpaces;
         // erase at max the number of characters remaining in the line from the current position.
-        const DWORD dwEraseLength = (uiNumChars <= usActualRemaining)? uiNumChars : usActualRemaining;
+        const unsigned short usEraseLength = (uiNumChars <= usActualRemaining)? static_cast<unsigned short>(uiNumChars) : usActualRemaining;
 
-        fSuccess = _EraseSingleLineDistanceHelper(coordStartPosition, dwEraseLength, csbiex.wAttributes);
+        if (usEraseLength > 0)
+        {
+            const SMALL_RECT srErase = { coordCursor.X, coordCursor.Y, gsl::narrow_cast<SHORT>(coordCursor.X + usEraseLength - 1), coordCursor.Y };
+            fSuccess = !!_conApi->EraseCells(&srErase);
+        }
     }
     return fSuccess;
 }
@@ -776,11 +650,11 @@ bool AdaptDispatch::EraseInDisplay(const DispatchTypes::EraseType eraseType)
         return _EraseAll();
     }
 
-    CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
-    csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
+    COORD coordCursor = { 0 };
+    SMALL_RECT srViewport = { 0 };
     // Make sure to reset the viewport (with MoveToBottom )to where it was
     //      before the user scrolled the console output
-    bool fSuccess = !!(_conApi->MoveToBottom() && _conApi->GetConsoleScreenBufferInfoEx(&csbiex));
+    bool fSuccess = !!(_conApi->MoveToBottom() && _conApi->PrivateGetCursorAndViewport(&coordCursor, &srViewport));
 
     if (fSuccess)
     {
@@ -791,46 +665,33 @@ bool AdaptDispatch::EraseInDisplay(const DispatchTypes::EraseType eraseType)
         // We erase one or more of these based on the erase type:
         // A. FromBeginning - Erase 1 and Some of 2.
         // B. ToEnd - Erase some of 2 and 3.
-        // C. All - Erase 1, 2, and 3.
+        // The complete lines of 1 and 3 are erased together, as one region.
 
         // 1. Lines before cursor line
-        if (eraseType == DispatchTypes::EraseType::FromBeginning)
+        if (eraseType == DispatchTypes::EraseType::FromBeginning && coordCursor.Y > srViewport.Top)
         {
-            // For beginning and all, erase all complete lines before (above vertically) from the cursor position.
-            for (SHORT sStartLine = csbiex.srWindow.Top; sStartLine < csbiex.dwCursorPosition.Y; sStartLine++)
-            {
-                fSuccess = _EraseSingleLineHelper(&csbiex, DispatchTypes::EraseType::All, sStartLine, csbiex.wAttributes);
-
-                if (!fSuccess)
-                {
-                    break;
-                }
-            }
+            const SMALL_RECT srErase = { srViewport.Left,
+                                         srViewport.Top,
+                                         gsl::narrow_cast<SHORT>(srViewport.Right - 1),
+                                         gsl::narrow_cast<SHORT>(coordCursor.Y - 1) };
+            fSuccess = !!_conApi->EraseCells(&srErase);
         }
 
         if (fSuccess)
         {
             // 2. Cursor Line
-            fSuccess = _EraseSingleLineHelper(&csbiex, eraseType, csbiex.dwCursorPosition.Y, csbiex.wAttributes);
+            fSuccess = _EraseSingleLineHelper(coordCursor, srViewport, eraseType, coordCursor.Y);
         }
 
-        if (fSuccess)
+        // 3. Lines after cursor line
+        // Remember that the viewport bottom value is 1 beyond the viewable area of the viewport.
+        if (fSuccess && eraseType == DispatchTypes::EraseType::ToEnd && coordCursor.Y + 1 < srViewport.Bottom)
         {
-            // 3. Lines after cursor line
-            if (eraseType == DispatchTypes::EraseType::ToEnd)
-            {
-                // For beginning and all, erase all complete lines after (below vertically) the cursor position.
-                // Remember that the viewport bottom value is 1 beyond the viewable area of the viewport.
-                for (SHORT sStartLine = csbiex.dwCursorPosition.Y + 1; sStartLine < csbiex.srWindow.Bottom; sStartLine++)
-                {
-                    fSuccess = _EraseSingleLineHelper(&csbiex, DispatchTypes::EraseType::All, sStartLine, csbiex.wAttributes);
-
-                    if (!fSuccess)
-                    {
-                        break;
-                    }
-                }
-            }
+            const SMALL_RECT srErase = { srViewport.Left,
+                                         gsl::narrow_cast<SHORT>(coordCursor.Y + 1),
+                                         gsl::narrow_cast<SHORT>(srViewport.Right - 1),
+                                         gsl::narrow_cast<SHORT>(srViewport.Bottom - 1) };
+            fSuccess = !!_conApi->EraseCells(&srErase);
         }
     }
 
@@ -845,13 +706,13 @@ bool AdaptDispatch::EraseInDisplay(const DispatchTypes::EraseType eraseType)
 // - True if handled successfully. False otherwise.
 bool AdaptDispatch::EraseInLine(const DispatchTypes::EraseType eraseType)
 {
-    CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
-    csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
-    bool fSuccess = !!_conApi->GetConsoleScreenBufferInfoEx(&csbiex);
+    COORD coordCursor = { 0 };
+    SMALL_RECT srViewport = { 0 };
+    bool fSuccess = !!_conApi->PrivateGetCursorAndViewport(&coordCursor, &srViewport);
 
     if (fSuccess)
     {
-        fSuccess = _EraseSingleLineHelper(&csbiex, eraseType, csbiex.dwCursorPosition.Y, csbiex.wAttributes);
+        fSuccess = _EraseSingleLineHelper(coordCursor, srViewport, eraseType, coordCursor.Y);
     }
 
     return fSuccess;
@@ -902,20 +763,18 @@ bool AdaptDispatch::DeviceAttributes()
 // - True if handled successfully. False otherwise.
 bool AdaptDispatch::_CursorPositionReport() const
 {
-    CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
-    csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
+    // First pull the cursor position relative to the entire buffer out of the console.
+    COORD coordCursorPos = { 0 };
+    SMALL_RECT srViewport = { 0 };
     // Make sure to reset the viewport (with MoveToBottom )to where it was
     //      before the user scrolled the console output
-    bool fSuccess = !!(_conApi->MoveToBottom() && _conApi->GetConsoleScreenBufferInfoEx(&csbiex));
+    bool fSuccess = !!(_conApi->MoveToBottom() && _conApi->PrivateGetCursorAndViewport(&coordCursorPos, &srViewport));
 
     if (fSuccess)
     {
-        // First pull the cursor position relative to the entire buffer out of the console.
-        COORD coordCursorPos = csbiex.dwCursorPosition;
-
         // Now adjust it for its position in respect to the current viewport.
-        coordCursorPos.X -= csbiex.srWindow.Left;
-        coordCursorPos.Y -= csbiex.srWindow.Top;
+        coordCursorPos.X -= srViewport.Left;
+        coordCursorPos.Y -= srViewport.Top;
 
         // NOTE: 1,1 is the top-left corner of the viewport in VT-speak, so add 1.
         coordCursorPos.X++;
@@ -1135,6 +994,9 @@ bool AdaptDispatch::_PrivateModeParamsHelper(_In_ DispatchTypes::PrivateModePara
     case DispatchTypes::PrivateModeParams::ASB_AlternateScreenBuffer:
         fSuccess = fEnable? UseAlternateScreenBuffer() : UseMainScreenBuffer();
         break;
+    case DispatchTypes::PrivateModeParams::XTERM_BracketedPasteMode:
+        fSuccess = EnableBracketedPasteMode(fEnable);
+        break;
     default:
         // If no functions to call, overall dispatch was a failure.
         fSuccess = false;
@@ -1262,11 +1124,11 @@ bool AdaptDispatch::DeleteLine(_In_ unsigned int const uiDistance)
 bool AdaptDispatch::_DoSetTopBottomScrollingMargins(const SHORT sTopMargin,
                                                     const SHORT sBottomMargin)
 {
-    CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
-    csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
+    COORD coordCursor = { 0 };
+    SMALL_RECT srViewport = { 0 };
     // Make sure to reset the viewport (with MoveToBottom )to where it was
     //      before the user scrolled the console output
-    bool fSuccess = !!(_conApi->MoveToBottom() && _conApi->GetConsoleScreenBufferInfoEx(&csbiex));
+    bool fSuccess = !!(_conApi->MoveToBottom() && _conApi->PrivateGetCursorAndViewport(&coordCursor, &srViewport));
 
     // so notes time: (input -> state machine out -> adapter out -> conhost internal)
     // having only a top param is legal         ([3;r   -> 3,0   -> 3,h  -> 3,h,true)
@@ -1277,7 +1139,7 @@ bool AdaptDispatch::_DoSetTopBottomScrollingMargins(const SHORT sTopMargin,
     {
         SHORT sActualTop = sTopMargin;
         SHORT sActualBottom = sBottomMargin;
-        SHORT sScreenHeight = csbiex.srWindow.Bottom - csbiex.srWindow.Top;
+        SHORT sScreenHeight = srViewport.Bottom - srViewport.Top;
         if ( sActualTop == 0 && sActualBottom == 0)
         {
             // Disable Margins
@@ -1743,6 +1605,31 @@ bool AdaptDispatch::EnableAlternateScroll(const bool fEnabled)
     return !!_conApi->PrivateEnableAlternateScroll(fEnabled);
 }
 
+//Routine Description:
+// Enable Bracketed Paste Mode - Text pasted into the console is sent to the
+//      client wrapped in ESC[200~ and ESC[201~, so that it can tell pasted
+//      text from typed keys.
+//Arguments:
+// - fEnabled - true to enable, false to disable.
+// Return value:
+// True if handled successfully. False othewise.
+bool AdaptDispatch::EnableBracketedPasteMode(const bool fEnabled)
+{
+    const bool fSuccess = !!_conApi->PrivateEnableBracketedPasteMode(fEnabled);
+
+    // If we're a conpty, always return false, so that the mode is passed on to
+    //      the terminal, which is the one that actually gets the paste. Still
+    //      record it, for pastes made into the console itself.
+    bool isPty = false;
+    _conApi->IsConsolePty(&isPty);
+    if (isPty)
+    {
+        return false;
+    }
+
+    return fSuccess;
+}
+
 //Routine Description:
 // Set Cursor Style - Changes the cursor's style to match the given Dispatch
 //      cursor style. Unix styles are a combination of the shape and the blinking state.
@@ -93,6 +93,7 @@ namespace Microsoft::Console::VirtualTerminal
         virtual bool EnableButtonEventMouseMode(const bool fEnabled); // ?1002
         virtual bool EnableAnyEventMouseMode(const bool fEnabled); // ?1003
         virtual bool EnableAlternateScroll(const bool fEnabled); // ?1007
+        virtual bool EnableBracketedPasteMode(const bool fEnabled); // ?2004
         virtual bool SetCursorStyle(const DispatchTypes::CursorStyle cursorStyle); // DECSCUSR
         virtual bool SetCursorColor(const COLORREF cursorColor);
 
@@ -121,7 +122,7 @@ namespace Microsoft::Console::VirtualTerminal
 
         bool _CursorMovement(const CursorDirection dir, _In_ unsigned int const uiDistance) const;
         bool _CursorMovePosition(_In_opt_ const unsigned int* const puiRow, _In_opt_ const unsigned int* const puiCol) const;
-        bool _EraseSingleLineHelper(const CONSOLE_SCREEN_BUFFER_INFOEX* const pcsbiex, const DispatchTypes::EraseType eraseType, const SHORT sLineId, const WORD wFillColor) const;
+        bool _EraseSingleLineHelper(const COORD coordCursor, const SMALL_RECT srViewport, const DispatchTypes::EraseType eraseType, const SHORT sLineId) const;
         void _SetGraphicsOptionHelper(const DispatchTypes::GraphicsOptions opt, _Inout_ WORD* const pAttr);
         bool _EraseAreaHelper(const COORD coordStartPosition, const COORD coordLastPosition, const WORD wFillColor);
         bool _EraseSingleLineDistanceHelper(const COORD coordStartPosition, const DWORD dwLength, const WORD wFillColor) const;
@@ -85,6 +85,7 @@ namespace Microsoft::Console::VirtualTerminal
         virtual BOOL PrivateEnableButtonEventMouseMode(const bool fEnabled) = 0;
         virtual BOOL PrivateEnableAnyEventMouseMode(const bool fEnabled) = 0;
         virtual BOOL PrivateEnableAlternateScroll(const bool fEnabled) = 0;
+        virtual BOOL PrivateEnableBracketedPasteMode(const bool fEnabled) = 0;
         virtual BOOL PrivateEraseAll() = 0;
         virtual BOOL SetCursorStyle(const CursorType cursorType) = 0;
         virtual BOOL SetCursorColor(const COLORREF cursorColor) = 0;
@@ -104,6 +105,12 @@ namespace Microsoft::Console::VirtualTerminal
         virtual BOOL DeleteLines(const unsigned int count) = 0;
         virtual BOOL InsertLines(const unsigned int count) = 0;
 
+        virtual BOOL PrivateGetCursorAndViewport(_Out_ COORD* const pCursorPosition,
+                                                 _Out_ SMALL_RECT* const psrViewport) const = 0;
+        virtual BOOL InsertCharacters(const unsigned int count) = 0;
+        virtual BOOL DeleteCharacters(const unsigned int count) = 0;
+        virtual BOOL EraseCells(const SMALL_RECT* const psrRegion) = 0;
+
         virtual BOOL MoveToBottom() const = 0;
 
         virtual BOOL PrivateSetColorTableEntry(const short index, const COLORREF value) const = 0;
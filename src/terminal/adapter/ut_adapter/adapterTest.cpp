@@ -652,6 +652,16 @@ public:
         return _fPrivateEnableAlternateScrollResult;
     }
 
+    BOOL PrivateEnableBracketedPasteMode(const bool fEnabled) override
+    {
+        Log::Comment(L"PrivateEnableBracketedPasteMode MOCK called...");
+        if (_fPrivateEnableBracketedPasteModeResult)
+        {
+            VERIFY_ARE_EQUAL(_fExpectedBracketedPasteEnabled, fEnabled);
+        }
+        return _fPrivateEnableBracketedPasteModeResult;
+    }
+
     BOOL PrivateEraseAll() override
     {
         Log::Comment(L"PrivateEraseAll MOCK called...");
@@ -736,6 +746,103 @@ public:
         return TRUE;
     }
 
+    BOOL PrivateGetCursorAndViewport(_Out_ COORD* const pCursorPosition, _Out_ SMALL_RECT* const psrViewport) const override
+    {
+        Log::Comment(L"PrivateGetCursorAndViewport MOCK returning data...");
+
+        if (_fPrivateGetCursorAndViewportResult)
+        {
+            *pCursorPosition = _coordCursorPos;
+            *psrViewport = _srViewport;
+        }
+
+        return _fPrivateGetCursorAndViewportResult;
+    }
+
+    BOOL InsertCharacters(const unsigned int count) override
+    {
+        Log::Comment(L"InsertCharacters MOCK called...");
+
+        if (_fInsertDeleteCharactersResult)
+        {
+            _ShiftCharacters(count, true);
+        }
+
+        return _fInsertDeleteCharactersResult;
+    }
+
+    BOOL DeleteCharacters(const unsigned int count) override
+    {
+        Log::Comment(L"DeleteCharacters MOCK called...");
+
+        if (_fInsertDeleteCharactersResult)
+        {
+            _ShiftCharacters(count, false);
+        }
+
+        return _fInsertDeleteCharactersResult;
+    }
+
+    BOOL EraseCells(const SMALL_RECT* const psrRegion) override
+    {
+        Log::Comment(L"EraseCells MOCK called...");
+
+        if (_fEraseCellsResult)
+        {
+            Log::Comment(NoThrowString().Format(L"Erasing area (L: %d, R: %d, T: %d, B: %d) with attr 0x%x", psrRegion->Left, psrRegion->Right, psrRegion->Top, psrRegion->Bottom, _wAttribute));
+
+            // The region is inclusive on all sides.
+            for (SHORT iRow = psrRegion->Top; iRow <= psrRegion->Bottom; iRow++)
+            {
+                for (SHORT iCol = psrRegion->Left; iCol <= psrRegion->Right; iCol++)
+                {
+                    CHAR_INFO* const pci = _GetCharAt(iRow, iCol);
+                    pci->Char.UnicodeChar = L' ';
+                    pci->Attributes = _wAttribute;
+                }
+            }
+        }
+
+        return _fEraseCellsResult;
+    }
+
+    // Moves the rest of the cursor's row within the viewport over by count,
+    //      filling what's left behind with spaces in the current attributes.
+    void _ShiftCharacters(const unsigned int count, const bool fIsInsert)
+    {
+        const SHORT sRight = _srViewport.Right; // exclusive
+        const SHORT sWidth = sRight - _coordCursorPos.X;
+        if (sWidth <= 0)
+        {
+            return;
+        }
+        const SHORT sBlank = static_cast<SHORT>(std::min<unsigned int>(count, sWidth));
+
+        std::vector<CHAR_INFO> row;
+        for (SHORT iCol = _coordCursorPos.X; iCol < sRight; iCol++)
+        {
+            row.push_back(*_GetCharAt(_coordCursorPos.Y, iCol));
+        }
+
+        CHAR_INFO ciFill;
+        ciFill.Char.UnicodeChar = L' ';
+        ciFill.Attributes = _wAttribute;
+
+        for (SHORT i = 0; i < sWidth; i++)
+        {
+            CHAR_INFO ci = ciFill;
+            if (fIsInsert && i >= sBlank)
+            {
+                ci = row[i - sBlank];
+            }
+            else if (!fIsInsert && i < sWidth - sBlank)
+            {
+                ci = row[i + sBlank];
+            }
+            *_GetCharAt(_coordCursorPos.Y, _coordCursorPos.X + i) = ci;
+        }
+    }
+
     BOOL PrivateSetDefaultAttributes(const bool fForeground,
                                      const bool fBackground) override
     {
@@ -840,6 +947,9 @@ public:
         _fSetConsoleWindowInfoResult = TRUE;
         _fPrivateGetConsoleScreenBufferAttributesResult = TRUE;
         _fMoveToBottomResult = true;
+        _fPrivateGetCursorAndViewportResult = TRUE;
+        _fInsertDeleteCharactersResult = TRUE;
+        _fEraseCellsResult = TRUE;
 
         _PrepCharsBuffer(wch, wAttr);
 
@@ -1354,12 +1464,14 @@ public:
     bool _fExpectedClearAll = false;
     bool _fExpectedMouseEnabled = false;
     bool _fExpectedAlternateScrollEnabled = false;
+    bool _fExpectedBracketedPasteEnabled = false;
     BOOL _fPrivateEnableVT200MouseModeResult = false;
     BOOL _fPrivateEnableUTF8ExtendedMouseModeResult = false;
     BOOL _fPrivateEnableSGRExtendedMouseModeResult = false;
     BOOL _fPrivateEnableButtonEventMouseModeResult = false;
     BOOL _fPrivateEnableAnyEventMouseModeResult = false;
     BOOL _fPrivateEnableAlternateScrollResult = false;
+    BOOL _fPrivateEnableBracketedPasteModeResult = false;
     BOOL _fSetConsoleXtermTextAttributeResult = false;
     BOOL _fSetConsoleRGBTextAttributeResult = false;
     BOOL _fPrivateSetLegacyAttributesResult = false;
@@ -1373,6 +1485,9 @@ public:
     bool _fMoveCursorVerticallyResult = false;
     bool _fPrivateSetDefaultAttributesResult = false;
     bool _fMoveToBottomResult = false;
+    BOOL _fPrivateGetCursorAndViewportResult = false;
+    BOOL _fInsertDeleteCharactersResult = false;
+    BOOL _fEraseCellsResult = false;
 
     bool _fPrivateSetColorTableEntryResult = false;
     short _expectedColorTableIndex = -1;
@@ -1642,13 +1757,13 @@ public:
         VERIFY_IS_FALSE((_pDispatch->*(moveFunc))(0));
         VERIFY_ARE_EQUAL(_testGetSet->_coordExpectedCursorPos, _testGetSet->_coordCursorPos);
 
-        // GetConsoleScreenBufferInfo throws failure. Parameters are otherwise normal.
-        Log::Comment(L"Test 7: When GetConsoleScreenBufferInfo throws a failure, call fails and cursor doesn't move.");
+        // PrivateGetCursorAndViewport throws failure. Parameters are otherwise normal.
+        Log::Comment(L"Test 7: When PrivateGetCursorAndViewport throws a failure, call fails and cursor doesn't move.");
         _testGetSet->PrepData(CursorX::LEFT, CursorY::TOP);
-        _testGetSet->_fGetConsoleScreenBufferInfoExResult = FALSE;
+        _testGetSet->_fPrivateGetCursorAndViewportResult = FALSE;
         _testGetSet->_fMoveCursorVerticallyResult = true;
         Log::Comment(NoThrowString().Format(
-            L"Cursor Up and Down don't need GetConsoleScreenBufferInfoEx, so they will succeed"
+            L"Cursor Up and Down don't need PrivateGetCursorAndViewport, so they will succeed"
         ));
         if (direction == CursorDirection::UP || direction == CursorDirection::DOWN)
         {
@@ -1712,7 +1827,7 @@ public:
         Log::Comment(L"Test 6: GetConsoleInfo API returns false. No move, return false.");
         _testGetSet->PrepData(CursorX::LEFT, CursorY::TOP);
 
-        _testGetSet->_fGetConsoleScreenBufferInfoExResult = FALSE;
+        _testGetSet->_fPrivateGetCursorAndViewportResult = FALSE;
 
         VERIFY_IS_FALSE(_pDispatch->CursorPosition(1, 1));
 
@@ -1821,7 +1936,7 @@ public:
         Log::Comment(L"Test 6: GetConsoleInfo API returns false. No move, return false.");
         _testGetSet->PrepData(CursorX::LEFT, CursorY::TOP);
 
-        _testGetSet->_fGetConsoleScreenBufferInfoExResult = FALSE;
+        _testGetSet->_fPrivateGetCursorAndViewportResult = FALSE;
 
         sVal = 1;
 
@@ -2053,6 +2168,12 @@ public:
 
         // The inserted spaces at the left edge resulted in an entire line of spaces bounded by the viewport
         VERIFY_IS_TRUE(_testGetSet->ValidateRectangleContains(srModifiedSpace, wchInsertExpected, wAttrInsertExpected), L"A whole line of spaces was inserted at the cursor position. All extra spaces were discarded as they hit the right boundary.");
+
+        Log::Comment(L"Test 4: Gracefully fail when the console fails to insert the characters.");
+        _testGetSet->PrepData(CursorX::XCENTER, CursorY::YCENTER);
+        _testGetSet->_fInsertDeleteCharactersResult = FALSE;
+
+        VERIFY_IS_FALSE(_pDispatch->InsertCharacter(cchInsertSize));
     }
 
     TEST_METHOD(DeleteCharacterTests)
@@ -2216,6 +2337,12 @@ public:
 
         // The inserted spaces at the left edge resulted in an entire line of spaces bounded by the viewport
         VERIFY_IS_TRUE(_testGetSet->ValidateRectangleContains(srModifiedSpace, wchDeleteExpected, wAttrDeleteExpected), L"A whole line of spaces was inserted from the right (the cursor position was deleted enough times.) Extra deletes just covered up some of the spaces that were shifted in.");
+
+        Log::Comment(L"Test 4: Gracefully fail when the console fails to delete the characters.");
+        _testGetSet->PrepData(CursorX::XCENTER, CursorY::YCENTER);
+        _testGetSet->_fInsertDeleteCharactersResult = FALSE;
+
+        VERIFY_IS_FALSE(_pDispatch->DeleteCharacter(cchDeleteSize));
     }
 
     // Ensures that EraseScrollback (^[[3J) deletes any content from the buffer
@@ -2434,7 +2561,7 @@ public:
 
         Log::Comment(L"Test 2: Gracefully fail when getting console information fails.");
         _testGetSet->PrepData();
-        _testGetSet->_fGetConsoleScreenBufferInfoExResult = false;
+        _testGetSet->_fPrivateGetCursorAndViewportResult = false;
 
         if (!fEraseScreen)
         {
@@ -2445,9 +2572,9 @@ public:
             VERIFY_IS_FALSE(_pDispatch->EraseInDisplay(eraseType));
         }
 
-        Log::Comment(L"Test 3: Gracefully fail when filling the rectangle fails.");
+        Log::Comment(L"Test 3: Gracefully fail when erasing the rectangle fails.");
         _testGetSet->PrepData();
-        _testGetSet->_fFillConsoleOutputCharacterWResult = false;
+        _testGetSet->_fEraseCellsResult = false;
 
         if (!fEraseScreen)
         {
@@ -3150,7 +3277,7 @@ public:
         SMALL_RECT srTestMargins = { 0 };
         _testGetSet->_srViewport.Right = 8;
         _testGetSet->_srViewport.Bottom = 8;
-        _testGetSet->_fGetConsoleScreenBufferInfoExResult = TRUE;
+        _testGetSet->_fPrivateGetCursorAndViewportResult = TRUE;
 
         Log::Comment(L"Test 1: Verify having both values is valid.");
         _testGetSet->_SetMarginsHelper(&srTestMargins, 2, 6);
@@ -3303,6 +3430,33 @@ public:
         VERIFY_IS_TRUE(_pDispatch->EnableAlternateScroll(false));
     }
 
+    TEST_METHOD(TestBracketedPasteMode)
+    {
+        Log::Comment(L"Starting test...");
+
+        Log::Comment(L"Test 1: Enable and disable bracketed paste mode");
+        _testGetSet->_fExpectedBracketedPasteEnabled = true;
+        _testGetSet->_fPrivateEnableBracketedPasteModeResult = TRUE;
+        VERIFY_IS_TRUE(_pDispatch->EnableBracketedPasteMode(true));
+        _testGetSet->_fExpectedBracketedPasteEnabled = false;
+        VERIFY_IS_TRUE(_pDispatch->EnableBracketedPasteMode(false));
+
+        Log::Comment(L"Test 2: DECSET/DECRST 2004 reach bracketed paste mode");
+        DispatchTypes::PrivateModeParams rgParams[] = { DispatchTypes::PrivateModeParams::XTERM_BracketedPasteMode };
+        _testGetSet->_fExpectedBracketedPasteEnabled = true;
+        VERIFY_IS_TRUE(_pDispatch->SetPrivateModes(rgParams, ARRAYSIZE(rgParams)));
+        _testGetSet->_fExpectedBracketedPasteEnabled = false;
+        VERIFY_IS_TRUE(_pDispatch->ResetPrivateModes(rgParams, ARRAYSIZE(rgParams)));
+
+        Log::Comment(L"Test 3: In pty mode the mode is still set, but the sequence is passed through");
+        _testGetSet->_fIsPty = true;
+        _testGetSet->_fIsConsolePtyResult = true;
+        _testGetSet->_fExpectedBracketedPasteEnabled = true;
+        VERIFY_IS_FALSE(_pDispatch->EnableBracketedPasteMode(true));
+        _testGetSet->_fExpectedBracketedPasteEnabled = false;
+        VERIFY_IS_FALSE(_pDispatch->ResetPrivateModes(rgParams, ARRAYSIZE(rgParams)));
+    }
+
     TEST_METHOD(Xterm256ColorTest)
     {
         Log::Comment(L"Starting test...");
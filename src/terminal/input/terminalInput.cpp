@@ -213,6 +213,19 @@ void TerminalInput::ChangeCursorKeysMode(const bool fApplicationMode)
     _fCursorApplicationMode = fApplicationMode;
 }
 
+// Bracketed paste mode (DECSET 2004) asks for pasted text to be wrapped in
+//      ESC[200~ and ESC[201~. The paste itself doesn't come through here as
+//      keys, the input buffer writes it as text and asks us for the mode.
+void TerminalInput::EnableBracketedPasteMode(const bool fEnable)
+{
+    _fBracketedPasteMode = fEnable;
+}
+
+bool TerminalInput::IsBracketedPasteModeEnabled() const
+{
+    return _fBracketedPasteMode;
+}
+
 const size_t TerminalInput::GetKeyMappingLength(const KeyEvent& keyEvent) const
 {
     size_t length = 0;
@@ -28,12 +28,15 @@ namespace Microsoft::Console::VirtualTerminal
         bool HandleKey(const IInputEvent* const pInEvent) const;
         void ChangeKeypadMode(const bool fApplicationMode);
         void ChangeCursorKeysMode(const bool fApplicationMode);
+        void EnableBracketedPasteMode(const bool fEnable);
+        bool IsBracketedPasteModeEnabled() const;
 
     private:
 
         std::function<void(std::deque<std::unique_ptr<IInputEvent>>&)> _pfnWriteEvents;
         bool _fKeypadApplicationMode = false;
         bool _fCursorApplicationMode = false;
+        bool _fBracketedPasteMode = false;
 
         void _SendNullInputSequence(const DWORD dwControlKeyState) const;
         void _SendInputSequence(_In_ PCWSTR const pwszSequence) const;
@@ -0,0 +1,44 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "allocationCounter.hpp"
+
+static std::atomic<size_t> s_cAllocations{ 0 };
+static std::atomic<size_t> s_cbAllocated{ 0 };
+
+size_t Microsoft::Console::Perf::GetAllocationCount() noexcept
+{
+    return s_cAllocations.load();
+}
+
+size_t Microsoft::Console::Perf::GetAllocatedBytes() noexcept
+{
+    return s_cbAllocated.load();
+}
+
+// The array and nothrow forms of new and delete all route through these, so
+//      replacing them is enough to see every allocation.
+void* __cdecl operator new(size_t cb)
+{
+    s_cAllocations++;
+    s_cbAllocated += cb;
+
+    void* const pv = malloc(cb == 0 ? 1 : cb);
+    if (pv == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return pv;
+}
+
+void __cdecl operator delete(void* pv) noexcept
+{
+    free(pv);
+}
+
+void __cdecl operator delete(void* pv, size_t /*cb*/) noexcept
+{
+    free(pv);
+}
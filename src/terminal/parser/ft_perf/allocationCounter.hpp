@@ -0,0 +1,21 @@
+/*++
+Copyright (c) Microsoft Corporation.
+Licensed under the MIT license.
+
+Module Name:
+- allocationCounter.hpp
+
+Abstract:
+- Counts the heap allocations made through operator new in this process.
+- The perf harnesses replace the global operator new/delete so that they can
+  report allocations alongside their timings. The parser and text buffer
+  harnesses both build this one copy.
+--*/
+
+#pragma once
+
+namespace Microsoft::Console::Perf
+{
+    size_t GetAllocationCount() noexcept;
+    size_t GetAllocatedBytes() noexcept;
+}
@@ -0,0 +1,307 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "corpora.hpp"
+
+using namespace Microsoft::Console::VirtualTerminal::Perf;
+
+namespace
+{
+    // A tiny xorshift generator. We don't use <random> here because the
+    //      distributions aren't guaranteed to produce the same sequence across
+    //      STL implementations, and the corpora need to be identical
+    //      everywhere.
+    class Generator final
+    {
+    public:
+        Generator(const uint32_t seed) noexcept :
+            _state(seed)
+        {
+        }
+
+        uint32_t Next() noexcept
+        {
+            _state ^= _state << 13;
+            _state ^= _state >> 17;
+            _state ^= _state << 5;
+            return _state;
+        }
+
+        // Returns a value in [0, range)
+        uint32_t Next(const uint32_t range) noexcept
+        {
+            return Next() % range;
+        }
+
+    private:
+        uint32_t _state;
+    };
+
+    constexpr std::wstring_view s_rgWords[] = {
+        L"Compiling", L"Linking", L"warning", L"C4100:", L"unreferenced", L"formal", L"parameter",
+        L"src\\host\\output.cpp", L"src\\buffer\\out\\textBuffer.cpp", L"-->", L"Build", L"succeeded.",
+        L"0", L"error(s),", L"12", L"warning(s)", L"Time", L"Elapsed", L"00:01:23.45", L"[100%]",
+        L"Generating", L"code", L"Finished", L"generating", L"obj\\x64\\Release\\OpenConsole.exe"
+    };
+
+    constexpr std::wstring_view s_rgFileNames[] = {
+        L"README.md", L"build", L"src", L"tools", L"dep", L"OpenConsole.sln", L".gitignore",
+        L"CONTRIBUTING.md", L"LICENSE", L"NuGet.Config", L"res", L"doc", L"scratch.cpp"
+    };
+
+    // Mostly short words, with the odd surrogate pair (emoji) mixed in.
+    constexpr std::wstring_view s_rgIntlWords[] = {
+        L"\x65e5\x672c\x8a9e", L"\x4e2d\x6587", L"\xd55c\xad6d\xc5b4", L"\x0440\x0443\x0441\x0441\x043a\x0438\x0439",
+        L"\x3053\x3093\x306b\x3061\x306f", L"\xd83d\xde00", L"\xd83d\xdc4d\xd83c\xdffd", L"caf\x00e9",
+        L"\x0627\x0644\x0639\x0631\x0628\x064a\x0629", L"\xd83c\xdf89", L"\x1f00\x03b8\x03b1"
+    };
+
+    template<typename T, size_t N>
+    const T& _Pick(Generator& rng, const T (&rg)[N]) noexcept
+    {
+        return rg[rng.Next(N)];
+    }
+
+    std::wstring _GenerateBuildLog(Generator& rng, const size_t cchTarget)
+    {
+        std::wstring text;
+        text.reserve(cchTarget + 256);
+        while (text.size() < cchTarget)
+        {
+            const auto cWords = 4 + rng.Next(12);
+            for (uint32_t i = 0; i < cWords; i++)
+            {
+                if (i > 0)
+                {
+                    text += L' ';
+                }
+                text += _Pick(rng, s_rgWords);
+            }
+            text += L"\r\n";
+        }
+        return text;
+    }
+
+    std::wstring _GenerateColorListing(Generator& rng, const size_t cchTarget)
+    {
+        std::wstring text;
+        text.reserve(cchTarget + 256);
+        while (text.size() < cchTarget)
+        {
+            const auto cEntries = 1 + rng.Next(6);
+            for (uint32_t i = 0; i < cEntries; i++)
+            {
+                switch (rng.Next(3))
+                {
+                case 0:
+                    // 16 color, possibly bold.
+                    text += L"\x1b[";
+                    text += rng.Next(2) ? L"01;" : L"00;";
+                    text += std::to_wstring(30 + rng.Next(8));
+                    text += L"m";
+                    break;
+                case 1:
+                    // 256 color
+                    text += L"\x1b[38;5;";
+                    text += std::to_wstring(rng.Next(256));
+                    text += L"m";
+                    break;
+                default:
+                    // Truecolor
+                    text += L"\x1b[38;2;";
+                    text += std::to_wstring(rng.Next(256));
+                    text += L';';
+                    text += std::to_wstring(rng.Next(256));
+                    text += L';';
+                    text += std::to_wstring(rng.Next(256));
+                    text += L"m";
+                    break;
+                }
+                text += _Pick(rng, s_rgFileNames);
+                text += L"\x1b[0m  ";
+            }
+            text += L"\r\n";
+        }
+        return text;
+    }
+
+    std::wstring _GenerateFullScreenFrames(Generator& rng, const size_t cchTarget)
+    {
+        constexpr uint32_t cRows = 30;
+        constexpr uint32_t cCols = 120;
+
+        std::wstring text;
+        text.reserve(cchTarget + 4096);
+        while (text.size() < cchTarget)
+        {
+            // One frame, the way a top-like app would repaint: hide the
+            //      cursor, address each row, recolor a few fields, clear to
+            //      end of line, then show the cursor again.
+            text += L"\x1b[?25l\x1b[H";
+            if (rng.Next(16) == 0)
+            {
+                text += L"\x1b[2J";
+            }
+            for (uint32_t row = 1; row <= cRows; row++)
+            {
+                text += L"\x1b[";
+                text += std::to_wstring(row);
+                text += L";1H";
+
+                uint32_t col = 0;
+                while (col < cCols - 20)
+                {
+                    text += L"\x1b[";
+                    text += std::to_wstring(rng.Next(2) ? 30 + rng.Next(8) : 90 + rng.Next(8));
+                    text += L";";
+                    text += std::to_wstring(40 + rng.Next(8));
+                    text += L"m";
+
+                    const auto cchField = 4 + rng.Next(12);
+                    for (uint32_t i = 0; i < cchField; i++)
+                    {
+                        text += static_cast<wchar_t>(L'0' + rng.Next(10));
+                    }
+                    text += L' ';
+                    col += cchField + 1;
+                }
+                text += L"\x1b[m\x1b[K";
+            }
+            text += L"\x1b[?25h";
+        }
+        return text;
+    }
+
+    std::wstring _GenerateLineEditing(Generator& rng, const size_t cchTarget)
+    {
+        constexpr uint32_t cRows = 30;
+        constexpr uint32_t cCols = 120;
+
+        std::wstring text;
+        text.reserve(cchTarget + 256);
+        while (text.size() < cchTarget)
+        {
+            // One edit, the way an editor or a shell's line editor updates the
+            //      screen: jump to a cell, then insert, delete or erase a few
+            //      characters around the cursor and retype the changed part.
+            text += L"\x1b[";
+            text += std::to_wstring(1 + rng.Next(cRows));
+            text += L';';
+            text += std::to_wstring(1 + rng.Next(cCols));
+            text += L'H';
+
+            const auto cOps = 1 + rng.Next(4);
+            for (uint32_t i = 0; i < cOps; i++)
+            {
+                text += L"\x1b[";
+                switch (rng.Next(6))
+                {
+                case 0:
+                    text += std::to_wstring(1 + rng.Next(8));
+                    text += L'@'; // ICH
+                    break;
+                case 1:
+                    text += std::to_wstring(1 + rng.Next(8));
+                    text += L'P'; // DCH
+                    break;
+                case 2:
+                    text += std::to_wstring(1 + rng.Next(16));
+                    text += L'X'; // ECH
+                    break;
+                case 3:
+                    text += rng.Next(2) ? L"K" : L"1K"; // EL
+                    break;
+                case 4:
+                    text += std::to_wstring(1 + rng.Next(8));
+                    text += L'C'; // CUF
+                    break;
+                default:
+                    text += std::to_wstring(1 + rng.Next(8));
+                    text += L'D'; // CUB
+                    break;
+                }
+
+                const auto cchTyped = rng.Next(8);
+                for (uint32_t ch = 0; ch < cchTyped; ch++)
+                {
+                    text += static_cast<wchar_t>(L'a' + rng.Next(26));
+                }
+            }
+        }
+        return text;
+    }
+
+    std::wstring _GenerateInternational(Generator& rng, const size_t cchTarget)
+    {
+        std::wstring text;
+        text.reserve(cchTarget + 256);
+        while (text.size() < cchTarget)
+        {
+            const auto cWords = 3 + rng.Next(10);
+            for (uint32_t i = 0; i < cWords; i++)
+            {
+                if (i > 0)
+                {
+                    text += L' ';
+                }
+                text += _Pick(rng, s_rgIntlWords);
+            }
+            text += L"\r\n";
+        }
+        return text;
+    }
+}
+
+// Routine Description:
+// - Builds each of the built-in corpora.
+// Arguments:
+// - cchTarget - The approximate length, in characters, of each corpus.
+// Return Value:
+// - The corpora, in a stable order.
+std::vector<Corpus> Microsoft::Console::VirtualTerminal::Perf::GenerateCorpora(const size_t cchTarget)
+{
+    // The seed is arbitrary, it just has to never change.
+    Generator rng{ 0x5eed1e55 };
+
+    std::vector<Corpus> corpora;
+    corpora.push_back({ L"build-log", _GenerateBuildLog(rng, cchTarget) });
+    corpora.push_back({ L"color-listing", _GenerateColorListing(rng, cchTarget) });
+    corpora.push_back({ L"full-screen", _GenerateFullScreenFrames(rng, cchTarget) });
+    corpora.push_back({ L"international", _GenerateInternational(rng, cchTarget) });
+    // Generated last so that adding it didn't change the corpora before it.
+    corpora.push_back({ L"line-editing", _GenerateLineEditing(rng, cchTarget) });
+    return corpora;
+}
+
+// Routine Description:
+// - Reads a UTF-8 file (for instance, a recorded session) to use as a corpus.
+// Arguments:
+// - path - The file to read.
+// Return Value:
+// - The corpus, named after the file.
+Corpus Microsoft::Console::VirtualTerminal::Perf::LoadCorpus(const std::wstring& path)
+{
+    wil::unique_file file{ _wfopen(path.c_str(), L"rb") };
+    THROW_LAST_ERROR_IF_NULL(file);
+
+    std::string bytes;
+    char rgch[4096];
+    size_t cchRead = 0;
+    while ((cchRead = fread(rgch, 1, ARRAYSIZE(rgch), file.get())) > 0)
+    {
+        bytes.append(rgch, cchRead);
+    }
+
+    Corpus corpus;
+    corpus.name = path;
+    if (!bytes.empty())
+    {
+        const auto cchWide = MultiByteToWideChar(CP_UTF8, 0, bytes.data(), gsl::narrow<int>(bytes.size()), nullptr, 0);
+        THROW_LAST_ERROR_IF(cchWide == 0);
+        corpus.text.resize(cchWide);
+        THROW_LAST_ERROR_IF(0 == MultiByteToWideChar(CP_UTF8, 0, bytes.data(), gsl::narrow<int>(bytes.size()), corpus.text.data(), cchWide));
+    }
+    return corpus;
+}
@@ -0,0 +1,30 @@
+/*++
+Copyright (c) Microsoft Corporation.
+Licensed under the MIT license.
+
+Module Name:
+- corpora.hpp
+
+Abstract:
+- The text the perf harness feeds through the parser.
+- The built-in corpora are generated from a fixed seed, so that every run (and
+  every machine) parses exactly the same input. Each approximates a workload
+  we care about: plain build output, colorized directory listings, full-screen
+  cursor-addressed TUIs, non-ASCII text, and the cursor moves, inserts,
+  deletes and erases of line editing.
+--*/
+
+#pragma once
+
+namespace Microsoft::Console::VirtualTerminal::Perf
+{
+    struct Corpus
+    {
+        std::wstring name;
+        std::wstring text;
+    };
+
+    std::vector<Corpus> GenerateCorpora(const size_t cchTarget);
+
+    Corpus LoadCorpus(const std::wstring& path);
+}
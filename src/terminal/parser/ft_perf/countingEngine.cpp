@@ -0,0 +1,115 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "countingEngine.hpp"
+
+using namespace Microsoft::Console::VirtualTerminal;
+using namespace Microsoft::Console::VirtualTerminal::Perf;
+
+CountingEngine::CountingEngine(IStateMachineEngine* const pEngine) :
+    _pEngine(THROW_IF_NULL_ALLOC(pEngine)),
+    _cDispatches(0)
+{
+}
+
+size_t CountingEngine::GetDispatchCount() const noexcept
+{
+    return _cDispatches;
+}
+
+void CountingEngine::ResetDispatchCount() noexcept
+{
+    _cDispatches = 0;
+}
+
+bool CountingEngine::ActionExecute(const wchar_t wch)
+{
+    _cDispatches++;
+    return _pEngine->ActionExecute(wch);
+}
+
+bool CountingEngine::ActionExecuteFromEscape(const wchar_t wch)
+{
+    _cDispatches++;
+    return _pEngine->ActionExecuteFromEscape(wch);
+}
+
+bool CountingEngine::ActionPrint(const wchar_t wch)
+{
+    _cDispatches++;
+    return _pEngine->ActionPrint(wch);
+}
+
+bool CountingEngine::ActionPrintString(const wchar_t* const rgwch, size_t const cch)
+{
+    // The state machine hands us empty runs between back-to-back sequences.
+    //      Those don't reach the dispatch, so don't count them.
+    if (cch > 0)
+    {
+        _cDispatches++;
+    }
+    return _pEngine->ActionPrintString(rgwch, cch);
+}
+
+bool CountingEngine::ActionPassThroughString(const wchar_t* const rgwch, size_t const cch)
+{
+    _cDispatches++;
+    return _pEngine->ActionPassThroughString(rgwch, cch);
+}
+
+bool CountingEngine::ActionEscDispatch(const wchar_t wch,
+                                       const unsigned short cIntermediate,
+                                       const wchar_t wchIntermediate)
+{
+    _cDispatches++;
+    return _pEngine->ActionEscDispatch(wch, cIntermediate, wchIntermediate);
+}
+
+bool CountingEngine::ActionCsiDispatch(const wchar_t wch,
+                                       const unsigned short cIntermediate,
+                                       const wchar_t wchIntermediate,
+                                       _In_reads_(cParams) const unsigned short* const rgusParams,
+                                       const unsigned short cParams)
+{
+    _cDispatches++;
+    return _pEngine->ActionCsiDispatch(wch, cIntermediate, wchIntermediate, rgusParams, cParams);
+}
+
+bool CountingEngine::ActionClear()
+{
+    return _pEngine->ActionClear();
+}
+
+bool CountingEngine::ActionIgnore()
+{
+    return _pEngine->ActionIgnore();
+}
+
+bool CountingEngine::ActionOscDispatch(const wchar_t wch,
+                                       const unsigned short sOscParam,
+                                       _Inout_updates_(cchOscString) wchar_t* const pwchOscStringBuffer,
+                                       const unsigned short cchOscString)
+{
+    _cDispatches++;
+    return _pEngine->ActionOscDispatch(wch, sOscParam, pwchOscStringBuffer, cchOscString);
+}
+
+bool CountingEngine::ActionSs3Dispatch(const wchar_t wch,
+                                       _In_reads_(cParams) const unsigned short* const rgusParams,
+                                       const unsigned short cParams)
+{
+    _cDispatches++;
+    return _pEngine->ActionSs3Dispatch(wch, rgusParams, cParams);
+}
+
+bool CountingEngine::FlushAtEndOfString() const
+{
+    return _pEngine->FlushAtEndOfString();
+}
+
+bool CountingEngine::DispatchControlCharsFromEscape() const
+{
+    return _pEngine->DispatchControlCharsFromEscape();
+}
@@ -0,0 +1,69 @@
+/*++
+Copyright (c) Microsoft Corporation.
+Licensed under the MIT license.
+
+Module Name:
+- countingEngine.hpp
+
+Abstract:
+- An IStateMachineEngine that forwards every action to another engine, and
+  counts how many of them were dispatches (anything that would reach an
+  ITermDispatch).
+- This lets the perf harness report dispatches/sec for any engine without
+  modifying it.
+--*/
+
+#pragma once
+
+#include "..\IStateMachineEngine.hpp"
+
+namespace Microsoft::Console::VirtualTerminal::Perf
+{
+    class CountingEngine final : public IStateMachineEngine
+    {
+    public:
+        // Takes ownership of pEngine.
+        CountingEngine(IStateMachineEngine* const pEngine);
+
+        size_t GetDispatchCount() const noexcept;
+        void ResetDispatchCount() noexcept;
+
+        bool ActionExecute(const wchar_t wch) override;
+        bool ActionExecuteFromEscape(const wchar_t wch) override;
+        bool ActionPrint(const wchar_t wch) override;
+        bool ActionPrintString(const wchar_t* const rgwch,
+                               size_t const cch) override;
+
+        bool ActionPassThroughString(const wchar_t* const rgwch,
+                                     size_t const cch) override;
+
+        bool ActionEscDispatch(const wchar_t wch,
+                               const unsigned short cIntermediate,
+                               const wchar_t wchIntermediate) override;
+        bool ActionCsiDispatch(const wchar_t wch,
+                               const unsigned short cIntermediate,
+                               const wchar_t wchIntermediate,
+                               _In_reads_(cParams) const unsigned short* const rgusParams,
+                               const unsigned short cParams) override;
+
+        bool ActionClear() override;
+
+        bool ActionIgnore() override;
+
+        bool ActionOscDispatch(const wchar_t wch,
+                               const unsigned short sOscParam,
+                               _Inout_updates_(cchOscString) wchar_t* const pwchOscStringBuffer,
+                               const unsigned short cchOscString) override;
+
+        bool ActionSs3Dispatch(const wchar_t wch,
+                               _In_reads_(cParams) const unsigned short* const rgusParams,
+                               const unsigned short cParams) override;
+
+        bool FlushAtEndOfString() const override;
+        bool DispatchControlCharsFromEscape() const override;
+
+    private:
+        std::unique_ptr<IStateMachineEngine> _pEngine;
+        size_t _cDispatches;
+    };
+}
@@ -0,0 +1,185 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "allocationCounter.hpp"
+#include "corpora.hpp"
+#include "countingEngine.hpp"
+#include "perfDispatch.hpp"
+#include "..\stateMachine.hpp"
+#include "..\OutputStateMachineEngine.hpp"
+#include "..\..\..\renderer\inc\DummyRenderTarget.hpp"
+
+using namespace Microsoft::Console::VirtualTerminal;
+using namespace Microsoft::Console::VirtualTerminal::Perf;
+using namespace Microsoft::Console::Perf;
+
+namespace
+{
+    // Approximately a few seconds worth of output from a chatty build.
+    constexpr size_t s_cchCorpus = 8 * 1024 * 1024;
+    constexpr size_t s_cchDefaultChunk = 4096;
+    constexpr unsigned int s_msDefaultTarget = 2000;
+
+    // The same size as a default conhost window, with the default scrollback.
+    constexpr COORD s_coordBufferSize{ 120, 9001 };
+
+    enum class Target
+    {
+        // Parser and output engine only, every dispatch is a no-op.
+        Null,
+        // The full adapter, over a text buffer with no console around it.
+        Adapt
+    };
+
+    struct Result
+    {
+        size_t cPasses;
+        double seconds;
+        size_t cDispatches;
+        size_t cAllocations;
+    };
+
+    void _PrintUsage()
+    {
+        wprintf(L"Usage: conterm.parser.perf.exe [-t <milliseconds>] [-c <chunk characters>] [<UTF-8 file> ...]\r\n");
+        wprintf(L"Parses each built-in corpus (and each file given) repeatedly for at least the given time.\r\n");
+        wprintf(L"Defaults: -t %u -c %zu\r\n", s_msDefaultTarget, s_cchDefaultChunk);
+    }
+
+    size_t _GetUtf8Length(const std::wstring& wstr)
+    {
+        if (wstr.empty())
+        {
+            return 0;
+        }
+        const auto cb = WideCharToMultiByte(CP_UTF8, 0, wstr.data(), gsl::narrow<int>(wstr.size()), nullptr, 0, nullptr, nullptr);
+        THROW_LAST_ERROR_IF(cb == 0);
+        return cb;
+    }
+
+    std::unique_ptr<StateMachine> _CreateMachine(const Target target, TextBuffer& buffer, COORD& coordCursor, CountingEngine*& pCounter)
+    {
+        ITermDispatch* pDispatch = nullptr;
+        if (target == Target::Null)
+        {
+            pDispatch = new NullDispatch();
+        }
+        else
+        {
+            pDispatch = new AdaptDispatch(new PerfGetSet(buffer, coordCursor, s_coordBufferSize),
+                                          new PerfDefaults(buffer, coordCursor, s_coordBufferSize));
+        }
+
+        // The machine owns the counting engine, which owns the output
+        //      engine, which owns the dispatch.
+        pCounter = new CountingEngine(new OutputStateMachineEngine(pDispatch));
+        return std::make_unique<StateMachine>(pCounter);
+    }
+
+    Result _Run(const Target target, const std::wstring& text, const size_t cchChunk, const std::chrono::milliseconds durationTarget)
+    {
+        DummyRenderTarget renderTarget;
+        TextBuffer buffer{ s_coordBufferSize, TextAttribute{ FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_RED }, CURSOR_SMALL_SIZE, renderTarget };
+        COORD coordCursor{ 0, 0 };
+        CountingEngine* pCounter = nullptr;
+        const auto machine = _CreateMachine(target, buffer, coordCursor, pCounter);
+
+        // Warm up once, so that the first pass doesn't pay for any lazy
+        //      initialization, or for faulting in the corpus.
+        machine->ProcessString(text);
+        pCounter->ResetDispatchCount();
+
+        Result result{};
+        const auto cAllocationsBefore = GetAllocationCount();
+        const auto start = std::chrono::steady_clock::now();
+        auto elapsed = std::chrono::steady_clock::duration::zero();
+        do
+        {
+            for (size_t i = 0; i < text.size(); i += cchChunk)
+            {
+                machine->ProcessString(text.data() + i, std::min(cchChunk, text.size() - i));
+            }
+            result.cPasses++;
+            elapsed = std::chrono::steady_clock::now() - start;
+        } while (elapsed < durationTarget);
+
+        result.seconds = std::chrono::duration<double>(elapsed).count();
+        result.cDispatches = pCounter->GetDispatchCount();
+        result.cAllocations = GetAllocationCount() - cAllocationsBefore;
+        return result;
+    }
+
+    void _Report(const Corpus& corpus, const Target target, const size_t cbUtf8, const Result& result)
+    {
+        const double mb = (static_cast<double>(cbUtf8) * result.cPasses) / (1024.0 * 1024.0);
+        wprintf(L"%-16s %-6s %10.2f MB/s %14.0f dispatches/s %10.2f allocs/MB\r\n",
+                corpus.name.c_str(),
+                target == Target::Null ? L"null" : L"adapt",
+                mb / result.seconds,
+                result.cDispatches / result.seconds,
+                mb > 0 ? result.cAllocations / mb : 0.0);
+    }
+}
+
+int __cdecl wmain(int argc, wchar_t* argv[])
+{
+    unsigned int msTarget = s_msDefaultTarget;
+    size_t cchChunk = s_cchDefaultChunk;
+    std::vector<std::wstring> files;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::wstring_view arg{ argv[i] };
+        if ((arg == L"-t" || arg == L"-c") && i + 1 < argc)
+        {
+            const auto value = _wtoi(argv[++i]);
+            if (value <= 0)
+            {
+                _PrintUsage();
+                return E_INVALIDARG;
+            }
+            if (arg == L"-t")
+            {
+                msTarget = value;
+            }
+            else
+            {
+                cchChunk = value;
+            }
+        }
+        else if (arg == L"-?" || arg == L"/?" || (!arg.empty() && arg.front() == L'-'))
+        {
+            _PrintUsage();
+            return E_INVALIDARG;
+        }
+        else
+        {
+            files.emplace_back(arg);
+        }
+    }
+
+    try
+    {
+        auto corpora = GenerateCorpora(s_cchCorpus);
+        for (const auto& file : files)
+        {
+            corpora.push_back(LoadCorpus(file));
+        }
+
+        wprintf(L"Chunk size: %zu characters, at least %u ms per run\r\n", cchChunk, msTarget);
+        for (const auto& corpus : corpora)
+        {
+            const auto cbUtf8 = _GetUtf8Length(corpus.text);
+            for (const auto target : { Target::Null, Target::Adapt })
+            {
+                const auto result = _Run(target, corpus.text, cchChunk, std::chrono::milliseconds(msTarget));
+                _Report(corpus, target, cbUtf8, result);
+            }
+        }
+    }
+    CATCH_RETURN();
+
+    return S_OK;
+}
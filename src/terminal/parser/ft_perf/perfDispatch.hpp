@@ -0,0 +1,370 @@
+/*++
+Copyright (c) Microsoft Corporation.
+Licensed under the MIT license.
+
+Module Name:
+- perfDispatch.hpp
+
+Abstract:
+- The dispatch targets the perf harness drives the parser into:
+  - NullDispatch accepts every sequence the corpora use and does nothing, so
+    that we measure the parser alone.
+  - PerfGetSet is a ConGetSet over a text buffer with no console around it, so
+    that AdaptDispatch does all of its usual work without a real console
+    behind it.
+--*/
+
+#pragma once
+
+#include "..\..\adapter\termDispatch.hpp"
+#include "..\..\adapter\adaptDispatch.hpp"
+#include "..\..\..\buffer\out\textBuffer.hpp"
+
+namespace Microsoft::Console::VirtualTerminal::Perf
+{
+    class NullDispatch final : public TermDispatch
+    {
+    public:
+        void Execute(const wchar_t /*wchControl*/) override {}
+        void Print(const wchar_t /*wchPrintable*/) override {}
+        void PrintString(const wchar_t* const /*rgwch*/, const size_t /*cch*/) override {}
+
+        // Accept (and drop) everything the generated corpora produce, so that
+        //      the engine doesn't take the failed-sequence telemetry path.
+        bool CursorUp(const unsigned int /*uiDistance*/) override { return true; }
+        bool CursorDown(const unsigned int /*uiDistance*/) override { return true; }
+        bool CursorForward(const unsigned int /*uiDistance*/) override { return true; }
+        bool CursorBackward(const unsigned int /*uiDistance*/) override { return true; }
+        bool CursorHorizontalPositionAbsolute(const unsigned int /*uiColumn*/) override { return true; }
+        bool VerticalLinePositionAbsolute(const unsigned int /*uiLine*/) override { return true; }
+        bool CursorPosition(const unsigned int /*uiLine*/, const unsigned int /*uiColumn*/) override { return true; }
+        bool InsertCharacter(const unsigned int /*uiCount*/) override { return true; }
+        bool DeleteCharacter(const unsigned int /*uiCount*/) override { return true; }
+        bool EraseCharacters(const unsigned int /*uiNumChars*/) override { return true; }
+        bool CursorVisibility(const bool /*fIsVisible*/) override { return true; }
+        bool SetTopBottomScrollingMargins(const SHORT /*sTopMargin*/, const SHORT /*sBottomMargin*/) override { return true; }
+        bool SetWindowTitle(std::wstring_view /*title*/) override { return true; }
+        bool EraseInDisplay(const DispatchTypes::EraseType /*eraseType*/) override { return true; }
+        bool EraseInLine(const DispatchTypes::EraseType /*eraseType*/) override { return true; }
+        bool SetGraphicsRendition(_In_reads_(_Param_(2)) const DispatchTypes::GraphicsOptions* const /*rgOptions*/,
+                                  const size_t /*cOptions*/) override { return true; }
+        bool SetPrivateModes(_In_reads_(_Param_(2)) const DispatchTypes::PrivateModeParams* const /*rgParams*/,
+                             const size_t /*cParams*/) override { return true; }
+        bool ResetPrivateModes(_In_reads_(_Param_(2)) const DispatchTypes::PrivateModeParams* const /*rgParams*/,
+                               const size_t /*cParams*/) override { return true; }
+    };
+
+    // Print/Execute are handled by the host's write path in conhost. Here the
+    //      text is written into the buffer at the cursor, so that the cells
+    //      ICH and DCH move are the ones the corpus wrote, and the cursor
+    //      keeps moving so the adapter sees a plausible buffer.
+    class PerfDefaults final : public AdaptDefaults
+    {
+    public:
+        PerfDefaults(TextBuffer& buffer, COORD& coordCursor, const COORD coordSize) :
+            _buffer(buffer),
+            _coordCursor(coordCursor),
+            _coordSize(coordSize)
+        {
+        }
+
+        void Print(const wchar_t wch) override
+        {
+            PrintString(&wch, 1);
+        }
+
+        void PrintString(const wchar_t* const rgwch, const size_t cch) override
+        {
+            _buffer.Write(OutputCellIterator({ rgwch, cch }, _buffer.GetCurrentAttributes()), _coordCursor);
+            _Advance(cch);
+        }
+
+        void Execute(const wchar_t wch) override
+        {
+            if (wch == L'\r')
+            {
+                _coordCursor.X = 0;
+            }
+            else if (wch == L'\n')
+            {
+                _coordCursor.Y = std::min<SHORT>(_coordCursor.Y + 1, _coordSize.Y - 1);
+            }
+        }
+
+    private:
+        void _Advance(const size_t cch)
+        {
+            const size_t x = _coordCursor.X + cch;
+            _coordCursor.X = static_cast<SHORT>(x % _coordSize.X);
+            _coordCursor.Y = static_cast<SHORT>(std::min<size_t>(_coordCursor.Y + (x / _coordSize.X), _coordSize.Y - 1));
+        }
+
+        TextBuffer& _buffer;
+        COORD& _coordCursor;
+        const COORD _coordSize;
+    };
+
+    class PerfGetSet final : public ConGetSet
+    {
+    public:
+        PerfGetSet(TextBuffer& buffer, COORD& coordCursor, const COORD coordSize) :
+            _buffer(buffer),
+            _coordCursor(coordCursor),
+            _coordSize(coordSize),
+            _srViewport{ 0, 0, gsl::narrow_cast<SHORT>(coordSize.X - 1), gsl::narrow_cast<SHORT>(coordSize.Y - 1) },
+            _wAttributes(FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_RED)
+        {
+        }
+
+        BOOL GetConsoleCursorInfo(_In_ CONSOLE_CURSOR_INFO* const pConsoleCursorInfo) const override
+        {
+            pConsoleCursorInfo->dwSize = 25;
+            pConsoleCursorInfo->bVisible = TRUE;
+            return TRUE;
+        }
+        // Fills in everything conhost's GetConsoleScreenBufferInfoEx does, the
+        //      color table and the largest window size included, so that
+        //      callers pay for the parts they don't use as they would there.
+        BOOL GetConsoleScreenBufferInfoEx(_Out_ CONSOLE_SCREEN_BUFFER_INFOEX* const pConsoleScreenBufferInfoEx) const override
+        {
+            pConsoleScreenBufferInfoEx->bFullscreenSupported = FALSE;
+            pConsoleScreenBufferInfoEx->dwSize = _coordSize;
+            pConsoleScreenBufferInfoEx->dwCursorPosition = _coordCursor;
+            pConsoleScreenBufferInfoEx->srWindow = _srViewport;
+            pConsoleScreenBufferInfoEx->wAttributes = _wAttributes;
+            pConsoleScreenBufferInfoEx->wPopupAttributes = _wPopupAttributes;
+            memmove(pConsoleScreenBufferInfoEx->ColorTable, _rgColorTable, sizeof(_rgColorTable));
+            pConsoleScreenBufferInfoEx->dwMaximumWindowSize = _GetMaxWindowSizeInCharacters();
+
+            // Callers of this function expect to receive an exclusive rect, not an inclusive one.
+            pConsoleScreenBufferInfoEx->srWindow.Right += 1;
+            pConsoleScreenBufferInfoEx->srWindow.Bottom += 1;
+            return TRUE;
+        }
+        BOOL SetConsoleScreenBufferInfoEx(const CONSOLE_SCREEN_BUFFER_INFOEX* const pConsoleScreenBufferInfoEx) override
+        {
+            _coordCursor = pConsoleScreenBufferInfoEx->dwCursorPosition;
+            _SetAttributes(pConsoleScreenBufferInfoEx->wAttributes);
+            return TRUE;
+        }
+        BOOL SetConsoleCursorInfo(const CONSOLE_CURSOR_INFO* const /*pConsoleCursorInfo*/) override { return TRUE; }
+        BOOL SetConsoleCursorPosition(const COORD coordCursorPosition) override
+        {
+            _coordCursor = coordCursorPosition;
+            return TRUE;
+        }
+        BOOL FillConsoleOutputCharacterW(const WCHAR /*wch*/,
+                                         const DWORD nLength,
+                                         const COORD /*dwWriteCoord*/,
+                                         size_t& numberOfCharsWritten) noexcept override
+        {
+            numberOfCharsWritten = nLength;
+            return TRUE;
+        }
+        BOOL FillConsoleOutputAttribute(const WORD /*wAttribute*/,
+                                        const DWORD nLength,
+                                        const COORD /*dwWriteCoord*/,
+                                        size_t& numberOfAttrsWritten) noexcept override
+        {
+            numberOfAttrsWritten = nLength;
+            return TRUE;
+        }
+        BOOL SetConsoleTextAttribute(const WORD wAttr) override
+        {
+            _SetAttributes(wAttr);
+            return TRUE;
+        }
+        BOOL PrivateSetLegacyAttributes(const WORD wAttr,
+                                        const bool /*fForeground*/,
+                                        const bool /*fBackground*/,
+                                        const bool /*fMeta*/) override
+        {
+            _SetAttributes(wAttr);
+            return TRUE;
+        }
+        BOOL PrivateSetDefaultAttributes(const bool /*fForeground*/, const bool /*fBackground*/) override { return TRUE; }
+        BOOL SetConsoleXtermTextAttribute(const int /*iXtermTableEntry*/, const bool /*fIsForeground*/) override { return TRUE; }
+        BOOL SetConsoleRGBTextAttribute(const COLORREF /*rgbColor*/, const bool /*fIsForeground*/) override { return TRUE; }
+        BOOL PrivateBoldText(const bool /*bolded*/) override { return TRUE; }
+        BOOL PrivateWriteConsoleInputW(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& events,
+                                       _Out_ size_t& eventsWritten) override
+        {
+            eventsWritten = events.size();
+            events.clear();
+            return TRUE;
+        }
+        BOOL ScrollConsoleScreenBufferW(const SMALL_RECT* /*pScrollRectangle*/,
+                                        _In_opt_ const SMALL_RECT* /*pClipRectangle*/,
+                                        _In_ COORD /*dwDestinationOrigin*/,
+                                        const CHAR_INFO* /*pFill*/) override { return TRUE; }
+        BOOL SetConsoleWindowInfo(const BOOL /*bAbsolute*/,
+                                  const SMALL_RECT* const lpConsoleWindow) override
+        {
+            _srViewport = *lpConsoleWindow;
+            return TRUE;
+        }
+        BOOL PrivateSetCursorKeysMode(const bool /*fApplicationMode*/) override { return TRUE; }
+        BOOL PrivateSetKeypadMode(const bool /*fApplicationMode*/) override { return TRUE; }
+        BOOL PrivateShowCursor(const bool /*show*/) override { return TRUE; }
+        BOOL PrivateAllowCursorBlinking(const bool /*fEnable*/) override { return TRUE; }
+        BOOL PrivateSetScrollingRegion(const SMALL_RECT* const /*psrScrollMargins*/) override { return TRUE; }
+        BOOL PrivateReverseLineFeed() override { return TRUE; }
+        BOOL SetConsoleTitleW(const std::wstring_view /*title*/) override { return TRUE; }
+        BOOL PrivateUseAlternateScreenBuffer() override { return TRUE; }
+        BOOL PrivateUseMainScreenBuffer() override { return TRUE; }
+        BOOL PrivateHorizontalTabSet() override { return TRUE; }
+        BOOL PrivateForwardTab(const SHORT /*sNumTabs*/) override { return TRUE; }
+        BOOL PrivateBackwardsTab(const SHORT /*sNumTabs*/) override { return TRUE; }
+        BOOL PrivateTabClear(const bool /*fClearAll*/) override { return TRUE; }
+        BOOL PrivateSetDefaultTabStops() override { return TRUE; }
+        BOOL PrivateEnableVT200MouseMode(const bool /*fEnabled*/) override { return TRUE; }
+        BOOL PrivateEnableUTF8ExtendedMouseMode(const bool /*fEnabled*/) override { return TRUE; }
+        BOOL PrivateEnableSGRExtendedMouseMode(const bool /*fEnabled*/) override { return TRUE; }
+        BOOL PrivateEnableButtonEventMouseMode(const bool /*fEnabled*/) override { return TRUE; }
+        BOOL PrivateEnableAnyEventMouseMode(const bool /*fEnabled*/) override { return TRUE; }
+        BOOL PrivateEnableAlternateScroll(const bool /*fEnabled*/) override { return TRUE; }
+        BOOL PrivateEnableBracketedPasteMode(const bool /*fEnabled*/) override { return TRUE; }
+        BOOL PrivateEraseAll() override { return TRUE; }
+        BOOL SetCursorStyle(const CursorType /*cursorType*/) override { return TRUE; }
+        BOOL SetCursorColor(const COLORREF /*cursorColor*/) override { return TRUE; }
+        BOOL PrivateGetConsoleScreenBufferAttributes(_Out_ WORD* const pwAttributes) override
+        {
+            *pwAttributes = _wAttributes;
+            return TRUE;
+        }
+        BOOL PrivatePrependConsoleInput(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& events,
+                                        _Out_ size_t& eventsWritten) override
+        {
+            eventsWritten = events.size();
+            events.clear();
+            return TRUE;
+        }
+        BOOL PrivateWriteConsoleControlInput(_In_ KeyEvent /*key*/) override { return TRUE; }
+        BOOL PrivateRefreshWindow() override { return TRUE; }
+        BOOL GetConsoleOutputCP(_Out_ unsigned int* const puiOutputCP) override
+        {
+            *puiOutputCP = CP_UTF8;
+            return TRUE;
+        }
+        BOOL PrivateSuppressResizeRepaint() override { return TRUE; }
+        BOOL IsConsolePty(_Out_ bool* const pIsPty) const override
+        {
+            *pIsPty = false;
+            return TRUE;
+        }
+        BOOL MoveCursorVertically(const short lines) override
+        {
+            const int y = std::clamp<int>(_coordCursor.Y + lines, _srViewport.Top, _srViewport.Bottom);
+            _coordCursor.Y = static_cast<SHORT>(y);
+            return TRUE;
+        }
+        BOOL DeleteLines(const unsigned int /*count*/) override { return TRUE; }
+        BOOL InsertLines(const unsigned int /*count*/) override { return TRUE; }
+        BOOL PrivateGetCursorAndViewport(_Out_ COORD* const pCursorPosition, _Out_ SMALL_RECT* const psrViewport) const override
+        {
+            *pCursorPosition = _coordCursor;
+            *psrViewport = _srViewport;
+            psrViewport->Right += 1;
+            psrViewport->Bottom += 1;
+            return TRUE;
+        }
+        BOOL InsertCharacters(const unsigned int count) override
+        {
+            return _ModifyCharacters(count, true);
+        }
+        BOOL DeleteCharacters(const unsigned int count) override
+        {
+            return _ModifyCharacters(count, false);
+        }
+        // The same as DoSrvPrivateEraseCells.
+        BOOL EraseCells(const SMALL_RECT* const psrRegion) override
+        {
+            try
+            {
+                using Microsoft::Console::Types::Viewport;
+                const auto region = Viewport::Intersect(_buffer.GetSize(), Viewport::FromInclusive(*psrRegion));
+                if (region.IsValid())
+                {
+                    _buffer.EraseCells(region, _buffer.GetCurrentAttributes());
+                }
+                return TRUE;
+            }
+            CATCH_LOG();
+            return FALSE;
+        }
+        BOOL MoveToBottom() const override { return TRUE; }
+        BOOL PrivateSetColorTableEntry(const short /*index*/, const COLORREF /*value*/) const override { return TRUE; }
+
+    private:
+        // The same as DoSrvPrivateModifyCharactersImpl. There are no scrolling
+        //      margins here, so the cursor is always inside them.
+        BOOL _ModifyCharacters(const unsigned int count, const bool insert)
+        {
+            try
+            {
+                using Microsoft::Console::Types::Viewport;
+                const auto viewport = Viewport::FromInclusive(_srViewport);
+                const auto remaining = viewport.RightExclusive() - _coordCursor.X;
+                if (remaining <= 0)
+                {
+                    return TRUE;
+                }
+
+                const auto fillAttributes = _buffer.GetCurrentAttributes();
+                const size_t limitRight = viewport.RightInclusive();
+                if (count >= gsl::narrow_cast<unsigned int>(remaining))
+                {
+                    const auto rest = Viewport::FromInclusive({ _coordCursor.X, _coordCursor.Y, viewport.RightInclusive(), _coordCursor.Y });
+                    _buffer.EraseCells(rest, fillAttributes);
+                }
+                else if (insert)
+                {
+                    _buffer.InsertCells(_coordCursor, count, limitRight, fillAttributes);
+                }
+                else
+                {
+                    _buffer.DeleteCells(_coordCursor, count, limitRight, fillAttributes);
+                }
+                return TRUE;
+            }
+            CATCH_LOG();
+            return FALSE;
+        }
+
+        void _SetAttributes(const WORD wAttr) noexcept
+        {
+            _wAttributes = wAttr;
+            _buffer.SetCurrentAttributes(TextAttribute{ wAttr });
+        }
+
+        // The same math as SCREEN_INFORMATION::GetMaxWindowSizeInCharacters,
+        //      for a 1920x1080 client area and an 8x16 font. Conhost also asks
+        //      the window metrics for the client area, which isn't counted here.
+        COORD _GetMaxWindowSizeInCharacters() const noexcept
+        {
+            const RECT rcClientInPixels{ 0, 0, 1920, 1080 };
+            const COORD coordFont{ 8, 16 };
+
+            COORD coordClientAreaSize;
+            coordClientAreaSize.X = gsl::narrow_cast<SHORT>((rcClientInPixels.right - rcClientInPixels.left) / coordFont.X);
+            coordClientAreaSize.Y = gsl::narrow_cast<SHORT>((rcClientInPixels.bottom - rcClientInPixels.top) / coordFont.Y);
+
+            coordClientAreaSize.X = std::min(_coordSize.X, coordClientAreaSize.X);
+            coordClientAreaSize.Y = std::min(_coordSize.Y, coordClientAreaSize.Y);
+            return coordClientAreaSize;
+        }
+
+        TextBuffer& _buffer;
+        COORD& _coordCursor;
+        const COORD _coordSize;
+        SMALL_RECT _srViewport;
+        WORD _wAttributes;
+        WORD _wPopupAttributes = FOREGROUND_RED | FOREGROUND_BLUE | BACKGROUND_RED | BACKGROUND_GREEN | BACKGROUND_BLUE | BACKGROUND_INTENSITY;
+        COLORREF _rgColorTable[16] = {
+            RGB(12, 12, 12), RGB(0, 55, 218), RGB(19, 161, 14), RGB(58, 150, 221),
+            RGB(197, 15, 31), RGB(136, 23, 152), RGB(193, 156, 0), RGB(204, 204, 204),
+            RGB(118, 118, 118), RGB(59, 120, 255), RGB(22, 198, 12), RGB(97, 214, 214),
+            RGB(231, 72, 86), RGB(180, 0, 158), RGB(249, 241, 165), RGB(242, 242, 242)
+        };
+    };
+}
@@ -7,6 +7,10 @@
 
 #include "ascii.hpp"
 
+#if (defined(_M_IX86) || defined(_M_AMD64))
+#include <emmintrin.h>
+#endif
+
 using namespace Microsoft::Console::VirtualTerminal;
 
 //Takes ownership of the pEngine.
@@ -25,7 +29,8 @@ StateMachine::StateMachine(IStateMachineEngine* const pEngine) :
     // rgusParams Initialized below
     _sOscNextChar(0),
     _sOscParam(0),
-    _currRunLength(0)
+    _currRunLength(0),
+    _fProcessingIndividually(false)
 {
     ZeroMemory(_pwchOscStringBuffer, sizeof(_pwchOscStringBuffer));
     ZeroMemory(_rgusParams, sizeof(_rgusParams));
@@ -54,6 +59,62 @@ bool StateMachine::s_IsActionableFromGround(const wchar_t wch)
     return (wch <= AsciiChars::US) || s_IsC1Csi(wch) || s_IsDelete(wch);
 }
 
+// Routine Description:
+// - Finds the first character in the given range that is actionable from the
+//      ground state (see s_IsActionableFromGround). Everything before it can be
+//      printed as a single run.
+//   On x86/x64, this checks 8 characters at a time with SSE2, then finishes the
+//      tail of the range one character at a time.
+// Arguments:
+// - pwchBegin - Pointer to the first character to check.
+// - pwchEnd - Pointer one past the last character to check.
+// Return Value:
+// - Pointer to the first actionable character, or pwchEnd if there is none.
+const wchar_t* StateMachine::s_FindNextActionableFromGround(const wchar_t* const pwchBegin,
+                                                            const wchar_t* const pwchEnd)
+{
+    const wchar_t* pwch = pwchBegin;
+
+#if (defined(_M_IX86) || defined(_M_AMD64))
+    static_assert(sizeof(wchar_t) == sizeof(unsigned short), "The SSE2 scan below expects 16-bit code units.");
+
+    const __m128i vecC0Max = _mm_set1_epi16(AsciiChars::US);
+    const __m128i vecDelete = _mm_set1_epi16(AsciiChars::DEL);
+    const __m128i vecC1Csi = _mm_set1_epi16(L'\x9b');
+    const __m128i vecZero = _mm_setzero_si128();
+
+    while (pwchEnd - pwch >= 8)
+    {
+        const __m128i vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pwch));
+
+        // There's no unsigned 16-bit compare in SSE2. A saturating subtract of
+        //      US leaves a zero only in the lanes that are <= US (the C0 range).
+        const __m128i vecIsC0 = _mm_cmpeq_epi16(_mm_subs_epu16(vec, vecC0Max), vecZero);
+        const __m128i vecIsDelete = _mm_cmpeq_epi16(vec, vecDelete);
+        const __m128i vecIsC1Csi = _mm_cmpeq_epi16(vec, vecC1Csi);
+
+        const __m128i vecActionable = _mm_or_si128(vecIsC0, _mm_or_si128(vecIsDelete, vecIsC1Csi));
+        const int mask = _mm_movemask_epi8(vecActionable);
+        if (mask != 0)
+        {
+            // movemask gives us two bits per 16-bit lane.
+            unsigned long bitIndex;
+            _BitScanForward(&bitIndex, static_cast<unsigned long>(mask));
+            return pwch + (bitIndex / 2);
+        }
+
+        pwch += 8;
+    }
+#endif
+
+    while (pwch < pwchEnd && !s_IsActionableFromGround(*pwch))
+    {
+        pwch++;
+    }
+
+    return pwch;
+}
+
 // Routine Description:
 // - Determines if a character belongs to the C0 escape range.
 //   This is character sequences less than a space character (null, backspace, new line, etc.)
@@ -62,7 +123,7 @@ bool StateMachine::s_IsActionableFromGround(const wchar_t wch)
 // - wch - Character to check.
 // Return Value:
 // - True if it is. False if it isn't.
-bool StateMachine::s_IsC0Code(const wchar_t wch)
+constexpr bool StateMachine::s_IsC0Code(const wchar_t wch) noexcept
 {
     return (wch >= AsciiChars::NUL && wch <= AsciiChars::ETB) ||
            wch == AsciiChars::EM ||
@@ -88,7 +149,7 @@ bool StateMachine::s_IsC0Code(const wchar_t wch)
 // - wch - Character to check.
 // Return Value:
 // - True if it is. False if it isn't.
-bool StateMachine::s_IsC1Csi(const wchar_t wch)
+constexpr bool StateMachine::s_IsC1Csi(const wchar_t wch) noexcept
 {
     return wch == L'\x9b';
 }
@@ -102,7 +163,7 @@ bool StateMachine::s_IsC1Csi(const wchar_t wch)
 // - wch - Character to check.
 // Return Value:
 // - True if it is. False if it isn't.
-bool StateMachine::s_IsIntermediate(const wchar_t wch)
+constexpr bool StateMachine::s_IsIntermediate(const wchar_t wch) noexcept
 {
     return wch >= L' ' && wch <= L'/'; // 0x20 - 0x2F
 }
@@ -113,7 +174,7 @@ bool StateMachine::s_IsIntermediate(const wchar_t wch)
 // - wch - Character to check.
 // Return Value:
 // - True if it is. False if it isn't.
-bool StateMachine::s_IsDelete(const wchar_t wch)
+constexpr bool StateMachine::s_IsDelete(const wchar_t wch) noexcept
 {
     return wch == AsciiChars::DEL;
 }
@@ -125,7 +186,7 @@ bool StateMachine::s_IsDelete(const wchar_t wch)
 // - wch - Character to check.
 // Return Value:
 // - True if it is. False if it isn't.
-bool StateMachine::s_IsEscape(const wchar_t wch)
+constexpr bool StateMachine::s_IsEscape(const wchar_t wch) noexcept
 {
     return wch == AsciiChars::ESC;
 }
@@ -137,7 +198,7 @@ bool StateMachine::s_IsEscape(const wchar_t wch)
 // - wch - Character to check.
 // Return Value:
 // - True if it is. False if it isn't.
-bool StateMachine::s_IsCsiIndicator(const wchar_t wch)
+constexpr bool StateMachine::s_IsCsiIndicator(const wchar_t wch) noexcept
 {
     return wch == L'['; // 0x5B
 }
@@ -150,7 +211,7 @@ bool StateMachine::s_IsCsiIndicator(const wchar_t wch)
 // - wch - Character to check.
 // Return Value:
 // - True if it is. False if it isn't.
-bool StateMachine::s_IsCsiDelimiter(const wchar_t wch)
+constexpr bool StateMachine::s_IsCsiDelimiter(const wchar_t wch) noexcept
 {
     return wch == L';'; // 0x3B
 }
@@ -162,7 +223,7 @@ bool StateMachine::s_IsCsiDelimiter(const wchar_t wch)
 // - wch - Character to check.
 // Return Value:
 // - True if it is. False if it isn't.
-bool StateMachine::s_IsCsiParamValue(const wchar_t wch)
+constexpr bool StateMachine::s_IsCsiParamValue(const wchar_t wch) noexcept
 {
     return wch >= L'0' && wch <= L'9'; // 0x30 - 0x39
 }
@@ -174,7 +235,7 @@ bool StateMachine::s_IsCsiParamValue(const wchar_t wch)
 // - wch - Character to check.
 // Return Value:
 // - True if it is. False if it isn't.
-bool StateMachine::s_IsCsiPrivateMarker(const wchar_t wch)
+constexpr bool StateMachine::s_IsCsiPrivateMarker(const wchar_t wch) noexcept
 {
     return wch == L'<' || wch == L'=' || wch == L'>' || wch == L'?'; // 0x3C - 0x3F
 }
@@ -185,7 +246,7 @@ bool StateMachine::s_IsCsiPrivateMarker(const wchar_t wch)
 // - wch - Character to check.
 // Return Value:
 // - True if it is. False if it isn't.
-bool StateMachine::s_IsCsiInvalid(const wchar_t wch)
+constexpr bool StateMachine::s_IsCsiInvalid(const wchar_t wch) noexcept
 {
     return wch == L':'; // 0x3A
 }
@@ -199,7 +260,7 @@ bool StateMachine::s_IsCsiInvalid(const wchar_t wch)
 // - wch - Character to check.
 // Return Value:
 // - True if it is. False if it isn't.
-bool StateMachine::s_IsSs3Indicator(const wchar_t wch)
+constexpr bool StateMachine::s_IsSs3Indicator(const wchar_t wch) noexcept
 {
     return wch == L'O'; // 0x4F
 }
@@ -211,61 +272,11 @@ bool StateMachine::s_IsSs3Indicator(const wchar_t wch)
 // - wch - Character to check.
 // Return Value:
 // - True if it is. False if it isn't.
-bool StateMachine::s_IsOscIndicator(const wchar_t wch)
+constexpr bool StateMachine::s_IsOscIndicator(const wchar_t wch) noexcept
 {
     return wch == L']'; // 0x5D
 }
 
-// Routine Description:
-// - Determines if a character is a delimiter between two parameters in a "operating system control sequence"
-//   This occurs in the middle of a control sequence after escape and OscIndicator have been recognized,
-//   after the paramater indicating which OSC action to take.
-// Arguments:
-// - wch - Character to check.
-// Return Value:
-// - True if it is. False if it isn't.
-bool StateMachine::s_IsOscDelimiter(const wchar_t wch)
-{
-    return wch == L';'; // 0x3B
-}
-
-// Routine Description:
-// - Determines if a character is a valid parameter value for an OSC String,
-//     that is, the indicator of which OSC action to take.
-//   Parameters must be numerical digits.
-// Arguments:
-// - wch - Character to check.
-// Return Value:
-// - True if it is. False if it isn't.
-bool StateMachine::s_IsOscParamValue(const wchar_t wch)
-{
-    return s_IsNumber(wch); // 0x30 - 0x39
-}
-
-// Routine Description:
-// - Determines if a character should be initiate the end of an OSC sequence.
-// Arguments:
-// - wch - Character to check.
-// Return Value:
-// - True if it is. False if it isn't.
-bool StateMachine::s_IsOscTerminationInitiator(const wchar_t wch)
-{
-    return wch == AsciiChars::ESC;
-}
-
-// Routine Description:
-// - Determines if a character should be ignored in a operating system control sequence
-// Arguments:
-// - wch - Character to check.
-// Return Value:
-// - True if it is. False if it isn't.
-bool StateMachine::s_IsOscInvalid(const wchar_t wch)
-{
-    return wch <= L'\x17' ||
-           wch == L'\x19' ||
-           (wch >= L'\x1c' && wch <= L'\x1f') ;
-}
-
 // Routine Description:
 // - Determines if a character is "operating system control string" termination indicator.
 //   This signals the end of an OSC string collection.
@@ -273,22 +284,11 @@ bool StateMachine::s_IsOscInvalid(const wchar_t wch)
 // - wch - Character to check.
 // Return Value:
 // - True if it is. False if it isn't.
-bool StateMachine::s_IsOscTerminator(const wchar_t wch)
+constexpr bool StateMachine::s_IsOscTerminator(const wchar_t wch) noexcept
 {
     return wch == L'\x7' || wch == L'\x9C'; // Bell character or C1 terminator
 }
 
-// Routine Description:
-// - Determines if a character is a valid number character, 0-9.
-// Arguments:
-// - wch - Character to check.
-// Return Value:
-// - True if it is. False if it isn't.
-bool StateMachine::s_IsNumber(const wchar_t wch)
-{
-    return wch >= L'0' && wch <= L'9'; // 0x30 - 0x39
-}
-
 // Routine Description:
 // - Triggers the Execute action to indicate that the listener should immediately respond to a C0 control character.
 // Arguments:
@@ -790,453 +790,452 @@ void StateMachine::_EnterSs3Param()
 }
 
 // Routine Description:
-// - Processes a character event into an Action that occurs while in the Ground state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Handle a C1 Control Sequence Introducer
-//   3. Print all other characters
+// - Moves the state machine into the given state, performing any actions
+//      associated with entering it.
 // Arguments:
-// - wch - Character that triggered the event
+// - state - The state to enter.
 // Return Value:
 // - <none>
-void StateMachine::_EventGround(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"Ground");
-    if (s_IsC0Code(wch) || s_IsDelete(wch))
-    {
-        _ActionExecute(wch);
-    }
-    else if (s_IsC1Csi(wch))
-    {
-        _EnterCsiEntry();
-    }
-    else
-    {
-        _ActionPrint(wch);
+void StateMachine::_EnterState(const VTStates state)
+{
+    switch (state)
+    {
+    case VTStates::Ground:
+        return _EnterGround();
+    case VTStates::Escape:
+        return _EnterEscape();
+    case VTStates::EscapeIntermediate:
+        return _EnterEscapeIntermediate();
+    case VTStates::CsiEntry:
+        return _EnterCsiEntry();
+    case VTStates::CsiIntermediate:
+        return _EnterCsiIntermediate();
+    case VTStates::CsiIgnore:
+        return _EnterCsiIgnore();
+    case VTStates::CsiParam:
+        return _EnterCsiParam();
+    case VTStates::OscParam:
+        return _EnterOscParam();
+    case VTStates::OscString:
+        return _EnterOscString();
+    case VTStates::OscTermination:
+        return _EnterOscTermination();
+    case VTStates::Ss3Entry:
+        return _EnterSs3Entry();
+    case VTStates::Ss3Param:
+        return _EnterSs3Param();
+    default:
+        return;
     }
 }
 
 // Routine Description:
-// - Processes a character event into an Action that occurs while in the Escape state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect Intermediate characters
-//   4. Enter Control Sequence state
-//   5. Dispatch an Escape action.
+// - Determines the class of a character, for indexing into the transition
+//      table. Every character in a class is handled the same way in every state.
+//   This is only ever evaluated at compile time, to build s_charClassTable.
 // Arguments:
-// - wch - Character that triggered the event
+// - wch - Character to classify.
 // Return Value:
-// - <none>
-void StateMachine::_EventEscape(const wchar_t wch)
+// - The class of the character.
+constexpr StateMachine::CharClasses StateMachine::s_ClassifyCharacter(const wchar_t wch) noexcept
 {
-    _trace.TraceOnEvent(L"Escape");
-    if (s_IsC0Code(wch))
-    {
-        if (_pEngine->DispatchControlCharsFromEscape())
-        {
-            _ActionExecuteFromEscape(wch);
-            _EnterGround();
-        }
-        else
-        {
-            _ActionExecute(wch);
-        }
-    }
-    else if (s_IsDelete(wch))
+    if (wch == AsciiChars::CAN || wch == AsciiChars::SUB)
     {
-        _ActionIgnore();
+        return CharClasses::Cancel;
     }
-    else if (s_IsIntermediate(wch))
-    {
-        _ActionCollect(wch);
-        _EnterEscapeIntermediate();
-    }
-    else if (s_IsCsiIndicator(wch))
-    {
-        _EnterCsiEntry();
-    }
-    else if (s_IsOscIndicator(wch))
+    else if (s_IsEscape(wch))
     {
-        _EnterOscParam();
+        return CharClasses::Escape;
     }
-    else if (s_IsSs3Indicator(wch))
+    else if (wch == AsciiChars::BEL)
     {
-        _EnterSs3Entry();
+        return CharClasses::Bell;
     }
-    else
+    else if (s_IsC0Code(wch))
     {
-        _ActionEscDispatch(wch);
-        _EnterGround();
-    }
-}
-
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the EscapeIntermediate state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect Intermediate characters
-//   4. Dispatch an Escape action.
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventEscapeIntermediate(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"EscapeIntermediate");
-    if (s_IsC0Code(wch))
-    {
-        _ActionExecute(wch);
+        return CharClasses::C0;
     }
     else if (s_IsIntermediate(wch))
     {
-        _ActionCollect(wch);
-    }
-    else if (s_IsDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else
-    {
-        _ActionEscDispatch(wch);
-        _EnterGround();
-    }
-}
-
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the CsiEntry state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect Intermediate characters
-//   4. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
-//   5. Store parameter data
-//   6. Collect Control Sequence Private markers
-//   7. Dispatch a control sequence with parameters for action
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventCsiEntry(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"CsiEntry");
-    if (s_IsC0Code(wch))
-    {
-        _ActionExecute(wch);
-    }
-    else if (s_IsDelete(wch))
-    {
-        _ActionIgnore();
+        return CharClasses::Intermediate;
     }
-    else if (s_IsIntermediate(wch))
+    else if (s_IsCsiParamValue(wch))
     {
-        _ActionCollect(wch);
-        _EnterCsiIntermediate();
+        return CharClasses::ParamValue;
     }
     else if (s_IsCsiInvalid(wch))
     {
-        _EnterCsiIgnore();
+        return CharClasses::Invalid;
     }
-    else if (s_IsCsiParamValue(wch) || s_IsCsiDelimiter(wch))
+    else if (s_IsCsiDelimiter(wch))
     {
-        _ActionParam(wch);
-        _EnterCsiParam();
+        return CharClasses::Delimiter;
     }
     else if (s_IsCsiPrivateMarker(wch))
     {
-        _ActionCollect(wch);
-        _EnterCsiParam();
-    }
-    else
-    {
-        _ActionCsiDispatch(wch);
-        _EnterGround();
-    }
-}
-
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the CsiIntermediate state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect Intermediate characters
-//   4. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
-//   5. Dispatch a control sequence with parameters for action
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventCsiIntermediate(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"CsiIntermediate");
-    if (s_IsC0Code(wch))
-    {
-        _ActionExecute(wch);
-    }
-    else if (s_IsIntermediate(wch))
-    {
-        _ActionCollect(wch);
-    }
-    else if (s_IsDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (s_IsCsiParamValue(wch) || s_IsCsiInvalid(wch) || s_IsCsiDelimiter(wch) || s_IsCsiPrivateMarker(wch))
-    {
-        _EnterCsiIgnore();
-    }
-    else
-    {
-        _ActionCsiDispatch(wch);
-        _EnterGround();
-    }
-}
-
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the CsiIgnore state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect Intermediate characters
-//   4. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
-//   5. Return to Ground
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventCsiIgnore(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"CsiIgnore");
-    if (s_IsC0Code(wch))
-    {
-        _ActionExecute(wch);
-    }
-    else if (s_IsDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (s_IsIntermediate(wch))
-    {
-        _ActionIgnore();
+        return CharClasses::PrivateMarker;
     }
-    else if (s_IsCsiParamValue(wch) || s_IsCsiInvalid(wch) || s_IsCsiDelimiter(wch) || s_IsCsiPrivateMarker(wch))
+    else if (s_IsCsiIndicator(wch))
     {
-        _ActionIgnore();
+        return CharClasses::CsiIndicator;
     }
-    else
+    else if (s_IsOscIndicator(wch))
     {
-        _EnterGround();
+        return CharClasses::OscIndicator;
     }
-}
-
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the CsiParam state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Collect Intermediate characters
-//   4. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
-//   5. Store parameter data
-//   6. Dispatch a control sequence with parameters for action
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventCsiParam(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"CsiParam");
-    if (s_IsC0Code(wch))
+    else if (s_IsSs3Indicator(wch))
     {
-        _ActionExecute(wch);
+        return CharClasses::Ss3Indicator;
     }
     else if (s_IsDelete(wch))
     {
-        _ActionIgnore();
-    }
-    else if (s_IsCsiParamValue(wch) || s_IsCsiDelimiter(wch))
-    {
-        _ActionParam(wch);
+        return CharClasses::Delete;
     }
-    else if (s_IsIntermediate(wch))
+    else if (s_IsC1Csi(wch))
     {
-        _ActionCollect(wch);
-        _EnterCsiIntermediate();
+        return CharClasses::C1Csi;
     }
-    else if (s_IsCsiInvalid(wch) || s_IsCsiPrivateMarker(wch))
+    else if (s_IsOscTerminator(wch))
     {
-        _EnterCsiIgnore();
+        // The BEL terminator was already handled above, so this is the C1 ST.
+        return CharClasses::C1StringTerminator;
     }
     else
     {
-        _ActionCsiDispatch(wch);
-        _EnterGround();
+        return CharClasses::Other;
     }
 }
 
 // Routine Description:
-// - Processes a character event into an Action that occurs while in the OscParam state.
-//   Events in this state will:
-//   1. Collect numeric values into an Osc Param
-//   2. Move to the OscString state on a delimiter
-//   3. Ignore everything else.
+// - Builds the table of character classes for the characters that aren't
+//      simply "Other". Everything at or past the end of the table is Other.
 // Arguments:
-// - wch - Character that triggered the event
-// Return Value:
 // - <none>
-void StateMachine::_EventOscParam(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"OscParam");
-    if (s_IsOscTerminator(wch))
-    {
-        _EnterGround();
-    }
-    else if (s_IsOscParamValue(wch))
-    {
-        _ActionOscParam(wch);
-    }
-    else if (s_IsOscDelimiter(wch))
-    {
-        _EnterOscString();
-    }
-    else
-    {
-        _ActionIgnore();
-    }
-}
-
-// Routine Description:
-// - Processes a character event into a Action that occurs while in the OscParam state.
-//   Events in this state will:
-//   1. Trigger the OSC action associated with the param on an OscTerminator
-//   2. If we see a ESC, enter the OscTermination state. We'll wait for one
-//      more character before we dispatch the string.
-//   3. Ignore OscInvalid characters.
-//   4. Collect everything else into the OscString
-// Arguments:
-// - wch - Character that triggered the event
 // Return Value:
-// - <none>
-void StateMachine::_EventOscString(const wchar_t wch)
+// - The table, indexed by character.
+constexpr StateMachine::CharClassTable StateMachine::s_BuildCharClassTable() noexcept
 {
-    _trace.TraceOnEvent(L"OscString");
-    if (s_IsOscTerminator(wch))
-    {
-        _ActionOscDispatch(wch);
-        _EnterGround();
-    }
-    else if (s_IsOscTerminationInitiator(wch))
-    {
-        _EnterOscTermination();
-    }
-    else if (s_IsOscInvalid(wch))
-    {
-        _ActionIgnore();
-    }
-    else
+    CharClassTable table{};
+    for (size_t i = 0; i < table.size(); i++)
     {
-        // add this character to our OSC string
-        _ActionOscPut(wch);
+        table[i] = s_ClassifyCharacter(static_cast<wchar_t>(i));
     }
+    return table;
 }
 
 // Routine Description:
-// - Handle the two-character termination of a OSC sequence.
-//   Events in this state will:
-//   1. Trigger the OSC action associated with the param on an OscTerminator
+// - Determines what happens when a character of the given class is seen in
+//      the given state. This encodes the rules from http://vt100.net/emu/dec_ansi_parser
+//      (with our own handling of OSC and SS3 sequences).
+//   This is only ever evaluated at compile time, to build s_transitionTable.
 // Arguments:
-// - wch - Character that triggered the event
+// - state - The state the machine is in.
+// - charClass - The class of the character that triggered the event.
 // Return Value:
-// - <none>
-void StateMachine::_EventOscTermination(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"OscTermination");
-
-    _ActionOscDispatch(wch);
-    _EnterGround();
-}
+// - The action to take, and the state to move into (if any).
+constexpr StateMachine::Transition StateMachine::s_BuildTransition(const VTStates state, const CharClasses charClass) noexcept
+{
+    // Perform the action and stay in the current state.
+    const auto stay = [](const VTActions action) constexpr {
+        return Transition{ action, VTStates::Ground, false };
+    };
+    // Perform the action, then enter the new state.
+    const auto enter = [](const VTActions action, const VTStates nextState) constexpr {
+        return Transition{ action, nextState, true };
+    };
 
-// Routine Description:
-// - Processes a character event into an Action that occurs while in the Ss3Entry state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
-//   4. Store parameter data
-//   5. Dispatch a control sequence with parameters for action
-//  SS3 sequences are structurally the same as CSI sequences, just with a
-//      different initiation. It's safe to reuse CSI's functions for
-//      determining if a character is a parameter, delimiter, or invalid.
-// Arguments:
-// - wch - Character that triggered the event
-// Return Value:
-// - <none>
-void StateMachine::_EventSs3Entry(const wchar_t wch)
-{
-    _trace.TraceOnEvent(L"Ss3Entry");
-    if (s_IsC0Code(wch))
-    {
-        _ActionExecute(wch);
-    }
-    else if (s_IsDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (s_IsCsiInvalid(wch))
+    // Process "from anywhere" events first.
+    if (charClass == CharClasses::Cancel)
     {
-        // It's safe for us to go into the CSI ignore here, because both SS3 and
-        //      CSI sequences ignore characters the same way.
-        _EnterCsiIgnore();
+        return enter(VTActions::Execute, VTStates::Ground);
     }
-    else if (s_IsCsiParamValue(wch) || s_IsCsiDelimiter(wch))
+    else if (charClass == CharClasses::Escape)
     {
-        _ActionParam(wch);
-        _EnterSs3Param();
+        // Don't go to escape from the OSC string state - ESC can be used to
+        //      terminate OSC strings.
+        return state == VTStates::OscString ?
+            enter(VTActions::None, VTStates::OscTermination) :
+            enter(VTActions::None, VTStates::Escape);
     }
-    else
+
+    switch (state)
     {
-        _ActionSs3Dispatch(wch);
-        _EnterGround();
+    case VTStates::Ground:
+        // 1. Execute C0 control characters
+        // 2. Handle a C1 Control Sequence Introducer
+        // 3. Print all other characters
+        switch (charClass)
+        {
+        case CharClasses::C0:
+        case CharClasses::Bell:
+        case CharClasses::Delete:
+            return stay(VTActions::Execute);
+        case CharClasses::C1Csi:
+            return enter(VTActions::None, VTStates::CsiEntry);
+        default:
+            return stay(VTActions::Print);
+        }
+    case VTStates::Escape:
+        // 1. Execute C0 control characters
+        // 2. Ignore Delete characters
+        // 3. Collect Intermediate characters
+        // 4. Enter Control Sequence, OSC or SS3 state
+        // 5. Dispatch an Escape action.
+        switch (charClass)
+        {
+        case CharClasses::C0:
+        case CharClasses::Bell:
+            return stay(VTActions::ExecuteFromEscape);
+        case CharClasses::Delete:
+            return stay(VTActions::Ignore);
+        case CharClasses::Intermediate:
+            return enter(VTActions::Collect, VTStates::EscapeIntermediate);
+        case CharClasses::CsiIndicator:
+            return enter(VTActions::None, VTStates::CsiEntry);
+        case CharClasses::OscIndicator:
+            return enter(VTActions::None, VTStates::OscParam);
+        case CharClasses::Ss3Indicator:
+            return enter(VTActions::None, VTStates::Ss3Entry);
+        default:
+            return enter(VTActions::EscDispatch, VTStates::Ground);
+        }
+    case VTStates::EscapeIntermediate:
+        // 1. Execute C0 control characters
+        // 2. Ignore Delete characters
+        // 3. Collect Intermediate characters
+        // 4. Dispatch an Escape action.
+        switch (charClass)
+        {
+        case CharClasses::C0:
+        case CharClasses::Bell:
+            return stay(VTActions::Execute);
+        case CharClasses::Intermediate:
+            return stay(VTActions::Collect);
+        case CharClasses::Delete:
+            return stay(VTActions::Ignore);
+        default:
+            return enter(VTActions::EscDispatch, VTStates::Ground);
+        }
+    case VTStates::CsiEntry:
+        // 1. Execute C0 control characters
+        // 2. Ignore Delete characters
+        // 3. Collect Intermediate characters
+        // 4. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
+        // 5. Store parameter data
+        // 6. Collect Control Sequence Private markers
+        // 7. Dispatch a control sequence with parameters for action
+        switch (charClass)
+        {
+        case CharClasses::C0:
+        case CharClasses::Bell:
+            return stay(VTActions::Execute);
+        case CharClasses::Delete:
+            return stay(VTActions::Ignore);
+        case CharClasses::Intermediate:
+            return enter(VTActions::Collect, VTStates::CsiIntermediate);
+        case CharClasses::Invalid:
+            return enter(VTActions::None, VTStates::CsiIgnore);
+        case CharClasses::ParamValue:
+        case CharClasses::Delimiter:
+            return enter(VTActions::Param, VTStates::CsiParam);
+        case CharClasses::PrivateMarker:
+            return enter(VTActions::Collect, VTStates::CsiParam);
+        default:
+            return enter(VTActions::CsiDispatch, VTStates::Ground);
+        }
+    case VTStates::CsiIntermediate:
+        // 1. Execute C0 control characters
+        // 2. Ignore Delete characters
+        // 3. Collect Intermediate characters
+        // 4. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
+        // 5. Dispatch a control sequence with parameters for action
+        switch (charClass)
+        {
+        case CharClasses::C0:
+        case CharClasses::Bell:
+            return stay(VTActions::Execute);
+        case CharClasses::Intermediate:
+            return stay(VTActions::Collect);
+        case CharClasses::Delete:
+            return stay(VTActions::Ignore);
+        case CharClasses::ParamValue:
+        case CharClasses::Invalid:
+        case CharClasses::Delimiter:
+        case CharClasses::PrivateMarker:
+            return enter(VTActions::None, VTStates::CsiIgnore);
+        default:
+            return enter(VTActions::CsiDispatch, VTStates::Ground);
+        }
+    case VTStates::CsiIgnore:
+        // 1. Execute C0 control characters
+        // 2. Ignore Delete, Intermediate and parameter characters
+        // 3. Return to Ground
+        switch (charClass)
+        {
+        case CharClasses::C0:
+        case CharClasses::Bell:
+            return stay(VTActions::Execute);
+        case CharClasses::Delete:
+        case CharClasses::Intermediate:
+        case CharClasses::ParamValue:
+        case CharClasses::Invalid:
+        case CharClasses::Delimiter:
+        case CharClasses::PrivateMarker:
+            return stay(VTActions::Ignore);
+        default:
+            return enter(VTActions::None, VTStates::Ground);
+        }
+    case VTStates::CsiParam:
+        // 1. Execute C0 control characters
+        // 2. Ignore Delete characters
+        // 3. Collect Intermediate characters
+        // 4. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
+        // 5. Store parameter data
+        // 6. Dispatch a control sequence with parameters for action
+        switch (charClass)
+        {
+        case CharClasses::C0:
+        case CharClasses::Bell:
+            return stay(VTActions::Execute);
+        case CharClasses::Delete:
+            return stay(VTActions::Ignore);
+        case CharClasses::ParamValue:
+        case CharClasses::Delimiter:
+            return stay(VTActions::Param);
+        case CharClasses::Intermediate:
+            return enter(VTActions::Collect, VTStates::CsiIntermediate);
+        case CharClasses::Invalid:
+        case CharClasses::PrivateMarker:
+            return enter(VTActions::None, VTStates::CsiIgnore);
+        default:
+            return enter(VTActions::CsiDispatch, VTStates::Ground);
+        }
+    case VTStates::OscParam:
+        // 1. Collect numeric values into an Osc Param
+        // 2. Move to the OscString state on a delimiter
+        // 3. Return to Ground on an OSC terminator
+        // 4. Ignore everything else.
+        switch (charClass)
+        {
+        case CharClasses::Bell:
+        case CharClasses::C1StringTerminator:
+            return enter(VTActions::None, VTStates::Ground);
+        case CharClasses::ParamValue:
+            return stay(VTActions::OscParam);
+        case CharClasses::Delimiter:
+            return enter(VTActions::None, VTStates::OscString);
+        default:
+            return stay(VTActions::Ignore);
+        }
+    case VTStates::OscString:
+        // 1. Trigger the OSC action associated with the param on an OscTerminator
+        // 2. If we see a ESC, enter the OscTermination state (handled above).
+        //    We'll wait for one more character before we dispatch the string.
+        // 3. Ignore C0 control characters.
+        // 4. Collect everything else into the OscString
+        switch (charClass)
+        {
+        case CharClasses::Bell:
+        case CharClasses::C1StringTerminator:
+            return enter(VTActions::OscDispatch, VTStates::Ground);
+        case CharClasses::C0:
+            return stay(VTActions::Ignore);
+        default:
+            return stay(VTActions::OscPut);
+        }
+    case VTStates::OscTermination:
+        // 1. Trigger the OSC action associated with the param on the second
+        //    character of the two-character termination.
+        return enter(VTActions::OscDispatch, VTStates::Ground);
+    case VTStates::Ss3Entry:
+        // 1. Execute C0 control characters
+        // 2. Ignore Delete characters
+        // 3. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
+        // 4. Store parameter data
+        // 5. Dispatch a control sequence with parameters for action
+        //  SS3 sequences are structurally the same as CSI sequences, just with a
+        //      different initiation. It's safe for us to go into the CSI ignore
+        //      state, because both SS3 and CSI sequences ignore characters the same way.
+        switch (charClass)
+        {
+        case CharClasses::C0:
+        case CharClasses::Bell:
+            return stay(VTActions::Execute);
+        case CharClasses::Delete:
+            return stay(VTActions::Ignore);
+        case CharClasses::Invalid:
+            return enter(VTActions::None, VTStates::CsiIgnore);
+        case CharClasses::ParamValue:
+        case CharClasses::Delimiter:
+            return enter(VTActions::Param, VTStates::Ss3Param);
+        default:
+            return enter(VTActions::Ss3Dispatch, VTStates::Ground);
+        }
+    case VTStates::Ss3Param:
+        // 1. Execute C0 control characters
+        // 2. Ignore Delete characters
+        // 3. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
+        // 4. Store parameter data
+        // 5. Dispatch a control sequence with parameters for action
+        switch (charClass)
+        {
+        case CharClasses::C0:
+        case CharClasses::Bell:
+            return stay(VTActions::Execute);
+        case CharClasses::Delete:
+            return stay(VTActions::Ignore);
+        case CharClasses::ParamValue:
+        case CharClasses::Delimiter:
+            return stay(VTActions::Param);
+        case CharClasses::Invalid:
+        case CharClasses::PrivateMarker:
+            return enter(VTActions::None, VTStates::CsiIgnore);
+        default:
+            return enter(VTActions::Ss3Dispatch, VTStates::Ground);
+        }
+    default:
+        return stay(VTActions::None);
     }
 }
 
 // Routine Description:
-// - Processes a character event into an Action that occurs while in the CsiParam state.
-//   Events in this state will:
-//   1. Execute C0 control characters
-//   2. Ignore Delete characters
-//   3. Begin to ignore all remaining parameters when an invalid character is detected (CsiIgnore)
-//   4. Store parameter data
-//   5. Dispatch a control sequence with parameters for action
+// - Builds the [state][character class] transition table.
 // Arguments:
-// - wch - Character that triggered the event
-// Return Value:
 // - <none>
-void StateMachine::_EventSs3Param(const wchar_t wch)
+// Return Value:
+// - The table.
+constexpr StateMachine::TransitionTable StateMachine::s_BuildTransitionTable() noexcept
 {
-    _trace.TraceOnEvent(L"Ss3Param");
-    if (s_IsC0Code(wch))
-    {
-        _ActionExecute(wch);
-    }
-    else if (s_IsDelete(wch))
-    {
-        _ActionIgnore();
-    }
-    else if (s_IsCsiParamValue(wch) || s_IsCsiDelimiter(wch))
-    {
-        _ActionParam(wch);
-    }
-    else if (s_IsCsiInvalid(wch) || s_IsCsiPrivateMarker(wch))
-    {
-        _EnterCsiIgnore();
-    }
-    else
+    TransitionTable table{};
+    for (size_t state = 0; state < table.size(); state++)
     {
-        _ActionSs3Dispatch(wch);
-        _EnterGround();
+        for (size_t charClass = 0; charClass < table[state].size(); charClass++)
+        {
+            table[state][charClass] = s_BuildTransition(static_cast<VTStates>(state), static_cast<CharClasses>(charClass));
+        }
     }
-}
+    return table;
+}
+
+// Both tables are generated by the compiler, so there's no work to build them at runtime.
+constexpr StateMachine::CharClassTable StateMachine::s_charClassTable = StateMachine::s_BuildCharClassTable();
+constexpr StateMachine::TransitionTable StateMachine::s_transitionTable = StateMachine::s_BuildTransitionTable();
+
+// The name each state reports to ParserTracing::TraceOnEvent, indexed by VTStates.
+constexpr StateMachine::StateNameTable StateMachine::s_stateNames = {
+    L"Ground",
+    L"Escape",
+    L"EscapeIntermediate",
+    L"CsiEntry",
+    L"CsiIntermediate",
+    L"CsiIgnore",
+    L"CsiParam",
+    L"OscParam",
+    L"OscString",
+    L"OscTermination",
+    L"Ss3Entry",
+    L"Ss3Param"
+};
 
 // Routine Description:
 // - Entry to the state machine. Takes characters one by one and processes them according to the state machine rules.
@@ -1247,52 +1246,66 @@ void StateMachine::_EventSs3Param(const wchar_t wch)
 void StateMachine::ProcessCharacter(const wchar_t wch)
 {
     _trace.TraceCharInput(wch);
+    _trace.TraceOnEvent(s_stateNames[static_cast<size_t>(_state)]);
 
-    // Process "from anywhere" events first.
-    if (wch == AsciiChars::CAN ||
-        wch == AsciiChars::SUB)
+    const CharClasses charClass = static_cast<size_t>(wch) < s_charClassTable.size() ? s_charClassTable[wch] : CharClasses::Other;
+    const Transition& transition = s_transitionTable[static_cast<size_t>(_state)][static_cast<size_t>(charClass)];
+
+    switch (transition.action)
     {
+    case VTActions::Ignore:
+        _ActionIgnore();
+        break;
+    case VTActions::Execute:
         _ActionExecute(wch);
-        _EnterGround();
-    }
-    else if (s_IsEscape(wch) && _state != VTStates::OscString)
-    {
-        // Don't go to escape from the OSC string state - ESC can be used to
-        //      terminate OSC strings.
-        _EnterEscape();
-    }
-    else
-    {
-        // Then pass to the current state as an event
-        switch (_state)
+        break;
+    case VTActions::ExecuteFromEscape:
+        // Whether a C0 control from the Escape state ends the sequence depends on the engine.
+        if (_pEngine->DispatchControlCharsFromEscape())
         {
-        case VTStates::Ground:
-            return _EventGround(wch);
-        case VTStates::Escape:
-            return _EventEscape(wch);
-        case VTStates::EscapeIntermediate:
-            return _EventEscapeIntermediate(wch);
-        case VTStates::CsiEntry:
-            return _EventCsiEntry(wch);
-        case VTStates::CsiIntermediate:
-            return _EventCsiIntermediate(wch);
-        case VTStates::CsiIgnore:
-            return _EventCsiIgnore(wch);
-        case VTStates::CsiParam:
-            return _EventCsiParam(wch);
-        case VTStates::OscParam:
-            return _EventOscParam(wch);
-        case VTStates::OscString:
-            return _EventOscString(wch);
-        case VTStates::OscTermination:
-            return _EventOscTermination(wch);
-        case VTStates::Ss3Entry:
-            return _EventSs3Entry(wch);
-        case VTStates::Ss3Param:
-            return _EventSs3Param(wch);
-        default:
-            return;
+            _ActionExecuteFromEscape(wch);
+            _EnterGround();
         }
+        else
+        {
+            _ActionExecute(wch);
+        }
+        break;
+    case VTActions::Print:
+        _ActionPrint(wch);
+        break;
+    case VTActions::Collect:
+        _ActionCollect(wch);
+        break;
+    case VTActions::Param:
+        _ActionParam(wch);
+        break;
+    case VTActions::EscDispatch:
+        _ActionEscDispatch(wch);
+        break;
+    case VTActions::CsiDispatch:
+        _ActionCsiDispatch(wch);
+        break;
+    case VTActions::OscParam:
+        _ActionOscParam(wch);
+        break;
+    case VTActions::OscPut:
+        _ActionOscPut(wch);
+        break;
+    case VTActions::OscDispatch:
+        _ActionOscDispatch(wch);
+        break;
+    case VTActions::Ss3Dispatch:
+        _ActionSs3Dispatch(wch);
+        break;
+    case VTActions::None:
+    default:
+        break;
+    }
+
+    if (transition.fEnterState)
+    {
+        _EnterState(transition.state);
     }
 }
 // Method Description:
@@ -1334,59 +1347,58 @@ void StateMachine::ProcessString(const wchar_t* const rgwch, const size_t cch)
     _pwchSequenceStart = rgwch;
     _currRunLength = 0;
 
-    // This should be static, because if one string starts a sequence, and the next finishes it,
-    //   we want the partial sequence state to persist.
-    static bool s_fProcessIndividually = false;
+    const wchar_t* const pwchEnd = rgwch + cch;
 
-    for(size_t cchCharsRemaining = cch; cchCharsRemaining > 0; cchCharsRemaining--)
+    while (_pwchCurr < pwchEnd)
     {
-        if (s_fProcessIndividually)
+        if (_fProcessingIndividually)
         {
             // If we're processing characters individually, send it to the state machine.
             ProcessCharacter(*_pwchCurr);
             _pwchCurr++;
             if (_state == VTStates::Ground)  // Then check if we're back at ground. If we are, the next character (pwchCurr)
             {                                //   is the start of the next run of characters that might be printable.
-                s_fProcessIndividually = false;
+                _fProcessingIndividually = false;
                 _pwchSequenceStart = _pwchCurr;
                 _currRunLength = 0;
             }
         }
         else
         {
-            if (s_IsActionableFromGround(*_pwchCurr))  // If the current char is the start of an escape sequence, or should be executed in ground state...
+            // Skip over the whole run of printable characters at once, adding them to the current run to be printed.
+            const wchar_t* const pwchActionable = s_FindNextActionableFromGround(_pwchCurr, pwchEnd);
+            _currRunLength += pwchActionable - _pwchCurr;
+            _pwchCurr = pwchActionable;
+
+            if (_pwchCurr < pwchEnd)  // If the current char is the start of an escape sequence, or should be executed in ground state...
             {
-                FAIL_FAST_IF(!(_pwchSequenceStart + _currRunLength <= rgwch + cch));
+                FAIL_FAST_IF(!(_pwchSequenceStart + _currRunLength <= pwchEnd));
                 _pEngine->ActionPrintString(_pwchSequenceStart, _currRunLength); // ... print all the chars leading up to it as part of the run...
                 _trace.DispatchPrintRunTrace(_pwchSequenceStart, _currRunLength);
-                s_fProcessIndividually = true; // begin processing future characters individually...
+                _fProcessingIndividually = true; // begin processing future characters individually...
                 _currRunLength = 0;
                 _pwchSequenceStart = _pwchCurr;
                 ProcessCharacter(*_pwchCurr); // ... Then process the character individually.
                 if (_state == VTStates::Ground)  // If the character took us right back to ground, start another run after it.
                 {
-                    s_fProcessIndividually = false;
+                    _fProcessingIndividually = false;
                     _pwchSequenceStart = _pwchCurr + 1;
                     _currRunLength = 0;
                 }
+                _pwchCurr++;
             }
-            else
-            {
-                _currRunLength++; // Otherwise, add this char to the current run to be printed.
-            }
-            _pwchCurr++;
         }
     }
 
     // If we're at the end of the string and have remaining un-printed characters,
-    if (!s_fProcessIndividually && _currRunLength > 0)
+    if (!_fProcessingIndividually && _currRunLength > 0)
     {
         // print the rest of the characters in the string
         _pEngine->ActionPrintString(_pwchSequenceStart, _currRunLength);
         _trace.DispatchPrintRunTrace(_pwchSequenceStart, _currRunLength);
 
     }
-    else if (s_fProcessIndividually)
+    else if (_fProcessingIndividually)
     {
         if (_pEngine->FlushAtEndOfString())
         {
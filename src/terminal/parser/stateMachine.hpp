@@ -17,6 +17,7 @@ Abstract:
 #include "IStateMachineEngine.hpp"
 #include "telemetry.hpp"
 #include "tracing.hpp"
+#include <array>
 #include <memory>
 
 namespace Microsoft::Console::VirtualTerminal
@@ -48,26 +49,21 @@ namespace Microsoft::Console::VirtualTerminal
 
     private:
         static bool s_IsActionableFromGround(const wchar_t wch);
-        static bool s_IsC0Code(const wchar_t wch);
-        static bool s_IsC1Csi(const wchar_t wch);
-        static bool s_IsIntermediate(const wchar_t wch);
-        static bool s_IsDelete(const wchar_t wch);
-        static bool s_IsEscape(const wchar_t wch);
-        static bool s_IsCsiIndicator(const wchar_t wch);
-        static bool s_IsCsiDelimiter(const wchar_t wch);
-        static bool s_IsCsiParamValue(const wchar_t wch);
-        static bool s_IsCsiPrivateMarker(const wchar_t wch);
-        static bool s_IsCsiInvalid(const wchar_t wch);
-        static bool s_IsOscIndicator(const wchar_t wch);
-        static bool s_IsOscDelimiter(const wchar_t wch);
-        static bool s_IsOscParamValue(const wchar_t wch);
-        static bool s_IsOscInvalid(const wchar_t wch);
-        static bool s_IsOscTerminator(const wchar_t wch);
-        static bool s_IsOscTerminationInitiator(const wchar_t wch);
-        static bool s_IsDesignateCharsetIndicator(const wchar_t wch);
-        static bool s_IsCharsetCode(const wchar_t wch);
-        static bool s_IsNumber(const wchar_t wch);
-        static bool s_IsSs3Indicator(const wchar_t wch);
+        static const wchar_t* s_FindNextActionableFromGround(const wchar_t* const pwchBegin,
+                                                             const wchar_t* const pwchEnd);
+        static constexpr bool s_IsC0Code(const wchar_t wch) noexcept;
+        static constexpr bool s_IsC1Csi(const wchar_t wch) noexcept;
+        static constexpr bool s_IsIntermediate(const wchar_t wch) noexcept;
+        static constexpr bool s_IsDelete(const wchar_t wch) noexcept;
+        static constexpr bool s_IsEscape(const wchar_t wch) noexcept;
+        static constexpr bool s_IsCsiIndicator(const wchar_t wch) noexcept;
+        static constexpr bool s_IsCsiDelimiter(const wchar_t wch) noexcept;
+        static constexpr bool s_IsCsiParamValue(const wchar_t wch) noexcept;
+        static constexpr bool s_IsCsiPrivateMarker(const wchar_t wch) noexcept;
+        static constexpr bool s_IsCsiInvalid(const wchar_t wch) noexcept;
+        static constexpr bool s_IsOscIndicator(const wchar_t wch) noexcept;
+        static constexpr bool s_IsOscTerminator(const wchar_t wch) noexcept;
+        static constexpr bool s_IsSs3Indicator(const wchar_t wch) noexcept;
 
         void _ActionExecute(const wchar_t wch);
         void _ActionExecuteFromEscape(const wchar_t wch);
@@ -97,19 +93,6 @@ namespace Microsoft::Console::VirtualTerminal
         void _EnterSs3Entry();
         void _EnterSs3Param();
 
-        void _EventGround(const wchar_t wch);
-        void _EventEscape(const wchar_t wch);
-        void _EventEscapeIntermediate(const wchar_t wch);
-        void _EventCsiEntry(const wchar_t wch);
-        void _EventCsiIntermediate(const wchar_t wch);
-        void _EventCsiIgnore(const wchar_t wch);
-        void _EventCsiParam(const wchar_t wch);
-        void _EventOscParam(const wchar_t wch);
-        void _EventOscString(const wchar_t wch);
-        void _EventOscTermination(const wchar_t wch);
-        void _EventSs3Entry(const wchar_t wch);
-        void _EventSs3Param(const wchar_t wch);
-
         enum class VTStates
         {
             Ground,
@@ -126,6 +109,74 @@ namespace Microsoft::Console::VirtualTerminal
             Ss3Param
         };
 
+        // The actions that can be taken when a character is processed. Each one
+        //      maps to one of the _Action* methods, see ProcessCharacter.
+        enum class VTActions
+        {
+            None,
+            Ignore,
+            Execute,
+            ExecuteFromEscape,
+            Print,
+            Collect,
+            Param,
+            EscDispatch,
+            CsiDispatch,
+            OscParam,
+            OscPut,
+            OscDispatch,
+            Ss3Dispatch
+        };
+
+        // Every character in a class is handled the same way in every state.
+        enum class CharClasses
+        {
+            C0,
+            Bell,
+            Cancel,
+            Escape,
+            Intermediate,
+            ParamValue,
+            Invalid,
+            Delimiter,
+            PrivateMarker,
+            CsiIndicator,
+            OscIndicator,
+            Ss3Indicator,
+            Delete,
+            C1Csi,
+            C1StringTerminator,
+            Other
+        };
+
+        struct Transition
+        {
+            VTActions action;
+            VTStates state;
+            bool fEnterState;
+        };
+
+        static constexpr size_t s_cStates = static_cast<size_t>(VTStates::Ss3Param) + 1;
+        static constexpr size_t s_cCharClasses = static_cast<size_t>(CharClasses::Other) + 1;
+
+        // Only characters below this need a lookup. Everything past it is CharClasses::Other.
+        static constexpr size_t s_cClassifiedChars = 0xA0;
+
+        using CharClassTable = std::array<CharClasses, s_cClassifiedChars>;
+        using TransitionTable = std::array<std::array<Transition, s_cCharClasses>, s_cStates>;
+        using StateNameTable = std::array<PCWSTR, s_cStates>;
+
+        static constexpr CharClasses s_ClassifyCharacter(const wchar_t wch) noexcept;
+        static constexpr CharClassTable s_BuildCharClassTable() noexcept;
+        static constexpr Transition s_BuildTransition(const VTStates state, const CharClasses charClass) noexcept;
+        static constexpr TransitionTable s_BuildTransitionTable() noexcept;
+
+        static const CharClassTable s_charClassTable;
+        static const TransitionTable s_transitionTable;
+        static const StateNameTable s_stateNames;
+
+        void _EnterState(const VTStates state);
+
         Microsoft::Console::VirtualTerminal::ParserTracing _trace;
 
         std::unique_ptr<IStateMachineEngine> _pEngine;
@@ -151,5 +202,11 @@ namespace Microsoft::Console::VirtualTerminal
         const wchar_t* _pwchSequenceStart;
         size_t _currRunLength;
 
+        // This is a member (and not a local), because if one string starts a
+        //      sequence, and the next finishes it, we want the partial sequence
+        //      state to persist. Each machine tracks its own, so that separate
+        //      machines can parse on separate threads.
+        bool _fProcessingIndividually;
+
     };
 }
@@ -550,16 +550,19 @@ class StatefulDispatch final : public TermDispatch
 {
 public:
 
-    virtual void Execute(const wchar_t /*wchControl*/) override
+    virtual void Execute(const wchar_t wchControl) override
     {
+        _executed += wchControl;
     }
 
-    virtual void Print(const wchar_t /*wchPrintable*/) override
+    virtual void Print(const wchar_t wchPrintable) override
     {
+        _printed += wchPrintable;
     }
 
-    virtual void PrintString(const wchar_t* const /*rgwch*/, const size_t /*cch*/) override
+    virtual void PrintString(const wchar_t* const rgwch, const size_t cch) override
     {
+        _printed.append(rgwch, cch);
     }
 
     StatefulDispatch() :
@@ -852,6 +855,9 @@ public:
     static const unsigned int s_uiGraphicsCleared = UINT_MAX;
     DispatchTypes::GraphicsOptions _rgOptions[s_cMaxOptions];
     size_t _cOptions;
+
+    std::wstring _printed;
+    std::wstring _executed;
 };
 
 class StateMachineExternalTest final
@@ -1647,4 +1653,127 @@ class StateMachineExternalTest final
         pDispatch->ClearState();
 
     }
+
+    TEST_METHOD(TestPrintableRunBoundaries)
+    {
+        StatefulDispatch* pDispatch = new StatefulDispatch;
+        VERIFY_IS_NOT_NULL(pDispatch);
+        StateMachine mach(new OutputStateMachineEngine(pDispatch));
+
+        // The ground state scans for actionable characters several at a time.
+        // Place each kind of actionable character at every offset of a run
+        //      long enough to span a few of those blocks, and make sure the
+        //      characters on either side of it are still printed.
+        // The filler includes the characters adjacent to each actionable one.
+        const std::wstring filler = L" ~\x80\x9a\x9c\xffff\x20ac\x3042" L"abcdefghijklmnopqrstuvwxyz0123456789";
+        const wchar_t rgwchActionable[] = { AsciiChars::NUL, AsciiChars::BEL, AsciiChars::US, AsciiChars::DEL };
+
+        for (const wchar_t wchActionable : rgwchActionable)
+        {
+            for (size_t pos = 0; pos <= filler.size(); pos++)
+            {
+                std::wstring input = filler;
+                input.insert(pos, 1, wchActionable);
+
+                mach.ProcessString(input);
+
+                VERIFY_ARE_EQUAL(String(filler.c_str()), String(pDispatch->_printed.c_str()));
+                VERIFY_ARE_EQUAL(1u, pDispatch->_executed.size());
+                VERIFY_ARE_EQUAL(wchActionable, pDispatch->_executed[0]);
+
+                // A character after the run is printed only if the machine
+                //      went back to the ground state.
+                mach.ProcessString(L"x");
+                VERIFY_ARE_EQUAL(String((filler + L"x").c_str()), String(pDispatch->_printed.c_str()));
+
+                pDispatch->ClearState();
+            }
+        }
+
+        Log::Comment(L"A C1 CSI in the middle of a long run should start a sequence.");
+        std::wstring input = filler;
+        input.insert(13, L"\x9b" L"2J");
+        mach.ProcessString(input);
+
+        VERIFY_IS_TRUE(pDispatch->_fEraseDisplay);
+        VERIFY_ARE_EQUAL(DispatchTypes::EraseType::All, pDispatch->_eraseType);
+        VERIFY_ARE_EQUAL(String(filler.c_str()), String(pDispatch->_printed.c_str()));
+
+        pDispatch->ClearState();
+    }
+
+    TEST_METHOD(TestInterleavedMachines)
+    {
+        StatefulDispatch* pDispatchA = new StatefulDispatch;
+        VERIFY_IS_NOT_NULL(pDispatchA);
+        StateMachine machA(new OutputStateMachineEngine(pDispatchA));
+
+        StatefulDispatch* pDispatchB = new StatefulDispatch;
+        VERIFY_IS_NOT_NULL(pDispatchB);
+        StateMachine machB(new OutputStateMachineEngine(pDispatchB));
+
+        Log::Comment(L"Start a sequence on one machine, then feed text to the other.");
+        machA.ProcessString(L"\x1b[1;", 4);
+        machB.ProcessString(L"Hello", 5);
+
+        VERIFY_IS_FALSE(pDispatchA->_fSetGraphics);
+        VERIFY_ARE_EQUAL(String(L"Hello"), String(pDispatchB->_printed.c_str()));
+
+        Log::Comment(L"Finishing the sequence on the first machine shouldn't be affected by the second.");
+        machA.ProcessString(L"30mWorld", 8);
+
+        VERIFY_IS_TRUE(pDispatchA->_fSetGraphics);
+        VERIFY_ARE_EQUAL(String(L"World"), String(pDispatchA->_printed.c_str()));
+        VERIFY_IS_FALSE(pDispatchB->_fSetGraphics);
+    }
+
+    TEST_METHOD(TestMachinesOnSeparateThreads)
+    {
+        const size_t cThreads = 8;
+        const size_t cIterations = 2000;
+
+        // Each thread owns a machine, and feeds it sequences split at a
+        //      different point, so that the machines are mid-sequence at
+        //      different times. The threads only record their failures, and
+        //      we verify them all here, once the threads are done.
+        std::vector<std::thread> threads;
+        std::vector<size_t> failures(cThreads, 0);
+
+        for (size_t i = 0; i < cThreads; i++)
+        {
+            threads.emplace_back([=, &failures]() {
+                StatefulDispatch* pDispatch = new StatefulDispatch;
+                StateMachine mach(new OutputStateMachineEngine(pDispatch));
+
+                const std::wstring input = L"abc\x1b[1;30mdef\x1b[2Jghi";
+                const size_t split = ((i * 3) % (input.size() - 1)) + 1;
+
+                for (size_t iteration = 0; iteration < cIterations; iteration++)
+                {
+                    mach.ProcessString(input.substr(0, split));
+                    mach.ProcessString(input.substr(split));
+
+                    if (!pDispatch->_fSetGraphics ||
+                        !pDispatch->_fEraseDisplay ||
+                        pDispatch->_eraseType != DispatchTypes::EraseType::All ||
+                        pDispatch->_printed != L"abcdefghi")
+                    {
+                        failures[i]++;
+                    }
+
+                    pDispatch->ClearState();
+                }
+            });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        for (size_t i = 0; i < cThreads; i++)
+        {
+            VERIFY_ARE_EQUAL(0u, failures[i], NoThrowString().Format(L"Thread %zu", i));
+        }
+    }
 };
@@ -48,3 +48,15 @@ void NotifyGlyphWidthFontChanged()
 {
     widthDetector.NotifyFontChanged();
 }
+
+// Function Description:
+// - Asks the global CodepointWidthDetector about each glyph in the text now, so
+//      that drawing them later doesn't have to wait on the fallback method.
+// Arguments:
+// - glyphs - the text whose glyphs are about to be drawn.
+// Return Value:
+// - <none>
+void WarmGlyphWidthCache(const std::wstring_view glyphs)
+{
+    widthDetector.WarmFallbackCache(glyphs);
+}
@@ -0,0 +1,205 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "inc/InputRecordRing.hpp"
+
+static constexpr size_t s_minimumCapacity = 16;
+
+InputRecordRing::InputRecordRing() noexcept :
+    _records{},
+    _head{ 0 },
+    _size{ 0 }
+{
+}
+
+bool InputRecordRing::empty() const noexcept
+{
+    return _size == 0;
+}
+
+size_t InputRecordRing::size() const noexcept
+{
+    return _size;
+}
+
+INPUT_RECORD& InputRecordRing::front() noexcept
+{
+    return (*this)[0];
+}
+
+const INPUT_RECORD& InputRecordRing::front() const noexcept
+{
+    return (*this)[0];
+}
+
+INPUT_RECORD& InputRecordRing::back() noexcept
+{
+    return (*this)[_size - 1];
+}
+
+const INPUT_RECORD& InputRecordRing::back() const noexcept
+{
+    return (*this)[_size - 1];
+}
+
+INPUT_RECORD& InputRecordRing::operator[](const size_t index) noexcept
+{
+    return _records[_Slot(index)];
+}
+
+const INPUT_RECORD& InputRecordRing::operator[](const size_t index) const noexcept
+{
+    return _records[_Slot(index)];
+}
+
+// Routine Description:
+// - Adds a record to the end of the queue.
+// Arguments:
+// - record - The record to add.
+// Return Value:
+// - <none>
+void InputRecordRing::push_back(const INPUT_RECORD& record)
+{
+    _Reserve(_size + 1);
+    _records[_Slot(_size)] = record;
+    _size++;
+}
+
+// Routine Description:
+// - Adds records to the end of the queue, growing the ring at most once.
+// Arguments:
+// - records - The records to add, in order.
+// Return Value:
+// - <none>
+void InputRecordRing::append(const gsl::span<const INPUT_RECORD> records)
+{
+    const size_t count = gsl::narrow<size_t>(records.size());
+    _Reserve(_size + count);
+
+    // The free space starts right after the last record and may wrap around
+    //      the end of the ring, so the records go in as at most two pieces.
+    const size_t tail = _Slot(_size);
+    const size_t firstCount = std::min(count, _records.size() - tail);
+    std::copy_n(records.data(), firstCount, _records.data() + tail);
+    std::copy_n(records.data() + firstCount, count - firstCount, _records.data());
+    _size += count;
+}
+
+// Routine Description:
+// - Copies records out of the queue without removing them.
+// Arguments:
+// - index - The position of the first record to copy.
+// - count - The number of records to copy. index + count must not be past
+//      the end of the queue.
+// - outRecords - The records are appended to this.
+// Return Value:
+// - <none>
+void InputRecordRing::copy_to(const size_t index, const size_t count, std::vector<INPUT_RECORD>& outRecords) const
+{
+    FAIL_FAST_IF(index + count > _size);
+
+    const size_t first = _Slot(index);
+    const size_t firstCount = std::min(count, _records.size() - first);
+    outRecords.insert(outRecords.end(), _records.cbegin() + first, _records.cbegin() + first + firstCount);
+    outRecords.insert(outRecords.end(), _records.cbegin(), _records.cbegin() + (count - firstCount));
+}
+
+// Routine Description:
+// - Removes records from the front of the queue.
+// Arguments:
+// - count - The number of records to remove. Must not be more than size().
+// Return Value:
+// - <none>
+void InputRecordRing::erase_front(const size_t count) noexcept
+{
+    FAIL_FAST_IF(count > _size);
+    if (count == _size)
+    {
+        clear();
+    }
+    else
+    {
+        _head = _Slot(count);
+        _size -= count;
+    }
+}
+
+// Routine Description:
+// - Removes records from the end of the queue.
+// Arguments:
+// - count - The number of records to remove. Must not be more than size().
+// Return Value:
+// - <none>
+void InputRecordRing::erase_back(const size_t count) noexcept
+{
+    FAIL_FAST_IF(count > _size);
+    if (count == _size)
+    {
+        clear();
+    }
+    else
+    {
+        _size -= count;
+    }
+}
+
+// Routine Description:
+// - Removes every record. A ring grown past RETAINED_CAPACITY is freed.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void InputRecordRing::clear() noexcept
+{
+    _head = 0;
+    _size = 0;
+    if (_records.size() > RETAINED_CAPACITY)
+    {
+        std::vector<INPUT_RECORD>{}.swap(_records);
+    }
+}
+
+// Routine Description:
+// - Makes sure the ring can hold at least the given number of records,
+//      doubling its capacity as many times as needed. Growing unwraps the
+//      records so the first one is at the start of the new ring.
+// Arguments:
+// - count - The number of records the ring needs to hold.
+// Return Value:
+// - <none>
+void InputRecordRing::_Reserve(const size_t count)
+{
+    if (count <= _records.size())
+    {
+        return;
+    }
+
+    size_t capacity = std::max(_records.size(), s_minimumCapacity);
+    while (capacity < count)
+    {
+        THROW_HR_IF(E_OUTOFMEMORY, capacity > SIZE_MAX / 2);
+        capacity *= 2;
+    }
+
+    std::vector<INPUT_RECORD> records(capacity);
+    const size_t firstCount = std::min(_size, _records.size() - _head);
+    std::copy_n(_records.data() + _head, firstCount, records.data());
+    std::copy_n(_records.data(), _size - firstCount, records.data() + firstCount);
+
+    _records.swap(records);
+    _head = 0;
+}
+
+// Routine Description:
+// - Finds the slot in the ring that holds the record at the given position
+//      in the queue.
+// Arguments:
+// - index - The position in the queue.
+// Return Value:
+// - The index into _records.
+size_t InputRecordRing::_Slot(const size_t index) const noexcept
+{
+    return (_head + index) & (_records.size() - 1);
+}
@@ -0,0 +1,232 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "inc/Utf8Decoder.hpp"
+
+static constexpr unsigned char s_lowerBoundaryDefault = 0x80;
+static constexpr unsigned char s_upperBoundaryDefault = 0xBF;
+
+Utf8Decoder::Utf8Decoder() noexcept :
+    _codepoint{ 0 },
+    _cbNeeded{ 0 },
+    _cbSeen{ 0 },
+    _lowerBoundary{ s_lowerBoundaryDefault },
+    _upperBoundary{ s_upperBoundaryDefault }
+{
+}
+
+// Routine Description:
+// - Decodes the given bytes, continuing any sequence left incomplete by the
+//   previous call.
+// - If the bytes end partway through a sequence, that sequence is held on to
+//   and finished by the next call (or replaced by Flush).
+// Arguments:
+// - bytes - The next chunk of the UTF-8 stream.
+// Return Value:
+// - The decoded text. The view is only valid until the next call to Decode
+//   or Flush.
+std::wstring_view Utf8Decoder::Decode(const std::string_view bytes)
+{
+    // Every byte decodes to at most one UTF-16 unit, except for:
+    // - a 4 byte sequence, which decodes to two units from four bytes, and
+    // - an invalid byte after a partial sequence, which is the replacement
+    //   character for the sequence and then the byte reprocessed by itself.
+    // The latter can only happen once per call more than the byte count,
+    // since it resets the carried-over state.
+    const size_t cchRequired = bytes.size() + 1;
+    if (_buffer.size() < cchRequired)
+    {
+        _buffer.resize(cchRequired);
+    }
+
+    wchar_t* const pwchBegin = _buffer.data();
+    wchar_t* pwchOut = pwchBegin;
+
+    size_t i = 0;
+    while (i < bytes.size())
+    {
+        const auto b = static_cast<unsigned char>(bytes[i]);
+
+        if (_cbNeeded == 0)
+        {
+            if (b < 0x80)
+            {
+                // Most output is ASCII, so handle as much of it at once as we can.
+                const auto cch = _DecodeAscii(bytes.substr(i), pwchOut);
+                pwchOut += cch;
+                i += cch;
+                continue;
+            }
+            else if (b >= 0xC2 && b <= 0xDF)
+            {
+                _cbNeeded = 1;
+                _codepoint = b & 0x1F;
+            }
+            else if (b >= 0xE0 && b <= 0xEF)
+            {
+                // Reject overlong encodings and surrogates up front.
+                if (b == 0xE0)
+                {
+                    _lowerBoundary = 0xA0;
+                }
+                else if (b == 0xED)
+                {
+                    _upperBoundary = 0x9F;
+                }
+                _cbNeeded = 2;
+                _codepoint = b & 0xF;
+            }
+            else if (b >= 0xF0 && b <= 0xF4)
+            {
+                // Reject overlong encodings and anything past U+10FFFF.
+                if (b == 0xF0)
+                {
+                    _lowerBoundary = 0x90;
+                }
+                else if (b == 0xF4)
+                {
+                    _upperBoundary = 0x8F;
+                }
+                _cbNeeded = 3;
+                _codepoint = b & 0x7;
+            }
+            else
+            {
+                // A stray continuation byte, or a lead byte that can never
+                //      start a valid sequence.
+                *pwchOut++ = UNICODE_REPLACEMENT;
+            }
+            i++;
+            continue;
+        }
+
+        if (b < _lowerBoundary || b > _upperBoundary)
+        {
+            // The sequence so far is invalid. Replace it, then start over at
+            //      this byte, without consuming it.
+            Reset();
+            *pwchOut++ = UNICODE_REPLACEMENT;
+            continue;
+        }
+
+        _lowerBoundary = s_lowerBoundaryDefault;
+        _upperBoundary = s_upperBoundaryDefault;
+        _codepoint = (_codepoint << 6) | (b & 0x3F);
+        _cbSeen++;
+        i++;
+
+        if (_cbSeen == _cbNeeded)
+        {
+            pwchOut = _AppendCodepoint(pwchOut);
+            Reset();
+        }
+    }
+
+    return { pwchBegin, static_cast<size_t>(pwchOut - pwchBegin) };
+}
+
+// Routine Description:
+// - Ends the stream. If we were in the middle of a sequence, it will never be
+//   completed, so it's replaced with U+FFFD.
+// Arguments:
+// - <none>
+// Return Value:
+// - The remaining decoded text, which is either empty or a single
+//   replacement character. Valid until the next call to Decode or Flush.
+std::wstring_view Utf8Decoder::Flush()
+{
+    if (_cbNeeded == 0)
+    {
+        return {};
+    }
+
+    Reset();
+    if (_buffer.empty())
+    {
+        _buffer.resize(1);
+    }
+    _buffer[0] = UNICODE_REPLACEMENT;
+    return { _buffer.data(), 1 };
+}
+
+// Routine Description:
+// - Drops any partial sequence carried over from a previous call.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Utf8Decoder::Reset() noexcept
+{
+    _codepoint = 0;
+    _cbNeeded = 0;
+    _cbSeen = 0;
+    _lowerBoundary = s_lowerBoundaryDefault;
+    _upperBoundary = s_upperBoundaryDefault;
+}
+
+// Routine Description:
+// - Widens the run of ASCII at the start of bytes, eight bytes at a time
+//   where possible.
+// Arguments:
+// - bytes - The bytes to decode. The first must be ASCII.
+// - pwchOut - Where to write the decoded characters. Must have room for
+//   bytes.size() characters.
+// Return Value:
+// - The number of bytes (and characters) handled.
+size_t Utf8Decoder::_DecodeAscii(const std::string_view bytes, wchar_t* const pwchOut) noexcept
+{
+    constexpr uint64_t highBits = 0x8080808080808080;
+
+    const char* const pchBegin = bytes.data();
+    const char* const pchEnd = pchBegin + bytes.size();
+    const char* pch = pchBegin;
+    wchar_t* pwch = pwchOut;
+
+    while (pchEnd - pch >= 8)
+    {
+        uint64_t block;
+        memcpy(&block, pch, sizeof(block));
+        if ((block & highBits) != 0)
+        {
+            break;
+        }
+
+        for (size_t j = 0; j < 8; j++)
+        {
+            pwch[j] = static_cast<wchar_t>(pch[j]);
+        }
+        pch += 8;
+        pwch += 8;
+    }
+
+    while (pch < pchEnd && static_cast<unsigned char>(*pch) < 0x80)
+    {
+        *pwch++ = static_cast<wchar_t>(*pch++);
+    }
+
+    return pch - pchBegin;
+}
+
+// Routine Description:
+// - Writes out the codepoint we just finished decoding, as a surrogate pair
+//   if it's outside the BMP.
+// Arguments:
+// - pwchOut - Where to write it. Must have room for two characters.
+// Return Value:
+// - The position just past what was written.
+wchar_t* Utf8Decoder::_AppendCodepoint(wchar_t* pwchOut) noexcept
+{
+    if (_codepoint < 0x10000)
+    {
+        *pwchOut++ = static_cast<wchar_t>(_codepoint);
+    }
+    else
+    {
+        const auto cp = _codepoint - 0x10000;
+        *pwchOut++ = static_cast<wchar_t>(0xD800 + (cp >> 10));
+        *pwchOut++ = static_cast<wchar_t>(0xDC00 + (cp & 0x3FF));
+    }
+    return pwchOut;
+}
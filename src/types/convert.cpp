@@ -322,6 +322,49 @@ std::deque<std::unique_ptr<KeyEvent>> SynthesizeNumpadEvents(const wchar_t wch,
     return keyEvents;
 }
 
+// Routine Description:
+// - makes the key down record for a wchar_t as if it was typed using the
+// keyboard, without the modifier key events or the key up that
+// SynthesizeKeyboardEvents surrounds it with.
+// Arguments:
+// - wch - the wchar_t to convert
+// Return Value:
+// - the key down record. Its virtual key is 0 if wch can't be typed on the
+// current keyboard layout.
+INPUT_RECORD CharToKeyDownRecord(const wchar_t wch) noexcept
+{
+    INPUT_RECORD record{};
+    record.EventType = KEY_EVENT;
+    record.Event.KeyEvent.bKeyDown = TRUE;
+    record.Event.KeyEvent.wRepeatCount = 1;
+    record.Event.KeyEvent.uChar.UnicodeChar = wch;
+
+    const short invalidKey = -1;
+    const short keyState = VkKeyScanW(wch);
+    if (keyState != invalidKey)
+    {
+        const byte modifierState = HIBYTE(keyState);
+        record.Event.KeyEvent.wVirtualKeyCode = LOBYTE(keyState);
+        record.Event.KeyEvent.wVirtualScanCode = gsl::narrow_cast<WORD>(MapVirtualKeyW(wch, MAPVK_VK_TO_VSC));
+
+        DWORD& controlKeyState = record.Event.KeyEvent.dwControlKeyState;
+        if (WI_IsFlagSet(modifierState, VkKeyScanModState::ShiftPressed))
+        {
+            WI_SetFlag(controlKeyState, SHIFT_PRESSED);
+        }
+        if (WI_IsFlagSet(modifierState, VkKeyScanModState::CtrlPressed))
+        {
+            WI_SetFlag(controlKeyState, LEFT_CTRL_PRESSED);
+        }
+        if (WI_AreAllFlagsSet(modifierState, VkKeyScanModState::CtrlAndAltPressed))
+        {
+            WI_SetFlag(controlKeyState, RIGHT_ALT_PRESSED);
+        }
+    }
+
+    return record;
+}
+
 // Routine Description:
 // - naively determines the width of a UCS2 encoded wchar
 // Arguments:
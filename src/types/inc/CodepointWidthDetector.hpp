@@ -15,87 +15,9 @@ Author:
 
 #include "convert.hpp"
 
-static_assert(sizeof(unsigned int) == sizeof(wchar_t) * 2,
-              "UnicodeRange expects to be able to store a unicode codepoint in an unsigned int");
-
-
 // use to measure the width of a codepoint
 class CodepointWidthDetector final
 {
-protected:
-
-    // used to store range data in CodepointWidthDetector's internal map
-    class UnicodeRange final
-    {
-    public:
-        UnicodeRange(const unsigned int lowerBound,
-                     const unsigned int upperBound) :
-                     _lowerBound{ lowerBound },
-                     _upperBound{ upperBound },
-                     _isBounds{ true }
-        {
-        }
-
-        UnicodeRange(const unsigned int searchTerm) :
-                     _lowerBound{ searchTerm },
-                     _upperBound{ searchTerm },
-                     _isBounds{ false }
-        {
-        }
-
-        bool IsBounds() const noexcept
-        {
-            return _isBounds;
-        }
-
-        unsigned int LowerBound() const
-        {
-            FAIL_FAST_IF(!_isBounds);
-            return _lowerBound;
-        }
-
-        unsigned int UpperBound() const
-        {
-            FAIL_FAST_IF(!_isBounds);
-            return _upperBound;
-        }
-
-        unsigned int SearchTerm() const
-        {
-            FAIL_FAST_IF(_isBounds);
-            return _lowerBound;
-        }
-
-    private:
-        unsigned int _lowerBound;
-        unsigned int _upperBound;
-        bool _isBounds;
-    };
-
-    // used for comparing if we've found the range that a searching UnicodeRange falls into
-    struct UnicodeRangeCompare final
-    {
-        bool operator()(const UnicodeRange& a, const UnicodeRange& b) const
-        {
-            if (!a.IsBounds() && b.IsBounds())
-            {
-                return a.SearchTerm() < b.LowerBound();
-            }
-            else if (a.IsBounds() && !b.IsBounds())
-            {
-                return a.UpperBound() < b.SearchTerm();
-            }
-            else if (a.IsBounds() && b.IsBounds())
-            {
-                return a.LowerBound() < b.LowerBound();
-            }
-            else
-            {
-                return a.SearchTerm() < b.SearchTerm();
-            }
-        }
-    };
-
 public:
     CodepointWidthDetector() = default;
     CodepointWidthDetector(const CodepointWidthDetector&) = delete;
@@ -108,6 +30,17 @@ public:
     bool IsWide(const wchar_t wch) const noexcept;
     void SetFallbackMethod(std::function<bool(const std::wstring_view)> pfnFallback);
     void NotifyFontChanged() const noexcept;
+    void WarmFallbackCache(const std::wstring_view glyphs) const;
+
+    struct FallbackCacheStatistics
+    {
+        size_t cHits;
+        size_t cMisses;
+        // Misses that pushed out another codepoint's answer for the current font.
+        size_t cEvictions;
+    };
+
+    FallbackCacheStatistics GetFallbackCacheStatistics() const noexcept;
 
 #ifdef UNIT_TESTING
     friend class CodepointWidthDetectorTests;
@@ -117,10 +50,25 @@ private:
     bool _lookupIsWide(const std::wstring_view glyph) const noexcept;
     bool _checkFallbackViaCache(const std::wstring_view glyph) const;
     unsigned int _extractCodepoint(const std::wstring_view glyph) const noexcept;
-    void _populateUnicodeSearchMap();
+    static CodepointWidth _lookupWidth(const unsigned int codepoint) noexcept;
+
+    // An answer from the fallback method. It's only good while its epoch is the
+    //      current one, so changing the font doesn't have to touch the cache.
+    struct FallbackCacheEntry
+    {
+        unsigned int codepoint;
+        unsigned int epoch;
+        bool isWide;
+    };
+
+    // Each codepoint can only go in the slot picked by its low bits. Ambiguous
+    //      codepoints come in runs, so a run fits without pushing itself out.
+    static constexpr size_t s_fallbackCacheSize = 1024;
+    static_assert((s_fallbackCacheSize & (s_fallbackCacheSize - 1)) == 0, "the fallback cache size must be a power of two");
 
-    mutable std::map<std::wstring, bool> _fallbackCache;
-    std::map<UnicodeRange, CodepointWidth, UnicodeRangeCompare> _map;
+    mutable std::array<FallbackCacheEntry, s_fallbackCacheSize> _fallbackCache{};
+    mutable unsigned int _fallbackEpoch = 1;
+    mutable FallbackCacheStatistics _fallbackCacheStatistics{};
     std::function<bool(std::wstring_view)> _pfnFallbackMethod;
     bool _hasFallback = false;
 };
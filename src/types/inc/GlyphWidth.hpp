@@ -13,3 +13,4 @@ bool IsGlyphFullWidth(const std::wstring_view glyph);
 bool IsGlyphFullWidth(const wchar_t wch);
 void SetGlyphWidthFallback(std::function<bool(std::wstring_view)> pfnFallback);
 void NotifyGlyphWidthFontChanged();
+void WarmGlyphWidthCache(const std::wstring_view glyphs);
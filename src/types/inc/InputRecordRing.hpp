@@ -0,0 +1,57 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- InputRecordRing.hpp
+
+Abstract:
+- A queue of INPUT_RECORDs stored by value in one contiguous ring.
+- INPUT_RECORD is already a tagged union of every kind of input event, so
+  storing it directly costs no allocation per event. Writing and reading
+  events in bulk copies them in at most two contiguous pieces.
+- The ring doubles in size when it's full. It keeps its memory while it's
+  in use, and lets go of it once a large burst (a paste) has been read out.
+--*/
+
+#pragma once
+
+#include <vector>
+
+class InputRecordRing final
+{
+public:
+    InputRecordRing() noexcept;
+
+    bool empty() const noexcept;
+    size_t size() const noexcept;
+
+    INPUT_RECORD& front() noexcept;
+    const INPUT_RECORD& front() const noexcept;
+    INPUT_RECORD& back() noexcept;
+    const INPUT_RECORD& back() const noexcept;
+    INPUT_RECORD& operator[](const size_t index) noexcept;
+    const INPUT_RECORD& operator[](const size_t index) const noexcept;
+
+    void push_back(const INPUT_RECORD& record);
+    void append(const gsl::span<const INPUT_RECORD> records);
+    void copy_to(const size_t index, const size_t count, std::vector<INPUT_RECORD>& outRecords) const;
+
+    void erase_front(const size_t count) noexcept;
+    void erase_back(const size_t count) noexcept;
+    void clear() noexcept;
+
+    // The most records we hold on to once the ring is empty again. A larger
+    //      ring was grown for a burst of input and is freed.
+    static constexpr size_t RETAINED_CAPACITY = 4096;
+
+private:
+    void _Reserve(const size_t count);
+    size_t _Slot(const size_t index) const noexcept;
+
+    // The capacity is always zero or a power of two, so a slot is found by
+    //      masking instead of dividing.
+    std::vector<INPUT_RECORD> _records;
+    size_t _head;
+    size_t _size;
+};
@@ -0,0 +1,50 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- Utf8Decoder.hpp
+
+Abstract:
+- Incrementally decodes a stream of UTF-8 bytes into UTF-16.
+- A multi-byte sequence may be split across calls to Decode, the partial
+  sequence is carried over to the next call.
+- Invalid sequences are replaced with U+FFFD, following the WHATWG Encoding
+  standard's "maximal subpart" rule (the same one MultiByteToWideChar uses).
+- The decoded text is written into a buffer owned by the decoder, which is
+  reused across calls, so steady-state decoding doesn't allocate.
+--*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+class Utf8Decoder final
+{
+public:
+    Utf8Decoder() noexcept;
+
+    std::wstring_view Decode(const std::string_view bytes);
+    std::wstring_view Flush();
+    void Reset() noexcept;
+
+    static constexpr wchar_t UNICODE_REPLACEMENT = 0xFFFD;
+
+private:
+    size_t _DecodeAscii(const std::string_view bytes, wchar_t* const pwchOut) noexcept;
+    wchar_t* _AppendCodepoint(wchar_t* pwchOut) noexcept;
+
+    // The state of the sequence we're currently in the middle of, if any.
+    uint32_t _codepoint;
+    unsigned int _cbNeeded;
+    unsigned int _cbSeen;
+    unsigned char _lowerBoundary;
+    unsigned char _upperBoundary;
+
+    std::wstring _buffer;
+
+#ifdef UNIT_TESTING
+    friend class Utf8DecoderTests;
+#endif
+};
@@ -0,0 +1,144 @@
+#.SYNOPSIS
+# Generates src\types\CodepointWidthTable.hpp, the lookup table that
+# CodepointWidthDetector uses for the width of a codepoint, from the Unicode
+# character database's EastAsianWidth.txt.
+#
+#.DESCRIPTION
+# Fullwidth (F) and Wide (W) codepoints are wide, Ambiguous (A) ones are
+# ambiguous, and every other listed codepoint is narrow. Codepoints the file
+# doesn't list are invalid.
+#
+# The table has two stages. The top bits of a codepoint pick a block of 256
+# codepoints and the low 8 bits pick the codepoint's width in that block. Each
+# byte of a block holds four widths, two bits each. Blocks that are alike are
+# only stored once, which keeps the whole table to a few kilobytes.
+#
+#.PARAMETER EastAsianWidthPath
+# Path to EastAsianWidth.txt, from http://www.unicode.org/Public/UCD/latest/ucd/EastAsianWidth.txt
+#
+#.PARAMETER OutputPath
+# Where to write the table. Defaults to src\types\CodepointWidthTable.hpp.
+[CmdletBinding()]
+Param (
+    [parameter(Mandatory=$true)]
+    [string]$EastAsianWidthPath,
+
+    [parameter(Mandatory=$false)]
+    [string]$OutputPath = "$PSScriptRoot\..\src\types\CodepointWidthTable.hpp"
+)
+
+# These have to match the values of the CodepointWidth enum in src\types\inc\convert.hpp.
+$Narrow = 0
+$Wide = 1
+$Ambiguous = 2
+$Invalid = 3
+
+$MaxCodepoint = 0x10FFFF
+$BlockShift = 8
+$BlockSize = 1 -shl $BlockShift
+$BlockCount = ($MaxCodepoint + 1) -shr $BlockShift
+
+$widths = New-Object 'byte[]' ($MaxCodepoint + 1)
+for ($cp = 0; $cp -le $MaxCodepoint; $cp++)
+{
+    $widths[$cp] = $Invalid
+}
+
+foreach ($line in Get-Content $EastAsianWidthPath)
+{
+    $data = ($line -split '#')[0].Trim()
+    if ($data -eq '')
+    {
+        continue
+    }
+
+    $fields = $data -split ';'
+    $range = $fields[0].Trim() -split '\.\.'
+    $first = [Convert]::ToInt32($range[0], 16)
+    $last = $first
+    if ($range.Length -gt 1)
+    {
+        $last = [Convert]::ToInt32($range[1], 16)
+    }
+
+    $width = switch -CaseSensitive ($fields[1].Trim())
+    {
+        'F' { $Wide }
+        'W' { $Wide }
+        'A' { $Ambiguous }
+        default { $Narrow }
+    }
+
+    for ($cp = $first; $cp -le $last; $cp++)
+    {
+        $widths[$cp] = $width
+    }
+}
+
+# Pack every block and keep the first of those that are alike.
+$blocks = New-Object 'System.Collections.Generic.List[byte[]]'
+$blockIds = @{}
+$blockIndex = New-Object 'byte[]' $BlockCount
+for ($block = 0; $block -lt $BlockCount; $block++)
+{
+    $packed = New-Object 'byte[]' ($BlockSize -shr 2)
+    for ($i = 0; $i -lt $BlockSize; $i++)
+    {
+        $packed[$i -shr 2] = $packed[$i -shr 2] -bor ($widths[($block -shl $BlockShift) + $i] -shl (($i -band 3) * 2))
+    }
+
+    $key = [BitConverter]::ToString($packed)
+    if (-not $blockIds.ContainsKey($key))
+    {
+        if ($blocks.Count -gt 255)
+        {
+            throw "There are too many different blocks to index them with a byte."
+        }
+        $blockIds[$key] = $blocks.Count
+        $blocks.Add($packed)
+    }
+    $blockIndex[$block] = $blockIds[$key]
+}
+
+# Formats bytes as C++ hex literals, 16 to a line.
+function Format-Bytes([byte[]]$bytes, [string]$indent)
+{
+    for ($i = 0; $i -lt $bytes.Length; $i += 16)
+    {
+        $end = [Math]::Min($i + 16, $bytes.Length) - 1
+        $indent + (($bytes[$i..$end] | ForEach-Object { '0x{0:X2}' -f $_ }) -join ', ') + ','
+    }
+}
+
+$lines = New-Object 'System.Collections.Generic.List[string]'
+$lines.Add('// Copyright (c) Microsoft Corporation.')
+$lines.Add('// Licensed under the MIT license.')
+$lines.Add('')
+$lines.Add('// Generated by tools\Generate-CodepointWidthTable.ps1 from EastAsianWidth.txt.')
+$lines.Add('// Run the script again rather than editing this file.')
+$lines.Add('')
+$lines.Add('#pragma once')
+$lines.Add('')
+$lines.Add('namespace CodepointWidthTable')
+$lines.Add('{')
+$lines.Add("    constexpr unsigned int s_maxCodepoint = 0x{0:X};" -f $MaxCodepoint)
+$lines.Add("    constexpr unsigned int s_blockShift = $BlockShift;")
+$lines.Add('')
+$lines.Add('    // Which of s_blocks each block of codepoints uses.')
+$lines.Add("    constexpr BYTE s_blockIndex[0x{0:X}] = {{" -f $BlockCount)
+Format-Bytes $blockIndex '        ' | ForEach-Object { $lines.Add($_) }
+$lines.Add('    };')
+$lines.Add('')
+$lines.Add('    // Four CodepointWidth values to a byte, the lowest codepoint in the lowest bits.')
+$lines.Add("    constexpr BYTE s_blocks[{0}][{1}] = {{" -f $blocks.Count, ($BlockSize -shr 2))
+foreach ($packed in $blocks)
+{
+    $lines.Add('        {')
+    Format-Bytes $packed '            ' | ForEach-Object { $lines.Add($_) }
+    $lines.Add('        },')
+}
+$lines.Add('    };')
+$lines.Add('}')
+
+[System.IO.File]::WriteAllText($OutputPath, ($lines -join "`r`n") + "`r`n")
+Write-Host "Wrote $($blocks.Count) blocks to $OutputPath" -ForegroundColor Green